@@ -0,0 +1,91 @@
+#include "../src/frontend/astArena.h"
+#include "../src/frontend/lexer.h"
+#include "../src/frontend/parser.h"
+#include "../src/frontend/program.h"
+#include "../src/frontend/sourceBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Benchmark parsing a translation unit into an AST and destroying it, with the
+// AST nodes allocated on the heap and from an `AST::ASTArena`.
+//
+// The tokens are lexed once up front, so only the parser (which allocates the
+// nodes) and the destruction of the AST are timed. With the arena, destroying
+// the AST still runs the destructor of every node (the nodes are owned through
+// `std::unique_ptr`, and their strings and vectors still live on the heap);
+// only the storage of the nodes themselves is freed all at once with the
+// arena.
+//
+// Usage: astArenaBenchmark <sourceFile> [<runs>]
+
+namespace {
+/**
+ * Parse the tokens into an AST and destroy it, with the AST nodes allocated
+ * from an arena (if given) or from the heap.
+ *
+ * @param tokens The tokens of the translation unit.
+ * @param useArena Whether to allocate the AST nodes from an arena.
+ * @return The elapsed time (in milliseconds).
+ */
+double parseAndDestroy(const std::vector<Token> &tokens, bool useArena) {
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::optional<AST::ASTArena> astArena;
+        std::unique_ptr<AST::Program> program;
+        AST::Parser parser(tokens);
+        if (useArena) {
+            astArena.emplace();
+            const AST::ASTArena::Scope astArenaScope(*astArena);
+            program = parser.parse();
+        }
+        else {
+            program = parser.parse();
+        }
+        // The AST is destroyed before the arena.
+        program.reset();
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const auto args = std::span(argv, static_cast<std::size_t>(argc));
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << args[0] << " <sourceFile> [<runs>]\n";
+        return EXIT_FAILURE;
+    }
+    try {
+        const std::size_t runs =
+            argc == 3 ? std::stoul(args[2]) : std::size_t{5};
+        const SourceBuffer sourceBuffer(args[1]);
+        const auto tokens = dfaLexer(sourceBuffer.getContents());
+
+        // Alternate the two configurations so that both see the same state of
+        // the machine, and keep the best run of each.
+        double bestHeap = std::numeric_limits<double>::infinity();
+        double bestArena = std::numeric_limits<double>::infinity();
+        for (std::size_t run = 0; run < runs; ++run) {
+            bestHeap = std::min(bestHeap, parseAndDestroy(tokens, false));
+            bestArena = std::min(bestArena, parseAndDestroy(tokens, true));
+        }
+        std::cout << "Parse+destroy of " << tokens.size()
+                  << " tokens (best of " << runs << "):\n";
+        std::cout << "  heap:  " << bestHeap << " ms\n";
+        std::cout << "  arena: " << bestArena << " ms\n";
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,354 @@
+#include "../src/backend/assembly.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+// Benchmark dispatching on the kind of an assembly instruction (and of an
+// assembly operand) with a `switch` on `getKind()` against a chain of
+// `dynamic_cast`s, as the backend passes and the code emitter did before.
+//
+// The instructions are a fixed-seed random mov-heavy mix (as in the output of
+// the assembly generator), and every dispatch returns a value depending on
+// the kind only, so that only the dispatch itself is timed. The chains try the
+// subclasses in the order of the `Kind` enumerations, which puts the most
+// common kinds first.
+//
+// Usage: dispatchBenchmark [<instructions>] [<runs>]
+
+namespace {
+/**
+ * Build a mov-heavy mix of assembly instructions.
+ *
+ * @param count The number of instructions.
+ * @return The instructions.
+ */
+std::vector<std::unique_ptr<Assembly::Instruction>>
+makeInstructions(std::size_t count) {
+    // About half of the instructions are movs, and a fifth are binary
+    // instructions.
+    std::mt19937 generator(42);
+    std::discrete_distribution<int> instructionKind(
+        {50, 20, 5, 5, 5, 5, 3, 3, 2, 2});
+    std::uniform_int_distribution<int> operandKind(0, 3);
+    auto makeOperand = [&]() -> std::unique_ptr<Assembly::Operand> {
+        switch (operandKind(generator)) {
+        case 0:
+            return std::make_unique<Assembly::ImmediateOperand>(42);
+        case 1:
+            return std::make_unique<Assembly::RegisterOperand>(
+                Assembly::makeRegister(Assembly::Register::Kind::AX));
+        case 2:
+            return std::make_unique<Assembly::StackOperand>(
+                -8, std::make_unique<Assembly::BP>());
+        default:
+            return std::make_unique<Assembly::DataOperand>("counter");
+        }
+    };
+    std::vector<std::unique_ptr<Assembly::Instruction>> instructions;
+    instructions.reserve(count);
+    for (std::size_t index = 0; index < count; ++index) {
+        switch (instructionKind(generator)) {
+        case 0:
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    std::make_unique<Assembly::Longword>(), makeOperand(),
+                    makeOperand()));
+            break;
+        case 1:
+            instructions.emplace_back(
+                std::make_unique<Assembly::BinaryInstruction>(
+                    std::make_unique<Assembly::AddOperator>(),
+                    std::make_unique<Assembly::Longword>(), makeOperand(),
+                    makeOperand()));
+            break;
+        case 2:
+            instructions.emplace_back(
+                std::make_unique<Assembly::CmpInstruction>(
+                    std::make_unique<Assembly::Longword>(), makeOperand(),
+                    makeOperand()));
+            break;
+        case 3:
+            instructions.emplace_back(
+                std::make_unique<Assembly::JmpCCInstruction>(
+                    std::make_unique<Assembly::E>(), "label"));
+            break;
+        case 4:
+            instructions.emplace_back(
+                std::make_unique<Assembly::LabelInstruction>("label"));
+            break;
+        case 5:
+            instructions.emplace_back(
+                std::make_unique<Assembly::JmpInstruction>("label"));
+            break;
+        case 6:
+            instructions.emplace_back(
+                std::make_unique<Assembly::PushInstruction>(makeOperand()));
+            break;
+        case 7:
+            instructions.emplace_back(
+                std::make_unique<Assembly::CallInstruction>("function"));
+            break;
+        case 8:
+            instructions.emplace_back(
+                std::make_unique<Assembly::CdqInstruction>(
+                    std::make_unique<Assembly::Longword>()));
+            break;
+        default:
+            instructions.emplace_back(
+                std::make_unique<Assembly::RetInstruction>());
+            break;
+        }
+    }
+    return instructions;
+}
+
+/**
+ * Dispatch on the kind of an instruction with a `switch` on its kind tag.
+ */
+std::size_t dispatchBySwitch(const Assembly::Instruction &instruction) {
+    switch (instruction.getKind()) {
+    case Assembly::Instruction::Kind::Mov:
+        return 1;
+    case Assembly::Instruction::Kind::Movsx:
+        return 2;
+    case Assembly::Instruction::Kind::MovZeroExtend:
+        return 3;
+    case Assembly::Instruction::Kind::Unary:
+        return 4;
+    case Assembly::Instruction::Kind::Binary:
+        return 5;
+    case Assembly::Instruction::Kind::Cmp:
+        return 6;
+    case Assembly::Instruction::Kind::Idiv:
+        return 7;
+    case Assembly::Instruction::Kind::Div:
+        return 8;
+    case Assembly::Instruction::Kind::Cdq:
+        return 9;
+    case Assembly::Instruction::Kind::Jmp:
+        return 10;
+    case Assembly::Instruction::Kind::JmpCC:
+        return 11;
+    case Assembly::Instruction::Kind::SetCC:
+        return 12;
+    case Assembly::Instruction::Kind::Label:
+        return 13;
+    case Assembly::Instruction::Kind::Push:
+        return 14;
+    case Assembly::Instruction::Kind::Call:
+        return 15;
+    case Assembly::Instruction::Kind::Ret:
+        return 16;
+    case Assembly::Instruction::Kind::Imul:
+        return 17;
+    case Assembly::Instruction::Kind::Mul:
+        return 18;
+    }
+    return 0;
+}
+
+/**
+ * Dispatch on the kind of an instruction with a chain of `dynamic_cast`s.
+ */
+std::size_t dispatchByDynamicCast(const Assembly::Instruction &instruction) {
+    const auto *pointer = &instruction;
+    if (dynamic_cast<const Assembly::MovInstruction *>(pointer) != nullptr) {
+        return 1;
+    }
+    if (dynamic_cast<const Assembly::MovsxInstruction *>(pointer) != nullptr) {
+        return 2;
+    }
+    if (dynamic_cast<const Assembly::MovZeroExtendInstruction *>(pointer) !=
+        nullptr) {
+        return 3;
+    }
+    if (dynamic_cast<const Assembly::UnaryInstruction *>(pointer) != nullptr) {
+        return 4;
+    }
+    if (dynamic_cast<const Assembly::BinaryInstruction *>(pointer) != nullptr) {
+        return 5;
+    }
+    if (dynamic_cast<const Assembly::CmpInstruction *>(pointer) != nullptr) {
+        return 6;
+    }
+    if (dynamic_cast<const Assembly::IdivInstruction *>(pointer) != nullptr) {
+        return 7;
+    }
+    if (dynamic_cast<const Assembly::DivInstruction *>(pointer) != nullptr) {
+        return 8;
+    }
+    if (dynamic_cast<const Assembly::CdqInstruction *>(pointer) != nullptr) {
+        return 9;
+    }
+    if (dynamic_cast<const Assembly::JmpInstruction *>(pointer) != nullptr) {
+        return 10;
+    }
+    if (dynamic_cast<const Assembly::JmpCCInstruction *>(pointer) != nullptr) {
+        return 11;
+    }
+    if (dynamic_cast<const Assembly::SetCCInstruction *>(pointer) != nullptr) {
+        return 12;
+    }
+    if (dynamic_cast<const Assembly::LabelInstruction *>(pointer) != nullptr) {
+        return 13;
+    }
+    if (dynamic_cast<const Assembly::PushInstruction *>(pointer) != nullptr) {
+        return 14;
+    }
+    if (dynamic_cast<const Assembly::CallInstruction *>(pointer) != nullptr) {
+        return 15;
+    }
+    if (dynamic_cast<const Assembly::RetInstruction *>(pointer) != nullptr) {
+        return 16;
+    }
+    if (dynamic_cast<const Assembly::ImulInstruction *>(pointer) != nullptr) {
+        return 17;
+    }
+    if (dynamic_cast<const Assembly::MulInstruction *>(pointer) != nullptr) {
+        return 18;
+    }
+    return 0;
+}
+
+/**
+ * Dispatch on the kind of an operand with a `switch` on its kind tag.
+ */
+std::size_t dispatchBySwitch(const Assembly::Operand &operand) {
+    switch (operand.getKind()) {
+    case Assembly::Operand::Kind::Immediate:
+        return 1;
+    case Assembly::Operand::Kind::Register:
+        return 2;
+    case Assembly::Operand::Kind::PseudoRegister:
+        return 3;
+    case Assembly::Operand::Kind::Stack:
+        return 4;
+    case Assembly::Operand::Kind::Data:
+        return 5;
+    }
+    return 0;
+}
+
+/**
+ * Dispatch on the kind of an operand with a chain of `dynamic_cast`s.
+ */
+std::size_t dispatchByDynamicCast(const Assembly::Operand &operand) {
+    const auto *pointer = &operand;
+    if (dynamic_cast<const Assembly::ImmediateOperand *>(pointer) != nullptr) {
+        return 1;
+    }
+    if (dynamic_cast<const Assembly::RegisterOperand *>(pointer) != nullptr) {
+        return 2;
+    }
+    if (dynamic_cast<const Assembly::PseudoRegisterOperand *>(pointer) !=
+        nullptr) {
+        return 3;
+    }
+    if (dynamic_cast<const Assembly::StackOperand *>(pointer) != nullptr) {
+        return 4;
+    }
+    if (dynamic_cast<const Assembly::DataOperand *>(pointer) != nullptr) {
+        return 5;
+    }
+    return 0;
+}
+
+/**
+ * Time dispatching on every node of a sequence, keeping the best of several
+ * runs.
+ *
+ * @param nodes The nodes to dispatch on.
+ * @param dispatch The dispatch function.
+ * @param runs The number of runs.
+ * @return The best time per dispatch (in nanoseconds).
+ */
+template <typename Node, typename Dispatch>
+double timeDispatch(std::span<const Node *const> nodes, Dispatch dispatch,
+                    std::size_t runs) {
+    double best = std::numeric_limits<double>::infinity();
+    std::size_t checksum = 0;
+    for (std::size_t run = 0; run < runs; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto *node : nodes) {
+            checksum += dispatch(*node);
+        }
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    // Keep the dispatches from being optimized away.
+    if (checksum == 0) {
+        std::cout << "(empty)\n";
+    }
+    return best / static_cast<double>(nodes.size());
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const auto args = std::span(argv, static_cast<std::size_t>(argc));
+    if (argc > 3) {
+        std::cerr << "Usage: " << args[0] << " [<instructions>] [<runs>]\n";
+        return EXIT_FAILURE;
+    }
+    try {
+        const std::size_t count =
+            argc >= 2 ? std::stoul(args[1]) : std::size_t{2000000};
+        const std::size_t runs =
+            argc == 3 ? std::stoul(args[2]) : std::size_t{5};
+        const auto instructions = makeInstructions(count);
+        std::vector<const Assembly::Instruction *> instructionPointers;
+        std::vector<const Assembly::Operand *> operandPointers;
+        for (const auto &instruction : instructions) {
+            instructionPointers.emplace_back(instruction.get());
+            if (instruction->getKind() == Assembly::Instruction::Kind::Mov) {
+                const auto &movInstruction =
+                    static_cast<const Assembly::MovInstruction &>(*instruction);
+                operandPointers.emplace_back(movInstruction.getSrc());
+                operandPointers.emplace_back(movInstruction.getDst());
+            }
+        }
+
+        auto instructionBySwitch = [](const Assembly::Instruction &node) {
+            return dispatchBySwitch(node);
+        };
+        auto instructionByDynamicCast =
+            [](const Assembly::Instruction &node) {
+                return dispatchByDynamicCast(node);
+            };
+        auto operandBySwitch = [](const Assembly::Operand &node) {
+            return dispatchBySwitch(node);
+        };
+        auto operandByDynamicCast = [](const Assembly::Operand &node) {
+            return dispatchByDynamicCast(node);
+        };
+        std::cout << "Dispatch on " << count << " instructions (best of "
+                  << runs << ", ns per dispatch):\n";
+        std::cout << "  instruction dispatch: dynamic_cast chain "
+                  << timeDispatch<Assembly::Instruction>(
+                         instructionPointers, instructionByDynamicCast, runs)
+                  << ", switch "
+                  << timeDispatch<Assembly::Instruction>(
+                         instructionPointers, instructionBySwitch, runs)
+                  << "\n";
+        std::cout << "  operand dispatch:     dynamic_cast chain "
+                  << timeDispatch<Assembly::Operand>(
+                         operandPointers, operandByDynamicCast, runs)
+                  << ", switch "
+                  << timeDispatch<Assembly::Operand>(operandPointers,
+                                                     operandBySwitch, runs)
+                  << "\n";
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,31 @@
+#!/bin/sh
+# Print a synthetic translation unit of N function definitions (each with a
+# loop, a branch, arithmetic, and a call to the previous function), followed by
+# a `main` that calls the last one.
+# Usage: bench/generateFunctions.sh <N>
+
+count=${1:?Usage: bench/generateFunctions.sh <N>}
+awk -v count="$count" 'BEGIN {
+    for (i = 0; i < count; ++i) {
+        printf "int f%d(int a, int b) {\n", i
+        printf "    int sum = a * %d + b;\n", i % 7 + 1
+        printf "    for (int k = 0; k < %d; k = k + 1) {\n", i % 5 + 2
+        printf "        if (sum %% 2 == 0) {\n"
+        printf "            sum = sum / 2 + k * 3;\n"
+        printf "        }\n"
+        printf "        else {\n"
+        printf "            sum = sum - k;\n"
+        printf "        }\n"
+        printf "    }\n"
+        if (i > 0) {
+            printf "    return f%d(sum %% 100, b - 1) + sum;\n", i - 1
+        }
+        else {
+            printf "    return sum;\n"
+        }
+        printf "}\n"
+    }
+    printf "int main(void) {\n"
+    printf "    return f%d(1, 2) %% 256;\n", count - 1
+    printf "}\n"
+}'
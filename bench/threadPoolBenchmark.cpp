@@ -0,0 +1,129 @@
+#include "../src/frontend/astArena.h"
+#include "../src/frontend/frontendSymbolTable.h"
+#include "../src/frontend/sourceBuffer.h"
+#include "../src/midend/irOptimizationPasses.h"
+#include "../src/utils/pipelineStagesExecutors.h"
+#include "../src/utils/threadPool.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+// Benchmark optimizing the function definitions of a translation unit with
+// `--optimize` on thread pools of increasing sizes.
+//
+// Only `PipelineStagesExecutors::irOptimizationExecutor` is timed: each run
+// rebuilds the IR program from scratch first (with the output of the earlier
+// stages discarded), since the optimization passes rewrite it in place. The
+// pool sizes are clamped by `ThreadPool`, so the size actually used is
+// printed with each result.
+//
+// The pools are created up front and warmed up with one untimed run each.
+// Every repetition then runs all of the pool sizes once, starting from a
+// different size each time, so that no size consistently runs first or last,
+// and the minimum, median, and maximum of the runs of each size are reported.
+//
+// Usage: threadPoolBenchmark <sourceFile> [<runs>]
+
+namespace {
+/**
+ * Build the IR program of the translation unit and optimize it on a thread
+ * pool.
+ *
+ * @param sourceBuffer The source buffer holding the translation unit.
+ * @param threadPool The thread pool to optimize the function definitions on.
+ * @return The elapsed time of the optimization (in milliseconds).
+ */
+double optimize(const SourceBuffer &sourceBuffer, ThreadPool &threadPool) {
+    // Discard what the stages before the optimization print.
+    auto *const coutBuffer = std::cout.rdbuf(nullptr);
+    const auto tokens =
+        PipelineStagesExecutors::lexerExecutor(sourceBuffer, true);
+    AST::ASTArena astArena;
+    const auto astProgram =
+        PipelineStagesExecutors::parserExecutor(tokens, astArena);
+    AST::FrontendSymbolTable frontendSymbolTable;
+    const auto variableResolutionCounter =
+        PipelineStagesExecutors::semanticAnalysisExecutor(*astProgram,
+                                                          frontendSymbolTable);
+    auto [irProgram, irStaticVariables] =
+        PipelineStagesExecutors::irGeneratorExecutor(
+            *astProgram, variableResolutionCounter, frontendSymbolTable);
+    std::cout.rdbuf(coutBuffer);
+    std::cout.clear();
+
+    IR::OptimizationOptions optimizationOptions;
+    optimizationOptions.foldConstants = true;
+    optimizationOptions.simplifyAlgebra = true;
+    optimizationOptions.propagateCopies = true;
+    optimizationOptions.eliminateUnreachableCode = true;
+    optimizationOptions.eliminateDeadStores = true;
+    optimizationOptions.propagateConstants = true;
+    optimizationOptions.eliminateCommonSubexpressions = true;
+    optimizationOptions.moveLoopInvariants = true;
+    optimizationOptions.reduceInductionVariables = true;
+    const auto start = std::chrono::steady_clock::now();
+    PipelineStagesExecutors::irOptimizationExecutor(
+        *irProgram, frontendSymbolTable, optimizationOptions, threadPool);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const auto args = std::span(argv, static_cast<std::size_t>(argc));
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << args[0] << " <sourceFile> [<runs>]\n";
+        return EXIT_FAILURE;
+    }
+    try {
+        const std::size_t runs =
+            argc == 3 ? std::stoul(args[2]) : std::size_t{5};
+        if (runs == 0) {
+            std::cerr << "The number of runs must be positive\n";
+            return EXIT_FAILURE;
+        }
+        const SourceBuffer sourceBuffer(args[1]);
+        constexpr std::array<std::size_t, 4> threadCounts{1, 2, 4, 8};
+        std::vector<std::unique_ptr<ThreadPool>> threadPools;
+        for (const auto threadCount : threadCounts) {
+            threadPools.emplace_back(std::make_unique<ThreadPool>(threadCount));
+            optimize(sourceBuffer, *threadPools.back());
+        }
+
+        std::array<std::vector<double>, threadCounts.size()> elapsedTimes;
+        for (std::size_t run = 0; run < runs; ++run) {
+            for (std::size_t offset = 0; offset < threadCounts.size();
+                 ++offset) {
+                const auto index = (run + offset) % threadCounts.size();
+                elapsedTimes[index].emplace_back(
+                    optimize(sourceBuffer, *threadPools[index]));
+            }
+        }
+        std::cout << "Optimization with --optimize (min/median/max of " << runs
+                  << " runs, " << std::thread::hardware_concurrency()
+                  << " hardware threads):\n";
+        for (std::size_t index = 0; index < threadCounts.size(); ++index) {
+            auto &times = elapsedTimes[index];
+            std::ranges::sort(times);
+            std::cout << "  -j " << threadCounts[index] << " ("
+                      << threadPools[index]->getThreadCount()
+                      << " threads): " << times.front() << " / "
+                      << times[times.size() / 2] << " / " << times.back()
+                      << " ms\n";
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
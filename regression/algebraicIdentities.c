@@ -0,0 +1,25 @@
+// Expected exit code: 129.
+int identities(int x, long y, unsigned int u) {
+    int a = x + 0;
+    int b = 0 + x;
+    int c = x * 1;
+    int d = x * 0;
+    int e = x - x;
+    int f = x < x;
+    int g = x <= x;
+    int h = -(-x);
+    int k = ~(~x);
+    long l = y * 0l + y - y + (y / 1l);
+    unsigned int m = u * 0u + (u - u) + u % 1u + u / 1u;
+    int n = 0;
+    if (!x)
+        n = 1;
+    if (!!x)
+        n = n + 2;
+    return a + b + c + d + e + f + g + h + k + (int)(l % 100l) +
+           (int)(m % 100u) + n;
+}
+int main(void) {
+    return (identities(5, 4000000007l, 4294967295u) +
+            identities(0, -3l, 0u)) % 256;
+}
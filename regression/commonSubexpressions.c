@@ -0,0 +1,33 @@
+// Expected exit code: 75.
+static int shared = 2;
+int bump(void) {
+    shared = shared + 3;
+    return shared;
+}
+int main(void) {
+    int a = 6;
+    int b = 7;
+    int c = 0;
+    if (a < b)
+        c = 1;
+    int p = a * b + c;
+    int q = b * a + c;
+    int less = a < b;
+    int greater = b > a;
+    int before = shared * a;
+    bump();
+    int after = shared * a;
+    long wide = a * b;
+    unsigned int ua = 4000000000u;
+    unsigned int ub = 300000000u;
+    unsigned int sum1 = ua + ub;
+    int sum2 = (int)ua + (int)ub;
+    int r = 0;
+    for (int i = 0; i < 3; i = i + 1) {
+        int x = a + i;
+        int y = i + a;
+        r = r + x * y;
+    }
+    return (p + q + less + greater + before + after + (int)wide +
+            (int)(sum1 % 7u) + sum2 % 7 + r) % 256;
+}
@@ -0,0 +1,10 @@
+// Expected exit code: 2.
+int main(void) {
+    long big = 4294967298L;
+    int trunc = (int)big;
+    unsigned int u = (unsigned int)-1;
+    long sext = (long)-5;
+    unsigned long zext = (unsigned long)u;
+    long r = (long)trunc + sext + (long)(zext - 4294967290UL);
+    return (int)r;
+}
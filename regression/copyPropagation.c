@@ -0,0 +1,29 @@
+// Expected exit code: 90.
+static int shared = 4;
+int bump(void) {
+    shared = shared + 1;
+    return 0;
+}
+int main(void) {
+    int a = 5;
+    int b = a;
+    a = 7;
+    int c = b;
+    int d = a;
+    if (c > 0)
+        d = c;
+    int e = d;
+    int s = shared;
+    bump();
+    int t = shared;
+    int x = 3;
+    int y = x;
+    for (int i = 0; i < 4; i = i + 1) {
+        y = y + x;
+        x = y;
+    }
+    unsigned int u = 4294967295u;
+    int v = (int)u;
+    long w = v;
+    return b + c + e + s * 10 + t * 100 + y + (int)w;
+}
@@ -0,0 +1,29 @@
+// Expected exit code: 97.
+int counter = 0;
+int touch(int x) {
+    counter = counter + x;
+    return x;
+}
+int storeStatic(void) {
+    static int calls = 0;
+    calls = calls + 1;
+    int unused = calls * 2;
+    unused = 9;
+    return calls;
+}
+int main(void) {
+    int a = 1;
+    a = 2;
+    int ignored = touch(3);
+    ignored = touch(4);
+    int carried = 0;
+    int last = 0;
+    for (int i = 0; i < 5; i = i + 1) {
+        last = carried;
+        carried = i * 3;
+    }
+    storeStatic();
+    storeStatic();
+    int dead = storeStatic() * 100;
+    return a + counter * 10 + last + carried + storeStatic();
+}
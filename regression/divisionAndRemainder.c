@@ -0,0 +1,19 @@
+// Expected exit code: 131.
+int main(void) {
+    int s = 0;
+    for (int i = -20; i < 21; i = i + 1) {
+        s = s + i / 4 + i % 4 + i / 7 + i % 7 + i * 8 + i * 10 + i / 1 + i % 1 + i / -3 + i % -3;
+    }
+    unsigned int u = 0u;
+    for (unsigned int k = 0u; k < 100u; k = k + 1u) {
+        u = u + k / 8u + k % 8u + k / 10u + k % 10u + k * 16u;
+    }
+    long L = 0;
+    for (long m = -1000; m < 1000; m = m + 37) {
+        L = L + m / 16 + m % 16 + m / 1000 + m * 3;
+    }
+    unsigned long ul = 18446744073709551615UL;
+    unsigned long q = ul / 7ul + ul % 7ul + ul / 2ul;
+    int big = 2147483647 / 5 + (-2147483647 - 1) / 8 + (-2147483647 - 1) % 8;
+    return (s + (int)u + (int)L + (int)(q % 97UL) + big) % 256;
+}
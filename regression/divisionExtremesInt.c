@@ -0,0 +1,50 @@
+// Expected exit code: 0.
+// Division and remainder of `int` dividends at the extremes by constant
+// divisors (the minimum, the maximum, negative ones, and powers of two),
+// each checked against dividing by the same divisor passed as a parameter,
+// which `--optimize` cannot fold. Returns the number of the first dividend
+// that fails.
+int differs(int x, int d, int quotient, int remainder) {
+    return quotient != x / d || remainder != x % d;
+}
+int check(int x) {
+    if (differs(x, -2147483647 - 1, x / (-2147483647 - 1),
+                x % (-2147483647 - 1)))
+        return 1;
+    if (differs(x, 2147483647, x / 2147483647, x % 2147483647))
+        return 1;
+    if (differs(x, -16, x / -16, x % -16))
+        return 1;
+    if (differs(x, -7, x / -7, x % -7))
+        return 1;
+    if (differs(x, 3, x / 3, x % 3))
+        return 1;
+    if (differs(x, 7, x / 7, x % 7))
+        return 1;
+    if (differs(x, 10, x / 10, x % 10))
+        return 1;
+    if (differs(x, 16, x / 16, x % 16))
+        return 1;
+    return 0;
+}
+int main(void) {
+    if (check(-2147483647 - 1))
+        return 1;
+    if (check(-2147483647))
+        return 2;
+    if (check(2147483647))
+        return 3;
+    if (check(2147483646))
+        return 4;
+    if (check(-1000000007))
+        return 5;
+    if (check(-1))
+        return 6;
+    if (check(0))
+        return 7;
+    if (check(1))
+        return 8;
+    if (check(1000000007))
+        return 9;
+    return 0;
+}
@@ -0,0 +1,52 @@
+// Expected exit code: 0.
+// Division and remainder of `long` dividends at the extremes by constant
+// divisors (the minimum, the maximum, negative ones, powers of two, and ones
+// whose signed magic number is at least 2^63), each checked against dividing
+// by the same divisor passed as a parameter, which `--optimize` cannot fold.
+// Returns the number of the first dividend that fails.
+int differs(long x, long d, long quotient, long remainder) {
+    return quotient != x / d || remainder != x % d;
+}
+int check(long x) {
+    if (differs(x, -9223372036854775807l - 1l,
+                x / (-9223372036854775807l - 1l),
+                x % (-9223372036854775807l - 1l)))
+        return 1;
+    if (differs(x, 9223372036854775807l, x / 9223372036854775807l,
+                x % 9223372036854775807l))
+        return 1;
+    if (differs(x, -4294967296l, x / -4294967296l, x % -4294967296l))
+        return 1;
+    if (differs(x, -7l, x / -7l, x % -7l))
+        return 1;
+    if (differs(x, 3l, x / 3l, x % 3l))
+        return 1;
+    if (differs(x, 10l, x / 10l, x % 10l))
+        return 1;
+    if (differs(x, 16l, x / 16l, x % 16l))
+        return 1;
+    if (differs(x, 1000000007l, x / 1000000007l, x % 1000000007l))
+        return 1;
+    return 0;
+}
+int main(void) {
+    if (check(-9223372036854775807l - 1l))
+        return 1;
+    if (check(-9223372036854775807l))
+        return 2;
+    if (check(9223372036854775807l))
+        return 3;
+    if (check(9223372036854775806l))
+        return 4;
+    if (check(-1000000007l))
+        return 5;
+    if (check(-1l))
+        return 6;
+    if (check(0l))
+        return 7;
+    if (check(1l))
+        return 8;
+    if (check(1000000007l))
+        return 9;
+    return 0;
+}
@@ -0,0 +1,46 @@
+// Expected exit code: 0.
+// Division and remainder of `unsigned int` dividends at the extremes by
+// constant divisors (the maximum, ones next to the top bit, powers of two,
+// and ones whose magic number does not fit in 4 bytes), each checked against
+// dividing by the same divisor passed as a parameter, which `--optimize`
+// cannot fold. Returns the number of the first dividend that fails.
+int differs(unsigned int x, unsigned int d, unsigned int quotient,
+            unsigned int remainder) {
+    return quotient != x / d || remainder != x % d;
+}
+int check(unsigned int x) {
+    if (differs(x, 4294967295u, x / 4294967295u, x % 4294967295u))
+        return 1;
+    if (differs(x, 2147483649u, x / 2147483649u, x % 2147483649u))
+        return 1;
+    if (differs(x, 2147483648u, x / 2147483648u, x % 2147483648u))
+        return 1;
+    if (differs(x, 7u, x / 7u, x % 7u))
+        return 1;
+    if (differs(x, 10u, x / 10u, x % 10u))
+        return 1;
+    if (differs(x, 16u, x / 16u, x % 16u))
+        return 1;
+    if (differs(x, 1000000007u, x / 1000000007u, x % 1000000007u))
+        return 1;
+    return 0;
+}
+int main(void) {
+    if (check(0u))
+        return 1;
+    if (check(1u))
+        return 2;
+    if (check(1000000007u))
+        return 3;
+    if (check(2147483647u))
+        return 4;
+    if (check(2147483648u))
+        return 5;
+    if (check(2147483649u))
+        return 6;
+    if (check(4294967294u))
+        return 7;
+    if (check(4294967295u))
+        return 8;
+    return 0;
+}
@@ -0,0 +1,49 @@
+// Expected exit code: 0.
+// Division and remainder of `unsigned long` dividends at the extremes by
+// constant divisors (the maximum, ones next to the top bit, powers of two,
+// and ones whose magic number does not fit in 8 bytes), each checked against
+// dividing by the same divisor passed as a parameter, which `--optimize`
+// cannot fold. Returns the number of the first dividend that fails.
+int differs(unsigned long x, unsigned long d, unsigned long quotient,
+            unsigned long remainder) {
+    return quotient != x / d || remainder != x % d;
+}
+int check(unsigned long x) {
+    if (differs(x, 18446744073709551615ul, x / 18446744073709551615ul,
+                x % 18446744073709551615ul))
+        return 1;
+    if (differs(x, 9223372036854775809ul, x / 9223372036854775809ul,
+                x % 9223372036854775809ul))
+        return 1;
+    if (differs(x, 9223372036854775808ul, x / 9223372036854775808ul,
+                x % 9223372036854775808ul))
+        return 1;
+    if (differs(x, 7ul, x / 7ul, x % 7ul))
+        return 1;
+    if (differs(x, 10ul, x / 10ul, x % 10ul))
+        return 1;
+    if (differs(x, 16ul, x / 16ul, x % 16ul))
+        return 1;
+    if (differs(x, 1000ul, x / 1000ul, x % 1000ul))
+        return 1;
+    return 0;
+}
+int main(void) {
+    if (check(0ul))
+        return 1;
+    if (check(1ul))
+        return 2;
+    if (check(1000000007ul))
+        return 3;
+    if (check(9223372036854775807ul))
+        return 4;
+    if (check(9223372036854775808ul))
+        return 5;
+    if (check(9223372036854775809ul))
+        return 6;
+    if (check(18446744073709551614ul))
+        return 7;
+    if (check(18446744073709551615ul))
+        return 8;
+    return 0;
+}
@@ -0,0 +1,10 @@
+// Expected exit code: 152.
+// Absent after --optimize: = i\.[0-9]*\.iv\.[0-9]*$
+int main(void) {
+    int s = 0;
+    int n = 30;
+    int i;
+    for (i = 0; i < n; i = i + 1)
+        s = s + i * 8;
+    return s % 256;
+}
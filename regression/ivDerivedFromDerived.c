@@ -0,0 +1,11 @@
+// Expected exit code: 108.
+int main(void) {
+    int acc = 0;
+    int i;
+    for (i = 0; i < 50; i = i + 1) {
+        int a = i * 3;
+        int b = a * 3;
+        acc = acc + a + b;
+    }
+    return acc % 256;
+}
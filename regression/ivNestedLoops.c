@@ -0,0 +1,17 @@
+// Expected exit code: 87.
+int main(void) {
+    int acc = 0;
+    int i;
+    int j;
+    for (i = 0; i < 10; i = i + 1) {
+        int a = i * 5;
+        for (j = 0; j < 10; j = j + 1) {
+            int b = j * 7;
+            int c = b * 2;
+            acc = acc + a + b + c;
+        }
+        int d = a * 3;
+        acc = acc + d;
+    }
+    return acc % 256;
+}
@@ -0,0 +1,49 @@
+// Expected exit code: 15.
+int zeroTrip(int n, int d) {
+    int r = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        int q = 100 / d;
+        int m = (-2147483647 - 1) / d;
+        r = r + q + m;
+    }
+    return r;
+}
+int liveAfter(int n, int a) {
+    int v = 11;
+    int i = 0;
+    while (i < n) {
+        v = a * 3;
+        i = i + 1;
+    }
+    return v;
+}
+int doWhile(int n, int a, int d) {
+    int r = 0;
+    int i = 0;
+    do {
+        int k = a * 5 + 2;
+        int q = a / 4;
+        int s = a % d;
+        r = r + k + q + s;
+        i = i + 1;
+    } while (i < n);
+    return r;
+}
+int conditional(int n, int a) {
+    int r = 0;
+    int t = 1;
+    for (int i = 0; i < n; i = i + 1) {
+        if (i > 2)
+            t = a * a;
+        r = r + t;
+    }
+    return r + t;
+}
+int main(void) {
+    int result = zeroTrip(0, 0);
+    result = result + zeroTrip(0, -1) + zeroTrip(3, 4) % 7;
+    result = result + liveAfter(0, 5) + liveAfter(4, 5);
+    result = result + doWhile(0, 9, 5) + doWhile(3, 9, 5);
+    result = result + conditional(5, 3) + conditional(2, 3);
+    return result % 256;
+}
@@ -0,0 +1,85 @@
+#!/bin/sh
+# Compile each regression program with each set of optimization flags, run it,
+# and compare its exit code with the one in its `// Expected exit code: N.`
+# first line. Also check that the flat IR round trip and the DFA-based lexer
+# leave the emitted assembly unchanged, and that no line of the IR optimized
+# with `--optimize` matches the basic regular expression of a
+# `// Absent after --optimize: RE` line of the program (if any).
+# Usage: regression/run.sh <compiler>
+
+compiler=${1:-bin/main}
+directory=$(dirname "$0")
+output=$(mktemp)
+assembly=$(mktemp)
+variantAssembly=$(mktemp)
+trap 'rm -f "$output" "$assembly" "$variantAssembly"' EXIT
+failures=0
+for program in "$directory"/*.c; do
+    expected=$(sed -n '1s/^\/\/ Expected exit code: \([0-9]*\)\.$/\1/p' \
+        "$program")
+    if [ -z "$expected" ]; then
+        echo "FAIL $program: missing expected exit code" >&2
+        failures=$((failures + 1))
+        continue
+    fi
+    for flags in "" \
+        "--dfa-lexer" \
+        "--fold-constants" \
+        "--simplify-algebra" \
+        "--eliminate-unreachable-code" \
+        "--propagate-copies" \
+        "--eliminate-dead-stores" \
+        "--propagate-constants" \
+        "--eliminate-common-subexpressions" \
+        "--licm" \
+        "--ssa" \
+        "--propagate-copies --reduce-induction-variables" \
+        "--reduce-induction-variables" \
+        "--reduce-induction-variables --propagate-constants" \
+        "--optimize" \
+        "--optimize --flat-ir-round-trip"; do
+        # shellcheck disable=SC2086
+        if ! "$compiler" $flags "$program" -o "$output" >/dev/null; then
+            echo "FAIL $program [$flags]: compilation failed" >&2
+            failures=$((failures + 1))
+            continue
+        fi
+        "$output"
+        actual=$?
+        if [ "$actual" -ne "$expected" ]; then
+            echo "FAIL $program [$flags]: exit code $actual," \
+                "expected $expected" >&2
+            failures=$((failures + 1))
+        fi
+    done
+    for flags in "" "--optimize"; do
+        # shellcheck disable=SC2086
+        if ! "$compiler" $flags -S "$program" -o "$assembly" >/dev/null; then
+            echo "FAIL $program [$flags]: compilation failed" >&2
+            failures=$((failures + 1))
+            continue
+        fi
+        for variant in "--flat-ir-round-trip" "--dfa-lexer"; do
+            # shellcheck disable=SC2086
+            if ! "$compiler" $flags $variant -S "$program" \
+                -o "$variantAssembly" >/dev/null ||
+                ! cmp -s "$assembly" "$variantAssembly"; then
+                echo "FAIL $program [$flags]: $variant changed the assembly" >&2
+                failures=$((failures + 1))
+            fi
+        done
+    done
+    absent=$(sed -n 's/^\/\/ Absent after --optimize: //p' "$program")
+    if [ -n "$absent" ] &&
+        "$compiler" --tacky --optimize "$program" |
+        sed -n '/^<<< After optimization passes: >>>$/,$p' |
+            grep -q -e "$absent"; then
+        echo "FAIL $program [--optimize]: optimized IR matches $absent" >&2
+        failures=$((failures + 1))
+    fi
+done
+if [ "$failures" -ne 0 ]; then
+    echo "$failures regression check(s) failed." >&2
+    exit 1
+fi
+echo "Regression checks passed!"
@@ -0,0 +1,31 @@
+// Expected exit code: 34.
+// Absent after --optimize: 12345
+int main(void) {
+    int x = 4;
+    int y;
+    if (x > 2)
+        y = 10;
+    else
+        y = 12345;
+    int z = y * 3;
+    int w = 0;
+    while (w < 0)
+        w = w + 12345;
+    unsigned int u = 0u - 1u;
+    int k = 0;
+    if (u > 5u)
+        k = 1;
+    long big = 3000000000l;
+    int t = (int)big;
+    int flag = 1;
+    for (int i = 0; i < 3; i = i + 1) {
+        if (flag == 1)
+            flag = 1;
+        else
+            flag = 12345;
+    }
+    int negative = 0;
+    if (t < 0)
+        negative = 2;
+    return z + w + k + flag + negative;
+}
@@ -0,0 +1,25 @@
+// Expected exit code: 47.
+// The strength-reduced variables (`<i>.iv.<n>`) and the versions SSA
+// destruction introduces reach constant propagation on the next iteration of
+// the optimizer, mixed with versions it folds to constants.
+int main(void) {
+    int sum = 0;
+    int flag = 3;
+    long total = 0l;
+    int i;
+    for (i = 0; i < 20; i = i + 1) {
+        int scaled = i * 8;
+        long wide = i * 3l;
+        if (flag > 2) {
+            sum = sum + scaled;
+        }
+        else {
+            sum = sum - scaled;
+        }
+        total = total + wide;
+    }
+    if (flag == 3) {
+        flag = 5;
+    }
+    return sum + (int)total + flag;
+}
@@ -0,0 +1,14 @@
+// Expected exit code: 76.
+static int s = 0;
+int incr(void) { s = s + 1; return s; }
+int main(void) {
+    int a = s;
+    incr();
+    int b = s;
+    s = 10;
+    int c = s;
+    incr();
+    int d = s;
+    int e = a;
+    return a + b * 2 + c * 3 + d * 4 + e;
+}
@@ -0,0 +1,16 @@
+// Expected exit code: 49.
+static int counter = 3;
+int global_x;
+extern int global_y;
+int global_y = 40;
+int bump(void) {
+    static int calls = 0;
+    calls = calls + 1;
+    counter = counter + calls;
+    return calls;
+}
+int main(void) {
+    bump(); bump(); bump();
+    global_x = counter + global_y;
+    return global_x;
+}
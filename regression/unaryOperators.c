@@ -0,0 +1,8 @@
+// Expected exit code: 19.
+int main(void) {
+    int a = -5;
+    int b = ~a;
+    int c = !b;
+    int d = !!a;
+    return b + c * 10 + d * 20 + (-(-a));
+}
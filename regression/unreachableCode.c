@@ -0,0 +1,32 @@
+// Expected exit code: 17.
+int early(int x) {
+    if (x > 0)
+        return 1;
+    else
+        return 2;
+    x = x + 5;
+    return x;
+}
+int loopForever(int n) {
+    int i = 0;
+    while (1) {
+        i = i + 1;
+        if (i == n)
+            return i * 2;
+    }
+    return -1;
+}
+int main(void) {
+    int a = early(3);
+    int b = early(-3);
+    int c = loopForever(5);
+    int d = 0;
+    for (;;) {
+        d = d + 1;
+        if (d > 3)
+            break;
+        continue;
+        d = 100;
+    }
+    return a + b + c + d;
+}
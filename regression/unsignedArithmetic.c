@@ -0,0 +1,13 @@
+// Expected exit code: 26.
+int main(void) {
+    unsigned int a = 4294967295U;
+    unsigned int b = a + 2u;
+    unsigned long c = 18446744073709551615UL;
+    unsigned long d = c / 3ul;
+    long e = -9223372036854775807L - 1;
+    int f = (int)(d % 1000UL);
+    unsigned int g = 100u;
+    unsigned int h = g / 7u + g % 7u;
+    int cmp = (a > b) + (c > 0) * 2 + (e < 0) * 4 + (-1 < 0u) * 8;
+    return (int)b + f % 7 + (int)h + cmp;
+}
@@ -1,13 +1,75 @@
 #include "assembly.h"
 #include "../frontend/semanticAnalysisPasses.h"
+#include <array>
 #include <cstddef>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+/**
+ * Unnamed namespace for the register name tables of the register operands.
+ */
+namespace {
+/**
+ * The number of register kinds (see `Assembly::Register::Kind`).
+ */
+constexpr std::size_t registerCount =
+    static_cast<std::size_t>(Assembly::Register::Kind::BP) + 1;
+
+/**
+ * The names of the 1-byte registers, indexed by register kind.
+ */
+constexpr std::array<std::string_view, registerCount> byteRegisterNames = {
+    "%al", "%cl", "%dl", "%dil", "%sil", "%r8b", "%r9b", "%r10b", "%r11b",
+    "%spl", "%bpl"};
+
+/**
+ * The names of the 4-byte registers, indexed by register kind.
+ */
+constexpr std::array<std::string_view, registerCount> longwordRegisterNames = {
+    "%eax", "%ecx", "%edx", "%edi", "%esi", "%r8d", "%r9d", "%r10d", "%r11d",
+    "%esp", "%ebp"};
+
+/**
+ * The names of the 8-byte registers, indexed by register kind.
+ */
+constexpr std::array<std::string_view, registerCount> quadwordRegisterNames = {
+    "%rax", "%rcx", "%rdx", "%rdi", "%rsi", "%r8", "%r9", "%r10", "%r11",
+    "%rsp", "%rbp"};
+} // namespace
+
 namespace Assembly {
+std::unique_ptr<Register> makeRegister(Register::Kind kind) {
+    switch (kind) {
+    case Register::Kind::AX:
+        return std::make_unique<AX>();
+    case Register::Kind::CX:
+        return std::make_unique<CX>();
+    case Register::Kind::DX:
+        return std::make_unique<DX>();
+    case Register::Kind::DI:
+        return std::make_unique<DI>();
+    case Register::Kind::SI:
+        return std::make_unique<SI>();
+    case Register::Kind::R8:
+        return std::make_unique<R8>();
+    case Register::Kind::R9:
+        return std::make_unique<R9>();
+    case Register::Kind::R10:
+        return std::make_unique<R10>();
+    case Register::Kind::R11:
+        return std::make_unique<R11>();
+    case Register::Kind::SP:
+        return std::make_unique<SP>();
+    case Register::Kind::BP:
+        return std::make_unique<BP>();
+    }
+    throw std::logic_error("Unsupported register in makeRegister");
+}
+
 unsigned long Operand::getImmediate() const {
     throw std::logic_error(
         "Operand is not an immediate in getImmediate in Operand");
@@ -99,31 +161,38 @@ RegisterOperand::RegisterOperand(const std::string &regInStr) {
 Register *RegisterOperand::getRegister() const { return reg.get(); }
 
 std::string RegisterOperand::getRegisterInBytesInStr(int size) const {
-    auto sizeIt = regMappings.find(size);
-    if (sizeIt == regMappings.end()) {
+    const std::array<std::string_view, registerCount> *names = nullptr;
+    switch (size) {
+    case 1:
+        names = &byteRegisterNames;
+        break;
+    case LONGWORD_SIZE:
+        names = &longwordRegisterNames;
+        break;
+    case QUADWORD_SIZE:
+        names = &quadwordRegisterNames;
+        break;
+    default:
         throw std::logic_error(
             "Unsupported register size while getting register in bytes in "
             "string in getRegisterInBytesInStr in RegisterOperand: " +
             std::to_string(size));
     }
-    const auto &sizeMappings = sizeIt->second;
-    const auto &r = *reg;
-    auto regIt = sizeMappings.find(typeid(r));
-    if (regIt == sizeMappings.end()) {
-        throw std::logic_error("Unsupported register type in "
-                               "getRegisterInBytesInStr in RegisterOperand: " +
-                               std::string(typeid(r).name()));
-    }
-    return regIt->second;
+    return std::string((*names)[static_cast<std::size_t>(reg->getKind())]);
 }
 
-PseudoRegisterOperand::PseudoRegisterOperand(std::string pseudoReg)
-    : pseudoReg(std::move(pseudoReg)) {}
+PseudoRegisterOperand::PseudoRegisterOperand(std::string_view pseudoReg)
+    : pseudoReg(pseudoReg) {}
+
+PseudoRegisterOperand::PseudoRegisterOperand(Symbol pseudoReg)
+    : pseudoReg(pseudoReg) {}
 
 std::string PseudoRegisterOperand::getPseudoRegister() const {
-    return pseudoReg;
+    return pseudoReg.str();
 }
 
+Symbol PseudoRegisterOperand::getSymbol() const { return pseudoReg; }
+
 StackOperand::StackOperand(int offset,
                            std::unique_ptr<ReservedRegister> reservedReg)
     : offset(offset), reservedReg(std::move(reservedReg)) {
@@ -141,18 +210,14 @@ ReservedRegister *StackOperand::getReservedRegister() const {
 }
 
 std::string StackOperand::getReservedRegisterInStr() const {
-    if (dynamic_cast<SP *>(reservedReg.get()) != nullptr) {
+    switch (reservedReg->getKind()) {
+    case Register::Kind::SP:
         return "%rsp";
-    }
-    else if (dynamic_cast<BP *>(reservedReg.get()) != nullptr) {
+    case Register::Kind::BP:
         return "%rbp";
-    }
-    else {
-        auto *reg = reservedReg.get();
-        const auto &r = *reg;
+    default:
         throw std::logic_error("Unsupported reserved register in "
-                               "getReservedRegisterInStr in StackOperand: " +
-                               std::string(typeid(r).name()));
+                               "getReservedRegisterInStr in StackOperand");
     }
 }
 
@@ -333,6 +398,16 @@ void UnaryInstruction::setOperand(std::unique_ptr<Operand> newOperand) {
     operand = std::move(newOperand);
 }
 
+LeaOperator::LeaOperator(int scale) : scale(scale) {
+    if (scale != 1 && scale != 2 && scale != 4 && scale != 8) {
+        throw std::invalid_argument(
+            "Creating LeaOperator with invalid scale in LeaOperator: " +
+            std::to_string(scale));
+    }
+}
+
+int LeaOperator::getScale() const { return scale; }
+
 BinaryInstruction::BinaryInstruction(
     std::unique_ptr<BinaryOperator> binaryOperator,
     std::unique_ptr<AssemblyType> type, std::unique_ptr<Operand> operand1,
@@ -522,6 +597,74 @@ void DivInstruction::setOperand(std::unique_ptr<Operand> newOperand) {
     operand = std::move(newOperand);
 }
 
+ImulInstruction::ImulInstruction(std::unique_ptr<AssemblyType> type,
+                                 std::unique_ptr<Operand> operand)
+    : type(std::move(type)), operand(std::move(operand)) {
+    if (!this->type) {
+        throw std::invalid_argument(
+            "Creating ImulInstruction with null type in ImulInstruction");
+    }
+    if (!this->operand) {
+        throw std::invalid_argument(
+            "Creating ImulInstruction with null operand in "
+            "ImulInstruction");
+    }
+}
+
+const AssemblyType *ImulInstruction::getType() const { return type.get(); }
+
+const Operand *ImulInstruction::getOperand() const { return operand.get(); }
+
+void ImulInstruction::setType(std::unique_ptr<AssemblyType> newType) {
+    if (!newType) {
+        throw std::invalid_argument(
+            "Setting null type in setType in ImulInstruction");
+    }
+    type = std::move(newType);
+}
+
+void ImulInstruction::setOperand(std::unique_ptr<Operand> newOperand) {
+    if (!newOperand) {
+        throw std::invalid_argument(
+            "Setting null operand in setOperand in ImulInstruction");
+    }
+    operand = std::move(newOperand);
+}
+
+MulInstruction::MulInstruction(std::unique_ptr<AssemblyType> type,
+                               std::unique_ptr<Operand> operand)
+    : type(std::move(type)), operand(std::move(operand)) {
+    if (!this->type) {
+        throw std::invalid_argument(
+            "Creating MulInstruction with null type in MulInstruction");
+    }
+    if (!this->operand) {
+        throw std::invalid_argument(
+            "Creating MulInstruction with null operand in "
+            "MulInstruction");
+    }
+}
+
+const AssemblyType *MulInstruction::getType() const { return type.get(); }
+
+const Operand *MulInstruction::getOperand() const { return operand.get(); }
+
+void MulInstruction::setType(std::unique_ptr<AssemblyType> newType) {
+    if (!newType) {
+        throw std::invalid_argument(
+            "Setting null type in setType in MulInstruction");
+    }
+    type = std::move(newType);
+}
+
+void MulInstruction::setOperand(std::unique_ptr<Operand> newOperand) {
+    if (!newOperand) {
+        throw std::invalid_argument(
+            "Setting null operand in setOperand in MulInstruction");
+    }
+    operand = std::move(newOperand);
+}
+
 CdqInstruction::CdqInstruction(std::unique_ptr<AssemblyType> type)
     : type(std::move(type)) {
     if (!this->type) {
@@ -3,11 +3,12 @@
 
 #include "../frontend/semanticAnalysisPasses.h"
 #include "../utils/constants.h"
+#include "../utils/symbol.h"
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <typeindex>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 namespace Assembly {
@@ -16,6 +17,24 @@ namespace Assembly {
  */
 class Register {
   public:
+    /**
+     * Enumeration representing the kinds of assembly registers (one per
+     * concrete subclass).
+     */
+    enum class Kind : std::uint8_t {
+        AX,
+        CX,
+        DX,
+        DI,
+        SI,
+        R8,
+        R9,
+        R10,
+        R11,
+        SP,
+        BP
+    };
+
     /**
      * Default constructor for the assembly register class.
      */
@@ -45,52 +64,86 @@ class Register {
      * Default move assignment operator for the assembly register class.
      */
     constexpr Register &operator=(Register &&) = default;
+
+    /**
+     * Get the kind of the register.
+     *
+     * @return The kind of the register.
+     */
+    [[nodiscard]] virtual Kind getKind() const = 0;
 };
 
 /**
  * Class for representing the AX assembly register.
  */
-class AX : public Register {};
+class AX : public Register {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::AX; }
+};
 
 /**
  * Class for representing the CX assembly register.
  */
-class CX : public Register {};
+class CX : public Register {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::CX; }
+};
 
 /**
  * Class for representing the DX assembly register.
  */
-class DX : public Register {};
+class DX : public Register {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::DX; }
+};
 
 /**
  * Class for representing the DI assembly register.
  */
-class DI : public Register {};
+class DI : public Register {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::DI; }
+};
 
 /**
  * Class for representing the SI assembly register.
  */
-class SI : public Register {};
+class SI : public Register {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::SI; }
+};
 
 /**
  * Class for representing the R8 assembly register.
  */
-class R8 : public Register {};
+class R8 : public Register {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::R8; }
+};
 
 /**
  * Class for representing the R9 assembly register.
  */
-class R9 : public Register {};
+class R9 : public Register {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::R9; }
+};
 
 /**
  * Class for representing the R10 assembly register.
  */
-class R10 : public Register {};
+class R10 : public Register {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::R10; }
+};
 
 /**
  * Class for representing the R11 assembly register.
  */
-class R11 : public Register {};
+class R11 : public Register {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::R11; }
+};
 
 /**
  * Class for representing a reserved assembly register.
@@ -100,18 +153,44 @@ class ReservedRegister : public Register {};
 /**
  * Class for representing the SP reserved assembly register.
  */
-class SP : public ReservedRegister {};
+class SP : public ReservedRegister {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::SP; }
+};
 
 /**
  * Class for representing the BP reserved assembly register.
  */
-class BP : public ReservedRegister {};
+class BP : public ReservedRegister {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::BP; }
+};
+
+/**
+ * Create an assembly register of a given kind.
+ *
+ * @param kind The kind of the register.
+ * @return The register.
+ */
+[[nodiscard]] std::unique_ptr<Register> makeRegister(Register::Kind kind);
 
 /**
  * Base class for representing an assembly operand.
  */
 class Operand {
   public:
+    /**
+     * Enumeration representing the kinds of assembly operands (one per
+     * subclass).
+     */
+    enum class Kind : std::uint8_t {
+        Immediate,
+        Register,
+        PseudoRegister,
+        Stack,
+        Data
+    };
+
     /**
      * Default constructor for the assembly operand class.
      */
@@ -142,6 +221,13 @@ class Operand {
      */
     constexpr Operand &operator=(Operand &&) = default;
 
+    /**
+     * Get the kind of the operand.
+     *
+     * @return The kind of the operand.
+     */
+    [[nodiscard]] virtual Kind getKind() const = 0;
+
     /**
      * Get the immediate value of the operand.
      *
@@ -231,6 +317,8 @@ class ImmediateOperand : public Operand {
     explicit ImmediateOperand(unsigned long imm);
 
     [[nodiscard]] unsigned long getImmediate() const override;
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Immediate; }
 };
 
 /**
@@ -243,47 +331,6 @@ class RegisterOperand : public Operand {
      */
     std::unique_ptr<Register> reg;
 
-    /**
-     * The mapping of register sizes to register names.
-     */
-    std::unordered_map<int, std::unordered_map<std::type_index, std::string>>
-        regMappings = {{1, // 1-byte registers.
-                        {{typeid(AX), "%al"},
-                         {typeid(CX), "%cl"},
-                         {typeid(DX), "%dl"},
-                         {typeid(DI), "%dil"},
-                         {typeid(SI), "%sil"},
-                         {typeid(R8), "%r8b"},
-                         {typeid(R9), "%r9b"},
-                         {typeid(R10), "%r10b"},
-                         {typeid(R11), "%r11b"},
-                         {typeid(SP), "%spl"},
-                         {typeid(BP), "%bpl"}}},
-                       {LONGWORD_SIZE, // 4-byte registers.
-                        {{typeid(AX), "%eax"},
-                         {typeid(CX), "%ecx"},
-                         {typeid(DX), "%edx"},
-                         {typeid(DI), "%edi"},
-                         {typeid(SI), "%esi"},
-                         {typeid(R8), "%r8d"},
-                         {typeid(R9), "%r9d"},
-                         {typeid(R10), "%r10d"},
-                         {typeid(R11), "%r11d"},
-                         {typeid(SP), "%esp"},
-                         {typeid(BP), "%ebp"}}},
-                       {QUADWORD_SIZE, // 8-byte registers.
-                        {{typeid(AX), "%rax"},
-                         {typeid(CX), "%rcx"},
-                         {typeid(DX), "%rdx"},
-                         {typeid(DI), "%rdi"},
-                         {typeid(SI), "%rsi"},
-                         {typeid(R8), "%r8"},
-                         {typeid(R9), "%r9"},
-                         {typeid(R10), "%r10"},
-                         {typeid(R11), "%r11"},
-                         {typeid(SP), "%rsp"},
-                         {typeid(BP), "%rbp"}}}};
-
   public:
     /**
      * Constructor for the register operand class.
@@ -302,6 +349,8 @@ class RegisterOperand : public Operand {
     [[nodiscard]] Register *getRegister() const override;
 
     [[nodiscard]] std::string getRegisterInBytesInStr(int size) const;
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Register; }
 };
 
 /**
@@ -310,9 +359,9 @@ class RegisterOperand : public Operand {
 class PseudoRegisterOperand : public Operand {
   private:
     /**
-     * The pseudo register of the operand.
+     * The (interned) pseudo register of the operand.
      */
-    std::string pseudoReg;
+    Symbol pseudoReg;
 
   public:
     /**
@@ -320,9 +369,20 @@ class PseudoRegisterOperand : public Operand {
      *
      * @param pseudoReg The pseudo register of the operand.
      */
-    explicit PseudoRegisterOperand(std::string pseudoReg);
+    explicit PseudoRegisterOperand(std::string_view pseudoReg);
+
+    /**
+     * Constructor for the pseudo register operand class.
+     *
+     * @param pseudoReg The interned pseudo register of the operand.
+     */
+    explicit PseudoRegisterOperand(Symbol pseudoReg);
 
     [[nodiscard]] std::string getPseudoRegister() const override;
+
+    [[nodiscard]] Symbol getSymbol() const;
+
+    [[nodiscard]] Kind getKind() const override { return Kind::PseudoRegister; }
 };
 
 /**
@@ -355,6 +415,8 @@ class StackOperand : public Operand {
     [[nodiscard]] ReservedRegister *getReservedRegister() const override;
 
     [[nodiscard]] std::string getReservedRegisterInStr() const;
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Stack; }
 };
 
 /**
@@ -376,6 +438,8 @@ class DataOperand : public Operand {
     explicit DataOperand(std::string identifier);
 
     [[nodiscard]] std::string getIdentifier() const override;
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Data; }
 };
 
 /**
@@ -540,6 +604,54 @@ class SubtractOperator : public BinaryOperator {};
  */
 class MultiplyOperator : public BinaryOperator {};
 
+/**
+ * Class for representing the shift-left binary operator (`sal`), whose first
+ * operand is the (immediate) shift count.
+ */
+class SalOperator : public BinaryOperator {};
+
+/**
+ * Class for representing the arithmetic shift-right binary operator (`sar`),
+ * whose first operand is the (immediate) shift count.
+ */
+class SarOperator : public BinaryOperator {};
+
+/**
+ * Class for representing the logical shift-right binary operator (`shr`),
+ * whose first operand is the (immediate) shift count.
+ */
+class ShrOperator : public BinaryOperator {};
+
+/**
+ * Class for representing the load-effective-address binary operator (`lea`)
+ * as a scaled add: the second operand becomes itself plus the first operand
+ * times the scale (`lea (op2, op1, scale), op2`). Both operands must be
+ * registers.
+ */
+class LeaOperator : public BinaryOperator {
+  public:
+    /**
+     * Constructor for the lea binary operator class.
+     *
+     * @param scale The scale of the first operand (1, 2, 4, or 8).
+     * @throws std::invalid_argument if the scale is not 1, 2, 4, or 8.
+     */
+    explicit LeaOperator(int scale);
+
+    /**
+     * Get the scale of the first operand.
+     *
+     * @return The scale of the first operand.
+     */
+    [[nodiscard]] int getScale() const;
+
+  private:
+    /**
+     * The scale of the first operand (1, 2, 4, or 8).
+     */
+    int scale;
+};
+
 /**
  * Base class for representing an assembly type.
  */
@@ -592,6 +704,33 @@ class Quadword : public AssemblyType {};
  */
 class Instruction {
   public:
+    /**
+     * Enumeration representing the kinds of assembly instructions (one per
+     * subclass), so that the backend passes and the code emitter can dispatch
+     * on an instruction with a single `switch` rather than a chain of
+     * `dynamic_cast`s.
+     */
+    enum class Kind : std::uint8_t {
+        Mov,
+        Movsx,
+        MovZeroExtend,
+        Unary,
+        Binary,
+        Cmp,
+        Idiv,
+        Div,
+        Imul,
+        Mul,
+        Cdq,
+        Jmp,
+        JmpCC,
+        SetCC,
+        Label,
+        Push,
+        Call,
+        Ret
+    };
+
     /**
      * Default constructor for the instruction class.
      */
@@ -621,6 +760,13 @@ class Instruction {
      * Default move assignment operator for the instruction class.
      */
     constexpr Instruction &operator=(Instruction &&) = default;
+
+    /**
+     * Get the kind of the instruction.
+     *
+     * @return The kind of the instruction.
+     */
+    [[nodiscard]] virtual Kind getKind() const = 0;
 };
 
 /**
@@ -661,6 +807,8 @@ class MovInstruction : public Instruction {
     void setSrc(std::unique_ptr<Operand> newSrc);
 
     void setDst(std::unique_ptr<Operand> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Mov; }
 };
 
 /**
@@ -690,6 +838,8 @@ class MovsxInstruction : public Instruction {
     void setSrc(std::unique_ptr<Operand> newSrc);
 
     void setDst(std::unique_ptr<Operand> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Movsx; }
 };
 
 /**
@@ -719,6 +869,8 @@ class MovZeroExtendInstruction : public Instruction {
     void setSrc(std::unique_ptr<Operand> newSrc);
 
     void setDst(std::unique_ptr<Operand> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::MovZeroExtend; }
 };
 
 /**
@@ -764,6 +916,8 @@ class UnaryInstruction : public Instruction {
     void setType(std::unique_ptr<AssemblyType> newType);
 
     void setOperand(std::unique_ptr<Operand> newOperand);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Unary; }
 };
 
 /**
@@ -815,6 +969,8 @@ class BinaryInstruction : public Instruction {
     void setOperand1(std::unique_ptr<Operand> newOperand1);
 
     void setOperand2(std::unique_ptr<Operand> newOperand2);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Binary; }
 };
 
 /**
@@ -855,6 +1011,8 @@ class CmpInstruction : public Instruction {
     void setOperand1(std::unique_ptr<Operand> newOperand1);
 
     void setOperand2(std::unique_ptr<Operand> newOperand2);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Cmp; }
 };
 
 /**
@@ -889,6 +1047,8 @@ class IdivInstruction : public Instruction {
     void setType(std::unique_ptr<AssemblyType> newType);
 
     void setOperand(std::unique_ptr<Operand> newOperand);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Idiv; }
 };
 
 /**
@@ -923,6 +1083,84 @@ class DivInstruction : public Instruction {
     void setType(std::unique_ptr<AssemblyType> newType);
 
     void setOperand(std::unique_ptr<Operand> newOperand);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Div; }
+};
+
+/**
+ * Class for representing the one-operand imul instruction, which multiplies
+ * `AX` by its operand as signed integers and writes the double-width product
+ * to `DX:AX`.
+ */
+class ImulInstruction : public Instruction {
+  private:
+    /**
+     * The type of the instruction.
+     */
+    std::unique_ptr<AssemblyType> type;
+
+    /**
+     * The operand of the instruction.
+     */
+    std::unique_ptr<Operand> operand;
+
+  public:
+    /**
+     * Constructor for the one-operand imul instruction class.
+     *
+     * @param type The type of the instruction.
+     * @param operand The operand of the instruction.
+     */
+    explicit ImulInstruction(std::unique_ptr<AssemblyType> type,
+                             std::unique_ptr<Operand> operand);
+
+    [[nodiscard]] const AssemblyType *getType() const;
+
+    [[nodiscard]] const Operand *getOperand() const;
+
+    void setType(std::unique_ptr<AssemblyType> newType);
+
+    void setOperand(std::unique_ptr<Operand> newOperand);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Imul; }
+};
+
+/**
+ * Class for representing the one-operand mul instruction, which multiplies
+ * `AX` by its operand as unsigned integers and writes the double-width product
+ * to `DX:AX`.
+ */
+class MulInstruction : public Instruction {
+  private:
+    /**
+     * The type of the instruction.
+     */
+    std::unique_ptr<AssemblyType> type;
+
+    /**
+     * The operand of the instruction.
+     */
+    std::unique_ptr<Operand> operand;
+
+  public:
+    /**
+     * Constructor for the one-operand mul instruction class.
+     *
+     * @param type The type of the instruction.
+     * @param operand The operand of the instruction.
+     */
+    explicit MulInstruction(std::unique_ptr<AssemblyType> type,
+                            std::unique_ptr<Operand> operand);
+
+    [[nodiscard]] const AssemblyType *getType() const;
+
+    [[nodiscard]] const Operand *getOperand() const;
+
+    void setType(std::unique_ptr<AssemblyType> newType);
+
+    void setOperand(std::unique_ptr<Operand> newOperand);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Mul; }
 };
 
 /**
@@ -946,6 +1184,8 @@ class CdqInstruction : public Instruction {
     [[nodiscard]] const AssemblyType *getType() const;
 
     void setType(std::unique_ptr<AssemblyType> newType);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Cdq; }
 };
 
 /**
@@ -969,6 +1209,8 @@ class JmpInstruction : public Instruction {
     [[nodiscard]] std::string getLabel() const;
 
     void setLabel(std::string newLabel);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Jmp; }
 };
 
 /**
@@ -1003,6 +1245,8 @@ class JmpCCInstruction : public Instruction {
     void setCondCode(std::unique_ptr<CondCode> newCondCode);
 
     void setLabel(std::string newLabel);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::JmpCC; }
 };
 
 /**
@@ -1037,6 +1281,8 @@ class SetCCInstruction : public Instruction {
     void setCondCode(std::unique_ptr<CondCode> newCondCode);
 
     void setOperand(std::unique_ptr<Operand> newOperand);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::SetCC; }
 };
 
 /**
@@ -1060,6 +1306,8 @@ class LabelInstruction : public Instruction {
     [[nodiscard]] std::string getLabel() const;
 
     void setLabel(std::string newLabel);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Label; }
 };
 
 /**
@@ -1083,6 +1331,8 @@ class PushInstruction : public Instruction {
     [[nodiscard]] const Operand *getOperand() const;
 
     void setOperand(std::unique_ptr<Operand> newOperand);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Push; }
 };
 
 /**
@@ -1104,12 +1354,17 @@ class CallInstruction : public Instruction {
     explicit CallInstruction(std::string functionIdentifier);
 
     [[nodiscard]] std::string getFunctionIdentifier() const;
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Call; }
 };
 
 /**
  * Class for representing the ret instruction.
  */
-class RetInstruction : public Instruction {};
+class RetInstruction : public Instruction {
+  public:
+    [[nodiscard]] Kind getKind() const override { return Kind::Ret; }
+};
 
 /**
  * Base class for representing a top-level construct.
@@ -5,11 +5,15 @@
 #include "../frontend/type.h"
 #include "../midend/ir.h"
 #include "../utils/constants.h"
+#include "../utils/threadPool.h"
 #include "assembly.h"
 #include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -37,7 +41,7 @@ bool isSignedType(const IR::Value *irValue,
     }
     else if (const auto *varVal =
                  dynamic_cast<const IR::VariableValue *>(irValue)) {
-        auto symbolIt = frontendSymbolTable.find(varVal->getIdentifier());
+        auto symbolIt = frontendSymbolTable.find(varVal->getSymbol());
         if (symbolIt != frontendSymbolTable.end()) {
             auto *varType = symbolIt->second.first.get();
             return (dynamic_cast<const AST::IntType *>(varType) != nullptr) ||
@@ -50,6 +54,174 @@ bool isSignedType(const IR::Value *irValue,
     throw std::logic_error("Unsupported IR value type for signedness check in "
                            "isSignedType");
 }
+
+/**
+ * Get the value of an IR constant as the bits of a 64-bit integer.
+ *
+ * @param irValue The IR value.
+ * @return The bits of the constant (sign-extended for `int`), or
+ * `std::nullopt` if the value is not a constant.
+ */
+std::optional<std::uint64_t> getConstantBits(const IR::Value *irValue) {
+    const auto *constantVal = dynamic_cast<const IR::ConstantValue *>(irValue);
+    if (constantVal == nullptr) {
+        return std::nullopt;
+    }
+    const auto *astConstant = constantVal->getASTConstant();
+    if (const auto *constantInt =
+            dynamic_cast<const AST::ConstantInt *>(astConstant)) {
+        return static_cast<std::uint64_t>(
+            static_cast<std::int64_t>(constantInt->getValue()));
+    }
+    else if (const auto *constantLong =
+                 dynamic_cast<const AST::ConstantLong *>(astConstant)) {
+        return static_cast<std::uint64_t>(constantLong->getValue());
+    }
+    else if (const auto *constantUInt =
+                 dynamic_cast<const AST::ConstantUInt *>(astConstant)) {
+        return constantUInt->getValue();
+    }
+    else if (const auto *constantULong =
+                 dynamic_cast<const AST::ConstantULong *>(astConstant)) {
+        return constantULong->getValue();
+    }
+    return std::nullopt;
+}
+
+/**
+ * Unsigned 16-byte integer, wide enough for the product of two 8-byte
+ * integers when computing magic numbers.
+ */
+__extension__ using UInt128 = unsigned __int128;
+
+/**
+ * Structure representing how to divide an integer `n` of `width` bits (32 or
+ * 64) by a constant with a multiplication by a magic number: the quotient is
+ * `(n * multiplier) >> shift`, or, if `addBack` is set (for unsigned divisors
+ * whose magic number does not fit in `width` bits),
+ * `(t + ((n - t) >> 1)) >> shift` with `t = (n * multiplier) >> width`.
+ */
+struct MagicNumber {
+    std::uint64_t multiplier;
+    int shift;
+    bool addBack;
+};
+
+/**
+ * Compute the magic number for dividing a signed integer by a constant
+ * (Granlund and Montgomery), rounding towards negative infinity (one must be
+ * added to the quotient of a negative dividend), with the smallest shift that
+ * is exact.
+ *
+ * @param divisor The divisor (greater than 2, less than `2^(width - 1)`, and
+ * not a power of two).
+ * @param width The width of the dividend in bits (32 or 64).
+ * @return The magic number (less than `2^width`, but possibly not less than
+ * `2^(width - 1)`).
+ */
+MagicNumber computeSignedMagicNumber(std::uint64_t divisor, int width) {
+    // `floor(2^shift / divisor) + 1` is exact for every dividend of magnitude
+    // at most `2^(width - 1)` if its rounding error is less than
+    // `2^(shift - width + 1)`, which always holds for
+    // `shift = width - 1 + ceil(log2(divisor))`.
+    const auto maxShift = width - 1 + static_cast<int>(std::bit_width(divisor));
+    for (int shift = width;; ++shift) {
+        const auto power = UInt128{1} << shift;
+        const auto multiplier = (power / divisor) + 1;
+        const auto error = (multiplier * divisor) - power;
+        if (error < (UInt128{1} << (shift - width + 1)) || shift == maxShift) {
+            return {.multiplier = static_cast<std::uint64_t>(multiplier),
+                    .shift = shift,
+                    .addBack = false};
+        }
+    }
+}
+
+/**
+ * Compute the magic number for dividing an unsigned integer by a constant
+ * (Granlund and Montgomery), preferring a single multiplication and shift.
+ *
+ * @param divisor The divisor (greater than 2, less than `2^width`, and not a
+ * power of two).
+ * @param width The width of the dividend in bits (32 or 64).
+ * @return The magic number.
+ */
+MagicNumber computeUnsignedMagicNumber(std::uint64_t divisor, int width) {
+    // `ceil(2^shift / divisor)` is exact for every dividend of `width` bits if
+    // its rounding error is at most `2^(shift - width)`.
+    const auto maxMultiplier = (UInt128{1} << width) - 1;
+    for (int shift = width; shift < 2 * width; ++shift) {
+        const auto power = UInt128{1} << shift;
+        const auto multiplier =
+            (power / divisor) + (power % divisor != 0 ? 1 : 0);
+        if (multiplier > maxMultiplier) {
+            break;
+        }
+        const auto error = (multiplier * divisor) - power;
+        if (error <= (UInt128{1} << (shift - width))) {
+            return {.multiplier = static_cast<std::uint64_t>(multiplier),
+                    .shift = shift,
+                    .addBack = false};
+        }
+    }
+    const auto log = static_cast<int>(std::bit_width(divisor));
+    return {.multiplier = static_cast<std::uint64_t>(
+                ((((UInt128{1} << log) - divisor) << width) / divisor) + 1),
+            .shift = log - 1,
+            .addBack = true};
+}
+
+/**
+ * Make an assembly type of a given size.
+ *
+ * @param isQuadword Whether the type is 8 bytes (4 bytes otherwise).
+ * @return The assembly type.
+ */
+std::unique_ptr<Assembly::AssemblyType> makeAssemblyType(bool isQuadword) {
+    if (isQuadword) {
+        return std::make_unique<Assembly::Quadword>();
+    }
+    return std::make_unique<Assembly::Longword>();
+}
+
+/**
+ * Append an assembly binary instruction whose second operand is a register.
+ *
+ * @param instructions The assembly instructions.
+ * @param binaryOperator The binary operator.
+ * @param isQuadword Whether the instruction operates on 8 bytes.
+ * @param operand1 The first operand.
+ * @param reg The register of the second operand (e.g., `"AX"`).
+ */
+void appendBinaryToRegister(
+    std::vector<std::unique_ptr<Assembly::Instruction>> &instructions,
+    std::unique_ptr<Assembly::BinaryOperator> binaryOperator, bool isQuadword,
+    std::unique_ptr<Assembly::Operand> operand1, const std::string &reg) {
+    instructions.emplace_back(std::make_unique<Assembly::BinaryInstruction>(
+        std::move(binaryOperator), makeAssemblyType(isQuadword),
+        std::move(operand1), std::make_unique<Assembly::RegisterOperand>(reg)));
+}
+
+/**
+ * Append an assembly shift of a register by a constant count.
+ *
+ * @param instructions The assembly instructions.
+ * @param shiftOperator The shift operator (`Sal`, `Sar`, or `Shr`).
+ * @param isQuadword Whether the instruction operates on 8 bytes.
+ * @param count The shift count (nothing is appended if it is zero).
+ * @param reg The register to shift (e.g., `"AX"`).
+ */
+void appendShift(
+    std::vector<std::unique_ptr<Assembly::Instruction>> &instructions,
+    std::unique_ptr<Assembly::BinaryOperator> shiftOperator, bool isQuadword,
+    int count, const std::string &reg) {
+    if (count == 0) {
+        return;
+    }
+    appendBinaryToRegister(instructions, std::move(shiftOperator), isQuadword,
+                           std::make_unique<Assembly::ImmediateOperand>(count),
+                           reg);
+}
 } // namespace
 
 namespace Assembly {
@@ -60,20 +232,17 @@ AssemblyGenerator::AssemblyGenerator(
       frontendSymbolTable(&frontendSymbolTable) {}
 
 std::unique_ptr<Assembly::Program>
-AssemblyGenerator::generateAssembly(const IR::Program &irProgram) {
+AssemblyGenerator::generateAssembly(const IR::Program &irProgram,
+                                    ThreadPool &threadPool) {
     const auto &irTopLevels = irProgram.getTopLevels();
     auto assyTopLevels =
         std::make_unique<std::vector<std::unique_ptr<TopLevel>>>();
 
-    // Generate assembly instructions for each IR top-level function definition.
+    std::vector<const IR::FunctionDefinition *> irFunctionDefinitions;
     for (const auto &irTopLevel : irTopLevels) {
         if (auto *irFunctionDefinition =
                 dynamic_cast<IR::FunctionDefinition *>(irTopLevel.get())) {
-            auto instructions = std::make_unique<
-                std::vector<std::unique_ptr<Assembly::Instruction>>>();
-            auto assyFunctionDefinition = convertIRFunctionDefinitionToAssy(
-                *irFunctionDefinition, std::move(instructions));
-            assyTopLevels->emplace_back(std::move(assyFunctionDefinition));
+            irFunctionDefinitions.emplace_back(irFunctionDefinition);
         }
         else {
             const auto &r = *irTopLevel;
@@ -83,6 +252,18 @@ AssemblyGenerator::generateAssembly(const IR::Program &irProgram) {
         }
     }
 
+    // Generate assembly instructions for each IR top-level function
+    // definition, each into its own slot so that the order of the IR program
+    // is kept.
+    assyTopLevels->resize(irFunctionDefinitions.size());
+    threadPool.parallelFor(
+        irFunctionDefinitions.size(), [&](std::size_t index) {
+            auto instructions = std::make_unique<
+                std::vector<std::unique_ptr<Assembly::Instruction>>>();
+            (*assyTopLevels)[index] = convertIRFunctionDefinitionToAssy(
+                *irFunctionDefinitions[index], std::move(instructions));
+        });
+
     // Generate assembly instructions for each IR (either top-level or local)
     // static variable.
     for (const auto &irStaticVariable : *irStaticVariables) {
@@ -214,68 +395,71 @@ AssemblyGenerator::convertIRStaticVariableToAssy(
 void AssemblyGenerator::convertIRInstructionToAssy(
     const IR::Instruction &irInstruction,
     std::vector<std::unique_ptr<Assembly::Instruction>> &instructions) {
-    if (const auto *returnInstr =
-            dynamic_cast<const IR::ReturnInstruction *>(&irInstruction)) {
-        convertIRReturnInstructionToAssy(*returnInstr, instructions);
-    }
-    else if (const auto *unaryInstr =
-                 dynamic_cast<const IR::UnaryInstruction *>(&irInstruction)) {
-        convertIRUnaryInstructionToAssy(*unaryInstr, instructions);
-    }
-    else if (const auto *binaryInstr =
-                 dynamic_cast<const IR::BinaryInstruction *>(&irInstruction)) {
-        convertIRBinaryInstructionToAssy(*binaryInstr, instructions);
-    }
-    else if (const auto *copyInstr =
-                 dynamic_cast<const IR::CopyInstruction *>(&irInstruction)) {
-        convertIRCopyInstructionToAssy(*copyInstr, instructions);
-    }
-    else if (const auto *jumpInstr =
-                 dynamic_cast<const IR::JumpInstruction *>(&irInstruction)) {
-        convertIRJumpInstructionToAssy(*jumpInstr, instructions);
-    }
-    else if (const auto *jumpIfZeroInstr =
-                 dynamic_cast<const IR::JumpIfZeroInstruction *>(
-                     &irInstruction)) {
-        convertIRJumpIfZeroInstructionToAssy(*jumpIfZeroInstr, instructions);
-    }
-    else if (const auto *jumpIfNotZeroInstr =
-                 dynamic_cast<const IR::JumpIfNotZeroInstruction *>(
-                     &irInstruction)) {
-        convertIRJumpIfNotZeroInstructionToAssy(*jumpIfNotZeroInstr,
-                                                instructions);
-    }
-    else if (const auto *labelInstr =
-                 dynamic_cast<const IR::LabelInstruction *>(&irInstruction)) {
-        convertIRLabelInstructionToAssy(*labelInstr, instructions);
-    }
-    else if (const auto *functionCallInstr =
-                 dynamic_cast<const IR::FunctionCallInstruction *>(
-                     &irInstruction)) {
-        convertIRFunctionCallInstructionToAssy(*functionCallInstr,
-                                               instructions);
-    }
-    else if (const auto *signExtendInstr =
-                 dynamic_cast<const IR::SignExtendInstruction *>(
-                     &irInstruction)) {
-        convertIRSignExtendInstructionToAssy(*signExtendInstr, instructions);
-    }
-    else if (const auto *truncateInstr =
-                 dynamic_cast<const IR::TruncateInstruction *>(
-                     &irInstruction)) {
-        convertIRTruncateInstructionToAssy(*truncateInstr, instructions);
-    }
-    else if (const auto *zeroExtendInstr =
-                 dynamic_cast<const IR::ZeroExtendInstruction *>(
-                     &irInstruction)) {
-        convertIRZeroExtendInstructionToAssy(*zeroExtendInstr, instructions);
-    }
-    else {
-        const auto &r = *&irInstruction;
+    switch (irInstruction.getKind()) {
+    case IR::Instruction::Kind::Return:
+        convertIRReturnInstructionToAssy(
+            static_cast<const IR::ReturnInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::SignExtend:
+        convertIRSignExtendInstructionToAssy(
+            static_cast<const IR::SignExtendInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::Truncate:
+        convertIRTruncateInstructionToAssy(
+            static_cast<const IR::TruncateInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::ZeroExtend:
+        convertIRZeroExtendInstructionToAssy(
+            static_cast<const IR::ZeroExtendInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::Unary:
+        convertIRUnaryInstructionToAssy(
+            static_cast<const IR::UnaryInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::Binary:
+        convertIRBinaryInstructionToAssy(
+            static_cast<const IR::BinaryInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::Copy:
+        convertIRCopyInstructionToAssy(
+            static_cast<const IR::CopyInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::Jump:
+        convertIRJumpInstructionToAssy(
+            static_cast<const IR::JumpInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::JumpIfZero:
+        convertIRJumpIfZeroInstructionToAssy(
+            static_cast<const IR::JumpIfZeroInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::JumpIfNotZero:
+        convertIRJumpIfNotZeroInstructionToAssy(
+            static_cast<const IR::JumpIfNotZeroInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::Label:
+        convertIRLabelInstructionToAssy(
+            static_cast<const IR::LabelInstruction &>(irInstruction),
+            instructions);
+        break;
+    case IR::Instruction::Kind::FunctionCall:
+        convertIRFunctionCallInstructionToAssy(
+            static_cast<const IR::FunctionCallInstruction &>(irInstruction),
+            instructions);
+        break;
+    default:
         throw std::logic_error(
             "Unsupported IR instruction type in convertIRInstructionToAssy in "
-            "AssemblyGenerator: " +
-            std::string(typeid(r).name()));
+            "AssemblyGenerator");
     }
 }
 
@@ -372,6 +556,9 @@ void AssemblyGenerator::convertIRBinaryInstructionToAssy(
     }
     else if (dynamic_cast<const IR::MultiplyOperator *>(binaryIROperator) !=
              nullptr) {
+        if (convertIRMultiplyByConstantToAssy(binaryInstr, instructions)) {
+            return;
+        }
         instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
             determineAssemblyType(binaryInstr.getSrc1()),
             convertValue(binaryInstr.getSrc1()),
@@ -384,6 +571,10 @@ void AssemblyGenerator::convertIRBinaryInstructionToAssy(
     }
     else if (dynamic_cast<const IR::DivideOperator *>(binaryIROperator) !=
              nullptr) {
+        if (convertIRDivideByConstantToAssy(binaryInstr, false,
+                                            instructions)) {
+            return;
+        }
         // Move `src1` to `AX` regardless of whether it is signed or unsigned.
         instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
             determineAssemblyType(binaryInstr.getSrc1()),
@@ -422,6 +613,9 @@ void AssemblyGenerator::convertIRBinaryInstructionToAssy(
     }
     else if (dynamic_cast<const IR::RemainderOperator *>(binaryIROperator) !=
              nullptr) {
+        if (convertIRDivideByConstantToAssy(binaryInstr, true, instructions)) {
+            return;
+        }
         // Move `src1` to `AX` regardless of whether it is signed or unsigned.
         instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
             determineAssemblyType(binaryInstr.getSrc1()),
@@ -585,6 +779,316 @@ void AssemblyGenerator::convertIRBinaryInstructionToAssy(
     }
 }
 
+bool AssemblyGenerator::convertIRMultiplyByConstantToAssy(
+    const IR::BinaryInstruction &binaryInstr,
+    std::vector<std::unique_ptr<Assembly::Instruction>> &instructions) {
+    // The multiplication is commutative, so the constant can be either
+    // operand.
+    const auto *src = binaryInstr.getSrc1();
+    auto constant = getConstantBits(binaryInstr.getSrc2());
+    if (!constant) {
+        src = binaryInstr.getSrc2();
+        constant = getConstantBits(binaryInstr.getSrc1());
+    }
+    if (!constant) {
+        return false;
+    }
+    const bool isQuadword = dynamic_cast<const Assembly::Quadword *>(
+                                determineAssemblyType(src).get()) != nullptr;
+    const int width = isQuadword ? 64 : 32;
+    // The low bits of the product do not depend on the signedness.
+    auto multiplier = *constant;
+    if (!isQuadword) {
+        multiplier &= std::numeric_limits<std::uint32_t>::max();
+    }
+    if (multiplier <= 1) {
+        return false;
+    }
+    const auto exponent = std::countr_zero(multiplier);
+    const auto oddFactor = multiplier >> exponent;
+
+    // `x * 2^k`: `sal` in place.
+    if (oddFactor == 1) {
+        instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+            makeAssemblyType(isQuadword), convertValue(src),
+            convertValue(binaryInstr.getDst())));
+        instructions.emplace_back(std::make_unique<Assembly::BinaryInstruction>(
+            std::make_unique<Assembly::SalOperator>(),
+            makeAssemblyType(isQuadword),
+            std::make_unique<Assembly::ImmediateOperand>(exponent),
+            convertValue(binaryInstr.getDst())));
+        return true;
+    }
+
+    // `x * {3, 5, 9} * 2^k`: `lea (x, x, 2/4/8)`, then `sal`.
+    if (oddFactor == 3 || oddFactor == 5 || oddFactor == 9) {
+        instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+            makeAssemblyType(isQuadword), convertValue(src),
+            std::make_unique<Assembly::RegisterOperand>("AX")));
+        appendBinaryToRegister(
+            instructions,
+            std::make_unique<Assembly::LeaOperator>(
+                static_cast<int>(oddFactor - 1)),
+            isQuadword, std::make_unique<Assembly::RegisterOperand>("AX"),
+            "AX");
+        appendShift(instructions, std::make_unique<Assembly::SalOperator>(),
+                    isQuadword, exponent, "AX");
+    }
+    // `x * (2^k + 1)` and `x * (2^k - 1)`: `sal`, then `add` or `sub` of `x`.
+    else if (exponent == 0 && std::has_single_bit(multiplier - 1) &&
+             std::countr_zero(multiplier - 1) < width) {
+        instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+            makeAssemblyType(isQuadword), convertValue(src),
+            std::make_unique<Assembly::RegisterOperand>("AX")));
+        appendShift(instructions, std::make_unique<Assembly::SalOperator>(),
+                    isQuadword, std::countr_zero(multiplier - 1), "AX");
+        appendBinaryToRegister(instructions,
+                               std::make_unique<Assembly::AddOperator>(),
+                               isQuadword, convertValue(src), "AX");
+    }
+    else if (exponent == 0 && std::has_single_bit(multiplier + 1) &&
+             std::countr_zero(multiplier + 1) < width) {
+        instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+            makeAssemblyType(isQuadword), convertValue(src),
+            std::make_unique<Assembly::RegisterOperand>("AX")));
+        appendShift(instructions, std::make_unique<Assembly::SalOperator>(),
+                    isQuadword, std::countr_zero(multiplier + 1), "AX");
+        appendBinaryToRegister(instructions,
+                               std::make_unique<Assembly::SubtractOperator>(),
+                               isQuadword, convertValue(src), "AX");
+    }
+    else {
+        return false;
+    }
+    instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+        makeAssemblyType(isQuadword),
+        std::make_unique<Assembly::RegisterOperand>("AX"),
+        convertValue(binaryInstr.getDst())));
+    return true;
+}
+
+bool AssemblyGenerator::convertIRDivideByConstantToAssy(
+    const IR::BinaryInstruction &binaryInstr, bool isRemainder,
+    std::vector<std::unique_ptr<Assembly::Instruction>> &instructions) {
+    const auto constant = getConstantBits(binaryInstr.getSrc2());
+    if (!constant) {
+        return false;
+    }
+    const auto *src = binaryInstr.getSrc1();
+    const bool isQuadword = dynamic_cast<const Assembly::Quadword *>(
+                                determineAssemblyType(src).get()) != nullptr;
+    const bool isSigned = isSignedType(src, *frontendSymbolTable);
+    const int width = isQuadword ? 64 : 32;
+
+    // Divide by the magnitude of the divisor: the remainder has the sign of
+    // the dividend, and the quotient is negated for a negative divisor.
+    auto divisor = *constant;
+    if (!isQuadword && !isSigned) {
+        divisor &= std::numeric_limits<std::uint32_t>::max();
+    }
+    const bool isNegativeDivisor =
+        isSigned && static_cast<std::int64_t>(divisor) < 0;
+    if (isNegativeDivisor) {
+        divisor = 0 - divisor;
+    }
+    if (divisor == 0) {
+        return false;
+    }
+    const bool isPowerOfTwo = std::has_single_bit(divisor);
+    const auto exponent = std::countr_zero(divisor);
+
+    // Compute the quotient by the magnitude of the divisor in `AX`.
+    if (isPowerOfTwo) {
+        instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+            makeAssemblyType(isQuadword), convertValue(src),
+            std::make_unique<Assembly::RegisterOperand>("AX")));
+        if (isSigned && exponent > 0) {
+            // Round towards zero: add `2^k - 1` to a negative dividend.
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    makeAssemblyType(isQuadword), convertValue(src),
+                    std::make_unique<Assembly::RegisterOperand>("DX")));
+            appendShift(instructions, std::make_unique<Assembly::SarOperator>(),
+                        isQuadword, width - 1, "DX");
+            appendShift(instructions, std::make_unique<Assembly::ShrOperator>(),
+                        isQuadword, width - exponent, "DX");
+            appendBinaryToRegister(
+                instructions, std::make_unique<Assembly::AddOperator>(),
+                isQuadword, std::make_unique<Assembly::RegisterOperand>("DX"),
+                "AX");
+            appendShift(instructions, std::make_unique<Assembly::SarOperator>(),
+                        isQuadword, exponent, "AX");
+        }
+        else {
+            appendShift(instructions, std::make_unique<Assembly::ShrOperator>(),
+                        isQuadword, exponent, "AX");
+        }
+    }
+    else if (isSigned) {
+        // Multiply the dividend by the magic number, keep the high half of the
+        // product, and add one for a negative dividend.
+        const auto magic = computeSignedMagicNumber(divisor, width);
+        if (!isQuadword) {
+            // The product of the sign-extended dividend fits in 8 bytes.
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovsxInstruction>(
+                    convertValue(src),
+                    std::make_unique<Assembly::RegisterOperand>("AX")));
+            appendBinaryToRegister(
+                instructions, std::make_unique<Assembly::MultiplyOperator>(),
+                true,
+                std::make_unique<Assembly::ImmediateOperand>(magic.multiplier),
+                "AX");
+            appendShift(instructions, std::make_unique<Assembly::SarOperator>(),
+                        true, magic.shift, "AX");
+        }
+        else {
+            // `imul` writes the 16-byte product to `DX:AX`. A magic number of
+            // at least 2^63 is read as itself minus 2^64, so the dividend is
+            // added back to the high half.
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    makeAssemblyType(true), convertValue(src),
+                    std::make_unique<Assembly::RegisterOperand>("AX")));
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    makeAssemblyType(true),
+                    std::make_unique<Assembly::ImmediateOperand>(
+                        magic.multiplier),
+                    std::make_unique<Assembly::RegisterOperand>("DX")));
+            instructions.emplace_back(
+                std::make_unique<Assembly::ImulInstruction>(
+                    makeAssemblyType(true),
+                    std::make_unique<Assembly::RegisterOperand>("DX")));
+            if (static_cast<std::int64_t>(magic.multiplier) < 0) {
+                appendBinaryToRegister(
+                    instructions, std::make_unique<Assembly::AddOperator>(),
+                    true, convertValue(src), "DX");
+            }
+            appendShift(instructions, std::make_unique<Assembly::SarOperator>(),
+                        true, magic.shift - width, "DX");
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    makeAssemblyType(true),
+                    std::make_unique<Assembly::RegisterOperand>("DX"),
+                    std::make_unique<Assembly::RegisterOperand>("AX")));
+        }
+        instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+            makeAssemblyType(isQuadword), convertValue(src),
+            std::make_unique<Assembly::RegisterOperand>("DX")));
+        appendShift(instructions, std::make_unique<Assembly::SarOperator>(),
+                    isQuadword, width - 1, "DX");
+        appendBinaryToRegister(
+            instructions, std::make_unique<Assembly::SubtractOperator>(),
+            isQuadword, std::make_unique<Assembly::RegisterOperand>("DX"),
+            "AX");
+    }
+    else {
+        // Multiply the dividend by the magic number, and keep the high half
+        // `t` of the product in `AX` (shifted right by the magic shift, unless
+        // the multiplier has to be added back).
+        const auto magic = computeUnsignedMagicNumber(divisor, width);
+        if (!isQuadword) {
+            // The product of the zero-extended dividend (a 4-byte `mov`
+            // clears the upper half of `AX`) fits in 8 bytes.
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    makeAssemblyType(false), convertValue(src),
+                    std::make_unique<Assembly::RegisterOperand>("AX")));
+            appendBinaryToRegister(
+                instructions, std::make_unique<Assembly::MultiplyOperator>(),
+                true,
+                std::make_unique<Assembly::ImmediateOperand>(magic.multiplier),
+                "AX");
+            appendShift(instructions, std::make_unique<Assembly::ShrOperator>(),
+                        true, magic.addBack ? width : magic.shift, "AX");
+        }
+        else {
+            // `mul` writes the 16-byte product to `DX:AX`.
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    makeAssemblyType(true), convertValue(src),
+                    std::make_unique<Assembly::RegisterOperand>("AX")));
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    makeAssemblyType(true),
+                    std::make_unique<Assembly::ImmediateOperand>(
+                        magic.multiplier),
+                    std::make_unique<Assembly::RegisterOperand>("DX")));
+            instructions.emplace_back(
+                std::make_unique<Assembly::MulInstruction>(
+                    makeAssemblyType(true),
+                    std::make_unique<Assembly::RegisterOperand>("DX")));
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    makeAssemblyType(true),
+                    std::make_unique<Assembly::RegisterOperand>("DX"),
+                    std::make_unique<Assembly::RegisterOperand>("AX")));
+            if (!magic.addBack) {
+                appendShift(instructions,
+                            std::make_unique<Assembly::ShrOperator>(), true,
+                            magic.shift - width, "AX");
+            }
+        }
+        if (magic.addBack) {
+            instructions.emplace_back(
+                std::make_unique<Assembly::MovInstruction>(
+                    makeAssemblyType(isQuadword), convertValue(src),
+                    std::make_unique<Assembly::RegisterOperand>("DX")));
+            appendBinaryToRegister(
+                instructions, std::make_unique<Assembly::SubtractOperator>(),
+                isQuadword, std::make_unique<Assembly::RegisterOperand>("AX"),
+                "DX");
+            appendShift(instructions, std::make_unique<Assembly::ShrOperator>(),
+                        isQuadword, 1, "DX");
+            appendBinaryToRegister(
+                instructions, std::make_unique<Assembly::AddOperator>(),
+                isQuadword, std::make_unique<Assembly::RegisterOperand>("DX"),
+                "AX");
+            appendShift(instructions, std::make_unique<Assembly::ShrOperator>(),
+                        isQuadword, magic.shift, "AX");
+        }
+    }
+
+    if (isRemainder) {
+        // The remainder is the dividend minus the quotient times the
+        // magnitude of the divisor.
+        if (isPowerOfTwo) {
+            appendShift(instructions, std::make_unique<Assembly::SalOperator>(),
+                        isQuadword, exponent, "AX");
+        }
+        else {
+            appendBinaryToRegister(
+                instructions, std::make_unique<Assembly::MultiplyOperator>(),
+                isQuadword,
+                std::make_unique<Assembly::ImmediateOperand>(divisor), "AX");
+        }
+        instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+            makeAssemblyType(isQuadword), convertValue(src),
+            std::make_unique<Assembly::RegisterOperand>("DX")));
+        appendBinaryToRegister(
+            instructions, std::make_unique<Assembly::SubtractOperator>(),
+            isQuadword, std::make_unique<Assembly::RegisterOperand>("AX"),
+            "DX");
+        instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+            makeAssemblyType(isQuadword),
+            std::make_unique<Assembly::RegisterOperand>("DX"),
+            convertValue(binaryInstr.getDst())));
+        return true;
+    }
+    if (isNegativeDivisor) {
+        instructions.emplace_back(std::make_unique<Assembly::UnaryInstruction>(
+            std::make_unique<Assembly::NegateOperator>(),
+            makeAssemblyType(isQuadword),
+            std::make_unique<Assembly::RegisterOperand>("AX")));
+    }
+    instructions.emplace_back(std::make_unique<Assembly::MovInstruction>(
+        makeAssemblyType(isQuadword),
+        std::make_unique<Assembly::RegisterOperand>("AX"),
+        convertValue(binaryInstr.getDst())));
+    return true;
+}
+
 void AssemblyGenerator::convertIRJumpInstructionToAssy(
     const IR::JumpInstruction &jumpInstr,
     std::vector<std::unique_ptr<Assembly::Instruction>> &instructions) {
@@ -795,7 +1299,7 @@ AssemblyGenerator::convertValue(const IR::Value *irValue) {
     else if (const auto *varVal =
                  dynamic_cast<const IR::VariableValue *>(irValue)) {
         return std::make_unique<Assembly::PseudoRegisterOperand>(
-            varVal->getIdentifier());
+            varVal->getSymbol());
     }
     else {
         throw std::logic_error(
@@ -872,7 +1376,7 @@ AssemblyGenerator::determineAssemblyType(const IR::Value *irValue) {
     else if (const auto *varVal =
                  dynamic_cast<const IR::VariableValue *>(irValue)) {
         // For variables, look up the type in the (frontend) symbol table.
-        auto symbolIt = frontendSymbolTable->find(varVal->getIdentifier());
+        auto symbolIt = frontendSymbolTable->find(varVal->getSymbol());
         if (symbolIt != frontendSymbolTable->end()) {
             auto *varType = symbolIt->second.first.get();
             return AssemblyGenerator::convertASTTypeToAssemblyType(varType);
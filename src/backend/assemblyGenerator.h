@@ -3,6 +3,7 @@
 
 #include "../frontend/frontendSymbolTable.h"
 #include "../midend/ir.h"
+#include "../utils/threadPool.h"
 #include "assembly.h"
 #include <memory>
 #include <vector>
@@ -28,11 +29,17 @@ class AssemblyGenerator {
     /**
      * Generate assembly from the IR program.
      *
+     * The function definitions are converted independently on the threads of
+     * the thread pool (the generator only reads the IR and the symbol table),
+     * and the top-levels keep the order of the IR program.
+     *
      * @param irProgram The IR program to generate assembly from.
+     * @param threadPool The thread pool to convert the function definitions
+     * on.
      * @return The generated assembly.
      */
     [[nodiscard]] std::unique_ptr<Assembly::Program>
-    generateAssembly(const IR::Program &irProgram);
+    generateAssembly(const IR::Program &irProgram, ThreadPool &threadPool);
 
   private:
     /**
@@ -103,6 +110,38 @@ class AssemblyGenerator {
         const IR::BinaryInstruction &binaryInstr,
         std::vector<std::unique_ptr<Assembly::Instruction>> &instructions);
 
+    /**
+     * Convert an IR multiplication by a constant to assembly without `imul`,
+     * if a cheaper sequence exists: `sal` for a power of two, `lea` (then
+     * `sal`) for 3, 5, or 9 times a power of two, and `sal` then `add` or
+     * `sub` for a power of two plus or minus one.
+     *
+     * @param binaryInstr The IR multiply instruction to convert.
+     * @param instructions The assembly instructions.
+     * @return True if the instruction has been converted, false otherwise.
+     */
+    bool convertIRMultiplyByConstantToAssy(
+        const IR::BinaryInstruction &binaryInstr,
+        std::vector<std::unique_ptr<Assembly::Instruction>> &instructions);
+
+    /**
+     * Convert an IR division or remainder by a constant to assembly without
+     * `idiv` or `div`: shifts for a power of two, and otherwise a
+     * multiplication of the dividend by a magic number, keeping the high half
+     * of the product (of the widened dividend for 4-byte operands, and from
+     * `DX` after a one-operand `imul` or `mul` for 8-byte operands). The
+     * remainder is the dividend minus the quotient times the divisor.
+     *
+     * @param binaryInstr The IR divide or remainder instruction to convert.
+     * @param isRemainder Whether the instruction computes the remainder.
+     * @param instructions The assembly instructions.
+     * @return True if the instruction has been converted, false otherwise
+     * (the divisor is not a constant or is zero).
+     */
+    bool convertIRDivideByConstantToAssy(
+        const IR::BinaryInstruction &binaryInstr, bool isRemainder,
+        std::vector<std::unique_ptr<Assembly::Instruction>> &instructions);
+
     /**
      * Convert an IR label instruction to assembly.
      *
@@ -2,6 +2,7 @@
 #define BACKEND_BACKEND_SYMBOL_TABLE_H
 
 #include "../frontend/frontendSymbolTable.h"
+#include "../utils/symbol.h"
 #include "assembly.h"
 #include <memory>
 #include <stdexcept>
@@ -126,11 +127,11 @@ class FunEntry : public BackendSymbolTableEntry {
 /**
  * Type alias for the backend symbol table.
  *
- * The key is the identifier (variable or function name), and the value is a
- * unique pointer to the backend symbol table entry.
+ * The key is the (interned) identifier (variable or function name), and the
+ * value is a unique pointer to the backend symbol table entry.
  */
 using BackendSymbolTable =
-    std::unordered_map<std::string, std::unique_ptr<BackendSymbolTableEntry>>;
+    std::unordered_map<Symbol, std::unique_ptr<BackendSymbolTableEntry>>;
 
 /**
  * Convert a frontend symbol table to a backend symbol table.
@@ -1,6 +1,8 @@
 #include "fixupPass.h"
 #include "../utils/constants.h"
+#include "../utils/threadPool.h"
 #include "assembly.h"
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <stdexcept>
@@ -46,91 +48,55 @@ cloneOperand(const Assembly::Operand *operand) {
     if (operand == nullptr) {
         throw std::logic_error("Cloning null Operand in cloneOperand");
     }
-    if (const auto *immOp =
-            dynamic_cast<const Assembly::ImmediateOperand *>(operand)) {
+    switch (operand->getKind()) {
+    case Assembly::Operand::Kind::Immediate:
         return std::make_unique<Assembly::ImmediateOperand>(
-            immOp->getImmediate());
-    }
-    else if (const auto *regOp =
-                 dynamic_cast<const Assembly::RegisterOperand *>(operand)) {
-        auto *reg = regOp->getRegister();
-        if (dynamic_cast<const Assembly::AX *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::AX>());
-        }
-        if (dynamic_cast<const Assembly::CX *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::CX>());
-        }
-        if (dynamic_cast<const Assembly::DX *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::DX>());
-        }
-        if (dynamic_cast<const Assembly::DI *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::DI>());
-        }
-        if (dynamic_cast<const Assembly::SI *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::SI>());
-        }
-        if (dynamic_cast<const Assembly::R8 *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::R8>());
-        }
-        if (dynamic_cast<const Assembly::R9 *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::R9>());
-        }
-        if (dynamic_cast<const Assembly::R10 *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::R10>());
-        }
-        if (dynamic_cast<const Assembly::R11 *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::R11>());
-        }
-        if (dynamic_cast<const Assembly::SP *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::SP>());
-        }
-        if (dynamic_cast<const Assembly::BP *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::BP>());
-        }
-        const auto &r = *reg;
-        throw std::logic_error("Unsupported register in cloneOperand: " +
-                               std::string(typeid(r).name()));
-    }
-    else if (const auto *stackOp =
-                 dynamic_cast<const Assembly::StackOperand *>(operand)) {
-        auto *reservedReg = stackOp->getReservedRegister();
-        if (dynamic_cast<const Assembly::SP *>(reservedReg) != nullptr) {
+            static_cast<const Assembly::ImmediateOperand *>(operand)
+                ->getImmediate());
+    case Assembly::Operand::Kind::Register:
+        return std::make_unique<Assembly::RegisterOperand>(
+            Assembly::makeRegister(
+                static_cast<const Assembly::RegisterOperand *>(operand)
+                    ->getRegister()
+                    ->getKind()));
+    case Assembly::Operand::Kind::Stack: {
+        const auto *stackOp =
+            static_cast<const Assembly::StackOperand *>(operand);
+        switch (stackOp->getReservedRegister()->getKind()) {
+        case Assembly::Register::Kind::SP:
             return std::make_unique<Assembly::StackOperand>(
                 stackOp->getOffset(), std::make_unique<Assembly::SP>());
-        }
-        if (dynamic_cast<const Assembly::BP *>(reservedReg) != nullptr) {
+        case Assembly::Register::Kind::BP:
             return std::make_unique<Assembly::StackOperand>(
                 stackOp->getOffset(), std::make_unique<Assembly::BP>());
+        default:
+            throw std::logic_error(
+                "Unsupported reserved register in cloneOperand");
         }
-        const auto &r = *reservedReg;
-        throw std::logic_error(
-            "Unsupported reserved register in cloneOperand: " +
-            std::string(typeid(r).name()));
-    }
-    else if (const auto *dataOp =
-                 dynamic_cast<const Assembly::DataOperand *>(operand)) {
-        return std::make_unique<Assembly::DataOperand>(dataOp->getIdentifier());
     }
-    else if (const auto *pseudoOp =
-                 dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                     operand)) {
+    case Assembly::Operand::Kind::Data:
+        return std::make_unique<Assembly::DataOperand>(
+            static_cast<const Assembly::DataOperand *>(operand)
+                ->getIdentifier());
+    case Assembly::Operand::Kind::PseudoRegister:
         return std::make_unique<Assembly::PseudoRegisterOperand>(
-            pseudoOp->getPseudoRegister());
+            static_cast<const Assembly::PseudoRegisterOperand *>(operand)
+                ->getSymbol());
     }
-    const auto &r = *operand;
-    throw std::logic_error("Unsupported Operand in cloneOperand: " +
-                           std::string(typeid(r).name()));
+    throw std::logic_error("Unsupported Operand in cloneOperand");
+}
+
+/**
+ * Check whether an assembly operand is a memory-address operand (i.e., a stack
+ * operand or a data operand).
+ *
+ * @param operand The assembly operand to check.
+ * @return True if the operand is a memory-address operand, false otherwise.
+ */
+bool isMemoryOperand(const Assembly::Operand *operand) {
+    const auto kind = operand->getKind();
+    return kind == Assembly::Operand::Kind::Stack ||
+           kind == Assembly::Operand::Kind::Data;
 }
 
 /**
@@ -157,6 +123,23 @@ cloneBinaryOperator(const Assembly::BinaryOperator *binaryOperator) {
              nullptr) {
         return std::make_unique<Assembly::MultiplyOperator>();
     }
+    else if (dynamic_cast<const Assembly::SalOperator *>(binaryOperator) !=
+             nullptr) {
+        return std::make_unique<Assembly::SalOperator>();
+    }
+    else if (dynamic_cast<const Assembly::SarOperator *>(binaryOperator) !=
+             nullptr) {
+        return std::make_unique<Assembly::SarOperator>();
+    }
+    else if (dynamic_cast<const Assembly::ShrOperator *>(binaryOperator) !=
+             nullptr) {
+        return std::make_unique<Assembly::ShrOperator>();
+    }
+    else if (const auto *leaOperator =
+                 dynamic_cast<const Assembly::LeaOperator *>(binaryOperator)) {
+        return std::make_unique<Assembly::LeaOperator>(
+            leaOperator->getScale());
+    }
     const auto &r = *binaryOperator;
     throw std::logic_error(
         "Unsupported BinaryOperator in cloneBinaryOperator: " +
@@ -165,13 +148,18 @@ cloneBinaryOperator(const Assembly::BinaryOperator *binaryOperator) {
 } // namespace
 
 namespace Assembly {
-void FixupPass::fixup(std::vector<std::unique_ptr<TopLevel>> &topLevels) {
+void FixupPass::fixup(std::vector<std::unique_ptr<TopLevel>> &topLevels,
+                      ThreadPool &threadPool) {
+    std::vector<FunctionDefinition *> functionDefinitions;
     for (auto &topLevel : topLevels) {
         if (auto *functionDefinition =
                 dynamic_cast<FunctionDefinition *>(topLevel.get())) {
-            rewriteFunctionDefinition(*functionDefinition);
+            functionDefinitions.emplace_back(functionDefinition);
         }
     }
+    threadPool.parallelFor(functionDefinitions.size(), [&](std::size_t index) {
+        rewriteFunctionDefinition(*functionDefinitions[index]);
+    });
 }
 
 void FixupPass::insertAllocateStackInstruction(
@@ -201,76 +189,87 @@ void FixupPass::rewriteFunctionDefinition(
     // Traverse the instructions (associated with (included in) the
     // function) and rewrite invalid instructions.
     for (auto it = instructions.begin(); it != instructions.end(); ++it) {
-        if (auto *movInstr =
-                dynamic_cast<Assembly::MovInstruction *>(it->get())) {
+        switch ((*it)->getKind()) {
+        case Instruction::Kind::Mov: {
+            auto &movInstr = static_cast<MovInstruction &>(**it);
             // If the mov instruction is invalid, rewrite it.
             // Replace the invalid `mov` instruction with two valid ones using
             // R10.
             // Replace the iterator with the new iterator returned by
             // `rewriteInvalidMov`.
-            if (isInvalidMov(*movInstr)) {
-                it = rewriteInvalidMov(instructions, it, *movInstr);
+            if (isInvalidMov(movInstr)) {
+                it = rewriteInvalidMov(instructions, it, movInstr);
             }
             // Check for large immediate values in mov instructions.
-            else if (isInvalidLargeImmediateMov(*movInstr)) {
+            else if (isInvalidLargeImmediateMov(movInstr)) {
                 it = rewriteInvalidLargeImmediateMov(instructions, it,
-                                                     *movInstr);
+                                                     movInstr);
             }
             // Check for 8-byte immediate values in movl instructions.
-            else if (isInvalidLongwordImmediateMov(*movInstr)) {
+            else if (isInvalidLongwordImmediateMov(movInstr)) {
                 it = rewriteInvalidLongwordImmediateMov(instructions, it,
-                                                        *movInstr);
+                                                        movInstr);
             }
+            break;
         }
-        else if (auto *movsxInstr =
-                     dynamic_cast<Assembly::MovsxInstruction *>(it->get())) {
-            if (isInvalidMovsx(*movsxInstr)) {
-                it = rewriteInvalidMovsx(instructions, it, *movsxInstr);
+        case Instruction::Kind::Movsx: {
+            auto &movsxInstr = static_cast<MovsxInstruction &>(**it);
+            if (isInvalidMovsx(movsxInstr)) {
+                it = rewriteInvalidMovsx(instructions, it, movsxInstr);
             }
+            break;
         }
-        else if (auto *binInstr =
-                     dynamic_cast<Assembly::BinaryInstruction *>(it->get())) {
-            if (isInvalidLargeImmediateBinary(*binInstr)) {
+        case Instruction::Kind::Binary: {
+            auto &binInstr = static_cast<BinaryInstruction &>(**it);
+            if (isInvalidLargeImmediateBinary(binInstr)) {
                 it = rewriteInvalidLargeImmediateBinary(instructions, it,
-                                                        *binInstr);
+                                                        binInstr);
             }
-            else if (isInvalidBinary(*binInstr)) {
-                it = rewriteInvalidBinary(instructions, it, *binInstr);
+            else if (isInvalidBinary(binInstr)) {
+                it = rewriteInvalidBinary(instructions, it, binInstr);
             }
+            break;
         }
-        else if (auto *idivInstr =
-                     dynamic_cast<Assembly::IdivInstruction *>(it->get())) {
-            if (isInvalidIdiv(*idivInstr)) {
-                it = rewriteInvalidIdiv(instructions, it, *idivInstr);
+        case Instruction::Kind::Idiv: {
+            auto &idivInstr = static_cast<IdivInstruction &>(**it);
+            if (isInvalidIdiv(idivInstr)) {
+                it = rewriteInvalidIdiv(instructions, it, idivInstr);
             }
+            break;
         }
-        else if (auto *divInstr =
-                     dynamic_cast<Assembly::DivInstruction *>(it->get())) {
-            if (isInvalidDiv(*divInstr)) {
-                it = rewriteInvalidDiv(instructions, it, *divInstr);
+        case Instruction::Kind::Div: {
+            auto &divInstr = static_cast<DivInstruction &>(**it);
+            if (isInvalidDiv(divInstr)) {
+                it = rewriteInvalidDiv(instructions, it, divInstr);
             }
+            break;
         }
-        else if (auto *movZeroExtendInstr =
-                     dynamic_cast<Assembly::MovZeroExtendInstruction *>(
-                         it->get())) {
-            it = rewriteMovZeroExtend(instructions, it, *movZeroExtendInstr);
-        }
-        else if (auto *cmpInstr =
-                     dynamic_cast<Assembly::CmpInstruction *>(it->get())) {
-            if (isInvalidLargeImmediateCmp(*cmpInstr)) {
+        case Instruction::Kind::MovZeroExtend:
+            it = rewriteMovZeroExtend(
+                instructions, it,
+                static_cast<MovZeroExtendInstruction &>(**it));
+            break;
+        case Instruction::Kind::Cmp: {
+            auto &cmpInstr = static_cast<CmpInstruction &>(**it);
+            if (isInvalidLargeImmediateCmp(cmpInstr)) {
                 it = rewriteInvalidLargeImmediateCmp(instructions, it,
-                                                     *cmpInstr);
+                                                     cmpInstr);
             }
-            else if (isInvalidCmp(*cmpInstr)) {
-                it = rewriteInvalidCmp(instructions, it, *cmpInstr);
+            else if (isInvalidCmp(cmpInstr)) {
+                it = rewriteInvalidCmp(instructions, it, cmpInstr);
             }
+            break;
         }
-        else if (auto *pushInstr =
-                     dynamic_cast<Assembly::PushInstruction *>(it->get())) {
-            if (isInvalidLargeImmediatePush(*pushInstr)) {
+        case Instruction::Kind::Push: {
+            auto &pushInstr = static_cast<PushInstruction &>(**it);
+            if (isInvalidLargeImmediatePush(pushInstr)) {
                 it = rewriteInvalidLargeImmediatePush(instructions, it,
-                                                      *pushInstr);
+                                                      pushInstr);
             }
+            break;
+        }
+        default:
+            break;
         }
     }
 }
@@ -280,10 +279,7 @@ bool FixupPass::isInvalidMov(const Assembly::MovInstruction &movInstr) {
     // operands).
     const auto *src = movInstr.getSrc();
     const auto *dst = movInstr.getDst();
-    return (dynamic_cast<const Assembly::StackOperand *>(src) != nullptr ||
-            dynamic_cast<const Assembly::DataOperand *>(src) != nullptr) &&
-           (dynamic_cast<const Assembly::StackOperand *>(dst) != nullptr ||
-            dynamic_cast<const Assembly::DataOperand *>(dst) != nullptr);
+    return isMemoryOperand(src) && isMemoryOperand(dst);
 }
 
 bool FixupPass::isInvalidLargeImmediateMov(
@@ -301,11 +297,7 @@ bool FixupPass::isInvalidLargeImmediateMov(
         return false;
     }
 
-    auto memoryDst =
-        (dynamic_cast<const Assembly::StackOperand *>(movInstr.getDst()) !=
-         nullptr) ||
-        (dynamic_cast<const Assembly::DataOperand *>(movInstr.getDst()) !=
-         nullptr);
+    auto memoryDst = isMemoryOperand(movInstr.getDst());
     if (!memoryDst) {
         return false;
     }
@@ -341,13 +333,9 @@ bool FixupPass::isInvalidLongwordImmediateMov(
 bool FixupPass::isInvalidMovsx(const Assembly::MovsxInstruction &movsxInstr) {
     // Movsx can't use a memory address as a destination or an immediate value
     // as a source.
-    const bool invalidSrc = dynamic_cast<const Assembly::ImmediateOperand *>(
-                                movsxInstr.getSrc()) != nullptr;
-    const bool invalidDst =
-        dynamic_cast<const Assembly::StackOperand *>(movsxInstr.getDst()) !=
-            nullptr ||
-        dynamic_cast<const Assembly::DataOperand *>(movsxInstr.getDst()) !=
-            nullptr;
+    const bool invalidSrc = movsxInstr.getSrc()->getKind() ==
+                            Assembly::Operand::Kind::Immediate;
+    const bool invalidDst = isMemoryOperand(movsxInstr.getDst());
     return invalidSrc || invalidDst;
 }
 
@@ -356,21 +344,19 @@ bool FixupPass::isInvalidBinary(const Assembly::BinaryInstruction &binInstr) {
              binInstr.getBinaryOperator()) != nullptr) ||
         (dynamic_cast<const Assembly::SubtractOperator *>(
              binInstr.getBinaryOperator()) != nullptr)) {
-        return (dynamic_cast<const Assembly::StackOperand *>(
-                    binInstr.getOperand1()) != nullptr ||
-                dynamic_cast<const Assembly::DataOperand *>(
-                    binInstr.getOperand1()) != nullptr) &&
-               (dynamic_cast<const Assembly::StackOperand *>(
-                    binInstr.getOperand2()) != nullptr ||
-                dynamic_cast<const Assembly::DataOperand *>(
-                    binInstr.getOperand2()) != nullptr);
+        return isMemoryOperand(binInstr.getOperand1()) &&
+               isMemoryOperand(binInstr.getOperand2());
     }
     else if (dynamic_cast<const Assembly::MultiplyOperator *>(
                  binInstr.getBinaryOperator()) != nullptr) {
-        return dynamic_cast<const Assembly::StackOperand *>(
-                   binInstr.getOperand2()) != nullptr ||
-               dynamic_cast<const Assembly::DataOperand *>(
-                   binInstr.getOperand2()) != nullptr;
+        return isMemoryOperand(binInstr.getOperand2());
+    }
+    else if (dynamic_cast<const Assembly::LeaOperator *>(
+                 binInstr.getBinaryOperator()) != nullptr) {
+        return binInstr.getOperand1()->getKind() !=
+                   Assembly::Operand::Kind::Register ||
+               binInstr.getOperand2()->getKind() !=
+                   Assembly::Operand::Kind::Register;
     }
     return false;
 }
@@ -422,16 +408,10 @@ bool FixupPass::isInvalidDiv(const Assembly::DivInstruction &divInstr) {
 bool FixupPass::isInvalidCmp(const Assembly::CmpInstruction &cmpInstr) {
     // If either both operands are memory-address operands or the second operand
     // is an immediate value, the `cmp` instruction is invalid.
-    return (((dynamic_cast<const Assembly::StackOperand *>(
-                  cmpInstr.getOperand1()) != nullptr) ||
-             (dynamic_cast<const Assembly::DataOperand *>(
-                  cmpInstr.getOperand1()) != nullptr)) &&
-            ((dynamic_cast<const Assembly::StackOperand *>(
-                  cmpInstr.getOperand2()) != nullptr) ||
-             (dynamic_cast<const Assembly::DataOperand *>(
-                  cmpInstr.getOperand2()) != nullptr))) ||
-           ((dynamic_cast<const Assembly::ImmediateOperand *>(
-                cmpInstr.getOperand2())) != nullptr);
+    return (isMemoryOperand(cmpInstr.getOperand1()) &&
+            isMemoryOperand(cmpInstr.getOperand2())) ||
+           cmpInstr.getOperand2()->getKind() ==
+               Assembly::Operand::Kind::Immediate;
 }
 
 bool FixupPass::isInvalidLargeImmediateCmp(
@@ -512,10 +492,8 @@ FixupPass::rewriteInvalidMovsx(
     const auto *dst = movsxInst.getDst();
 
     const bool invalidSrc =
-        dynamic_cast<const Assembly::ImmediateOperand *>(src) != nullptr;
-    const bool invalidDst =
-        dynamic_cast<const Assembly::StackOperand *>(dst) != nullptr ||
-        dynamic_cast<const Assembly::DataOperand *>(dst) != nullptr;
+        src->getKind() == Assembly::Operand::Kind::Immediate;
+    const bool invalidDst = isMemoryOperand(dst);
 
     if (invalidSrc && invalidDst) {
         auto newMov1 = std::make_unique<Assembly::MovInstruction>(
@@ -612,6 +590,35 @@ FixupPass::rewriteInvalidBinary(
         it = instructions.insert(it + 1, std::move(newImul));
         it = instructions.insert(it + 1, std::move(newMov2));
     }
+    else if (dynamic_cast<const Assembly::LeaOperator *>(
+                 binInstr.getBinaryOperator()) != nullptr) {
+        auto newMov1 = std::make_unique<Assembly::MovInstruction>(
+            cloneAssemblyType(binInstr.getType()),
+            cloneOperand(binInstr.getOperand1()),
+            std::make_unique<Assembly::RegisterOperand>(
+                std::make_unique<Assembly::R10>()));
+        auto newMov2 = std::make_unique<Assembly::MovInstruction>(
+            cloneAssemblyType(binInstr.getType()),
+            cloneOperand(binInstr.getOperand2()),
+            std::make_unique<Assembly::RegisterOperand>(
+                std::make_unique<Assembly::R11>()));
+        auto newLea = std::make_unique<Assembly::BinaryInstruction>(
+            cloneBinaryOperator(binInstr.getBinaryOperator()),
+            cloneAssemblyType(binInstr.getType()),
+            std::make_unique<Assembly::RegisterOperand>(
+                std::make_unique<Assembly::R10>()),
+            std::make_unique<Assembly::RegisterOperand>(
+                std::make_unique<Assembly::R11>()));
+        auto newMov3 = std::make_unique<Assembly::MovInstruction>(
+            cloneAssemblyType(binInstr.getType()),
+            std::make_unique<Assembly::RegisterOperand>(
+                std::make_unique<Assembly::R11>()),
+            cloneOperand(binInstr.getOperand2()));
+        *it = std::move(newMov1);
+        it = instructions.insert(it + 1, std::move(newMov2));
+        it = instructions.insert(it + 1, std::move(newLea));
+        it = instructions.insert(it + 1, std::move(newMov3));
+    }
 
     return it;
 }
@@ -693,14 +700,8 @@ FixupPass::rewriteInvalidCmp(
     std::vector<std::unique_ptr<Assembly::Instruction>> &instructions,
     std::vector<std::unique_ptr<Assembly::Instruction>>::iterator it,
     const Assembly::CmpInstruction &cmpInstr) {
-    if (((dynamic_cast<const Assembly::StackOperand *>(
-              cmpInstr.getOperand1()) != nullptr) ||
-         (dynamic_cast<const Assembly::DataOperand *>(cmpInstr.getOperand1()) !=
-          nullptr)) &&
-        ((dynamic_cast<const Assembly::StackOperand *>(
-              cmpInstr.getOperand2()) != nullptr) ||
-         (dynamic_cast<const Assembly::DataOperand *>(cmpInstr.getOperand2()) !=
-          nullptr))) {
+    if (isMemoryOperand(cmpInstr.getOperand1()) &&
+        isMemoryOperand(cmpInstr.getOperand2())) {
         auto newMov = std::make_unique<Assembly::MovInstruction>(
             cloneAssemblyType(cmpInstr.getType()),
             cloneOperand(cmpInstr.getOperand1()),
@@ -795,9 +796,7 @@ FixupPass::rewriteInvalidLargeImmediateBinary(
         isFirstOperand = false;
     }
 
-    const bool otherIsMemory =
-        (dynamic_cast<const Assembly::StackOperand *>(otherOp) != nullptr) ||
-        (dynamic_cast<const Assembly::DataOperand *>(otherOp) != nullptr);
+    const bool otherIsMemory = isMemoryOperand(otherOp);
     auto otherOpCloneForLoad = otherIsMemory ? cloneOperand(otherOp) : nullptr;
     auto otherOpCloneForBin = cloneOperand(otherOp);
     auto otherOpCloneForStore = otherIsMemory ? cloneOperand(otherOp) : nullptr;
@@ -1,6 +1,7 @@
 #ifndef BACKEND_FIXUP_PASS_H
 #define BACKEND_FIXUP_PASS_H
 
+#include "../utils/threadPool.h"
 #include "assembly.h"
 #include <memory>
 #include <vector>
@@ -14,9 +15,15 @@ class FixupPass {
     /**
      * Perform fixup passes on the assembly program.
      *
+     * The function definitions are rewritten independently on the threads of
+     * the thread pool.
+     *
      * @param topLevels The top-levels of the assembly program.
+     * @param threadPool The thread pool to rewrite the function definitions
+     * on.
      */
-    static void fixup(std::vector<std::unique_ptr<TopLevel>> &topLevels);
+    static void fixup(std::vector<std::unique_ptr<TopLevel>> &topLevels,
+                      ThreadPool &threadPool);
 
   private:
     /**
@@ -230,6 +237,10 @@ class FixupPass {
      * `Mov(Quadword, Stack/Data, Reg(R10))` + `Binary(op, Quadword, Reg(R10),
      * Stack/Data)`.
      *
+     * Rewrite: `Binary(Lea, op1, op2)` (with a non-register operand) ->
+     * `Mov(op1, Reg(R10))` + `Mov(op2, Reg(R11))` +
+     * `Binary(Lea, Reg(R10), Reg(R11))` + `Mov(Reg(R11), op2)`.
+     *
      * @param instructions The instructions of the function.
      * @param it The iterator to the binary instruction.
      * @param binInstr The binary instruction to rewrite.
@@ -1,5 +1,6 @@
 #include "pseudoToStackPass.h"
 #include "../utils/constants.h"
+#include "../utils/threadPool.h"
 #include "assembly.h"
 #include "backendSymbolTable.h"
 #include <cassert>
@@ -13,49 +14,58 @@
 namespace Assembly {
 void PseudoToStackPass::replacePseudoWithStackAndAssociateStackSize(
     std::vector<std::unique_ptr<TopLevel>> &topLevels,
-    const BackendSymbolTable &backendSymbolTable) {
-    // Replace pseudo registers with stack operands in each instruction and
-    // associate the stack size with each function.
+    const BackendSymbolTable &backendSymbolTable, ThreadPool &threadPool) {
+    std::vector<Assembly::FunctionDefinition *> functionDefinitions;
     for (auto &topLevel : topLevels) {
         if (auto *functionDefinition =
                 dynamic_cast<Assembly::FunctionDefinition *>(topLevel.get())) {
-            // Reset offset and clear map for each function.
-            this->offset = 0;
-            this->pseudoToStackMap.clear();
-
-            // Replace pseudo registers with stack operands in each instruction.
-            for (auto &instruction : functionDefinition->getFunctionBody()) {
-                replacePseudoWithStack(instruction, backendSymbolTable);
-            }
-
-            // Set the stack size for the function.
-            functionDefinition->setStackSize(
-                static_cast<size_t>(-this->offset));
+            functionDefinitions.emplace_back(functionDefinition);
         }
     }
 
+    // Replace pseudo registers with stack operands in each instruction and
+    // associate the stack size with each function.
+    threadPool.parallelFor(functionDefinitions.size(), [&](std::size_t index) {
+        replacePseudoWithStackInFunctionDefinition(*functionDefinitions[index],
+                                                   backendSymbolTable);
+    });
+
     // Check that all pseudo registers have been replaced.
-    for (const auto &topLevel : topLevels) {
-        if (auto *functionDefinition =
-                dynamic_cast<Assembly::FunctionDefinition *>(topLevel.get())) {
-            checkPseudoRegistersInFunctionDefinitionReplaced(
-                *functionDefinition);
-        }
+    for (const auto *functionDefinition : functionDefinitions) {
+        checkPseudoRegistersInFunctionDefinitionReplaced(*functionDefinition);
     }
 }
 
+void PseudoToStackPass::replacePseudoWithStackInFunctionDefinition(
+    FunctionDefinition &functionDefinition,
+    const BackendSymbolTable &backendSymbolTable) {
+    // Start a fresh stack frame for the function.
+    StackFrame stackFrame;
+
+    // Replace pseudo registers with stack operands in each instruction.
+    for (auto &instruction : functionDefinition.getFunctionBody()) {
+        replacePseudoWithStack(instruction, backendSymbolTable, stackFrame);
+    }
+
+    // Set the stack size for the function.
+    functionDefinition.setStackSize(
+        static_cast<std::size_t>(-stackFrame.offset));
+}
+
 std::unique_ptr<Assembly::Operand> PseudoToStackPass::replaceOperand(
     const Assembly::Operand *operand,
-    const BackendSymbolTable &backendSymbolTable) {
+    const BackendSymbolTable &backendSymbolTable, StackFrame &stackFrame) {
     if (operand == nullptr) {
         throw std::logic_error(
             "Setting null operand in replaceOperand in PseudoToStackPass");
     }
 
-    if (const auto *pseudoReg =
-            dynamic_cast<const Assembly::PseudoRegisterOperand *>(operand)) {
-        const std::string &pseudoRegister = pseudoReg->getPseudoRegister();
-        if (!this->pseudoToStackMap.contains(pseudoRegister)) {
+    switch (operand->getKind()) {
+    case Assembly::Operand::Kind::PseudoRegister: {
+        const auto pseudoRegister =
+            static_cast<const Assembly::PseudoRegisterOperand *>(operand)
+                ->getSymbol();
+        if (!stackFrame.pseudoToStackMap.contains(pseudoRegister)) {
             // If a pseudoregister is not in `pseudoToStackMap`, look it up in
             // the backend symbol table.
             auto backendSymbolTableItForAlloc =
@@ -68,7 +78,7 @@ std::unique_ptr<Assembly::Operand> PseudoToStackPass::replaceOperand(
                         dynamic_cast<ObjEntry *>(backendEntry.get())) {
                     if (objEntry->isStaticStorage()) {
                         return std::make_unique<Assembly::DataOperand>(
-                            pseudoRegister);
+                            pseudoRegister.str());
                     }
                 }
             }
@@ -99,7 +109,7 @@ std::unique_ptr<Assembly::Operand> PseudoToStackPass::replaceOperand(
             // type `Quadword`).
             if (allocationSize == QUADWORD_SIZE) {
                 // Compute the (negative) remainder when offset is divided by 8.
-                const int rem = this->offset % QUADWORD_SIZE;
+                const int rem = stackFrame.offset % QUADWORD_SIZE;
                 // If it's not aligned, round down the (negative) offset to the
                 // next 8-byte boundary.
                 if (rem != 0) {
@@ -107,348 +117,298 @@ std::unique_ptr<Assembly::Operand> PseudoToStackPass::replaceOperand(
                     // subtracting `8 - |rem|` where `rem` is negative, which
                     // moves the negative offset down to the next lower multiple
                     // of 8.
-                    this->offset -= (QUADWORD_SIZE + rem);
+                    stackFrame.offset -= (QUADWORD_SIZE + rem);
                 }
             }
 
             // Update the offset to the next available stack slot.
-            this->offset -= allocationSize;
+            stackFrame.offset -= allocationSize;
             // Update the `pseudoToStackMap` with the new offset.
-            this->pseudoToStackMap[pseudoRegister] = this->offset;
+            stackFrame.pseudoToStackMap[pseudoRegister] = stackFrame.offset;
         }
 
         // Replace the pseudo register with a stack operand.
         return std::make_unique<Assembly::StackOperand>(
-            this->pseudoToStackMap[pseudoRegister],
+            stackFrame.pseudoToStackMap[pseudoRegister],
             std::make_unique<Assembly::BP>());
     }
-
-    if (const auto *imm =
-            dynamic_cast<const Assembly::ImmediateOperand *>(operand)) {
+    case Assembly::Operand::Kind::Immediate:
         return std::make_unique<Assembly::ImmediateOperand>(
-            imm->getImmediate());
-    }
-
-    if (const auto *regOp =
-            dynamic_cast<const Assembly::RegisterOperand *>(operand)) {
-        auto *reg = regOp->getRegister();
-        if (dynamic_cast<const Assembly::AX *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::AX>());
-        }
-        if (dynamic_cast<const Assembly::CX *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::CX>());
-        }
-        if (dynamic_cast<const Assembly::DX *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::DX>());
-        }
-        if (dynamic_cast<const Assembly::DI *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::DI>());
-        }
-        if (dynamic_cast<const Assembly::SI *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::SI>());
-        }
-        if (dynamic_cast<const Assembly::R8 *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::R8>());
-        }
-        if (dynamic_cast<const Assembly::R9 *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::R9>());
-        }
-        if (dynamic_cast<const Assembly::R10 *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::R10>());
-        }
-        if (dynamic_cast<const Assembly::R11 *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::R11>());
-        }
-        if (dynamic_cast<const Assembly::SP *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::SP>());
-        }
-        if (dynamic_cast<const Assembly::BP *>(reg) != nullptr) {
-            return std::make_unique<Assembly::RegisterOperand>(
-                std::make_unique<Assembly::BP>());
-        }
-        const auto &r = *reg;
-        throw std::logic_error("Unsupported register while replacing operand "
-                               "in replaceOperand in PseudoToStackPass: " +
-                               std::string(typeid(r).name()));
-    }
-
-    if (const auto *stackOp =
-            dynamic_cast<const Assembly::StackOperand *>(operand)) {
-        auto *reservedReg = stackOp->getReservedRegister();
-        if (dynamic_cast<const Assembly::SP *>(reservedReg) != nullptr) {
+            static_cast<const Assembly::ImmediateOperand *>(operand)
+                ->getImmediate());
+    case Assembly::Operand::Kind::Register:
+        return std::make_unique<Assembly::RegisterOperand>(
+            Assembly::makeRegister(
+                static_cast<const Assembly::RegisterOperand *>(operand)
+                    ->getRegister()
+                    ->getKind()));
+    case Assembly::Operand::Kind::Stack: {
+        const auto *stackOp =
+            static_cast<const Assembly::StackOperand *>(operand);
+        switch (stackOp->getReservedRegister()->getKind()) {
+        case Assembly::Register::Kind::SP:
             return std::make_unique<Assembly::StackOperand>(
                 stackOp->getOffset(), std::make_unique<Assembly::SP>());
-        }
-        if (dynamic_cast<const Assembly::BP *>(reservedReg) != nullptr) {
+        case Assembly::Register::Kind::BP:
             return std::make_unique<Assembly::StackOperand>(
                 stackOp->getOffset(), std::make_unique<Assembly::BP>());
+        default:
+            throw std::logic_error(
+                "Unsupported reserved register while replacing operand in "
+                "replaceOperand in PseudoToStackPass");
         }
-        const auto &r = *reservedReg;
-        throw std::logic_error(
-            "Unsupported reserved register while replacing operand in "
-            "replaceOperand in PseudoToStackPass: " +
-            std::string(typeid(r).name()));
     }
-
-    if (const auto *dataOp =
-            dynamic_cast<const Assembly::DataOperand *>(operand)) {
-        return std::make_unique<Assembly::DataOperand>(dataOp->getIdentifier());
+    case Assembly::Operand::Kind::Data:
+        return std::make_unique<Assembly::DataOperand>(
+            static_cast<const Assembly::DataOperand *>(operand)
+                ->getIdentifier());
     }
-
-    const auto &r = *operand;
     throw std::logic_error(
-        "Unsupported operand type in replaceOperand in PseudoToStackPass: " +
-        std::string(typeid(r).name()));
+        "Unsupported operand type in replaceOperand in PseudoToStackPass");
 }
 
 void PseudoToStackPass::replacePseudoWithStack(
     std::unique_ptr<Assembly::Instruction> &instruction,
-    const BackendSymbolTable &backendSymbolTable) {
-    if (auto *movInstruction =
-            dynamic_cast<Assembly::MovInstruction *>(instruction.get())) {
-        auto newSrc =
-            replaceOperand(movInstruction->getSrc(), backendSymbolTable);
-        auto newDst =
-            replaceOperand(movInstruction->getDst(), backendSymbolTable);
+    const BackendSymbolTable &backendSymbolTable, StackFrame &stackFrame) {
+    switch (instruction->getKind()) {
+    case Assembly::Instruction::Kind::Mov: {
+        auto *movInstruction =
+            static_cast<Assembly::MovInstruction *>(instruction.get());
+        auto newSrc = replaceOperand(movInstruction->getSrc(),
+                                     backendSymbolTable, stackFrame);
+        auto newDst = replaceOperand(movInstruction->getDst(),
+                                     backendSymbolTable, stackFrame);
         movInstruction->setSrc(std::move(newSrc));
         movInstruction->setDst(std::move(newDst));
+        break;
     }
-    else if (auto *movsxInstruction =
-                 dynamic_cast<Assembly::MovsxInstruction *>(
-                     instruction.get())) {
-        auto newSrc =
-            replaceOperand(movsxInstruction->getSrc(), backendSymbolTable);
-        auto newDst =
-            replaceOperand(movsxInstruction->getDst(), backendSymbolTable);
+    case Assembly::Instruction::Kind::Movsx: {
+        auto *movsxInstruction =
+            static_cast<Assembly::MovsxInstruction *>(instruction.get());
+        auto newSrc = replaceOperand(movsxInstruction->getSrc(),
+                                     backendSymbolTable, stackFrame);
+        auto newDst = replaceOperand(movsxInstruction->getDst(),
+                                     backendSymbolTable, stackFrame);
         movsxInstruction->setSrc(std::move(newSrc));
         movsxInstruction->setDst(std::move(newDst));
+        break;
     }
-    else if (auto *movZeroExtendInstruction =
-                 dynamic_cast<Assembly::MovZeroExtendInstruction *>(
-                     instruction.get())) {
+    case Assembly::Instruction::Kind::MovZeroExtend: {
+        auto *movZeroExtendInstruction =
+            static_cast<Assembly::MovZeroExtendInstruction *>(
+                instruction.get());
         auto newSrc = replaceOperand(movZeroExtendInstruction->getSrc(),
-                                     backendSymbolTable);
+                                     backendSymbolTable, stackFrame);
         auto newDst = replaceOperand(movZeroExtendInstruction->getDst(),
-                                     backendSymbolTable);
+                                     backendSymbolTable, stackFrame);
         movZeroExtendInstruction->setSrc(std::move(newSrc));
         movZeroExtendInstruction->setDst(std::move(newDst));
+        break;
     }
-    else if (auto *unaryInstruction =
-                 dynamic_cast<Assembly::UnaryInstruction *>(
-                     instruction.get())) {
-        auto newOperand =
-            replaceOperand(unaryInstruction->getOperand(), backendSymbolTable);
+    case Assembly::Instruction::Kind::Unary: {
+        auto *unaryInstruction =
+            static_cast<Assembly::UnaryInstruction *>(instruction.get());
+        auto newOperand = replaceOperand(unaryInstruction->getOperand(),
+                                         backendSymbolTable, stackFrame);
         unaryInstruction->setOperand(std::move(newOperand));
+        break;
     }
-    else if (auto *binaryInstruction =
-                 dynamic_cast<Assembly::BinaryInstruction *>(
-                     instruction.get())) {
+    case Assembly::Instruction::Kind::Binary: {
+        auto *binaryInstruction =
+            static_cast<Assembly::BinaryInstruction *>(instruction.get());
         auto newOperand1 = replaceOperand(binaryInstruction->getOperand1(),
-                                          backendSymbolTable);
+                                          backendSymbolTable, stackFrame);
         auto newOperand2 = replaceOperand(binaryInstruction->getOperand2(),
-                                          backendSymbolTable);
+                                          backendSymbolTable, stackFrame);
         binaryInstruction->setOperand1(std::move(newOperand1));
         binaryInstruction->setOperand2(std::move(newOperand2));
+        break;
     }
-    else if (auto *cmpInstruction =
-                 dynamic_cast<Assembly::CmpInstruction *>(instruction.get())) {
-        auto newOperand1 =
-            replaceOperand(cmpInstruction->getOperand1(), backendSymbolTable);
-        auto newOperand2 =
-            replaceOperand(cmpInstruction->getOperand2(), backendSymbolTable);
+    case Assembly::Instruction::Kind::Cmp: {
+        auto *cmpInstruction =
+            static_cast<Assembly::CmpInstruction *>(instruction.get());
+        auto newOperand1 = replaceOperand(cmpInstruction->getOperand1(),
+                                          backendSymbolTable, stackFrame);
+        auto newOperand2 = replaceOperand(cmpInstruction->getOperand2(),
+                                          backendSymbolTable, stackFrame);
         cmpInstruction->setOperand1(std::move(newOperand1));
         cmpInstruction->setOperand2(std::move(newOperand2));
+        break;
     }
-    else if (auto *idivInstruction =
-                 dynamic_cast<Assembly::IdivInstruction *>(instruction.get())) {
-        auto newOperand =
-            replaceOperand(idivInstruction->getOperand(), backendSymbolTable);
+    case Assembly::Instruction::Kind::Idiv: {
+        auto *idivInstruction =
+            static_cast<Assembly::IdivInstruction *>(instruction.get());
+        auto newOperand = replaceOperand(idivInstruction->getOperand(),
+                                         backendSymbolTable, stackFrame);
         idivInstruction->setOperand(std::move(newOperand));
+        break;
     }
-    else if (auto *divInstruction =
-                 dynamic_cast<Assembly::DivInstruction *>(instruction.get())) {
-        auto newOperand =
-            replaceOperand(divInstruction->getOperand(), backendSymbolTable);
+    case Assembly::Instruction::Kind::Div: {
+        auto *divInstruction =
+            static_cast<Assembly::DivInstruction *>(instruction.get());
+        auto newOperand = replaceOperand(divInstruction->getOperand(),
+                                         backendSymbolTable, stackFrame);
         divInstruction->setOperand(std::move(newOperand));
+        break;
     }
-    else if (auto *setCCInstruction =
-                 dynamic_cast<Assembly::SetCCInstruction *>(
-                     instruction.get())) {
-        auto newOperand =
-            replaceOperand(setCCInstruction->getOperand(), backendSymbolTable);
-        setCCInstruction->setOperand(std::move(newOperand));
-    }
-    else if (auto *pushInstruction =
-                 dynamic_cast<Assembly::PushInstruction *>(instruction.get())) {
-        auto newOperand =
-            replaceOperand(pushInstruction->getOperand(), backendSymbolTable);
-        pushInstruction->setOperand(std::move(newOperand));
-    }
-    else if (auto *retInstruction =
-                 dynamic_cast<Assembly::RetInstruction *>(instruction.get())) {
-        (void)retInstruction;
+    case Assembly::Instruction::Kind::Imul: {
+        auto *imulInstruction =
+            static_cast<Assembly::ImulInstruction *>(instruction.get());
+        auto newOperand = replaceOperand(imulInstruction->getOperand(),
+                                         backendSymbolTable, stackFrame);
+        imulInstruction->setOperand(std::move(newOperand));
+        break;
     }
-    else if (auto *callInstruction =
-                 dynamic_cast<Assembly::CallInstruction *>(instruction.get())) {
-        (void)callInstruction;
+    case Assembly::Instruction::Kind::Mul: {
+        auto *mulInstruction =
+            static_cast<Assembly::MulInstruction *>(instruction.get());
+        auto newOperand = replaceOperand(mulInstruction->getOperand(),
+                                         backendSymbolTable, stackFrame);
+        mulInstruction->setOperand(std::move(newOperand));
+        break;
     }
-    else if (auto *cdqInstruction =
-                 dynamic_cast<Assembly::CdqInstruction *>(instruction.get())) {
-        (void)cdqInstruction;
-    }
-    else if (auto *jmpInstruction =
-                 dynamic_cast<Assembly::JmpInstruction *>(instruction.get())) {
-        (void)jmpInstruction;
-    }
-    else if (auto *jmpCCInstruction =
-                 dynamic_cast<Assembly::JmpCCInstruction *>(
-                     instruction.get())) {
-        (void)jmpCCInstruction;
+    case Assembly::Instruction::Kind::SetCC: {
+        auto *setCCInstruction =
+            static_cast<Assembly::SetCCInstruction *>(instruction.get());
+        auto newOperand = replaceOperand(setCCInstruction->getOperand(),
+                                         backendSymbolTable, stackFrame);
+        setCCInstruction->setOperand(std::move(newOperand));
+        break;
     }
-    else if (auto *labelInstruction =
-                 dynamic_cast<Assembly::LabelInstruction *>(
-                     instruction.get())) {
-        (void)labelInstruction;
+    case Assembly::Instruction::Kind::Push: {
+        auto *pushInstruction =
+            static_cast<Assembly::PushInstruction *>(instruction.get());
+        auto newOperand = replaceOperand(pushInstruction->getOperand(),
+                                         backendSymbolTable, stackFrame);
+        pushInstruction->setOperand(std::move(newOperand));
+        break;
     }
-    else {
-        const auto &r = *instruction;
+    case Assembly::Instruction::Kind::Ret:
+    case Assembly::Instruction::Kind::Call:
+    case Assembly::Instruction::Kind::Cdq:
+    case Assembly::Instruction::Kind::Jmp:
+    case Assembly::Instruction::Kind::JmpCC:
+    case Assembly::Instruction::Kind::Label:
+        // These instructions have no operands that can be pseudo registers.
+        break;
+    default:
         throw std::logic_error("Unsupported instruction type while replacing "
                                "pseudo registers with stack operands in "
-                               "replacePseudoWithStack in PseudoToStackPass: " +
-                               std::string(typeid(r).name()));
+                               "replacePseudoWithStack in PseudoToStackPass");
     }
 }
 
 void PseudoToStackPass::checkPseudoRegistersInFunctionDefinitionReplaced(
     const Assembly::FunctionDefinition &functionDefinition) {
+    const auto isPseudoRegisterOperand = [](const Assembly::Operand *operand) {
+        return operand->getKind() == Assembly::Operand::Kind::PseudoRegister;
+    };
     for (const auto &instruction : functionDefinition.getFunctionBody()) {
-        if (auto *movInstruction =
-                dynamic_cast<MovInstruction *>(instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                movInstruction->getSrc()));
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                movInstruction->getDst()));
-            (void)movInstruction;
-        }
-        else if (auto *movsxInstruction =
-                     dynamic_cast<Assembly::MovsxInstruction *>(
-                         instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                movsxInstruction->getSrc()));
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                movsxInstruction->getDst()));
-            (void)movsxInstruction;
-        }
-        else if (auto *movZeroExtendInstruction =
-                     dynamic_cast<Assembly::MovZeroExtendInstruction *>(
-                         instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
+        switch (instruction->getKind()) {
+        case Assembly::Instruction::Kind::Mov: {
+            [[maybe_unused]] const auto *movInstruction =
+                static_cast<const Assembly::MovInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(movInstruction->getSrc()));
+            assert(!isPseudoRegisterOperand(movInstruction->getDst()));
+            break;
+        }
+        case Assembly::Instruction::Kind::Movsx: {
+            [[maybe_unused]] const auto *movsxInstruction =
+                static_cast<const Assembly::MovsxInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(movsxInstruction->getSrc()));
+            assert(!isPseudoRegisterOperand(movsxInstruction->getDst()));
+            break;
+        }
+        case Assembly::Instruction::Kind::MovZeroExtend: {
+            [[maybe_unused]] const auto *movZeroExtendInstruction =
+                static_cast<const Assembly::MovZeroExtendInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(
                 movZeroExtendInstruction->getSrc()));
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
+            assert(!isPseudoRegisterOperand(
                 movZeroExtendInstruction->getDst()));
-            (void)movZeroExtendInstruction;
-        }
-        else if (auto *unaryInstruction =
-                     dynamic_cast<Assembly::UnaryInstruction *>(
-                         instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                unaryInstruction->getOperand()));
-            (void)unaryInstruction;
-        }
-        else if (auto *binaryInstruction =
-                     dynamic_cast<Assembly::BinaryInstruction *>(
-                         instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                binaryInstruction->getOperand1()));
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                binaryInstruction->getOperand2()));
-            (void)binaryInstruction;
-        }
-        else if (auto *cmpInstruction =
-                     dynamic_cast<Assembly::CmpInstruction *>(
-                         instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                cmpInstruction->getOperand1()));
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                cmpInstruction->getOperand2()));
-            (void)cmpInstruction;
-        }
-        else if (auto *idivInstruction =
-                     dynamic_cast<Assembly::IdivInstruction *>(
-                         instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                idivInstruction->getOperand()));
-            (void)idivInstruction;
-        }
-        else if (auto *divInstruction =
-                     dynamic_cast<Assembly::DivInstruction *>(
-                         instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                divInstruction->getOperand()));
-            (void)divInstruction;
-        }
-        else if (auto *setCCInstruction =
-                     dynamic_cast<Assembly::SetCCInstruction *>(
-                         instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                setCCInstruction->getOperand()));
-            (void)setCCInstruction;
-        }
-        else if (auto *pushInstruction =
-                     dynamic_cast<Assembly::PushInstruction *>(
-                         instruction.get())) {
-            assert(!dynamic_cast<const Assembly::PseudoRegisterOperand *>(
-                pushInstruction->getOperand()));
-            (void)pushInstruction;
-        }
-        else if (auto *retInstruction =
-                     dynamic_cast<Assembly::RetInstruction *>(
-                         instruction.get())) {
-            (void)retInstruction;
-        }
-        else if (auto *callInstruction =
-                     dynamic_cast<Assembly::CallInstruction *>(
-                         instruction.get())) {
-            (void)callInstruction;
-        }
-        else if (auto *cdqInstruction =
-                     dynamic_cast<Assembly::CdqInstruction *>(
-                         instruction.get())) {
-            (void)cdqInstruction;
-        }
-        else if (auto *jmpInstruction =
-                     dynamic_cast<Assembly::JmpInstruction *>(
-                         instruction.get())) {
-            (void)jmpInstruction;
-        }
-        else if (auto *jmpCCInstruction =
-                     dynamic_cast<Assembly::JmpCCInstruction *>(
-                         instruction.get())) {
-            (void)jmpCCInstruction;
-        }
-        else if (auto *labelInstruction =
-                     dynamic_cast<Assembly::LabelInstruction *>(
-                         instruction.get())) {
-            (void)labelInstruction;
-        }
-        else {
-            const auto &r = *instruction;
+            break;
+        }
+        case Assembly::Instruction::Kind::Unary: {
+            [[maybe_unused]] const auto *unaryInstruction =
+                static_cast<const Assembly::UnaryInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(unaryInstruction->getOperand()));
+            break;
+        }
+        case Assembly::Instruction::Kind::Binary: {
+            [[maybe_unused]] const auto *binaryInstruction =
+                static_cast<const Assembly::BinaryInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(binaryInstruction->getOperand1()));
+            assert(!isPseudoRegisterOperand(binaryInstruction->getOperand2()));
+            break;
+        }
+        case Assembly::Instruction::Kind::Cmp: {
+            [[maybe_unused]] const auto *cmpInstruction =
+                static_cast<const Assembly::CmpInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(cmpInstruction->getOperand1()));
+            assert(!isPseudoRegisterOperand(cmpInstruction->getOperand2()));
+            break;
+        }
+        case Assembly::Instruction::Kind::Idiv: {
+            [[maybe_unused]] const auto *idivInstruction =
+                static_cast<const Assembly::IdivInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(idivInstruction->getOperand()));
+            break;
+        }
+        case Assembly::Instruction::Kind::Div: {
+            [[maybe_unused]] const auto *divInstruction =
+                static_cast<const Assembly::DivInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(divInstruction->getOperand()));
+            break;
+        }
+        case Assembly::Instruction::Kind::Imul: {
+            [[maybe_unused]] const auto *imulInstruction =
+                static_cast<const Assembly::ImulInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(imulInstruction->getOperand()));
+            break;
+        }
+        case Assembly::Instruction::Kind::Mul: {
+            [[maybe_unused]] const auto *mulInstruction =
+                static_cast<const Assembly::MulInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(mulInstruction->getOperand()));
+            break;
+        }
+        case Assembly::Instruction::Kind::SetCC: {
+            [[maybe_unused]] const auto *setCCInstruction =
+                static_cast<const Assembly::SetCCInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(setCCInstruction->getOperand()));
+            break;
+        }
+        case Assembly::Instruction::Kind::Push: {
+            [[maybe_unused]] const auto *pushInstruction =
+                static_cast<const Assembly::PushInstruction *>(
+                    instruction.get());
+            assert(!isPseudoRegisterOperand(pushInstruction->getOperand()));
+            break;
+        }
+        case Assembly::Instruction::Kind::Ret:
+        case Assembly::Instruction::Kind::Call:
+        case Assembly::Instruction::Kind::Cdq:
+        case Assembly::Instruction::Kind::Jmp:
+        case Assembly::Instruction::Kind::JmpCC:
+        case Assembly::Instruction::Kind::Label:
+            break;
+        default:
             throw std::logic_error(
                 "Unsupported instruction type while checking whether pseudo "
                 "registers have been replaced in "
                 "checkPseudoRegistersInFunctionDefinitionReplaced in "
-                "PseudoToStackPass: " +
-                std::string(typeid(r).name()));
+                "PseudoToStackPass");
         }
     }
 }
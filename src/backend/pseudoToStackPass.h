@@ -1,6 +1,8 @@
 #ifndef BACKEND_PSEUDO_TO_STACK_PASS_H
 #define BACKEND_PSEUDO_TO_STACK_PASS_H
 
+#include "../utils/symbol.h"
+#include "../utils/threadPool.h"
 #include "assembly.h"
 #include "backendSymbolTable.h"
 #include <memory>
@@ -11,6 +13,10 @@
 namespace Assembly {
 /**
  * Class for performing pseudo-to-stack pass on the assembly program.
+ *
+ * The pass keeps no state between function definitions: the stack frame being
+ * laid out is local to each function definition, so the function definitions
+ * can be processed independently (and concurrently).
  */
 class PseudoToStackPass {
   public:
@@ -18,35 +24,71 @@ class PseudoToStackPass {
      * Replace pseudo registers with stack operands and associate the stack size
      * with each function.
      *
+     * The function definitions are processed on the threads of the thread
+     * pool, sharing the backend symbol table read-only.
+     *
      * @param topLevels The top-levels of the assembly program.
      * @param backendSymbolTable The backend symbol table.
+     * @param threadPool The thread pool to process the function definitions
+     * on.
      */
-    void replacePseudoWithStackAndAssociateStackSize(
+    static void replacePseudoWithStackAndAssociateStackSize(
         std::vector<std::unique_ptr<TopLevel>> &topLevels,
-        const BackendSymbolTable &backendSymbolTable);
+        const BackendSymbolTable &backendSymbolTable, ThreadPool &threadPool);
 
   private:
+    /**
+     * Structure representing the stack frame of the function definition being
+     * processed.
+     */
+    struct StackFrame {
+        /**
+         * A map from (interned) pseudo registers to stack offsets.
+         */
+        std::unordered_map<Symbol, int> pseudoToStackMap;
+
+        /**
+         * The current stack offset.
+         */
+        int offset = 0;
+    };
+
+    /**
+     * Replace pseudo registers with stack operands in a function definition
+     * and associate its stack size with it.
+     *
+     * @param functionDefinition The function definition to process.
+     * @param backendSymbolTable The backend symbol table.
+     */
+    static void replacePseudoWithStackInFunctionDefinition(
+        FunctionDefinition &functionDefinition,
+        const BackendSymbolTable &backendSymbolTable);
+
     /**
      * Replace pseudo registers with stack operands in an instruction.
      *
      * @param instruction The instruction to replace pseudo registers with stack
      * operands.
      * @param backendSymbolTable The backend symbol table.
+     * @param stackFrame The stack frame of the function definition.
      */
-    void
+    static void
     replacePseudoWithStack(std::unique_ptr<Assembly::Instruction> &instruction,
-                           const BackendSymbolTable &backendSymbolTable);
+                           const BackendSymbolTable &backendSymbolTable,
+                           StackFrame &stackFrame);
 
     /**
      * Replace an operand with a stack operand.
      *
      * @param operand The operand to replace.
      * @param backendSymbolTable The backend symbol table.
+     * @param stackFrame The stack frame of the function definition.
      * @return The replaced operand.
      */
-    [[nodiscard]] std::unique_ptr<Assembly::Operand>
+    [[nodiscard]] static std::unique_ptr<Assembly::Operand>
     replaceOperand(const Assembly::Operand *operand,
-                   const BackendSymbolTable &backendSymbolTable);
+                   const BackendSymbolTable &backendSymbolTable,
+                   StackFrame &stackFrame);
 
     /**
      * Check if all pseudo registers in a function definition have been replaced
@@ -56,16 +98,6 @@ class PseudoToStackPass {
      */
     static void checkPseudoRegistersInFunctionDefinitionReplaced(
         const Assembly::FunctionDefinition &functionDefinition);
-
-    /**
-     * A map from pseudo registers to stack offsets.
-     */
-    std::unordered_map<std::string, int> pseudoToStackMap;
-
-    /**
-     * The current stack offset.
-     */
-    int offset = -4;
 };
 } // namespace Assembly
 
@@ -2,6 +2,7 @@
 #define FRONTEND_AST_H
 
 #include "visitor.h"
+#include <cstddef>
 
 namespace AST {
 /**
@@ -39,6 +40,28 @@ class AST {
      */
     constexpr AST &operator=(AST &&) = default;
 
+    /**
+     * Allocate an AST node, from the arena active on the current thread if
+     * there is one (see `ASTArena`), and from the heap otherwise.
+     *
+     * @param size The size of the node (in bytes).
+     * @return A pointer to the storage for the node.
+     */
+    static void *operator new(std::size_t size);
+
+    /**
+     * Free an AST node allocated from the heap (nodes allocated from an arena
+     * are freed along with the arena).
+     *
+     * This only releases the storage of the node: its destructor (and those of
+     * its children, through their `std::unique_ptr`s) has already run, since
+     * the AST keeps its owning pointers whether or not the nodes come from an
+     * arena.
+     *
+     * @param pointer A pointer to the node.
+     */
+    static void operator delete(void *pointer) noexcept;
+
     /**
      * Pure virtual method to accept a visitor.
      *
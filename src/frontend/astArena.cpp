@@ -0,0 +1,92 @@
+#include "astArena.h"
+#include "ast.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace {
+/**
+ * The arena active on the current thread (if any).
+ */
+thread_local AST::ASTArena *activeArena = nullptr;
+
+/**
+ * The alignment of the blocks handed out for AST nodes.
+ */
+constexpr std::size_t nodeAlignment = alignof(std::max_align_t);
+
+/**
+ * The size of the header preceding each AST node, recording where the node
+ * was allocated (so that `operator delete` knows whether to free it).
+ */
+constexpr std::size_t nodeHeaderSize = nodeAlignment;
+
+/**
+ * Enumeration representing where an AST node was allocated.
+ */
+enum class NodeOrigin : std::uint8_t { Heap, Arena };
+
+/**
+ * Round a size up to the node alignment.
+ *
+ * @param size The size to round up.
+ * @return The rounded-up size.
+ */
+constexpr std::size_t alignUp(std::size_t size) {
+    return (size + nodeAlignment - 1) & ~(nodeAlignment - 1);
+}
+} // namespace
+
+namespace AST {
+ASTArena::Scope::Scope(ASTArena &arena) : previous(activeArena) {
+    activeArena = &arena;
+}
+
+ASTArena::Scope::~Scope() { activeArena = previous; }
+
+void *ASTArena::allocate(std::size_t size) {
+    size = alignUp(size);
+    if (cursor == nullptr || static_cast<std::size_t>(end - cursor) < size) {
+        const auto newChunkSize = size > chunkSize ? size : chunkSize;
+        // `new[]` of `std::byte` is aligned to at least
+        // `__STDCPP_DEFAULT_NEW_ALIGNMENT__` (i.e., `max_align_t`).
+        chunks.emplace_back(
+            std::make_unique_for_overwrite<std::byte[]>(newChunkSize));
+        cursor = chunks.back().get();
+        end = cursor + newChunkSize;
+    }
+    auto *block = cursor;
+    cursor += size;
+    return block;
+}
+
+ASTArena *ASTArena::getActive() { return activeArena; }
+
+void *AST::operator new(std::size_t size) {
+    // Prefix the node with a header recording its origin.
+    std::byte *block = nullptr;
+    NodeOrigin origin = NodeOrigin::Heap;
+    if (auto *arena = ASTArena::getActive()) {
+        block = static_cast<std::byte *>(
+            arena->allocate(nodeHeaderSize + size));
+        origin = NodeOrigin::Arena;
+    }
+    else {
+        block = static_cast<std::byte *>(::operator new(nodeHeaderSize + size));
+    }
+    *reinterpret_cast<NodeOrigin *>(block) = origin;
+    return block + nodeHeaderSize;
+}
+
+void AST::operator delete(void *pointer) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    auto *block = static_cast<std::byte *>(pointer) - nodeHeaderSize;
+    // Nodes allocated from an arena are freed along with the arena.
+    if (*reinterpret_cast<NodeOrigin *>(block) == NodeOrigin::Heap) {
+        ::operator delete(block);
+    }
+}
+} // Namespace AST
@@ -0,0 +1,143 @@
+#ifndef FRONTEND_AST_ARENA_H
+#define FRONTEND_AST_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace AST {
+/**
+ * Class representing a bump (arena) allocator for the AST nodes of a
+ * translation unit.
+ *
+ * While an arena is active on a thread (see `ASTArena::Scope`), every AST node
+ * created with `new` (e.g., through `std::make_unique`) on that thread is
+ * carved out of the current chunk of the arena instead of being allocated
+ * individually on the heap. Deleting such a node still runs its destructor
+ * (which releases the strings and vectors it owns), but does not free its
+ * storage: the chunks are freed all at once when the arena is destroyed, so
+ * the arena must outlive every node allocated from it.
+ */
+class ASTArena {
+  public:
+    /**
+     * Class representing the activation of an arena on the current thread for
+     * the lifetime of the scope object.
+     */
+    class Scope {
+      public:
+        /**
+         * Constructor for the scope class.
+         *
+         * Activate the arena on the current thread (remembering the previously
+         * active arena, if any).
+         *
+         * @param arena The arena to activate.
+         */
+        explicit Scope(ASTArena &arena);
+
+        /**
+         * Destructor for the scope class.
+         *
+         * Reactivate the previously active arena (if any).
+         */
+        ~Scope();
+
+        /**
+         * Delete the copy constructor for the scope class.
+         */
+        Scope(const Scope &) = delete;
+
+        /**
+         * Delete the copy assignment operator for the scope class.
+         */
+        Scope &operator=(const Scope &) = delete;
+
+        /**
+         * Delete the move constructor for the scope class.
+         */
+        Scope(Scope &&) = delete;
+
+        /**
+         * Delete the move assignment operator for the scope class.
+         */
+        Scope &operator=(Scope &&) = delete;
+
+      private:
+        /**
+         * The arena that was active before this scope.
+         */
+        ASTArena *previous;
+    };
+
+    /**
+     * Default constructor for the AST arena class.
+     */
+    ASTArena() = default;
+
+    /**
+     * Default destructor for the AST arena class (freeing all the chunks).
+     */
+    ~ASTArena() = default;
+
+    /**
+     * Delete the copy constructor for the AST arena class.
+     */
+    ASTArena(const ASTArena &) = delete;
+
+    /**
+     * Delete the copy assignment operator for the AST arena class.
+     */
+    ASTArena &operator=(const ASTArena &) = delete;
+
+    /**
+     * Delete the move constructor for the AST arena class.
+     */
+    ASTArena(ASTArena &&) = delete;
+
+    /**
+     * Delete the move assignment operator for the AST arena class.
+     */
+    ASTArena &operator=(ASTArena &&) = delete;
+
+    /**
+     * Allocate a block of memory from the arena, aligned to
+     * `alignof(std::max_align_t)`.
+     *
+     * @param size The size of the block (in bytes).
+     * @return A pointer to the block.
+     */
+    [[nodiscard]] void *allocate(std::size_t size);
+
+    /**
+     * Get the arena active on the current thread.
+     *
+     * @return The active arena, or `nullptr` if there is none.
+     */
+    [[nodiscard]] static ASTArena *getActive();
+
+  private:
+    /**
+     * The size of a regular chunk (in bytes). Blocks larger than a chunk get
+     * a chunk of their own.
+     */
+    static constexpr std::size_t chunkSize = 64 * 1024;
+
+    /**
+     * The chunks of memory owned by the arena.
+     */
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+
+    /**
+     * The next free byte of the current chunk.
+     */
+    std::byte *cursor = nullptr;
+
+    /**
+     * The end of the current chunk.
+     */
+    std::byte *end = nullptr;
+};
+} // Namespace AST
+
+#endif // FRONTEND_AST_ARENA_H
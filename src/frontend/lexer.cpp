@@ -1,19 +1,315 @@
 #include "lexer.h"
+#include "simdScanner.h"
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <regex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
 #include <vector>
 
-Token matchToken(std::string_view input) {
-    // Convert string_view to string for regex operations
-    const std::string inputStr(input);
+/**
+ * Unnamed namespace for helper functions for the lexers.
+ */
+namespace {
+/**
+ * Keywords and their corresponding token types.
+ *
+ * To add a keyword, add its entry here; the perfect hash table below is
+ * regenerated at compile time.
+ */
+constexpr std::array keywords = std::to_array<
+    std::pair<std::string_view, TokenType>>({
+    {"int", TokenType::intKeyword},
+    {"long", TokenType::longKeyword},
+    {"signed", TokenType::signedKeyword},
+    {"unsigned", TokenType::unsignedKeyword},
+    {"void", TokenType::voidKeyword},
+    {"return", TokenType::returnKeyword},
+    {"if", TokenType::ifKeyword},
+    {"else", TokenType::elseKeyword},
+    {"do", TokenType::doKeyword},
+    {"while", TokenType::whileKeyword},
+    {"for", TokenType::forKeyword},
+    {"break", TokenType::breakKeyword},
+    {"continue", TokenType::continueKeyword},
+    {"static", TokenType::staticKeyword},
+    {"extern", TokenType::externKeyword},
+});
+
+/**
+ * The number of slots in the keyword hash table (a power of two, so that the
+ * hash can be reduced with a mask).
+ */
+constexpr std::size_t keywordTableSize = 64;
+
+/**
+ * The marker for an empty slot in the keyword hash table.
+ */
+constexpr std::uint8_t emptyKeywordSlot = 0xFF;
+
+static_assert(keywords.size() < keywordTableSize &&
+                  keywords.size() < emptyKeywordSlot,
+              "Too many keywords for the keyword hash table");
+
+/**
+ * Hash a word (of at least one character) into a slot of the keyword hash
+ * table from its length and its first and last characters (FNV-1a style).
+ *
+ * @param word The word to hash.
+ * @param seed The seed (offset basis) of the hash.
+ * @return The slot index of the word.
+ */
+constexpr std::size_t keywordHash(std::string_view word, std::uint32_t seed) {
+    constexpr std::uint32_t prime = 16777619U;
+    auto hash = seed;
+    hash = (hash ^ static_cast<std::uint32_t>(word.size())) * prime;
+    hash = (hash ^ static_cast<unsigned char>(word.front())) * prime;
+    hash = (hash ^ static_cast<unsigned char>(word.back())) * prime;
+    return (hash >> 16U) & (keywordTableSize - 1);
+}
+
+/**
+ * Structure representing a perfect hash table over the keywords: every
+ * keyword hashes (with `seed`) to its own slot, which holds its index into
+ * `keywords`.
+ */
+struct KeywordHashTable {
+    std::uint32_t seed = 0;
+    std::array<std::uint8_t, keywordTableSize> slots{};
+};
+
+/**
+ * Search (at compile time) for a seed under which the keywords hash without
+ * collisions, and build the keyword hash table with it.
+ *
+ * @return The perfect hash table over the keywords.
+ */
+consteval KeywordHashTable makeKeywordHashTable() {
+    constexpr std::uint32_t maxSeed = 1U << 16U;
+    for (std::uint32_t seed = 0; seed < maxSeed; ++seed) {
+        KeywordHashTable table{.seed = seed, .slots = {}};
+        table.slots.fill(emptyKeywordSlot);
+        bool isPerfect = true;
+        for (std::size_t i = 0; i < keywords.size() && isPerfect; ++i) {
+            auto &slot = table.slots[keywordHash(keywords[i].first, seed)];
+            isPerfect = slot == emptyKeywordSlot;
+            slot = static_cast<std::uint8_t>(i);
+        }
+        if (isPerfect) {
+            return table;
+        }
+    }
+    throw std::logic_error("No perfect hash seed found for the keywords in "
+                           "makeKeywordHashTable in Lexer");
+}
+
+/**
+ * The perfect hash table over the keywords.
+ */
+constexpr KeywordHashTable keywordHashTable = makeKeywordHashTable();
+
+/**
+ * Check if a character is a decimal digit (i.e., matched by `[0-9]`).
+ *
+ * @param c The character to check.
+ * @return True if the character is a decimal digit, false otherwise.
+ */
+constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+/**
+ * Check if a character can start an identifier (i.e., matched by
+ * `[a-zA-Z_]`).
+ *
+ * @param c The character to check.
+ * @return True if the character can start an identifier, false otherwise.
+ */
+constexpr bool isIdentifierStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+/**
+ * Check if a character is a word character (i.e., matched by `\w`).
+ *
+ * @param c The character to check.
+ * @return True if the character is a word character, false otherwise.
+ */
+constexpr bool isWordCharacter(char c) {
+    return isIdentifierStart(c) || isDigit(c);
+}
+
+/**
+ * Advance the cursor past any whitespace characters and comments.
+ *
+ * Whitespace runs and comment bodies are skipped with the vectorized scanners
+ * (see `simdScanner.h`). An unterminated multi-line comment is not skipped, so
+ * that it is lexed as a division followed by whatever comes next (as by the
+ * regular expressions).
+ *
+ * @param input The input string.
+ * @param cursor The position to start skipping from.
+ * @return The position of the first character that is neither whitespace nor
+ * part of a comment (or the end of the input).
+ */
+std::size_t skipWhitespaceAndComments(std::string_view input,
+                                      std::size_t cursor) {
+    while ((cursor = skipWhitespaceRun(input, cursor)) + 1 < input.size() &&
+           input[cursor] == '/') {
+        if (input[cursor + 1] == '/') {
+            const auto newline = findNewline(input, cursor + 2);
+            cursor = newline == std::string_view::npos ? input.size()
+                                                       : newline + 1;
+        }
+        else if (input[cursor + 1] == '*') {
+            const auto close = findBlockCommentEnd(input, cursor + 2);
+            if (close == std::string_view::npos) {
+                break;
+            }
+            cursor = close + 2;
+        }
+        else {
+            break;
+        }
+    }
+    return cursor;
+}
 
+/**
+ * Advance the cursor past a run of word characters.
+ *
+ * @param input The input string.
+ * @param cursor The position to start scanning from.
+ * @return The position of the first non-word character (or the end of the
+ * input).
+ */
+std::size_t skipWordCharacters(std::string_view input, std::size_t cursor) {
+    while (cursor < input.size() && isWordCharacter(input[cursor])) {
+        ++cursor;
+    }
+    return cursor;
+}
+
+/**
+ * Classify a lexeme matched by `identifier_regex` as a keyword or an
+ * identifier.
+ *
+ * @param lexeme The lexeme to classify.
+ * @return The keyword token type, or `TokenType::Identifier`.
+ */
+TokenType classifyIdentifier(std::string_view lexeme) {
+    // Look up the only keyword that the lexeme could be and compare against
+    // it.
+    const auto slot =
+        keywordHashTable.slots[keywordHash(lexeme, keywordHashTable.seed)];
+    if (slot != emptyKeywordSlot && keywords[slot].first == lexeme) {
+        return keywords[slot].second;
+    }
+    return TokenType::Identifier;
+}
+
+/**
+ * Classify the (word-character) suffix following the digits of an integer
+ * constant.
+ *
+ * @param suffix The suffix to classify.
+ * @return The constant token type, or `TokenType::Invalid` if the suffix is
+ * not a valid integer suffix.
+ */
+TokenType classifyIntegerSuffix(std::string_view suffix) {
+    const auto isL = [](char c) { return c == 'l' || c == 'L'; };
+    const auto isU = [](char c) { return c == 'u' || c == 'U'; };
+    if (suffix.empty()) {
+        return TokenType::IntConstant;
+    }
+    if (suffix.size() == 1) {
+        if (isL(suffix[0])) {
+            return TokenType::LongConstant;
+        }
+        if (isU(suffix[0])) {
+            return TokenType::UnsignedIntegerConstant;
+        }
+    }
+    if (suffix.size() == 2 && ((isL(suffix[0]) && isU(suffix[1])) ||
+                               (isU(suffix[0]) && isL(suffix[1])))) {
+        return TokenType::UnsignedLongIntegerConstant;
+    }
+    return TokenType::Invalid;
+}
+
+/**
+ * Estimate the number of tokens in the input string, so that the token vector
+ * can be allocated up front (rather than grown token by token).
+ *
+ * @param input The input string to estimate the number of tokens of.
+ * @return The estimated number of tokens.
+ */
+constexpr std::size_t estimateTokenCount(std::string_view input) {
+    // C source averages well over four bytes per token (once whitespace and
+    // comments are accounted for).
+    return input.size() / 4 + 16;
+}
+
+/**
+ * Decode the numeric value of the digits of an integer-constant token (if the
+ * token is an integer constant).
+ *
+ * @param token The token to decode the constant value of.
+ */
+void decodeIntegerConstant(Token &token) {
+    if (token.type != TokenType::IntConstant &&
+        token.type != TokenType::LongConstant &&
+        token.type != TokenType::UnsignedIntegerConstant &&
+        token.type != TokenType::UnsignedLongIntegerConstant) {
+        return;
+    }
+    std::uint64_t value = 0;
+    const auto *const begin = token.value.data();
+    const auto *const end = begin + token.value.size();
+    const auto result = std::from_chars(begin, end, value);
+    if (result.ec == std::errc{}) {
+        token.constantValue = value;
+    }
+}
+
+/**
+ * Throw an error for an invalid token at the cursor position.
+ *
+ * @param input The input string.
+ * @param cursor The position of the invalid token.
+ */
+[[noreturn]] void throwInvalidToken(std::string_view input,
+                                    std::size_t cursor) {
+    const auto lineEnd = input.find('\n', cursor);
+    std::stringstream msg;
+    msg << "Invalid token found in scanToken in Lexer: "
+        << input.substr(cursor, lineEnd == std::string_view::npos
+                                    ? std::string_view::npos
+                                    : lineEnd - cursor);
+    throw std::invalid_argument(msg.str());
+}
+} // namespace
+
+Token matchToken(std::string_view input) {
     // Instantiate the `match_results` class template for matches on string
-    // objects.
-    std::smatch tokenMatches;
+    // views, so that the matched lexemes can be viewed in place.
+    std::match_results<std::string_view::const_iterator> tokenMatches;
+    const auto search = [&](const std::regex &regex) {
+        // All the regular expressions are anchored at the start of the input,
+        // so only try to match at the start of the input.
+        return std::regex_search(input.begin(), input.end(), tokenMatches,
+                                 regex,
+                                 std::regex_constants::match_continuous);
+    };
+    const auto matchedLexeme = [&]() {
+        return input.substr(
+            0, static_cast<std::size_t>(tokenMatches.length(0)));
+    };
 
     // Match the input string against the regular expressions for the different
     // token types and return the token struct, containing the token type and
@@ -22,203 +318,149 @@ Token matchToken(std::string_view input) {
     // token-matching `singleLineComment_regex` and `multiLineComment_regex` to
     // resolve the conflict with the other token matchings (e.g.,
     // `multiply_regex`).
-    if (std::regex_search(inputStr, tokenMatches,
-                          preprocessorDirective_regex)) {
+    if (search(preprocessorDirective_regex)) {
         return {.type = TokenType::PreprocessorDirective,
-                .value = tokenMatches.str(0)};
+                .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, stringLiteral_regex)) {
-        return {.type = TokenType::StringLiteral, .value = tokenMatches.str(0)};
+    else if (search(stringLiteral_regex)) {
+        return {.type = TokenType::StringLiteral, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches,
-                               singleLineComment_regex)) {
+    else if (search(singleLineComment_regex)) {
         return {.type = TokenType::SingleLineComment,
-                .value = tokenMatches.str(0)};
+                .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches,
-                               multiLineComment_regex)) {
+    else if (search(multiLineComment_regex)) {
         return {.type = TokenType::MultiLineComment,
-                .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, LongConstant_regex)) {
-        return {.type = TokenType::LongConstant, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, intConstant_regex)) {
-        return {.type = TokenType::IntConstant, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, intKeyword_regex)) {
-        return {.type = TokenType::intKeyword, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, longKeyword_regex)) {
-        return {.type = TokenType::longKeyword, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, signedKeyword_regex)) {
-        return {.type = TokenType::signedKeyword, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, unsignedKeyword_regex)) {
-        return {.type = TokenType::unsignedKeyword,
-                .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, voidKeyword_regex)) {
-        return {.type = TokenType::voidKeyword, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, returnKeyword_regex)) {
-        return {.type = TokenType::returnKeyword, .value = tokenMatches.str(0)};
+                .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, ifKeyword_regex)) {
-        return {.type = TokenType::ifKeyword, .value = tokenMatches.str(0)};
+    else if (search(LongConstant_regex)) {
+        return {.type = TokenType::LongConstant, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, elseKeyword_regex)) {
-        return {.type = TokenType::elseKeyword, .value = tokenMatches.str(0)};
+    else if (search(intConstant_regex)) {
+        return {.type = TokenType::IntConstant, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, doKeyword_regex)) {
-        return {.type = TokenType::doKeyword, .value = tokenMatches.str(0)};
+    // Match keywords and identifiers with the same regex and tell them apart
+    // through the keyword table (rather than trying each keyword regex in
+    // turn before falling back to `identifier_regex`).
+    else if (search(identifier_regex)) {
+        const auto lexeme = matchedLexeme();
+        return {.type = classifyIdentifier(lexeme), .value = lexeme};
     }
-    else if (std::regex_search(inputStr, tokenMatches, whileKeyword_regex)) {
-        return {.type = TokenType::whileKeyword, .value = tokenMatches.str(0)};
+    else if (search(comma_regex)) {
+        return {.type = TokenType::Comma, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, forKeyword_regex)) {
-        return {.type = TokenType::forKeyword, .value = tokenMatches.str(0)};
+    else if (search(questionMark_regex)) {
+        return {.type = TokenType::QuestionMark, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, breakKeyword_regex)) {
-        return {.type = TokenType::breakKeyword, .value = tokenMatches.str(0)};
+    else if (search(colon_regex)) {
+        return {.type = TokenType::Colon, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, continueKeyword_regex)) {
-        return {.type = TokenType::continueKeyword,
-                .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, staticKeyword_regex)) {
-        return {.type = TokenType::staticKeyword, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, externKeyword_regex)) {
-        return {.type = TokenType::externKeyword, .value = tokenMatches.str(0)};
-        // Lower down the precedence of token-matching `identifier_regex`
-        // to avoid the conflict with the other token matchings (e.g.,
-        // `intKeyword_regex`)
-    }
-    else if (std::regex_search(inputStr, tokenMatches, identifier_regex)) {
-        return {.type = TokenType::Identifier, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, comma_regex)) {
-        return {.type = TokenType::Comma, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, questionMark_regex)) {
-        return {.type = TokenType::QuestionMark, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, colon_regex)) {
-        return {.type = TokenType::Colon, .value = tokenMatches.str(0)};
-    }
-    else if (std::regex_search(inputStr, tokenMatches, openParenthesis_regex)) {
+    else if (search(openParenthesis_regex)) {
         return {.type = TokenType::OpenParenthesis,
-                .value = tokenMatches.str(0)};
+                .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches,
-                               closeParenthesis_regex)) {
+    else if (search(closeParenthesis_regex)) {
         return {.type = TokenType::CloseParenthesis,
-                .value = tokenMatches.str(0)};
+                .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, openBrace_regex)) {
-        return {.type = TokenType::OpenBrace, .value = tokenMatches.str(0)};
+    else if (search(openBrace_regex)) {
+        return {.type = TokenType::OpenBrace, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, closeBrace_regex)) {
-        return {.type = TokenType::CloseBrace, .value = tokenMatches.str(0)};
+    else if (search(closeBrace_regex)) {
+        return {.type = TokenType::CloseBrace, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, semicolon_regex)) {
-        return {.type = TokenType::Semicolon, .value = tokenMatches.str(0)};
+    else if (search(semicolon_regex)) {
+        return {.type = TokenType::Semicolon, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, tilde_regex)) {
-        return {.type = TokenType::Tilde, .value = tokenMatches.str(0)};
+    else if (search(tilde_regex)) {
+        return {.type = TokenType::Tilde, .value = matchedLexeme()};
         // Enforce the precedence of token-matching `twoHyphen_regex` over
         // `minus_regex` to avoid the conflict with the token matching of
         // `minus_regex`.
     }
-    else if (std::regex_search(inputStr, tokenMatches, twoHyphen_regex)) {
-        return {.type = TokenType::TwoHyphen, .value = tokenMatches.str(0)};
+    else if (search(twoHyphen_regex)) {
+        return {.type = TokenType::TwoHyphen, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, plus_regex)) {
-        return {.type = TokenType::Plus, .value = tokenMatches.str(0)};
+    else if (search(plus_regex)) {
+        return {.type = TokenType::Plus, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, minus_regex)) {
-        return {.type = TokenType::Minus, .value = tokenMatches.str(0)};
+    else if (search(minus_regex)) {
+        return {.type = TokenType::Minus, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, multiply_regex)) {
-        return {.type = TokenType::Multiply, .value = tokenMatches.str(0)};
+    else if (search(multiply_regex)) {
+        return {.type = TokenType::Multiply, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, divide_regex)) {
-        return {.type = TokenType::Divide, .value = tokenMatches.str(0)};
+    else if (search(divide_regex)) {
+        return {.type = TokenType::Divide, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, modulo_regex)) {
-        return {.type = TokenType::Modulo, .value = tokenMatches.str(0)};
+    else if (search(modulo_regex)) {
+        return {.type = TokenType::Modulo, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, equal_regex)) {
-        return {.type = TokenType::Equal, .value = tokenMatches.str(0)};
+    else if (search(equal_regex)) {
+        return {.type = TokenType::Equal, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, notEqual_regex)) {
-        return {.type = TokenType::NotEqual, .value = tokenMatches.str(0)};
+    else if (search(notEqual_regex)) {
+        return {.type = TokenType::NotEqual, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, lessThanOrEqual_regex)) {
+    else if (search(lessThanOrEqual_regex)) {
         return {.type = TokenType::LessThanOrEqual,
-                .value = tokenMatches.str(0)};
+                .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches,
-                               greaterThanOrEqual_regex)) {
+    else if (search(greaterThanOrEqual_regex)) {
         return {.type = TokenType::GreaterThanOrEqual,
-                .value = tokenMatches.str(0)};
+                .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, lessThan_regex)) {
-        return {.type = TokenType::LessThan, .value = tokenMatches.str(0)};
+    else if (search(lessThan_regex)) {
+        return {.type = TokenType::LessThan, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, greaterThan_regex)) {
-        return {.type = TokenType::GreaterThan, .value = tokenMatches.str(0)};
+    else if (search(greaterThan_regex)) {
+        return {.type = TokenType::GreaterThan, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, logicalNot_regex)) {
-        return {.type = TokenType::LogicalNot, .value = tokenMatches.str(0)};
+    else if (search(logicalNot_regex)) {
+        return {.type = TokenType::LogicalNot, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, logicalAnd_regex)) {
-        return {.type = TokenType::LogicalAnd, .value = tokenMatches.str(0)};
+    else if (search(logicalAnd_regex)) {
+        return {.type = TokenType::LogicalAnd, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches, logicalOr_regex)) {
-        return {.type = TokenType::LogicalOr, .value = tokenMatches.str(0)};
+    else if (search(logicalOr_regex)) {
+        return {.type = TokenType::LogicalOr, .value = matchedLexeme()};
         // Lower down the precedence of token-matching `assign_regex` to avoid
         // the conflict with the token matching of `equal_regex`.
     }
-    else if (std::regex_search(inputStr, tokenMatches, assign_regex)) {
-        return {.type = TokenType::Assign, .value = tokenMatches.str(0)};
+    else if (search(assign_regex)) {
+        return {.type = TokenType::Assign, .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches,
-                               unsignedLongIntegerConstant_regex)) {
+    else if (search(unsignedLongIntegerConstant_regex)) {
         return {.type = TokenType::UnsignedLongIntegerConstant,
-                .value = tokenMatches.str(0)};
+                .value = matchedLexeme()};
     }
-    else if (std::regex_search(inputStr, tokenMatches,
-                               unsignedIntegerConstant_regex)) {
+    else if (search(unsignedIntegerConstant_regex)) {
         return {.type = TokenType::UnsignedIntegerConstant,
-                .value = tokenMatches.str(0)};
+                .value = matchedLexeme()};
     }
     else {
         std::stringstream msg;
-        msg << "Invalid token found in matchToken in Lexer: " << inputStr;
+        msg << "Invalid token found in matchToken in Lexer: " << input;
         throw std::invalid_argument(msg.str());
     }
 }
 
 std::vector<Token> lexer(std::string_view input) {
     std::vector<Token> tokens;
-    std::string remainingInput(input);
+    tokens.reserve(estimateTokenCount(input));
+    std::size_t cursor = 0;
 
-    // Process the input string until it is empty.
-    while (!remainingInput.empty()) {
-        // If the input starts with some whitespace, trim the whitespace from
-        // the start of the input.
-        remainingInput =
-            std::regex_replace(remainingInput, std::regex("^\\s+"), "");
-        if (remainingInput.empty()) {
+    // Process the input string until the cursor reaches the end of it.
+    while (cursor < input.size()) {
+        // If the input starts with some whitespace or comments, skip them.
+        cursor = skipWhitespaceAndComments(input, cursor);
+        if (cursor == input.size()) {
             break;
         }
 
         // Find the longest match at the start of the input for any regex
         // specified in Table 1-1 (page 9).
-        const Token token = matchToken(remainingInput);
+        Token token = matchToken(input.substr(cursor));
 
         // If no match is found, raise an error.
         // Print out the remaining input (intentionally) and exit the program.
@@ -231,37 +473,208 @@ std::vector<Token> lexer(std::string_view input) {
         // Skip preprocessor directives and their corresponding tokens (e.g.,
         // string literals).
         if (token.type == TokenType::PreprocessorDirective) {
-            remainingInput = remainingInput.substr(token.value.size());
+            cursor += token.value.size();
             // Skip any additional tokens, such as string literals, that might
             // follow a directive.
-            while (!remainingInput.empty()) {
-                remainingInput =
-                    std::regex_replace(remainingInput, std::regex("^\\s+"), "");
-                const Token nextToken = matchToken(remainingInput);
+            while (cursor < input.size()) {
+                cursor = skipWhitespaceRun(input, cursor);
+                if (cursor == input.size()) {
+                    break;
+                }
+                const Token nextToken = matchToken(input.substr(cursor));
                 // Stop skipping if the next token is not part of the directive
                 if (nextToken.type != TokenType::StringLiteral &&
                     nextToken.type != TokenType::Identifier) {
                     break;
                 }
-                remainingInput = remainingInput.substr(nextToken.value.size());
+                cursor += nextToken.value.size();
             }
             continue;
         }
 
-        // Skip the token (matching substring) if the token is of type
-        // `SingleLineComment` or `MultiLineComment`.
-        if (token.type == TokenType::SingleLineComment ||
-            token.type == TokenType::MultiLineComment) {
-            remainingInput = remainingInput.substr(token.value.size());
+        // Remove the token (matching substring) from the start of the input.
+        cursor += token.value.size();
+
+        // Add the token (matching substring) to the list of tokens (comments
+        // have already been skipped along with the whitespace).
+        decodeIntegerConstant(token);
+        tokens.emplace_back(token);
+    }
+
+    // Return the vector of tokens.
+    return tokens;
+}
+
+Token scanToken(std::string_view input, std::size_t &cursor) {
+    const auto start = cursor;
+    const auto peek = [&](std::size_t offset) {
+        return start + offset < input.size() ? input[start + offset] : '\0';
+    };
+    const auto makeToken = [&](TokenType type, std::size_t length) {
+        cursor = start + length;
+        return Token{.type = type, .value = input.substr(start, length)};
+    };
+
+    // Dispatch on the current character and consume the longest lexeme that
+    // the corresponding regular expression would have matched. The states of
+    // the automaton that need more than one character of lookahead are
+    // handled by the inner loops (identifiers, constants, comments, string
+    // literals, and preprocessor directives).
+    const auto c = peek(0);
+    switch (c) {
+    case '#': {
+        const auto end = skipWordCharacters(input, start + 1);
+        if (end == start + 1) {
+            throwInvalidToken(input, start);
+        }
+        return makeToken(TokenType::PreprocessorDirective, end - start);
+    }
+    case '"':
+    case '\'': {
+        // Scan up to the closing quote on the same line (`.` does not match
+        // a newline).
+        auto end = start + 1;
+        while (end < input.size() && input[end] != c && input[end] != '\n') {
+            ++end;
+        }
+        if (end >= input.size() || input[end] != c) {
+            throwInvalidToken(input, start);
+        }
+        return makeToken(TokenType::StringLiteral, end + 1 - start);
+    }
+    case '/': {
+        if (peek(1) == '/') {
+            const auto newline = findNewline(input, start + 2);
+            return makeToken(TokenType::SingleLineComment,
+                             newline == std::string_view::npos
+                                 ? input.size() - start
+                                 : newline + 1 - start);
+        }
+        if (peek(1) == '*') {
+            const auto close = findBlockCommentEnd(input, start + 2);
+            // An unterminated multi-line comment is lexed as a division
+            // followed by whatever comes next (as by the regular expressions).
+            if (close != std::string_view::npos) {
+                return makeToken(TokenType::MultiLineComment,
+                                 close + 2 - start);
+            }
+        }
+        return makeToken(TokenType::Divide, 1);
+    }
+    case ',':
+        return makeToken(TokenType::Comma, 1);
+    case '?':
+        return makeToken(TokenType::QuestionMark, 1);
+    case ':':
+        return makeToken(TokenType::Colon, 1);
+    case '(':
+        return makeToken(TokenType::OpenParenthesis, 1);
+    case ')':
+        return makeToken(TokenType::CloseParenthesis, 1);
+    case '{':
+        return makeToken(TokenType::OpenBrace, 1);
+    case '}':
+        return makeToken(TokenType::CloseBrace, 1);
+    case ';':
+        return makeToken(TokenType::Semicolon, 1);
+    case '~':
+        return makeToken(TokenType::Tilde, 1);
+    case '-':
+        if (peek(1) == '-') {
+            return makeToken(TokenType::TwoHyphen, 2);
+        }
+        return makeToken(TokenType::Minus, 1);
+    case '+':
+        return makeToken(TokenType::Plus, 1);
+    case '*':
+        return makeToken(TokenType::Multiply, 1);
+    case '%':
+        return makeToken(TokenType::Modulo, 1);
+    case '=':
+        if (peek(1) == '=') {
+            return makeToken(TokenType::Equal, 2);
+        }
+        return makeToken(TokenType::Assign, 1);
+    case '!':
+        if (peek(1) == '=') {
+            return makeToken(TokenType::NotEqual, 2);
+        }
+        return makeToken(TokenType::LogicalNot, 1);
+    case '<':
+        if (peek(1) == '=') {
+            return makeToken(TokenType::LessThanOrEqual, 2);
+        }
+        return makeToken(TokenType::LessThan, 1);
+    case '>':
+        if (peek(1) == '=') {
+            return makeToken(TokenType::GreaterThanOrEqual, 2);
+        }
+        return makeToken(TokenType::GreaterThan, 1);
+    case '&':
+        if (peek(1) == '&') {
+            return makeToken(TokenType::LogicalAnd, 2);
+        }
+        throwInvalidToken(input, start);
+    case '|':
+        if (peek(1) == '|') {
+            return makeToken(TokenType::LogicalOr, 2);
+        }
+        throwInvalidToken(input, start);
+    default:
+        break;
+    }
+
+    if (isDigit(c)) {
+        // Scan the digits and then the word-character suffix (if any); the
+        // suffix determines the type of the constant.
+        auto digitsEnd = start;
+        while (digitsEnd < input.size() && isDigit(input[digitsEnd])) {
+            ++digitsEnd;
+        }
+        const auto end = skipWordCharacters(input, digitsEnd);
+        const auto type =
+            classifyIntegerSuffix(input.substr(digitsEnd, end - digitsEnd));
+        if (type == TokenType::Invalid) {
+            throwInvalidToken(input, start);
+        }
+        return makeToken(type, end - start);
+    }
+    if (isIdentifierStart(c)) {
+        const auto end = skipWordCharacters(input, start);
+        return makeToken(classifyIdentifier(input.substr(start, end - start)),
+                         end - start);
+    }
+    throwInvalidToken(input, start);
+}
+
+std::vector<Token> dfaLexer(std::string_view input) {
+    std::vector<Token> tokens;
+    tokens.reserve(estimateTokenCount(input));
+    std::size_t cursor = 0;
+
+    // Process the input string until the cursor reaches the end of it.
+    while ((cursor = skipWhitespaceAndComments(input, cursor)) <
+           input.size()) {
+        Token token = scanToken(input, cursor);
+
+        // Skip preprocessor directives and any string literals or identifiers
+        // that follow them (e.g., the operands of `#pragma`).
+        if (token.type == TokenType::PreprocessorDirective) {
+            while ((cursor = skipWhitespaceRun(input, cursor)) <
+                   input.size()) {
+                const auto nextTokenStart = cursor;
+                const Token nextToken = scanToken(input, cursor);
+                if (nextToken.type != TokenType::StringLiteral &&
+                    nextToken.type != TokenType::Identifier) {
+                    cursor = nextTokenStart;
+                    break;
+                }
+            }
             continue;
         }
 
-        // Add the token (matching substring) to the list of tokens except for
-        // tokens of types `SingleLineComment` and `MultiLineComment`.
+        decodeIntegerConstant(token);
         tokens.emplace_back(token);
-
-        // Remove the token (matching substring) from the start of the input.
-        remainingInput = remainingInput.substr(token.value.size());
     }
 
     // Return the vector of tokens.
@@ -1,7 +1,9 @@
 #ifndef FRONTEND_LEXER_H
 #define FRONTEND_LEXER_H
 
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <regex>
 #include <string>
 #include <string_view>
@@ -18,21 +20,6 @@ namespace {
 const std::regex identifier_regex(R"(^[a-zA-Z_]\w*\b)");
 const std::regex LongConstant_regex(R"(^[0-9]+[lL]\b)");
 const std::regex intConstant_regex(R"(^[0-9]+\b)");
-const std::regex intKeyword_regex(R"(^int\b)");
-const std::regex longKeyword_regex(R"(^long\b)");
-const std::regex signedKeyword_regex(R"(^signed\b)");
-const std::regex unsignedKeyword_regex(R"(^unsigned\b)");
-const std::regex voidKeyword_regex(R"(^void\b)");
-const std::regex returnKeyword_regex(R"(^return\b)");
-const std::regex ifKeyword_regex(R"(^if\b)");
-const std::regex elseKeyword_regex(R"(^else\b)");
-const std::regex doKeyword_regex(R"(^do\b)");
-const std::regex whileKeyword_regex(R"(^while\b)");
-const std::regex forKeyword_regex(R"(^for\b)");
-const std::regex breakKeyword_regex(R"(^break\b)");
-const std::regex continueKeyword_regex(R"(^continue\b)");
-const std::regex staticKeyword_regex(R"(^static\b)");
-const std::regex externKeyword_regex(R"(^extern\b)");
 const std::regex comma_regex(R"(^\,)");
 const std::regex questionMark_regex(R"(^\?)");
 const std::regex colon_regex(R"(^\:)");
@@ -131,10 +118,16 @@ enum class TokenType : std::uint8_t {
 
 /**
  * Structure representing a token with its type and value.
+ *
+ * The value is a view into the source text that the token was lexed from (see
+ * `SourceBuffer`), so the source text must outlive the token. For integer
+ * constants, the numeric value of the digits (without the suffix) is decoded
+ * by the lexer, or left empty if it does not fit in 64 bits.
  */
 struct Token {
     TokenType type;
-    std::string value;
+    std::string_view value;
+    std::optional<std::uint64_t> constantValue = std::nullopt;
 };
 
 /**
@@ -142,7 +135,7 @@ struct Token {
  *
  * Match the input string against the regular expressions for the different
  * token types and return the token struct, containing the token type and the
- * token value (in string).
+ * token value (as a view into the input string).
  *
  * @param input The input string to match the token from.
  * @return The matched token.
@@ -152,11 +145,36 @@ Token matchToken(std::string_view input);
 /**
  * Lex the input string into a vector of tokens.
  *
+ * The values of the tokens are views into the input string.
+ *
  * @param input The input string to lex.
  * @return A vector of tokens.
  */
 std::vector<Token> lexer(std::string_view input);
 
+/**
+ * Scan a single token starting at the cursor position of the input string.
+ *
+ * The scanner is a hand-written deterministic finite automaton (DFA) that
+ * dispatches on the current character and consumes the longest lexeme that
+ * the regular expressions in `matchToken` would have matched, so that it
+ * produces the same token types in the same order.
+ *
+ * @param input The input string to scan the token from.
+ * @param cursor The position to scan from, advanced past the scanned token.
+ * @return The scanned token.
+ */
+Token scanToken(std::string_view input, std::size_t &cursor);
+
+/**
+ * Lex the input string into a vector of tokens with a single pass over the
+ * input (using `scanToken` instead of the regular expressions).
+ *
+ * @param input The input string to lex.
+ * @return A vector of tokens.
+ */
+std::vector<Token> dfaLexer(std::string_view input);
+
 /**
  * Pretty-print the tokens to the stdout.
  *
@@ -11,6 +11,7 @@
 #include "storageClass.h"
 #include "type.h"
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -534,15 +535,19 @@ std::unique_ptr<Constant> Parser::parseConstant() {
     // 2^32 - 1 = 4294967295ULL.
     constexpr unsigned long long MAX_UINT = 4294967295ULL;
 
-    if ((*tokens)[current].type == TokenType::UnsignedIntegerConstant ||
-        (*tokens)[current].type == TokenType::UnsignedLongIntegerConstant) {
-        auto constantValue = std::stoull((*tokens)[current].value);
-        if (constantValue > MAX_ULONG) {
+    // The lexer decodes the value of the digits of the constant up front and
+    // leaves it empty if the digits do not fit in 64 bits.
+    const auto &constantToken = (*tokens)[current];
+    if (constantToken.type == TokenType::UnsignedIntegerConstant ||
+        constantToken.type == TokenType::UnsignedLongIntegerConstant) {
+        if (!constantToken.constantValue.has_value() ||
+            *constantToken.constantValue > MAX_ULONG) {
             throw std::invalid_argument(
                 "Constant is too large to represent as an unsigned long in "
                 "parseConstant in Parser");
         }
-        if ((*tokens)[current].type == TokenType::UnsignedIntegerConstant) {
+        const auto constantValue = *constantToken.constantValue;
+        if (constantToken.type == TokenType::UnsignedIntegerConstant) {
             if (constantValue <= MAX_UINT) {
                 consumeToken(TokenType::UnsignedIntegerConstant);
                 return std::make_unique<ConstantUInt>(
@@ -557,12 +562,13 @@ std::unique_ptr<Constant> Parser::parseConstant() {
             static_cast<unsigned long>(constantValue));
     }
 
-    auto constantValue = std::stoll((*tokens)[current].value);
-    if (constantValue > MAX_LONG) {
+    if (!constantToken.constantValue.has_value() ||
+        *constantToken.constantValue > static_cast<std::uint64_t>(MAX_LONG)) {
         throw std::invalid_argument("Constant is too large to represent as an "
                                     "int or long in parseConstant in Parser");
     }
-    if ((*tokens)[current].type == TokenType::IntConstant) {
+    const auto constantValue = static_cast<long>(*constantToken.constantValue);
+    if (constantToken.type == TokenType::IntConstant) {
         if (constantValue <= MAX_INT) {
             consumeToken(TokenType::IntConstant);
             return std::make_unique<ConstantInt>(
@@ -876,9 +876,9 @@ void TypeCheckingPass::typeCheckFunctionDeclaration(
              declaration->getOptStorageClass()) != nullptr)) {
         global = false;
     }
-    if (frontendSymbolTable->contains(declaration->getIdentifier())) {
+    if (frontendSymbolTable->contains(Symbol(declaration->getIdentifier()))) {
         auto &oldDeclaration =
-            (*frontendSymbolTable)[declaration->getIdentifier()];
+            (*frontendSymbolTable)[Symbol(declaration->getIdentifier())];
         auto *oldType = oldDeclaration.first.get();
         if (*oldType != *funType) {
             const auto &r = *oldType;
@@ -911,7 +911,7 @@ void TypeCheckingPass::typeCheckFunctionDeclaration(
 
     auto attribute =
         std::make_unique<FunctionAttribute>(alreadyDefined || hasBody, global);
-    (*frontendSymbolTable)[declaration->getIdentifier()] = {
+    (*frontendSymbolTable)[Symbol(declaration->getIdentifier())] = {
         cloneType(funType), std::move(attribute)};
 
     if (hasBody) {
@@ -923,13 +923,13 @@ void TypeCheckingPass::typeCheckFunctionDeclaration(
         for (size_t i = 0; i < parameterIdentifiers.size(); ++i) {
             // If the parameter type is available, use it.
             if (i < funcParameterTypes.size()) {
-                (*frontendSymbolTable)[parameterIdentifiers[i]] = {
+                (*frontendSymbolTable)[Symbol(parameterIdentifiers[i])] = {
                     cloneType(funcParameterTypes[i].get()),
                     std::make_unique<LocalAttribute>()};
             }
             else {
                 // Otherwise, fallback to `IntType`.
-                (*frontendSymbolTable)[parameterIdentifiers[i]] = {
+                (*frontendSymbolTable)[Symbol(parameterIdentifiers[i])] = {
                     std::make_unique<IntType>(),
                     std::make_unique<LocalAttribute>()};
             }
@@ -1030,9 +1030,9 @@ void TypeCheckingPass::typeCheckFileScopeVariableDeclaration(
                    ((dynamic_cast<StaticStorageClass *>(
                         declaration->getOptStorageClass())) == nullptr));
 
-    if (frontendSymbolTable->contains(declaration->getIdentifier())) {
+    if (frontendSymbolTable->contains(Symbol(declaration->getIdentifier()))) {
         auto &oldDeclaration =
-            (*frontendSymbolTable)[declaration->getIdentifier()];
+            (*frontendSymbolTable)[Symbol(declaration->getIdentifier())];
         auto *oldType = oldDeclaration.first.get();
         if (*oldType != *varType) {
             throw std::logic_error(
@@ -1072,7 +1072,7 @@ void TypeCheckingPass::typeCheckFileScopeVariableDeclaration(
     auto attribute =
         std::make_unique<StaticAttribute>(std::move(initialValue), global);
     // Store the corresponding variable type and attribute in the symbol table.
-    (*frontendSymbolTable)[declaration->getIdentifier()] = {
+    (*frontendSymbolTable)[Symbol(declaration->getIdentifier())] = {
         cloneType(varType), std::move(attribute)};
 }
 
@@ -1094,9 +1094,10 @@ void TypeCheckingPass::typeCheckLocalVariableDeclaration(
                 "Initializer on local extern variable declaration in "
                 "typeCheckLocalVariableDeclaration in TypeCheckingPass");
         }
-        if (frontendSymbolTable->contains(declaration->getIdentifier())) {
+        if (frontendSymbolTable->contains(
+                Symbol(declaration->getIdentifier()))) {
             auto &oldDeclaration =
-                (*frontendSymbolTable)[declaration->getIdentifier()];
+                (*frontendSymbolTable)[Symbol(declaration->getIdentifier())];
             auto *oldType = oldDeclaration.first.get();
             if (*oldType != *varType) {
                 throw std::logic_error(
@@ -1107,7 +1108,7 @@ void TypeCheckingPass::typeCheckLocalVariableDeclaration(
         else {
             auto staticAttribute = std::make_unique<StaticAttribute>(
                 std::make_unique<NoInitializer>(), true);
-            (*frontendSymbolTable)[declaration->getIdentifier()] =
+            (*frontendSymbolTable)[Symbol(declaration->getIdentifier())] =
                 std::make_pair(cloneType(varType), std::move(staticAttribute));
         }
     }
@@ -1180,12 +1181,12 @@ void TypeCheckingPass::typeCheckLocalVariableDeclaration(
         }
         auto staticAttribute =
             std::make_unique<StaticAttribute>(std::move(initialValue), false);
-        (*frontendSymbolTable)[declaration->getIdentifier()] =
+        (*frontendSymbolTable)[Symbol(declaration->getIdentifier())] =
             std::make_pair(cloneType(varType), std::move(staticAttribute));
     }
     else {
         auto localAttribute = std::make_unique<LocalAttribute>();
-        (*frontendSymbolTable)[declaration->getIdentifier()] =
+        (*frontendSymbolTable)[Symbol(declaration->getIdentifier())] =
             std::make_pair(cloneType(varType), std::move(localAttribute));
         if (declaration->getOptInitializer() != nullptr) {
             auto *initializer = declaration->getOptInitializer();
@@ -1249,9 +1250,8 @@ void TypeCheckingPass::typeCheckBlock(
 void TypeCheckingPass::typeCheckExpression(Expression *expression) {
     if (auto *functionCallExpression =
             dynamic_cast<FunctionCallExpression *>(expression)) {
-        auto *fType =
-            (*frontendSymbolTable)[functionCallExpression->getIdentifier()]
-                .first.get();
+        const Symbol identifier(functionCallExpression->getIdentifier());
+        auto *fType = (*frontendSymbolTable)[identifier].first.get();
         if (isArithmeticType(fType)) {
             throw std::logic_error("Function name used as variable in "
                                    "typeCheckExpression in TypeCheckingPass: " +
@@ -1316,7 +1316,7 @@ void TypeCheckingPass::typeCheckExpression(Expression *expression) {
     else if (auto *variableExpression =
                  dynamic_cast<VariableExpression *>(expression)) {
         auto *variableType =
-            (*frontendSymbolTable)[variableExpression->getIdentifier()]
+            (*frontendSymbolTable)[Symbol(variableExpression->getIdentifier())]
                 .first.get();
         // If the variable is not an arithmetic type, it is of type function.
         if (!isArithmeticType(variableType)) {
@@ -1414,7 +1414,8 @@ void TypeCheckingPass::typeCheckStatement(
         // Use the enclosing function's name to look up the enclosing function's
         // return type.
         auto *functionType =
-            (*frontendSymbolTable)[enclosingFunctionIdentifier].first.get();
+            (*frontendSymbolTable)[Symbol(enclosingFunctionIdentifier)]
+                .first.get();
         if (functionType == nullptr) {
             throw std::logic_error("Function not found in symbol table in "
                                    "typeCheckStatement in TypeCheckingPass: " +
@@ -0,0 +1,265 @@
+#include "simdScanner.h"
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FRONTEND_SIMD_SCANNER_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Unnamed namespace for the scanning kernels and their runtime dispatch.
+ */
+namespace {
+/**
+ * Type of a kernel that scans the input (given as a pointer and a size) from
+ * the cursor position and returns the position it stopped at.
+ */
+using ScanKernel = std::size_t (*)(const char *data, std::size_t size,
+                                   std::size_t cursor);
+
+/**
+ * Check if a character is a whitespace character (i.e., matched by `\s`).
+ *
+ * @param c The character to check.
+ * @return True if the character is a whitespace character, false otherwise.
+ */
+constexpr bool isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' ||
+           c == '\r';
+}
+
+std::size_t skipWhitespaceScalar(const char *data, std::size_t size,
+                                 std::size_t cursor) {
+    while (cursor < size && isWhitespace(data[cursor])) {
+        ++cursor;
+    }
+    return cursor;
+}
+
+std::size_t findNewlineScalar(const char *data, std::size_t size,
+                              std::size_t cursor) {
+    const auto *const newline = static_cast<const char *>(
+        std::memchr(data + cursor, '\n', size - cursor));
+    return newline == nullptr ? std::string_view::npos
+                              : static_cast<std::size_t>(newline - data);
+}
+
+std::size_t findBlockCommentEndScalar(const char *data, std::size_t size,
+                                      std::size_t cursor) {
+    for (; cursor + 1 < size; ++cursor) {
+        if (data[cursor] == '*' && data[cursor + 1] == '/') {
+            return cursor;
+        }
+    }
+    return std::string_view::npos;
+}
+
+#ifdef FRONTEND_SIMD_SCANNER_X86
+// Each vector kernel handles the full-width strides and leaves the tail of the
+// input (shorter than a stride) to the scalar kernel. The whitespace test
+// relies on `\t`, `\n`, `\v`, `\f`, and `\r` being the contiguous range 9-13:
+// a byte `c` is whitespace iff `c == ' '` or `min(c - 9, 4) == c - 9`
+// (unsigned).
+
+/**
+ * Load 16 bytes from an unaligned address.
+ */
+__m128i load128(const char *address) {
+    __m128i vector;
+    std::memcpy(&vector, address, sizeof(vector));
+    return vector;
+}
+
+std::size_t skipWhitespaceSSE2(const char *data, std::size_t size,
+                               std::size_t cursor) {
+    constexpr std::size_t stride = 16;
+    const auto space = _mm_set1_epi8(' ');
+    const auto tab = _mm_set1_epi8('\t');
+    const auto range = _mm_set1_epi8('\r' - '\t');
+    for (; cursor + stride <= size; cursor += stride) {
+        const auto chunk = load128(data + cursor);
+        const auto offset = _mm_sub_epi8(chunk, tab);
+        const auto isSpace = _mm_cmpeq_epi8(chunk, space);
+        const auto isControl =
+            _mm_cmpeq_epi8(_mm_min_epu8(offset, range), offset);
+        const auto whitespaceMask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_or_si128(isSpace, isControl)));
+        const auto otherMask = ~whitespaceMask & 0xFFFFU;
+        if (otherMask != 0) {
+            return cursor +
+                   static_cast<std::size_t>(std::countr_zero(otherMask));
+        }
+    }
+    return skipWhitespaceScalar(data, size, cursor);
+}
+
+std::size_t findNewlineSSE2(const char *data, std::size_t size,
+                            std::size_t cursor) {
+    constexpr std::size_t stride = 16;
+    const auto newline = _mm_set1_epi8('\n');
+    for (; cursor + stride <= size; cursor += stride) {
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(load128(data + cursor), newline)));
+        if (mask != 0) {
+            return cursor + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return findNewlineScalar(data, size, cursor);
+}
+
+std::size_t findBlockCommentEndSSE2(const char *data, std::size_t size,
+                                    std::size_t cursor) {
+    constexpr std::size_t stride = 16;
+    const auto star = _mm_set1_epi8('*');
+    const auto slash = _mm_set1_epi8('/');
+    // Compare each byte with `*` and the byte after it with `/`.
+    for (; cursor + stride + 1 <= size; cursor += stride) {
+        const auto isStar = _mm_cmpeq_epi8(load128(data + cursor), star);
+        const auto isSlash = _mm_cmpeq_epi8(load128(data + cursor + 1), slash);
+        const auto mask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_and_si128(isStar, isSlash)));
+        if (mask != 0) {
+            return cursor + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return findBlockCommentEndScalar(data, size, cursor);
+}
+
+/**
+ * Load 32 bytes from an unaligned address.
+ */
+__attribute__((target("avx2"))) __m256i load256(const char *address) {
+    __m256i vector;
+    std::memcpy(&vector, address, sizeof(vector));
+    return vector;
+}
+
+__attribute__((target("avx2"))) std::size_t
+skipWhitespaceAVX2(const char *data, std::size_t size, std::size_t cursor) {
+    constexpr std::size_t stride = 32;
+    const auto space = _mm256_set1_epi8(' ');
+    const auto tab = _mm256_set1_epi8('\t');
+    const auto range = _mm256_set1_epi8('\r' - '\t');
+    for (; cursor + stride <= size; cursor += stride) {
+        const auto chunk = load256(data + cursor);
+        const auto offset = _mm256_sub_epi8(chunk, tab);
+        const auto isSpace = _mm256_cmpeq_epi8(chunk, space);
+        const auto isControl =
+            _mm256_cmpeq_epi8(_mm256_min_epu8(offset, range), offset);
+        const auto otherMask = ~static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_or_si256(isSpace, isControl)));
+        if (otherMask != 0) {
+            return cursor +
+                   static_cast<std::size_t>(std::countr_zero(otherMask));
+        }
+    }
+    return skipWhitespaceSSE2(data, size, cursor);
+}
+
+__attribute__((target("avx2"))) std::size_t
+findNewlineAVX2(const char *data, std::size_t size, std::size_t cursor) {
+    constexpr std::size_t stride = 32;
+    const auto newline = _mm256_set1_epi8('\n');
+    for (; cursor + stride <= size; cursor += stride) {
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(load256(data + cursor), newline)));
+        if (mask != 0) {
+            return cursor + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return findNewlineSSE2(data, size, cursor);
+}
+
+__attribute__((target("avx2"))) std::size_t
+findBlockCommentEndAVX2(const char *data, std::size_t size,
+                        std::size_t cursor) {
+    constexpr std::size_t stride = 32;
+    const auto star = _mm256_set1_epi8('*');
+    const auto slash = _mm256_set1_epi8('/');
+    for (; cursor + stride + 1 <= size; cursor += stride) {
+        const auto isStar = _mm256_cmpeq_epi8(load256(data + cursor), star);
+        const auto isSlash =
+            _mm256_cmpeq_epi8(load256(data + cursor + 1), slash);
+        const auto mask = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_and_si256(isStar, isSlash)));
+        if (mask != 0) {
+            return cursor + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    return findBlockCommentEndSSE2(data, size, cursor);
+}
+#endif
+
+/**
+ * Structure holding the scanning kernels selected for the running CPU.
+ */
+struct ScanKernels {
+    ScanKernel skipWhitespace;
+    ScanKernel findNewline;
+    ScanKernel findBlockCommentEnd;
+};
+
+/**
+ * Select the widest scanning kernels supported by the running CPU (queried
+ * via CPUID).
+ *
+ * @return The selected scanning kernels.
+ */
+ScanKernels selectScanKernels() {
+#ifdef FRONTEND_SIMD_SCANNER_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return {.skipWhitespace = skipWhitespaceAVX2,
+                .findNewline = findNewlineAVX2,
+                .findBlockCommentEnd = findBlockCommentEndAVX2};
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return {.skipWhitespace = skipWhitespaceSSE2,
+                .findNewline = findNewlineSSE2,
+                .findBlockCommentEnd = findBlockCommentEndSSE2};
+    }
+#endif
+    return {.skipWhitespace = skipWhitespaceScalar,
+            .findNewline = findNewlineScalar,
+            .findBlockCommentEnd = findBlockCommentEndScalar};
+}
+
+/**
+ * Get the scanning kernels for the running CPU (selected on first use).
+ *
+ * @return The scanning kernels.
+ */
+const ScanKernels &getScanKernels() {
+    static const ScanKernels kernels = selectScanKernels();
+    return kernels;
+}
+} // namespace
+
+std::size_t skipWhitespaceRun(std::string_view input, std::size_t cursor) {
+    // Most runs of whitespace between tokens are a single character, so check
+    // the first two characters before dispatching to the vector kernel.
+    if (cursor >= input.size() || !isWhitespace(input[cursor])) {
+        return cursor;
+    }
+    if (++cursor >= input.size() || !isWhitespace(input[cursor])) {
+        return cursor;
+    }
+    return getScanKernels().skipWhitespace(input.data(), input.size(), cursor);
+}
+
+std::size_t findNewline(std::string_view input, std::size_t cursor) {
+    if (cursor >= input.size()) {
+        return std::string_view::npos;
+    }
+    return getScanKernels().findNewline(input.data(), input.size(), cursor);
+}
+
+std::size_t findBlockCommentEnd(std::string_view input, std::size_t cursor) {
+    if (cursor >= input.size()) {
+        return std::string_view::npos;
+    }
+    return getScanKernels().findBlockCommentEnd(input.data(), input.size(),
+                                                cursor);
+}
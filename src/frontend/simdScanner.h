@@ -0,0 +1,44 @@
+#ifndef FRONTEND_SIMD_SCANNER_H
+#define FRONTEND_SIMD_SCANNER_H
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * Skip the run of whitespace characters (i.e., characters matched by `\s`)
+ * starting at the cursor position of the input string.
+ *
+ * The scan is vectorized with AVX2 (32-byte strides) or SSE2 (16-byte strides),
+ * chosen at runtime via CPUID, and falls back to a scalar loop on other
+ * targets.
+ *
+ * @param input The input string to scan.
+ * @param cursor The position to start skipping from.
+ * @return The position of the first non-whitespace character (or the size of
+ * the input).
+ */
+std::size_t skipWhitespaceRun(std::string_view input, std::size_t cursor);
+
+/**
+ * Find the next newline character at or after the cursor position of the input
+ * string (e.g., the end of a `//` comment).
+ *
+ * @param input The input string to scan.
+ * @param cursor The position to start searching from.
+ * @return The position of the newline character, or `std::string_view::npos`
+ * if there is none.
+ */
+std::size_t findNewline(std::string_view input, std::size_t cursor);
+
+/**
+ * Find the next `*` `/` pair at or after the cursor position of the input
+ * string (i.e., the end of a multi-line comment).
+ *
+ * @param input The input string to scan.
+ * @param cursor The position to start searching from.
+ * @return The position of the `*` of the pair, or `std::string_view::npos` if
+ * there is none.
+ */
+std::size_t findBlockCommentEnd(std::string_view input, std::size_t cursor);
+
+#endif // FRONTEND_SIMD_SCANNER_H
@@ -0,0 +1,128 @@
+#include "sourceBuffer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <ios>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * Unnamed namespace for helper functions for the source buffer.
+ */
+namespace {
+/**
+ * Throw an I/O error for the source file, including the current `errno`
+ * description.
+ *
+ * @param what The description of the failed operation.
+ * @param sourceFileName The name of the source file.
+ */
+[[noreturn]] void throwIOError(std::string_view what,
+                               std::string_view sourceFileName) {
+    std::stringstream msg;
+    msg << what << ": " << sourceFileName << " (" << std::strerror(errno)
+        << ")";
+    throw std::ios_base::failure(msg.str());
+}
+
+/**
+ * RAII wrapper closing a file descriptor when it goes out of scope.
+ */
+class FileDescriptorCloser {
+  public:
+    explicit FileDescriptorCloser(int fileDescriptor)
+        : fileDescriptor(fileDescriptor) {}
+    ~FileDescriptorCloser() { ::close(fileDescriptor); }
+    FileDescriptorCloser(const FileDescriptorCloser &) = delete;
+    FileDescriptorCloser &operator=(const FileDescriptorCloser &) = delete;
+    FileDescriptorCloser(FileDescriptorCloser &&) = delete;
+    FileDescriptorCloser &operator=(FileDescriptorCloser &&) = delete;
+
+  private:
+    int fileDescriptor;
+};
+} // namespace
+
+SourceBuffer::SourceBuffer(std::string_view sourceFileName) {
+    const std::string sourceFileNameStr(sourceFileName);
+    const int fileDescriptor = ::open(sourceFileNameStr.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        throwIOError("Unable to open source file", sourceFileName);
+    }
+    const FileDescriptorCloser closer(fileDescriptor);
+
+    struct stat fileStatus {};
+    if (::fstat(fileDescriptor, &fileStatus) != 0) {
+        throwIOError("Unable to stat source file", sourceFileName);
+    }
+
+    // Map regular, non-empty files into memory (`mmap` rejects zero-length
+    // mappings). The mapping stays valid after the file descriptor is closed
+    // (and even after the file is removed), until it is unmapped.
+    if (S_ISREG(fileStatus.st_mode) && fileStatus.st_size > 0) {
+        const auto fileSize = static_cast<std::size_t>(fileStatus.st_size);
+        void *mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE,
+                               fileDescriptor, 0);
+        if (mapping != MAP_FAILED) {
+            // The lexer scans the buffer front to back exactly once.
+            ::madvise(mapping, fileSize, MADV_SEQUENTIAL);
+            data = static_cast<const char *>(mapping);
+            size = fileSize;
+            isMapped = true;
+            return;
+        }
+        readAll(fileDescriptor, fileSize, sourceFileName);
+        return;
+    }
+    readAll(fileDescriptor, 0, sourceFileName);
+}
+
+SourceBuffer::~SourceBuffer() {
+    if (isMapped) {
+        ::munmap(const_cast<char *>(data), size);
+    }
+}
+
+std::string_view SourceBuffer::getContents() const { return {data, size}; }
+
+void SourceBuffer::readAll(int fileDescriptor, std::size_t sizeHint,
+                           std::string_view sourceFileName) {
+    // Read in large chunks, doubling the capacity of the heap buffer whenever
+    // it fills up (which only happens when the size of the file is unknown).
+    constexpr std::size_t minimumCapacity = 64 * 1024;
+    std::size_t capacity = std::max(sizeHint + 1, minimumCapacity);
+    auto buffer = std::make_unique_for_overwrite<char[]>(capacity);
+    std::size_t length = 0;
+    while (true) {
+        if (length == capacity) {
+            auto grownBuffer =
+                std::make_unique_for_overwrite<char[]>(capacity * 2);
+            std::copy_n(buffer.get(), length, grownBuffer.get());
+            buffer = std::move(grownBuffer);
+            capacity *= 2;
+        }
+        const auto bytesRead =
+            ::read(fileDescriptor, buffer.get() + length, capacity - length);
+        if (bytesRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwIOError("Unable to read source file", sourceFileName);
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        length += static_cast<std::size_t>(bytesRead);
+    }
+    readBuffer = std::move(buffer);
+    data = readBuffer.get();
+    size = length;
+}
@@ -0,0 +1,95 @@
+#ifndef FRONTEND_SOURCE_BUFFER_H
+#define FRONTEND_SOURCE_BUFFER_H
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+/**
+ * Class owning the contents of a source file in a single contiguous buffer.
+ *
+ * The buffer is a read-only memory mapping of the source file where possible,
+ * and otherwise a heap buffer filled with bulk `read()` calls. The values of
+ * the tokens produced by the lexer are views into this buffer, so the buffer
+ * must outlive the tokens lexed from it.
+ */
+class SourceBuffer {
+  public:
+    /**
+     * Constructor for the source buffer class.
+     *
+     * Map the source file into memory, falling back to reading the entire
+     * source file into a heap buffer if the file cannot be mapped (e.g., if it
+     * is a pipe).
+     *
+     * @param sourceFileName The name of the source file to read.
+     */
+    explicit SourceBuffer(std::string_view sourceFileName);
+
+    /**
+     * Destructor for the source buffer class.
+     *
+     * Unmap the source file if it was mapped into memory.
+     */
+    ~SourceBuffer();
+
+    /**
+     * Delete the copy constructor for the source buffer class.
+     */
+    SourceBuffer(const SourceBuffer &) = delete;
+
+    /**
+     * Delete the copy assignment operator for the source buffer class.
+     */
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    /**
+     * Delete the move constructor for the source buffer class.
+     */
+    SourceBuffer(SourceBuffer &&) = delete;
+
+    /**
+     * Delete the move assignment operator for the source buffer class.
+     */
+    SourceBuffer &operator=(SourceBuffer &&) = delete;
+
+    /**
+     * Get the contents of the source buffer.
+     *
+     * @return A view of the contents of the source buffer.
+     */
+    [[nodiscard]] std::string_view getContents() const;
+
+  private:
+    /**
+     * The start of the contents of the source file (either the memory mapping
+     * or the heap buffer).
+     */
+    const char *data = nullptr;
+    /**
+     * The size of the contents of the source file (in bytes).
+     */
+    std::size_t size = 0;
+    /**
+     * Whether the contents of the source file are memory-mapped.
+     */
+    bool isMapped = false;
+    /**
+     * The heap buffer holding the contents of the source file if the source
+     * file could not be memory-mapped.
+     */
+    std::unique_ptr<char[]> readBuffer;
+
+    /**
+     * Read the entire file into the heap buffer with bulk `read()` calls.
+     *
+     * @param fileDescriptor The file descriptor of the file to read.
+     * @param sizeHint The expected size of the file (in bytes), or 0 if the
+     * size is unknown.
+     * @param sourceFileName The name of the file (for error messages).
+     */
+    void readAll(int fileDescriptor, std::size_t sizeHint,
+                 std::string_view sourceFileName);
+};
+
+#endif // FRONTEND_SOURCE_BUFFER_H
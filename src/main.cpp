@@ -1,16 +1,24 @@
+#include "frontend/astArena.h"
 #include "frontend/frontendSymbolTable.h"
+#include "frontend/sourceBuffer.h"
+#include "midend/irOptimizationPasses.h"
 #include "utils/compilerDriver.h"
 #include "utils/pipelineStagesExecutors.h"
 #include "utils/prettyPrinters.h"
+#include "utils/threadPool.h"
+#include <charconv>
 #include <cstddef>
 #include <cstdlib>
 #include <exception>
 #include <filesystem>
 #include <iostream>
+#include <optional>
 #include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <utility>
 #include <vector>
 
@@ -20,13 +28,14 @@ int main(int argc, char *argv[]) {
         auto args = std::span(argv, static_cast<std::size_t>(argc));
         std::vector<std::string> flags;
         std::string sourceFile;
+        constexpr std::string_view threadsFlag = "--threads=";
         std::string outputFileName;
         bool isOutputFileSpecified = false;
         if (argc < 2) {
             std::cerr
                 << "Usage: " << args[0]
                 << " [--lex] [--parse] [--validate] [--tacky] [--codegen] [-S] "
-                   "[-s] [-c] [-o <outputFile>] <sourceFile>\n";
+                   "[-s] [-c] [-j <threads>] [-o <outputFile>] <sourceFile>\n";
             std::cerr << "Given argc: " << argc << "\n";
             return EXIT_FAILURE;
         }
@@ -43,6 +52,15 @@ int main(int argc, char *argv[]) {
                 isOutputFileSpecified = true;
                 continue;
             }
+            if (arg == "-j" || arg == "--threads") {
+                if (i + 1 >= static_cast<std::size_t>(argc)) {
+                    std::cerr << "Missing thread count after " << arg << "\n";
+                    return EXIT_FAILURE;
+                }
+                // Normalize the separate-argument form to the joined one.
+                flags.emplace_back(std::string(threadsFlag) + args[++i]);
+                continue;
+            }
             if (!arg.empty() && arg[0] == '-') {
                 flags.emplace_back(arg);
                 continue;
@@ -57,7 +75,7 @@ int main(int argc, char *argv[]) {
             std::cerr
                 << "Usage: " << args[0]
                 << " [--lex] [--parse] [--validate] [--tacky] [--codegen] [-S] "
-                   "[-s] [-c] [-o <outputFile>] <sourceFile>\n";
+                   "[-s] [-c] [-j <threads>] [-o <outputFile>] <sourceFile>\n";
             return EXIT_FAILURE;
         }
 
@@ -70,10 +88,27 @@ int main(int argc, char *argv[]) {
         bool tillCodegen = false;
         bool tillEmitAssembly = false;
         bool tillObject = false;
-        bool foldConstantsPass = false;
-        bool propagateCopiesPass = false;
-        bool eliminateUnreachableCodePass = false;
-        bool eliminateDeadStoresPass = false;
+        IR::OptimizationOptions optimizationOptions;
+        constexpr std::string_view maxOptimizationIterationsFlag =
+            "--max-optimization-iterations=";
+        // The number of threads to run the per-function stages on (`0` for
+        // the number of hardware threads).
+        std::size_t threadCount = 1;
+        bool useDFALexer = false;
+        bool roundTripFlatIR = false;
+        // Parse the (whole) value of a count flag: a string of decimal digits
+        // (`std::from_chars` accepts neither whitespace nor a sign).
+        auto parseCount =
+            [](std::string_view value) -> std::optional<std::size_t> {
+            std::size_t count = 0;
+            const auto *const end = value.data() + value.size();
+            const auto [parsedEnd, error] =
+                std::from_chars(value.data(), end, count);
+            if (error != std::errc{} || parsedEnd != end) {
+                return std::nullopt;
+            }
+            return count;
+        };
         for (const auto &flag : flags) {
             // Direct the compiler to run the lexer, but stop before the parser.
             if (flag == "--lex") {
@@ -109,28 +144,110 @@ int main(int argc, char *argv[]) {
             else if (flag == "-c") {
                 tillObject = true;
             }
+            // Direct the compiler to lex with the single-pass DFA scanner
+            // instead of the regular expressions.
+            else if (flag == "--dfa-lexer") {
+                useDFALexer = true;
+            }
+            // Direct the compiler to convert each function body to the flat
+            // IR and back before code generation.
+            else if (flag == "--flat-ir-round-trip") {
+                roundTripFlatIR = true;
+            }
             // Direct the compiler to fold constants.
             else if (flag == "--fold-constants") {
-                foldConstantsPass = true;
+                optimizationOptions.foldConstants = true;
+            }
+            // Direct the compiler to simplify algebraic identities.
+            else if (flag == "--simplify-algebra") {
+                optimizationOptions.simplifyAlgebra = true;
             }
             // Direct the compiler to propagate copies.
             else if (flag == "--propagate-copies") {
-                propagateCopiesPass = true;
+                optimizationOptions.propagateCopies = true;
             }
             // Direct the compiler to eliminate unreachable code.
             else if (flag == "--eliminate-unreachable-code") {
-                eliminateUnreachableCodePass = true;
+                optimizationOptions.eliminateUnreachableCode = true;
             }
             // Direct the compiler to eliminate dead stores.
             else if (flag == "--eliminate-dead-stores") {
-                eliminateDeadStoresPass = true;
+                optimizationOptions.eliminateDeadStores = true;
+            }
+            // Direct the compiler to propagate constants (and prune the
+            // branches never taken) on SSA form.
+            else if (flag == "--propagate-constants") {
+                optimizationOptions.propagateConstants = true;
+            }
+            // Direct the compiler to eliminate common subexpressions (by
+            // global value numbering on SSA form).
+            else if (flag == "--eliminate-common-subexpressions") {
+                optimizationOptions.eliminateCommonSubexpressions = true;
+            }
+            // Direct the compiler to convert each function body into SSA
+            // form and back at the end of each optimization iteration.
+            else if (flag == "--ssa") {
+                optimizationOptions.convertToSSA = true;
+            }
+            // Direct the compiler to hoist loop-invariant instructions into
+            // the preheaders of their loops.
+            else if (flag == "--licm") {
+                optimizationOptions.moveLoopInvariants = true;
+            }
+            // Direct the compiler to replace the multiplications of
+            // induction variables by constants with additive updates.
+            else if (flag == "--reduce-induction-variables") {
+                optimizationOptions.reduceInductionVariables = true;
             }
             // Direct the compiler to perform all the optimization passes.
             else if (flag == "--optimize") {
-                foldConstantsPass = true;
-                propagateCopiesPass = true;
-                eliminateUnreachableCodePass = true;
-                eliminateDeadStoresPass = true;
+                optimizationOptions.foldConstants = true;
+                optimizationOptions.simplifyAlgebra = true;
+                optimizationOptions.propagateCopies = true;
+                optimizationOptions.eliminateUnreachableCode = true;
+                optimizationOptions.eliminateDeadStores = true;
+                optimizationOptions.propagateConstants = true;
+                optimizationOptions.eliminateCommonSubexpressions = true;
+                optimizationOptions.moveLoopInvariants = true;
+                optimizationOptions.reduceInductionVariables = true;
+            }
+            // Direct the compiler to iterate the optimization passes at most
+            // the given (positive) number of times.
+            else if (flag.starts_with(maxOptimizationIterationsFlag)) {
+                const auto maxIterations = parseCount(
+                    std::string_view(flag).substr(
+                        maxOptimizationIterationsFlag.size()));
+                if (!maxIterations || *maxIterations == 0) {
+                    std::cerr << "Invalid iteration cap in flag: " << flag
+                              << "\n";
+                    return EXIT_FAILURE;
+                }
+                optimizationOptions.maxIterations = *maxIterations;
+            }
+            // Direct the compiler to run the per-function stages on the given
+            // number of threads (`0` for the number of hardware threads).
+            else if (flag.starts_with(threadsFlag) || flag.starts_with("-j")) {
+                const auto value =
+                    std::string_view(flag).substr(flag.starts_with(threadsFlag)
+                                                      ? threadsFlag.size()
+                                                      : 2);
+                const auto parsedThreadCount = parseCount(value);
+                if (!parsedThreadCount) {
+                    std::cerr << "Invalid thread count in flag: " << flag
+                              << "\n";
+                    return EXIT_FAILURE;
+                }
+                threadCount = *parsedThreadCount;
+                // Clamp the number of threads (with a warning), since every
+                // thread beyond a few per hardware thread only adds overhead.
+                if (threadCount > ThreadPool::getMaxThreadCount()) {
+                    threadCount = ThreadPool::getMaxThreadCount();
+                    std::cerr << "Warning: thread count in flag " << flag
+                              << " exceeds the maximum of " << threadCount
+                              << " (" << ThreadPool::maxThreadsPerHardwareThread
+                              << " per hardware thread); using " << threadCount
+                              << " threads\n";
+                }
             }
             else {
                 std::cerr << "Unsupported command-line flag: " << flag << "\n";
@@ -188,9 +305,17 @@ int main(int argc, char *argv[]) {
         // Preprocess the source file and write the result to the preprocessed.
         preprocess(sourceFile, preprocessedFileName);
 
+        // Read the preprocessed file into the source buffer, which must
+        // outlive the tokens (whose values are views into it).
+        const SourceBuffer sourceBuffer(preprocessedFileName);
+
+        // Construct the arena for the AST nodes, which must outlive the AST
+        // program (and anything else holding AST nodes created by the parser).
+        AST::ASTArena astArena;
+
         // Tokenize the input, print the tokens, and return the tokens.
         auto tokens =
-            PipelineStagesExecutors::lexerExecutor(preprocessedFileName);
+            PipelineStagesExecutors::lexerExecutor(sourceBuffer, useDFALexer);
 
         // Delete the preprocessed file after compiling it to assembly.
         std::filesystem::remove(preprocessedFileName);
@@ -202,7 +327,8 @@ int main(int argc, char *argv[]) {
 
         // Parse the tokens, generate the AST, visit the AST, and print the AST,
         // and return the AST program.
-        auto astProgram = PipelineStagesExecutors::parserExecutor(tokens);
+        auto astProgram =
+            PipelineStagesExecutors::parserExecutor(tokens, astArena);
 
         if (tillParse) {
             std::cout << "Parsing completed.\n";
@@ -228,17 +354,22 @@ int main(int argc, char *argv[]) {
         auto irStaticVariables =
             std::move(irProgramAndIRStaticVariables.second);
 
-        if (foldConstantsPass || propagateCopiesPass ||
-            eliminateUnreachableCodePass || eliminateDeadStoresPass) {
+        // Construct the thread pool for the per-function stages (the
+        // optimization passes and code generation).
+        ThreadPool threadPool(threadCount);
+
+        if (optimizationOptions.isAnyEnabled()) {
             // Print the IR program to stdout.
             std::cout << "<<< Before optimization passes: >>>\n";
             PrettyPrinters::printIRProgram(*irProgram, *irStaticVariables);
 
             // Perform the optimization passes on the IR program (if any of the
-            // flags is set to true).
-            PipelineStagesExecutors::irOptimizationExecutor(
-                *irProgram, foldConstantsPass, propagateCopiesPass,
-                eliminateUnreachableCodePass, eliminateDeadStoresPass);
+            // flags is set to true), one function definition per task.
+            const auto optimizationStatistics =
+                PipelineStagesExecutors::irOptimizationExecutor(
+                    *irProgram, frontendSymbolTable, optimizationOptions,
+                    threadPool);
+            PrettyPrinters::printOptimizationStatistics(optimizationStatistics);
 
             // Print the optimized IR program to stdout (after the
             // optimization passes).
@@ -257,10 +388,17 @@ int main(int argc, char *argv[]) {
             return EXIT_SUCCESS;
         }
 
+        // Convert the IR program to the flat IR and back (if requested), one
+        // function definition per task.
+        if (roundTripFlatIR) {
+            PipelineStagesExecutors::flatIRRoundTripExecutor(*irProgram,
+                                                             threadPool);
+        }
+
         // Generate the assembly program from the IR program and the IR static
         // variables.
         auto assemblyProgram = PipelineStagesExecutors::codegenExecutor(
-            *irProgram, *irStaticVariables, frontendSymbolTable);
+            *irProgram, *irStaticVariables, frontendSymbolTable, threadPool);
 
         // Print out the (assembly) instructions that would be emitted from the
         // assembly program.
@@ -0,0 +1,64 @@
+#include "algebraicSimplification.h"
+#include "constantEvaluator.h"
+#include "flatIR.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * Unnamed namespace for helper functions for the algebraic simplifier.
+ */
+namespace {
+/**
+ * Check whether the right operand of a binary instruction matches a pattern.
+ *
+ * @param pattern The pattern.
+ * @param rhs The right operand, if it is a constant.
+ * @param isSameOperand Whether both operands are the same variable.
+ * @return True if the operand matches the pattern, false otherwise.
+ */
+bool matchesPattern(IR::OperandPattern pattern,
+                    std::optional<IR::FlatConstant> rhs, bool isSameOperand) {
+    switch (pattern) {
+    case IR::OperandPattern::Zero:
+        return rhs.has_value() && rhs->bits == 0;
+    case IR::OperandPattern::One:
+        return rhs.has_value() && rhs->bits == 1;
+    case IR::OperandPattern::MinusOne:
+        return rhs.has_value() &&
+               rhs->bits == IR::makeConstant(rhs->kind, ~std::uint64_t{0}).bits;
+    case IR::OperandPattern::SameAsLeft:
+        return isSameOperand;
+    }
+    return false;
+}
+} // namespace
+
+namespace IR {
+std::optional<std::size_t> findBinaryIdentity(BinaryOpcode opcode,
+                                              std::optional<FlatConstant> rhs,
+                                              bool isSameOperand) {
+    for (std::size_t index = 0; index < simplificationRules.size(); ++index) {
+        const auto &rule = simplificationRules[index];
+        if (rule.kind == SimplificationRuleKind::BinaryIdentity &&
+            rule.binaryOpcode == opcode &&
+            matchesPattern(rule.pattern, rhs, isSameOperand)) {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::size_t> findStructuralRule(SimplificationRuleKind kind,
+                                              UnaryOpcode unaryOpcode) {
+    for (std::size_t index = 0; index < simplificationRules.size(); ++index) {
+        const auto &rule = simplificationRules[index];
+        if (rule.kind == kind &&
+            (kind != SimplificationRuleKind::DoubleUnary ||
+             rule.unaryOpcode == unaryOpcode)) {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+} // namespace IR
@@ -0,0 +1,190 @@
+#ifndef MIDEND_ALGEBRAIC_SIMPLIFICATION_H
+#define MIDEND_ALGEBRAIC_SIMPLIFICATION_H
+
+#include "flatIR.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace IR {
+/**
+ * Enumeration representing the kinds of rules of the algebraic simplifier.
+ */
+enum class SimplificationRuleKind : std::uint8_t {
+    /**
+     * Swap the constant left operand of a commutative operator (or of a
+     * comparison, mirroring it) with its variable right operand.
+     */
+    ConstantToRight,
+    /**
+     * Replace a binary instruction whose right operand matches a pattern by
+     * a simpler result.
+     */
+    BinaryIdentity,
+    /**
+     * Replace a unary operator applied twice (e.g., `-(-x)`) by its operand.
+     */
+    DoubleUnary,
+    /**
+     * Replace a conditional jump on `!x` by the opposite conditional jump on
+     * `x` (so that `!!x` in a branch becomes `x`).
+     */
+    BranchOnNot
+};
+
+/**
+ * Enumeration representing the patterns the right operand of a binary
+ * instruction can match (the left operand is any value).
+ */
+enum class OperandPattern : std::uint8_t {
+    Zero,
+    One,
+    MinusOne,
+    SameAsLeft
+};
+
+/**
+ * Enumeration representing the results of binary identities.
+ */
+enum class SimplificationResult : std::uint8_t {
+    Left,
+    Zero,
+    One,
+    NegatedLeft
+};
+
+/**
+ * Structure representing a rule of the algebraic simplifier (the fields that
+ * do not apply to its kind are left at their defaults).
+ */
+struct SimplificationRule {
+    std::string_view name;
+    SimplificationRuleKind kind = SimplificationRuleKind::BinaryIdentity;
+    BinaryOpcode binaryOpcode = BinaryOpcode::Add;
+    OperandPattern pattern = OperandPattern::Zero;
+    SimplificationResult result = SimplificationResult::Left;
+    UnaryOpcode unaryOpcode = UnaryOpcode::Negate;
+};
+
+/**
+ * Make a binary identity rule: `x <opcode> <pattern>` becomes `<result>`.
+ *
+ * @param name The name of the rule.
+ * @param opcode The binary operator.
+ * @param pattern The pattern of the right operand.
+ * @param result The result.
+ * @return The rule.
+ */
+constexpr SimplificationRule makeBinaryIdentity(std::string_view name,
+                                                BinaryOpcode opcode,
+                                                OperandPattern pattern,
+                                                SimplificationResult result) {
+    return {.name = name,
+            .kind = SimplificationRuleKind::BinaryIdentity,
+            .binaryOpcode = opcode,
+            .pattern = pattern,
+            .result = result,
+            .unaryOpcode = UnaryOpcode::Negate};
+}
+
+/**
+ * Make a rule of another kind than the binary identities.
+ *
+ * @param name The name of the rule.
+ * @param kind The kind of the rule.
+ * @param unaryOpcode The unary operator (for `DoubleUnary`).
+ * @return The rule.
+ */
+constexpr SimplificationRule
+makeStructuralRule(std::string_view name, SimplificationRuleKind kind,
+                   UnaryOpcode unaryOpcode = UnaryOpcode::Negate) {
+    return {.name = name,
+            .kind = kind,
+            .binaryOpcode = BinaryOpcode::Add,
+            .pattern = OperandPattern::Zero,
+            .result = SimplificationResult::Left,
+            .unaryOpcode = unaryOpcode};
+}
+
+/**
+ * The rules of the algebraic simplifier (the first binary identity that
+ * matches an instruction applies). None of them removes a division that
+ * could trap at runtime.
+ */
+inline constexpr std::array simplificationRules = {
+    makeStructuralRule("constant-to-right",
+                       SimplificationRuleKind::ConstantToRight),
+    makeBinaryIdentity("add-zero", BinaryOpcode::Add, OperandPattern::Zero,
+                       SimplificationResult::Left),
+    makeBinaryIdentity("subtract-zero", BinaryOpcode::Subtract,
+                       OperandPattern::Zero, SimplificationResult::Left),
+    makeBinaryIdentity("subtract-self", BinaryOpcode::Subtract,
+                       OperandPattern::SameAsLeft, SimplificationResult::Zero),
+    makeBinaryIdentity("multiply-one", BinaryOpcode::Multiply,
+                       OperandPattern::One, SimplificationResult::Left),
+    makeBinaryIdentity("multiply-zero", BinaryOpcode::Multiply,
+                       OperandPattern::Zero, SimplificationResult::Zero),
+    makeBinaryIdentity("multiply-minus-one", BinaryOpcode::Multiply,
+                       OperandPattern::MinusOne,
+                       SimplificationResult::NegatedLeft),
+    makeBinaryIdentity("divide-one", BinaryOpcode::Divide, OperandPattern::One,
+                       SimplificationResult::Left),
+    makeBinaryIdentity("remainder-one", BinaryOpcode::Remainder,
+                       OperandPattern::One, SimplificationResult::Zero),
+    makeBinaryIdentity("equal-self", BinaryOpcode::Equal,
+                       OperandPattern::SameAsLeft, SimplificationResult::One),
+    makeBinaryIdentity("not-equal-self", BinaryOpcode::NotEqual,
+                       OperandPattern::SameAsLeft, SimplificationResult::Zero),
+    makeBinaryIdentity("less-than-self", BinaryOpcode::LessThan,
+                       OperandPattern::SameAsLeft, SimplificationResult::Zero),
+    makeBinaryIdentity("less-than-or-equal-self",
+                       BinaryOpcode::LessThanOrEqual,
+                       OperandPattern::SameAsLeft, SimplificationResult::One),
+    makeBinaryIdentity("greater-than-self", BinaryOpcode::GreaterThan,
+                       OperandPattern::SameAsLeft, SimplificationResult::Zero),
+    makeBinaryIdentity("greater-than-or-equal-self",
+                       BinaryOpcode::GreaterThanOrEqual,
+                       OperandPattern::SameAsLeft, SimplificationResult::One),
+    makeStructuralRule("double-negation", SimplificationRuleKind::DoubleUnary,
+                       UnaryOpcode::Negate),
+    makeStructuralRule("double-complement",
+                       SimplificationRuleKind::DoubleUnary,
+                       UnaryOpcode::Complement),
+    makeStructuralRule("branch-on-not", SimplificationRuleKind::BranchOnNot),
+};
+
+/**
+ * The number of rules of the algebraic simplifier.
+ */
+inline constexpr std::size_t simplificationRuleCount =
+    simplificationRules.size();
+
+/**
+ * Find the first binary identity that matches a binary instruction.
+ *
+ * @param opcode The binary operator of the instruction.
+ * @param rhs The right operand of the instruction, if it is a constant.
+ * @param isSameOperand Whether both operands are the same variable.
+ * @return The index of the rule in `simplificationRules`, or `std::nullopt`
+ * if none matches.
+ */
+[[nodiscard]] std::optional<std::size_t>
+findBinaryIdentity(BinaryOpcode opcode, std::optional<FlatConstant> rhs,
+                   bool isSameOperand);
+
+/**
+ * Find the rule of a given kind (and unary operator, for `DoubleUnary`).
+ *
+ * @param kind The kind of the rule.
+ * @param unaryOpcode The unary operator (for `DoubleUnary`).
+ * @return The index of the rule in `simplificationRules`, or `std::nullopt`
+ * if there is none.
+ */
+[[nodiscard]] std::optional<std::size_t>
+findStructuralRule(SimplificationRuleKind kind,
+                   UnaryOpcode unaryOpcode = UnaryOpcode::Negate);
+} // namespace IR
+
+#endif // MIDEND_ALGEBRAIC_SIMPLIFICATION_H
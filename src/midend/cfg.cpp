@@ -0,0 +1,233 @@
+#include "cfg.h"
+#include "ir.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Unnamed namespace for helper functions for the control flow graph (CFG).
+ */
+namespace {
+/**
+ * Check whether an instruction ends a basic block (control cannot fall
+ * through it unconditionally).
+ *
+ * @param instruction The instruction to check.
+ * @return True if the instruction ends a basic block, false otherwise.
+ */
+bool endsBasicBlock(const IR::Instruction &instruction) {
+    switch (instruction.getKind()) {
+    case IR::Instruction::Kind::Return:
+    case IR::Instruction::Kind::Jump:
+    case IR::Instruction::Kind::JumpIfZero:
+    case IR::Instruction::Kind::JumpIfNotZero:
+        return true;
+    default:
+        return false;
+    }
+}
+} // namespace
+
+namespace IR {
+CFG CFG::makeControlFlowGraph(
+    std::vector<std::unique_ptr<Instruction>> &&functionBody) {
+    CFG cfg;
+    // Add the entry node.
+    cfg.blocks.emplace_back();
+
+    BasicBlock current;
+    auto finishBlock = [&cfg, &current]() {
+        if (!current.instructions.empty()) {
+            cfg.blocks.emplace_back(std::move(current));
+            current = BasicBlock{};
+        }
+    };
+    for (auto &instruction : functionBody) {
+        // A label starts a new basic block (it may be a jump target).
+        if (instruction->getKind() == Instruction::Kind::Label) {
+            finishBlock();
+        }
+        const bool endsBlock = endsBasicBlock(*instruction);
+        current.instructions.emplace_back(std::move(instruction));
+        if (endsBlock) {
+            finishBlock();
+        }
+    }
+    finishBlock();
+    functionBody.clear();
+
+    // Add the exit node.
+    cfg.blocks.emplace_back();
+    for (std::size_t id = 0; id < cfg.blocks.size(); ++id) {
+        cfg.blocks[id].id = id;
+    }
+    cfg.recomputeEdges();
+    return cfg;
+}
+
+std::vector<std::unique_ptr<Instruction>> CFG::cfgToInstructions(CFG &&cfg) {
+    std::size_t instructionCount = 0;
+    for (const auto &block : cfg.blocks) {
+        instructionCount += block.instructions.size();
+    }
+    std::vector<std::unique_ptr<Instruction>> instructions;
+    instructions.reserve(instructionCount);
+    for (auto &block : cfg.blocks) {
+        for (auto &instruction : block.instructions) {
+            instructions.emplace_back(std::move(instruction));
+        }
+        block.instructions.clear();
+    }
+    return instructions;
+}
+
+std::size_t CFG::getExitId() const { return blocks.size() - 1; }
+
+const std::vector<BasicBlock> &CFG::getBlocks() const { return blocks; }
+
+std::vector<BasicBlock> &CFG::getBlocks() { return blocks; }
+
+const BasicBlock &CFG::getBlock(std::size_t id) const {
+    checkBlockId(id, "getBlock");
+    return blocks[id];
+}
+
+BasicBlock &CFG::getBlock(std::size_t id) {
+    checkBlockId(id, "getBlock");
+    return blocks[id];
+}
+
+std::optional<std::size_t>
+CFG::getBlockIdForLabel(Symbol label) const {
+    auto it = labelBlockIds.find(label);
+    if (it == labelBlockIds.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void CFG::addEdge(std::size_t from, std::size_t to) {
+    checkBlockId(from, "addEdge");
+    checkBlockId(to, "addEdge");
+    auto &successors = blocks[from].successors;
+    if (std::ranges::find(successors, to) != successors.end()) {
+        return;
+    }
+    successors.emplace_back(to);
+    blocks[to].predecessors.emplace_back(from);
+}
+
+void CFG::removeEdge(std::size_t from, std::size_t to) {
+    checkBlockId(from, "removeEdge");
+    checkBlockId(to, "removeEdge");
+    std::erase(blocks[from].successors, to);
+    std::erase(blocks[to].predecessors, from);
+}
+
+void CFG::removeBlock(std::size_t id) {
+    checkBlockId(id, "removeBlock");
+    if (id == getEntryId() || id == getExitId()) {
+        throw std::logic_error(
+            "Removing entry or exit node in removeBlock in CFG");
+    }
+    auto &block = blocks[id];
+    for (auto successor : block.successors) {
+        std::erase(blocks[successor].predecessors, id);
+    }
+    for (auto predecessor : block.predecessors) {
+        std::erase(blocks[predecessor].successors, id);
+    }
+    block.successors.clear();
+    block.predecessors.clear();
+    block.instructions.clear();
+    block.removed = true;
+}
+
+void CFG::recomputeEdges() {
+    labelBlockIds.clear();
+    for (auto &block : blocks) {
+        block.predecessors.clear();
+        block.successors.clear();
+    }
+
+    const auto exitId = getExitId();
+    for (std::size_t id = getEntryId() + 1; id < exitId; ++id) {
+        const auto &block = blocks[id];
+        if (block.removed || block.instructions.empty()) {
+            continue;
+        }
+        const auto &first = *block.instructions.front();
+        if (first.getKind() == Instruction::Kind::Label) {
+            labelBlockIds.emplace(
+                static_cast<const LabelInstruction &>(first).getLabelSymbol(),
+                id);
+        }
+    }
+
+    auto nextBlockId = [this, exitId](std::size_t id) {
+        auto next = id + 1;
+        while (next < exitId && blocks[next].removed) {
+            ++next;
+        }
+        return next;
+    };
+    auto targetBlockId = [this](Symbol target) {
+        auto it = labelBlockIds.find(target);
+        if (it == labelBlockIds.end()) {
+            throw std::logic_error("Jump to unknown label " + target.str() +
+                                   " in recomputeEdges in CFG");
+        }
+        return it->second;
+    };
+
+    addEdge(getEntryId(), nextBlockId(getEntryId()));
+    for (std::size_t id = getEntryId() + 1; id < exitId; ++id) {
+        const auto &block = blocks[id];
+        if (block.removed) {
+            continue;
+        }
+        if (block.instructions.empty()) {
+            addEdge(id, nextBlockId(id));
+            continue;
+        }
+        const auto &last = *block.instructions.back();
+        switch (last.getKind()) {
+        case Instruction::Kind::Return:
+            addEdge(id, exitId);
+            break;
+        case Instruction::Kind::Jump:
+            addEdge(id, targetBlockId(
+                            static_cast<const JumpInstruction &>(last)
+                                .getTargetSymbol()));
+            break;
+        case Instruction::Kind::JumpIfZero:
+            addEdge(id, targetBlockId(
+                            static_cast<const JumpIfZeroInstruction &>(last)
+                                .getTargetSymbol()));
+            addEdge(id, nextBlockId(id));
+            break;
+        case Instruction::Kind::JumpIfNotZero:
+            addEdge(id, targetBlockId(
+                            static_cast<const JumpIfNotZeroInstruction &>(last)
+                                .getTargetSymbol()));
+            addEdge(id, nextBlockId(id));
+            break;
+        default:
+            addEdge(id, nextBlockId(id));
+            break;
+        }
+    }
+}
+
+void CFG::checkBlockId(std::size_t id, const char *functionName) const {
+    if (id >= blocks.size()) {
+        throw std::logic_error(std::string("Out-of-range block ID in ") +
+                               functionName + " in CFG");
+    }
+}
+} // namespace IR
@@ -0,0 +1,209 @@
+#ifndef MIDEND_CFG_H
+#define MIDEND_CFG_H
+
+#include "../utils/symbol.h"
+#include "ir.h"
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace IR {
+/**
+ * Structure representing a node of a control flow graph (CFG): a basic block
+ * (a maximal straight-line sequence of IR instructions that can only be
+ * entered at its first instruction and only left after its last one), or one
+ * of the (empty) entry and exit nodes.
+ */
+struct BasicBlock {
+    /**
+     * The ID of the node (its index in the nodes of the CFG).
+     */
+    std::size_t id = 0;
+    /**
+     * The instructions of the basic block (empty for the entry and exit
+     * nodes).
+     */
+    std::vector<std::unique_ptr<Instruction>> instructions;
+    /**
+     * The IDs of the predecessors of the node.
+     */
+    std::vector<std::size_t> predecessors;
+    /**
+     * The IDs of the successors of the node.
+     */
+    std::vector<std::size_t> successors;
+    /**
+     * Boolean indicating whether the basic block has been removed from the
+     * CFG (removed basic blocks keep their IDs but have no instructions and
+     * no edges).
+     */
+    bool removed = false;
+};
+
+/**
+ * Class representing the control flow graph (CFG) of an IR function body.
+ *
+ * The nodes are stored by ID: the entry node is always `0`, the basic blocks
+ * follow in the order they appear in the function body, and the exit node is
+ * always last. The CFG owns the instructions of the function body (they are
+ * moved, not copied, in and out of it), so the dataflow passes rewrite the
+ * basic blocks in place and `cfgToInstructions` concatenates them back.
+ */
+class CFG {
+  public:
+    /**
+     * Convert the given IR function body into a control flow graph (CFG),
+     * taking ownership of its instructions.
+     *
+     * Basic blocks start at labels and after jumps, conditional jumps, and
+     * returns; edges follow jumps to their target labels, conditional jumps
+     * to both their target labels and the next basic block, returns to the
+     * exit node, and everything else to the next basic block.
+     *
+     * @param functionBody The IR function body to convert.
+     * @return The control flow graph (CFG) representation of the function body.
+     * @throws std::logic_error if a jump targets a label that is not in the
+     * function body.
+     */
+    [[nodiscard]] static CFG makeControlFlowGraph(
+        std::vector<std::unique_ptr<Instruction>> &&functionBody);
+
+    /**
+     * Convert the given control flow graph (CFG) back into a linear sequence
+     * of IR instructions (the basic blocks in ID order), taking ownership of
+     * its instructions.
+     *
+     * @param cfg The control flow graph (CFG) to convert.
+     * @return The linear sequence of IR instructions.
+     */
+    [[nodiscard]] static std::vector<std::unique_ptr<Instruction>>
+    cfgToInstructions(CFG &&cfg);
+
+    /**
+     * Default destructor for the CFG class.
+     */
+    ~CFG() = default;
+
+    /**
+     * Delete the copy constructor for the CFG class.
+     */
+    CFG(const CFG &) = delete;
+
+    /**
+     * Delete the copy assignment operator for the CFG class.
+     */
+    CFG &operator=(const CFG &) = delete;
+
+    /**
+     * Default move constructor for the CFG class.
+     */
+    CFG(CFG &&) = default;
+
+    /**
+     * Default move assignment operator for the CFG class.
+     */
+    CFG &operator=(CFG &&) = default;
+
+    [[nodiscard]] static constexpr std::size_t getEntryId() { return 0; }
+
+    [[nodiscard]] std::size_t getExitId() const;
+
+    /**
+     * Get the nodes of the CFG (indexed by ID, including the entry and exit
+     * nodes).
+     *
+     * @return The nodes of the CFG.
+     */
+    [[nodiscard]] const std::vector<BasicBlock> &getBlocks() const;
+
+    [[nodiscard]] std::vector<BasicBlock> &getBlocks();
+
+    /**
+     * Get the node with the given ID.
+     *
+     * @param id The ID of the node.
+     * @return The node.
+     * @throws std::logic_error if the ID is out of range.
+     */
+    [[nodiscard]] const BasicBlock &getBlock(std::size_t id) const;
+
+    [[nodiscard]] BasicBlock &getBlock(std::size_t id);
+
+    /**
+     * Get the ID of the basic block starting with the given label.
+     *
+     * @param label The label.
+     * @return The ID of the basic block, or `std::nullopt` if no basic block
+     * starts with the label.
+     */
+    [[nodiscard]] std::optional<std::size_t>
+    getBlockIdForLabel(Symbol label) const;
+
+    /**
+     * Add an edge between two nodes (if it is not already present).
+     *
+     * @param from The ID of the source node.
+     * @param to The ID of the destination node.
+     * @throws std::logic_error if either ID is out of range.
+     */
+    void addEdge(std::size_t from, std::size_t to);
+
+    /**
+     * Remove the edge between two nodes (if present).
+     *
+     * @param from The ID of the source node.
+     * @param to The ID of the destination node.
+     * @throws std::logic_error if either ID is out of range.
+     */
+    void removeEdge(std::size_t from, std::size_t to);
+
+    /**
+     * Remove a basic block: drop its instructions and all of its edges. The
+     * node keeps its ID (marked as removed) so that the other IDs stay valid.
+     *
+     * @param id The ID of the basic block.
+     * @throws std::logic_error if the ID is out of range or is the entry or
+     * exit node.
+     */
+    void removeBlock(std::size_t id);
+
+    /**
+     * Recompute the label index and all the edges from the instructions of
+     * the basic blocks (after a pass has changed labels or jumps).
+     *
+     * Removed basic blocks get no edges and are skipped by fall-through
+     * edges; empty (but not removed) basic blocks fall through to the next
+     * basic block.
+     *
+     * @throws std::logic_error if a jump targets a label that is not in the
+     * CFG.
+     */
+    void recomputeEdges();
+
+  private:
+    /**
+     * Default constructor for the CFG class (used by `makeControlFlowGraph`).
+     */
+    CFG() = default;
+
+    /**
+     * Check that a node ID is in range.
+     */
+    void checkBlockId(std::size_t id, const char *functionName) const;
+
+    /**
+     * The nodes of the CFG (indexed by ID).
+     */
+    std::vector<BasicBlock> blocks;
+
+    /**
+     * The map from labels to the IDs of the basic blocks they start.
+     */
+    std::unordered_map<Symbol, std::size_t> labelBlockIds;
+};
+} // namespace IR
+
+#endif // MIDEND_CFG_H
@@ -0,0 +1,158 @@
+#include "constantEvaluator.h"
+#include "../frontend/type.h"
+#include "flatIR.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+/**
+ * Unnamed namespace for helper functions for the constant evaluator.
+ */
+namespace {
+/**
+ * Get the value of a signed constant (its bits are stored sign-extended).
+ *
+ * @param constant The constant.
+ * @return The value.
+ */
+std::int64_t getSignedValue(IR::FlatConstant constant) {
+    return static_cast<std::int64_t>(constant.bits);
+}
+
+/**
+ * Get the minimum value of a signed constant kind.
+ *
+ * @param kind The constant kind.
+ * @return The minimum value.
+ */
+std::int64_t getSignedMinimum(IR::ConstantKind kind) {
+    return kind == IR::ConstantKind::Int
+               ? std::numeric_limits<std::int32_t>::min()
+               : std::numeric_limits<std::int64_t>::min();
+}
+
+/**
+ * Make the `int` result of a comparison.
+ *
+ * @param result The result of the comparison.
+ * @return `1` if the comparison holds, `0` otherwise.
+ */
+IR::FlatConstant makeTruthValue(bool result) {
+    return {.kind = IR::ConstantKind::Int, .bits = result ? 1U : 0U};
+}
+} // namespace
+
+namespace IR {
+bool isSignedKind(ConstantKind kind) {
+    return kind == ConstantKind::Int || kind == ConstantKind::Long;
+}
+
+std::optional<ConstantKind> getConstantKind(const AST::Type *type) {
+    if (dynamic_cast<const AST::IntType *>(type) != nullptr) {
+        return ConstantKind::Int;
+    }
+    else if (dynamic_cast<const AST::LongType *>(type) != nullptr) {
+        return ConstantKind::Long;
+    }
+    else if (dynamic_cast<const AST::UIntType *>(type) != nullptr) {
+        return ConstantKind::UInt;
+    }
+    else if (dynamic_cast<const AST::ULongType *>(type) != nullptr) {
+        return ConstantKind::ULong;
+    }
+    return std::nullopt;
+}
+
+FlatConstant makeConstant(ConstantKind kind, std::uint64_t bits) {
+    switch (kind) {
+    case ConstantKind::Int:
+        return {.kind = kind,
+                .bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(
+                    static_cast<std::int32_t>(bits)))};
+    case ConstantKind::UInt:
+        return {.kind = kind,
+                .bits = static_cast<std::uint64_t>(
+                    static_cast<std::uint32_t>(bits))};
+    case ConstantKind::Long:
+    case ConstantKind::ULong:
+        return {.kind = kind, .bits = bits};
+    }
+    throw std::logic_error("Unsupported constant kind in makeConstant");
+}
+
+FlatConstant convertConstant(FlatConstant constant, ConstantKind kind) {
+    // The bits of a constant hold its value modulo `2^64`, and C conversions
+    // to an integer type reduce the value modulo the width of the type.
+    return makeConstant(kind, constant.bits);
+}
+
+FlatConstant evaluateUnary(UnaryOpcode opcode, FlatConstant src) {
+    switch (opcode) {
+    case UnaryOpcode::Negate:
+        return makeConstant(src.kind, 0 - src.bits);
+    case UnaryOpcode::Complement:
+        return makeConstant(src.kind, ~src.bits);
+    case UnaryOpcode::Not:
+        return makeTruthValue(src.bits == 0);
+    }
+    throw std::logic_error("Unsupported unary opcode in evaluateUnary");
+}
+
+std::optional<FlatConstant> evaluateBinary(BinaryOpcode opcode,
+                                           FlatConstant lhs, FlatConstant rhs) {
+    if (lhs.kind != rhs.kind) {
+        return std::nullopt;
+    }
+    const auto kind = lhs.kind;
+    const bool isSigned = isSignedKind(kind);
+    switch (opcode) {
+    case BinaryOpcode::Add:
+        return makeConstant(kind, lhs.bits + rhs.bits);
+    case BinaryOpcode::Subtract:
+        return makeConstant(kind, lhs.bits - rhs.bits);
+    case BinaryOpcode::Multiply:
+        return makeConstant(kind, lhs.bits * rhs.bits);
+    case BinaryOpcode::Divide:
+    case BinaryOpcode::Remainder: {
+        if (rhs.bits == 0) {
+            return std::nullopt;
+        }
+        const bool isDivide = opcode == BinaryOpcode::Divide;
+        if (!isSigned) {
+            return makeConstant(kind, isDivide ? lhs.bits / rhs.bits
+                                               : lhs.bits % rhs.bits);
+        }
+        const auto lhsValue = getSignedValue(lhs);
+        const auto rhsValue = getSignedValue(rhs);
+        if (lhsValue == getSignedMinimum(kind) && rhsValue == -1) {
+            return std::nullopt;
+        }
+        return makeConstant(kind, static_cast<std::uint64_t>(
+                                      isDivide ? lhsValue / rhsValue
+                                               : lhsValue % rhsValue));
+    }
+    case BinaryOpcode::Equal:
+        return makeTruthValue(lhs.bits == rhs.bits);
+    case BinaryOpcode::NotEqual:
+        return makeTruthValue(lhs.bits != rhs.bits);
+    case BinaryOpcode::LessThan:
+        return makeTruthValue(isSigned
+                                  ? getSignedValue(lhs) < getSignedValue(rhs)
+                                  : lhs.bits < rhs.bits);
+    case BinaryOpcode::LessThanOrEqual:
+        return makeTruthValue(isSigned
+                                  ? getSignedValue(lhs) <= getSignedValue(rhs)
+                                  : lhs.bits <= rhs.bits);
+    case BinaryOpcode::GreaterThan:
+        return makeTruthValue(isSigned
+                                  ? getSignedValue(lhs) > getSignedValue(rhs)
+                                  : lhs.bits > rhs.bits);
+    case BinaryOpcode::GreaterThanOrEqual:
+        return makeTruthValue(isSigned
+                                  ? getSignedValue(lhs) >= getSignedValue(rhs)
+                                  : lhs.bits >= rhs.bits);
+    }
+    throw std::logic_error("Unsupported binary opcode in evaluateBinary");
+}
+} // namespace IR
@@ -0,0 +1,80 @@
+#ifndef MIDEND_CONSTANT_EVALUATOR_H
+#define MIDEND_CONSTANT_EVALUATOR_H
+
+#include "../frontend/type.h"
+#include "flatIR.h"
+#include <cstdint>
+#include <optional>
+
+namespace IR {
+/**
+ * Check whether a constant kind is a signed type.
+ *
+ * @param kind The constant kind.
+ * @return True if the kind is `int` or `long`, false otherwise.
+ */
+[[nodiscard]] bool isSignedKind(ConstantKind kind);
+
+/**
+ * Get the constant kind of a (scalar) type.
+ *
+ * @param type The type.
+ * @return The constant kind, or `std::nullopt` if the type is not one of the
+ * integer types.
+ */
+[[nodiscard]] std::optional<ConstantKind>
+getConstantKind(const AST::Type *type);
+
+/**
+ * Make a constant of the given kind from the low bits of a value, as C
+ * converts an integer to the (narrower or same-width) type of the kind:
+ * the value is reduced modulo `2^N` for an `N`-bit type, and stored
+ * sign-extended for `int` and zero-extended for `unsigned int`.
+ *
+ * @param kind The constant kind.
+ * @param bits The value (only its low bits are kept for 32-bit kinds).
+ * @return The constant.
+ */
+[[nodiscard]] FlatConstant makeConstant(ConstantKind kind, std::uint64_t bits);
+
+/**
+ * Convert a constant to another constant kind with the semantics of a C
+ * conversion (sign extension, zero extension, truncation, or reinterpretation
+ * between the signed and unsigned types of the same width).
+ *
+ * @param constant The constant to convert.
+ * @param kind The constant kind to convert to.
+ * @return The converted constant.
+ */
+[[nodiscard]] FlatConstant convertConstant(FlatConstant constant,
+                                           ConstantKind kind);
+
+/**
+ * Evaluate a unary operator on a constant with the semantics of its type
+ * (arithmetic wraps around, as it does in the generated code; `!` gives an
+ * `int`).
+ *
+ * @param opcode The unary operator.
+ * @param src The operand.
+ * @return The result.
+ */
+[[nodiscard]] FlatConstant evaluateUnary(UnaryOpcode opcode, FlatConstant src);
+
+/**
+ * Evaluate a binary operator on two constants of the same kind with the
+ * semantics of their type: arithmetic wraps around, division and remainder
+ * truncate toward zero (and are signed or unsigned as the type is), and the
+ * comparisons give an `int`.
+ *
+ * @param opcode The binary operator.
+ * @param lhs The left operand.
+ * @param rhs The right operand.
+ * @return The result, or `std::nullopt` if the operands are of different
+ * kinds or the operation traps at runtime (division or remainder by zero, or
+ * of the minimum of a signed type by `-1`), so that it is left to runtime.
+ */
+[[nodiscard]] std::optional<FlatConstant>
+evaluateBinary(BinaryOpcode opcode, FlatConstant lhs, FlatConstant rhs);
+} // namespace IR
+
+#endif // MIDEND_CONSTANT_EVALUATOR_H
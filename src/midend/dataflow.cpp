@@ -0,0 +1,446 @@
+#include "dataflow.h"
+#include "../frontend/frontendSymbolTable.h"
+#include "../frontend/semanticAnalysisPasses.h"
+#include "../utils/symbol.h"
+#include "cfg.h"
+#include "ir.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace IR {
+BitSet::BitSet(std::size_t size, bool value)
+    : bitCount(size), words((size + 63) / 64, 0) {
+    if (value) {
+        setAll();
+    }
+}
+
+std::size_t BitSet::size() const { return bitCount; }
+
+bool BitSet::test(std::size_t index) const {
+    return ((words[index / 64] >> (index % 64)) & 1U) != 0;
+}
+
+void BitSet::set(std::size_t index) {
+    words[index / 64] |= std::uint64_t{1} << (index % 64);
+}
+
+void BitSet::reset(std::size_t index) {
+    words[index / 64] &= ~(std::uint64_t{1} << (index % 64));
+}
+
+void BitSet::setAll() {
+    for (auto &word : words) {
+        word = ~std::uint64_t{0};
+    }
+    // Keep the bits past the end cleared so that equality stays exact.
+    if (bitCount % 64 != 0) {
+        words.back() = (std::uint64_t{1} << (bitCount % 64)) - 1;
+    }
+}
+
+bool BitSet::intersectWith(const BitSet &other) {
+    bool changed = false;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        const auto word = words[i] & other.words[i];
+        changed = changed || word != words[i];
+        words[i] = word;
+    }
+    return changed;
+}
+
+bool BitSet::uniteWith(const BitSet &other) {
+    bool changed = false;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        const auto word = words[i] | other.words[i];
+        changed = changed || word != words[i];
+        words[i] = word;
+    }
+    return changed;
+}
+
+std::vector<BitSet> solveDataflow(
+    const CFG &cfg, DataflowDirection direction, DataflowMeet meet,
+    const BitSet &boundary,
+    const std::function<BitSet(std::size_t, const BitSet &)> &transfer) {
+    const auto &blocks = cfg.getBlocks();
+    const bool forward = direction == DataflowDirection::Forward;
+    const bool intersect = meet == DataflowMeet::Intersection;
+    const auto startId = forward ? CFG::getEntryId() : cfg.getExitId();
+    const auto endId = forward ? cfg.getExitId() : CFG::getEntryId();
+
+    // The facts flowing into each node (from the nodes before it in the
+    // direction of the analysis) and out of each node (through its transfer
+    // function). Everything starts at the top of the lattice (every fact for
+    // an intersection, no fact for a union) except the boundary.
+    const BitSet top(boundary.size(), intersect);
+    std::vector<BitSet> flowIn(blocks.size(), top);
+    std::vector<BitSet> flowOut(blocks.size(), top);
+    flowIn[startId] = boundary;
+    flowOut[startId] = boundary;
+
+    auto before = [forward](const BasicBlock &block) -> const auto & {
+        return forward ? block.predecessors : block.successors;
+    };
+    auto after = [forward](const BasicBlock &block) -> const auto & {
+        return forward ? block.successors : block.predecessors;
+    };
+    auto meetInto = [&](std::size_t id) {
+        auto facts = top;
+        for (auto neighbor : before(blocks[id])) {
+            if (intersect) {
+                facts.intersectWith(flowOut[neighbor]);
+            }
+            else {
+                facts.uniteWith(flowOut[neighbor]);
+            }
+        }
+        return facts;
+    };
+
+    // Visit the basic blocks in layout order (reversed for a backward
+    // analysis), which is close to the order the facts propagate in.
+    std::deque<std::size_t> worklist;
+    std::vector<bool> inWorklist(blocks.size(), false);
+    for (std::size_t i = 1; i + 1 < blocks.size(); ++i) {
+        const auto id = forward ? i : blocks.size() - 1 - i;
+        if (!blocks[id].removed) {
+            worklist.emplace_back(id);
+            inWorklist[id] = true;
+        }
+    }
+    while (!worklist.empty()) {
+        const auto id = worklist.front();
+        worklist.pop_front();
+        inWorklist[id] = false;
+
+        flowIn[id] = meetInto(id);
+        auto facts = transfer(id, flowIn[id]);
+        if (facts == flowOut[id]) {
+            continue;
+        }
+        flowOut[id] = std::move(facts);
+        for (auto neighbor : after(blocks[id])) {
+            if (neighbor != endId && !inWorklist[neighbor]) {
+                worklist.emplace_back(neighbor);
+                inWorklist[neighbor] = true;
+            }
+        }
+    }
+    flowIn[endId] = meetInto(endId);
+    return flowIn;
+}
+
+const Value *getDst(const Instruction &instruction) {
+    switch (instruction.getKind()) {
+    case Instruction::Kind::SignExtend:
+        return static_cast<const SignExtendInstruction &>(instruction)
+            .getDst();
+    case Instruction::Kind::Truncate:
+        return static_cast<const TruncateInstruction &>(instruction).getDst();
+    case Instruction::Kind::ZeroExtend:
+        return static_cast<const ZeroExtendInstruction &>(instruction)
+            .getDst();
+    case Instruction::Kind::Unary:
+        return static_cast<const UnaryInstruction &>(instruction).getDst();
+    case Instruction::Kind::Binary:
+        return static_cast<const BinaryInstruction &>(instruction).getDst();
+    case Instruction::Kind::Copy:
+        return static_cast<const CopyInstruction &>(instruction).getDst();
+    case Instruction::Kind::FunctionCall:
+        return static_cast<const FunctionCallInstruction &>(instruction)
+            .getDst();
+    default:
+        return nullptr;
+    }
+}
+
+void forEachSrc(const Instruction &instruction,
+                const std::function<void(const Value &)> &function) {
+    switch (instruction.getKind()) {
+    case Instruction::Kind::Return:
+        function(*static_cast<const ReturnInstruction &>(instruction)
+                      .getReturnValue());
+        break;
+    case Instruction::Kind::SignExtend:
+        function(
+            *static_cast<const SignExtendInstruction &>(instruction).getSrc());
+        break;
+    case Instruction::Kind::Truncate:
+        function(
+            *static_cast<const TruncateInstruction &>(instruction).getSrc());
+        break;
+    case Instruction::Kind::ZeroExtend:
+        function(
+            *static_cast<const ZeroExtendInstruction &>(instruction).getSrc());
+        break;
+    case Instruction::Kind::Unary:
+        function(*static_cast<const UnaryInstruction &>(instruction).getSrc());
+        break;
+    case Instruction::Kind::Binary: {
+        const auto &binary =
+            static_cast<const BinaryInstruction &>(instruction);
+        function(*binary.getSrc1());
+        function(*binary.getSrc2());
+        break;
+    }
+    case Instruction::Kind::Copy:
+        function(*static_cast<const CopyInstruction &>(instruction).getSrc());
+        break;
+    case Instruction::Kind::JumpIfZero:
+        function(*static_cast<const JumpIfZeroInstruction &>(instruction)
+                      .getCondition());
+        break;
+    case Instruction::Kind::JumpIfNotZero:
+        function(*static_cast<const JumpIfNotZeroInstruction &>(instruction)
+                      .getCondition());
+        break;
+    case Instruction::Kind::FunctionCall:
+        for (const auto &arg :
+             static_cast<const FunctionCallInstruction &>(instruction)
+                 .getArgs()) {
+            function(*arg);
+        }
+        break;
+    case Instruction::Kind::Jump:
+    case Instruction::Kind::Label:
+        break;
+    }
+}
+
+bool replaceSrcs(
+    Instruction &instruction,
+    const std::function<std::unique_ptr<Value>(const Value &)> &replacement) {
+    bool replaced = false;
+    // Replace one source operand through its setter (if it has a
+    // replacement).
+    auto replaceWith = [&](const Value *src, auto &&setter) {
+        if (auto newSrc = replacement(*src)) {
+            setter(std::move(newSrc));
+            replaced = true;
+        }
+    };
+    switch (instruction.getKind()) {
+    case Instruction::Kind::Return: {
+        auto &ret = static_cast<ReturnInstruction &>(instruction);
+        replaceWith(ret.getReturnValue(), [&ret](std::unique_ptr<Value> v) {
+            ret.setReturnValue(std::move(v));
+        });
+        break;
+    }
+    case Instruction::Kind::SignExtend: {
+        auto &signExtend = static_cast<SignExtendInstruction &>(instruction);
+        replaceWith(signExtend.getSrc(),
+                    [&signExtend](std::unique_ptr<Value> v) {
+                        signExtend.setSrc(std::move(v));
+                    });
+        break;
+    }
+    case Instruction::Kind::Truncate: {
+        auto &truncate = static_cast<TruncateInstruction &>(instruction);
+        replaceWith(truncate.getSrc(), [&truncate](std::unique_ptr<Value> v) {
+            truncate.setSrc(std::move(v));
+        });
+        break;
+    }
+    case Instruction::Kind::ZeroExtend: {
+        auto &zeroExtend = static_cast<ZeroExtendInstruction &>(instruction);
+        replaceWith(zeroExtend.getSrc(),
+                    [&zeroExtend](std::unique_ptr<Value> v) {
+                        zeroExtend.setSrc(std::move(v));
+                    });
+        break;
+    }
+    case Instruction::Kind::Unary: {
+        auto &unary = static_cast<UnaryInstruction &>(instruction);
+        replaceWith(unary.getSrc(), [&unary](std::unique_ptr<Value> v) {
+            unary.setSrc(std::move(v));
+        });
+        break;
+    }
+    case Instruction::Kind::Binary: {
+        auto &binary = static_cast<BinaryInstruction &>(instruction);
+        replaceWith(binary.getSrc1(), [&binary](std::unique_ptr<Value> v) {
+            binary.setSrc1(std::move(v));
+        });
+        replaceWith(binary.getSrc2(), [&binary](std::unique_ptr<Value> v) {
+            binary.setSrc2(std::move(v));
+        });
+        break;
+    }
+    case Instruction::Kind::Copy: {
+        auto &copy = static_cast<CopyInstruction &>(instruction);
+        replaceWith(copy.getSrc(), [&copy](std::unique_ptr<Value> v) {
+            copy.setSrc(std::move(v));
+        });
+        break;
+    }
+    case Instruction::Kind::JumpIfZero: {
+        auto &jumpIfZero = static_cast<JumpIfZeroInstruction &>(instruction);
+        replaceWith(jumpIfZero.getCondition(),
+                    [&jumpIfZero](std::unique_ptr<Value> v) {
+                        jumpIfZero.setCondition(std::move(v));
+                    });
+        break;
+    }
+    case Instruction::Kind::JumpIfNotZero: {
+        auto &jumpIfNotZero =
+            static_cast<JumpIfNotZeroInstruction &>(instruction);
+        replaceWith(jumpIfNotZero.getCondition(),
+                    [&jumpIfNotZero](std::unique_ptr<Value> v) {
+                        jumpIfNotZero.setCondition(std::move(v));
+                    });
+        break;
+    }
+    case Instruction::Kind::FunctionCall:
+        for (auto &arg :
+             static_cast<FunctionCallInstruction &>(instruction).getArgs()) {
+            replaceWith(arg.get(), [&arg](std::unique_ptr<Value> v) {
+                arg = std::move(v);
+            });
+        }
+        break;
+    case Instruction::Kind::Jump:
+    case Instruction::Kind::Label:
+        break;
+    }
+    return replaced;
+}
+
+void replaceDst(Instruction &instruction, std::unique_ptr<Value> dst) {
+    switch (instruction.getKind()) {
+    case Instruction::Kind::SignExtend:
+        static_cast<SignExtendInstruction &>(instruction).setDst(
+            std::move(dst));
+        break;
+    case Instruction::Kind::Truncate:
+        static_cast<TruncateInstruction &>(instruction).setDst(std::move(dst));
+        break;
+    case Instruction::Kind::ZeroExtend:
+        static_cast<ZeroExtendInstruction &>(instruction).setDst(
+            std::move(dst));
+        break;
+    case Instruction::Kind::Unary:
+        static_cast<UnaryInstruction &>(instruction).setDst(std::move(dst));
+        break;
+    case Instruction::Kind::Binary:
+        static_cast<BinaryInstruction &>(instruction).setDst(std::move(dst));
+        break;
+    case Instruction::Kind::Copy:
+        static_cast<CopyInstruction &>(instruction).setDst(std::move(dst));
+        break;
+    case Instruction::Kind::FunctionCall:
+        static_cast<FunctionCallInstruction &>(instruction)
+            .setDst(std::move(dst));
+        break;
+    default:
+        throw std::logic_error(
+            "Replacing destination of instruction without one in replaceDst");
+    }
+}
+
+bool isStaticVariable(Symbol variable,
+                      const AST::FrontendSymbolTable &frontendSymbolTable) {
+    auto it = frontendSymbolTable.find(variable);
+    return it != frontendSymbolTable.end() &&
+           dynamic_cast<const AST::StaticAttribute *>(
+               it->second.second.get()) != nullptr;
+}
+
+LivenessAnalysis::LivenessAnalysis(
+    const CFG &cfg, const AST::FrontendSymbolTable &frontendSymbolTable) {
+    auto numberValue = [&](const Value &value) {
+        if (const auto *variableValue =
+                dynamic_cast<const VariableValue *>(&value)) {
+            addVariable(variableValue->getSymbol());
+        }
+    };
+    for (const auto &block : cfg.getBlocks()) {
+        for (const auto &instruction : block.instructions) {
+            forEachSrc(*instruction, numberValue);
+            if (const auto *dst = getDst(*instruction)) {
+                numberValue(*dst);
+            }
+        }
+    }
+    staticVariables = BitSet(variables.size());
+    for (std::size_t index = 0; index < variables.size(); ++index) {
+        if (isStaticVariable(variables[index], frontendSymbolTable)) {
+            staticVariables.set(index);
+        }
+    }
+
+    liveOut = solveDataflow(
+        cfg, DataflowDirection::Backward, DataflowMeet::Union, staticVariables,
+        [this, &cfg](std::size_t id, const BitSet &out) {
+            auto live = out;
+            const auto &instructions = cfg.getBlock(id).instructions;
+            for (auto it = instructions.rbegin(); it != instructions.rend();
+                 ++it) {
+                transfer(**it, live);
+            }
+            return live;
+        });
+}
+
+const BitSet &LivenessAnalysis::getLiveOut(std::size_t id) const {
+    return liveOut[id];
+}
+
+void LivenessAnalysis::transfer(const Instruction &instruction,
+                                BitSet &live) const {
+    if (const auto *dst = getDst(instruction)) {
+        if (auto index = getVariableIndex(
+                static_cast<const VariableValue *>(dst)->getSymbol())) {
+            live.reset(*index);
+        }
+    }
+    forEachSrc(instruction,
+               [this, &live](const Value &src) { markLive(src, live); });
+    // The callee may read any static variable.
+    if (instruction.getKind() == Instruction::Kind::FunctionCall) {
+        live.uniteWith(staticVariables);
+    }
+}
+
+std::optional<std::size_t>
+LivenessAnalysis::getVariableIndex(Symbol variable) const {
+    auto it = variableIndices.find(variable);
+    if (it == variableIndices.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const std::vector<Symbol> &LivenessAnalysis::getVariables() const {
+    return variables;
+}
+
+bool LivenessAnalysis::isStatic(std::size_t index) const {
+    return staticVariables.test(index);
+}
+
+std::size_t LivenessAnalysis::addVariable(Symbol variable) {
+    auto [it, inserted] = variableIndices.emplace(variable, variables.size());
+    if (inserted) {
+        variables.emplace_back(variable);
+    }
+    return it->second;
+}
+
+void LivenessAnalysis::markLive(const Value &value, BitSet &live) const {
+    if (const auto *variableValue =
+            dynamic_cast<const VariableValue *>(&value)) {
+        if (auto index = getVariableIndex(variableValue->getSymbol())) {
+            live.set(*index);
+        }
+    }
+}
+} // namespace IR
@@ -0,0 +1,252 @@
+#ifndef MIDEND_DATAFLOW_H
+#define MIDEND_DATAFLOW_H
+
+#include "../frontend/frontendSymbolTable.h"
+#include "../utils/symbol.h"
+#include "cfg.h"
+#include "ir.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace IR {
+/**
+ * Class representing a fixed-size set of bits (the sets of facts of the
+ * dataflow analyses, indexed by fact).
+ */
+class BitSet {
+  public:
+    /**
+     * Constructor for the bit set class.
+     *
+     * @param size The number of bits.
+     * @param value The initial value of every bit.
+     */
+    explicit BitSet(std::size_t size = 0, bool value = false);
+
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] bool test(std::size_t index) const;
+
+    void set(std::size_t index);
+
+    void reset(std::size_t index);
+
+    /**
+     * Set every bit (to one).
+     */
+    void setAll();
+
+    /**
+     * Intersect the bit set with another one of the same size.
+     *
+     * @param other The other bit set.
+     * @return True if the bit set has changed, false otherwise.
+     */
+    bool intersectWith(const BitSet &other);
+
+    /**
+     * Unite the bit set with another one of the same size.
+     *
+     * @param other The other bit set.
+     * @return True if the bit set has changed, false otherwise.
+     */
+    bool uniteWith(const BitSet &other);
+
+    friend bool operator==(const BitSet &, const BitSet &) = default;
+
+  private:
+    /**
+     * The number of bits.
+     */
+    std::size_t bitCount;
+
+    /**
+     * The bits, packed into words.
+     */
+    std::vector<std::uint64_t> words;
+};
+
+/**
+ * Enumeration representing the direction of a dataflow analysis.
+ */
+enum class DataflowDirection : std::uint8_t { Forward, Backward };
+
+/**
+ * Enumeration representing the meet operator of a dataflow analysis (how the
+ * facts flowing into a basic block from its neighbors are combined).
+ */
+enum class DataflowMeet : std::uint8_t { Intersection, Union };
+
+/**
+ * Solve a bit-vector dataflow analysis over a CFG with the iterative worklist
+ * algorithm.
+ *
+ * For a forward analysis, the result holds, for each node, the facts on entry
+ * to the node (the meet of the facts on exit from its predecessors), and the
+ * transfer function maps the facts on entry to a basic block to the facts on
+ * exit from it. For a backward analysis, the result holds the facts on exit
+ * from each node (the meet of the facts on entry to its successors), and the
+ * transfer function maps the facts on exit from a basic block to the facts on
+ * entry to it.
+ *
+ * @param cfg The CFG to analyze.
+ * @param direction The direction of the analysis.
+ * @param meet The meet operator of the analysis.
+ * @param boundary The facts flowing out of the entry node (forward) or into
+ * the exit node (backward).
+ * @param transfer The transfer function of a basic block (given its ID).
+ * @return The facts on entry to (forward) or exit from (backward) each node,
+ * indexed by node ID.
+ */
+[[nodiscard]] std::vector<BitSet> solveDataflow(
+    const CFG &cfg, DataflowDirection direction, DataflowMeet meet,
+    const BitSet &boundary,
+    const std::function<BitSet(std::size_t, const BitSet &)> &transfer);
+
+/**
+ * Get the destination of an instruction.
+ *
+ * @param instruction The instruction.
+ * @return The destination value, or `nullptr` if the instruction has none.
+ */
+[[nodiscard]] const Value *getDst(const Instruction &instruction);
+
+/**
+ * Call a function on each source operand of an instruction (the values it
+ * reads).
+ *
+ * @param instruction The instruction.
+ * @param function The function to call on each source operand.
+ */
+void forEachSrc(const Instruction &instruction,
+                const std::function<void(const Value &)> &function);
+
+/**
+ * Replace the source operands of an instruction.
+ *
+ * @param instruction The instruction.
+ * @param replacement The function giving the replacement of a source operand
+ * (or `nullptr` to keep it).
+ * @return True if any source operand has been replaced, false otherwise.
+ */
+bool replaceSrcs(
+    Instruction &instruction,
+    const std::function<std::unique_ptr<Value>(const Value &)> &replacement);
+
+/**
+ * Replace the destination of an instruction.
+ *
+ * @param instruction The instruction.
+ * @param dst The new destination value.
+ * @throws std::logic_error if the instruction has no destination.
+ */
+void replaceDst(Instruction &instruction, std::unique_ptr<Value> dst);
+
+/**
+ * Check whether a variable has static storage duration (so that it may be
+ * read or written by any function call).
+ *
+ * @param variable The variable.
+ * @param frontendSymbolTable The frontend symbol table.
+ * @return True if the variable is static, false otherwise.
+ */
+[[nodiscard]] bool
+isStaticVariable(Symbol variable,
+                 const AST::FrontendSymbolTable &frontendSymbolTable);
+
+/**
+ * Class for the liveness analysis of a CFG: which variables may be read
+ * before being written again at each point of the function body.
+ *
+ * The variables of the function body are numbered so that the live sets are
+ * bit sets (indexed by variable). Static variables are treated as live at the
+ * exit node and at every function call (the caller or the callee may read
+ * them).
+ */
+class LivenessAnalysis {
+  public:
+    /**
+     * Constructor for the liveness analysis class.
+     *
+     * Number the variables of the CFG and solve the analysis.
+     *
+     * @param cfg The CFG to analyze.
+     * @param frontendSymbolTable The frontend symbol table.
+     */
+    LivenessAnalysis(const CFG &cfg,
+                     const AST::FrontendSymbolTable &frontendSymbolTable);
+
+    /**
+     * Get the variables live at the end of a node.
+     *
+     * @param id The ID of the node.
+     * @return The live variables.
+     */
+    [[nodiscard]] const BitSet &getLiveOut(std::size_t id) const;
+
+    /**
+     * Apply the effect of an instruction (backward) to the variables live
+     * after it, giving the variables live before it.
+     *
+     * @param instruction The instruction.
+     * @param live The variables live after the instruction (updated in
+     * place).
+     */
+    void transfer(const Instruction &instruction, BitSet &live) const;
+
+    /**
+     * Get the index of a variable in the live sets.
+     *
+     * @param variable The variable.
+     * @return The index, or `std::nullopt` if the variable does not occur in
+     * the CFG.
+     */
+    [[nodiscard]] std::optional<std::size_t>
+    getVariableIndex(Symbol variable) const;
+
+    [[nodiscard]] const std::vector<Symbol> &getVariables() const;
+
+    /**
+     * Check whether a variable has static storage duration.
+     *
+     * @param index The index of the variable.
+     * @return True if the variable is static, false otherwise.
+     */
+    [[nodiscard]] bool isStatic(std::size_t index) const;
+
+  private:
+    /**
+     * Get the index of a variable, numbering it if needed.
+     */
+    std::size_t addVariable(Symbol variable);
+
+    /**
+     * Mark the variable of a value (if any) as live.
+     */
+    void markLive(const Value &value, BitSet &live) const;
+
+    /**
+     * The variables of the CFG (indexed by variable).
+     */
+    std::vector<Symbol> variables;
+    /**
+     * The map from variables to their indices.
+     */
+    std::unordered_map<Symbol, std::size_t> variableIndices;
+    /**
+     * The static variables of the CFG.
+     */
+    BitSet staticVariables;
+    /**
+     * The variables live at the end of each node (indexed by ID).
+     */
+    std::vector<BitSet> liveOut;
+};
+} // namespace IR
+
+#endif // MIDEND_DATAFLOW_H
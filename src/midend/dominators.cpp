@@ -0,0 +1,194 @@
+#include "dominators.h"
+#include "cfg.h"
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace IR {
+DominatorTree::DominatorTree(const CFG &cfg) {
+    const auto nodeCount = cfg.getBlocks().size();
+    immediateDominators.assign(nodeCount, std::nullopt);
+    children.assign(nodeCount, {});
+    dominanceFrontiers.assign(nodeCount, {});
+    preorderNumbers.assign(nodeCount, 0);
+    postorderNumbers.assign(nodeCount, 0);
+
+    // Compute the postorder of the reachable nodes with an explicit stack of
+    // (node, index of the next successor to visit), since function bodies
+    // can be deeply nested.
+    constexpr auto entryId = CFG::getEntryId();
+    std::vector<bool> visited(nodeCount, false);
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    visited[entryId] = true;
+    stack.emplace_back(entryId, 0);
+    while (!stack.empty()) {
+        const auto id = stack.back().first;
+        const auto &successors = cfg.getBlock(id).successors;
+        if (stack.back().second < successors.size()) {
+            const auto successor = successors[stack.back().second++];
+            if (!visited[successor]) {
+                visited[successor] = true;
+                stack.emplace_back(successor, 0);
+            }
+        }
+        else {
+            reversePostorder.emplace_back(id);
+            stack.pop_back();
+        }
+    }
+    std::ranges::reverse(reversePostorder);
+    std::vector<std::size_t> reversePostorderIndices(nodeCount, 0);
+    for (std::size_t index = 0; index < reversePostorder.size(); ++index) {
+        reversePostorderIndices[reversePostorder[index]] = index;
+    }
+
+    // Walk up from two nodes to their closest common dominator (the node
+    // with the larger reverse-postorder index is never an ancestor of the
+    // other one).
+    auto intersect = [&](std::size_t lhs, std::size_t rhs) {
+        while (lhs != rhs) {
+            while (reversePostorderIndices[lhs] >
+                   reversePostorderIndices[rhs]) {
+                lhs = *immediateDominators[lhs];
+            }
+            while (reversePostorderIndices[rhs] >
+                   reversePostorderIndices[lhs]) {
+                rhs = *immediateDominators[rhs];
+            }
+        }
+        return lhs;
+    };
+
+    // Iterate to a fixed point over the reverse postorder (the entry node is
+    // its own immediate dominator while computing).
+    immediateDominators[entryId] = entryId;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto id : reversePostorder) {
+            if (id == entryId) {
+                continue;
+            }
+            std::optional<std::size_t> newImmediateDominator;
+            for (const auto predecessor : cfg.getBlock(id).predecessors) {
+                if (!immediateDominators[predecessor]) {
+                    // The predecessor is unreachable or not processed yet.
+                    continue;
+                }
+                newImmediateDominator =
+                    newImmediateDominator
+                        ? intersect(predecessor, *newImmediateDominator)
+                        : predecessor;
+            }
+            if (immediateDominators[id] != newImmediateDominator) {
+                immediateDominators[id] = newImmediateDominator;
+                changed = true;
+            }
+        }
+    }
+
+    for (std::size_t id = 0; id < nodeCount; ++id) {
+        if (id != entryId && immediateDominators[id]) {
+            children[*immediateDominators[id]].emplace_back(id);
+        }
+    }
+
+    // Each node with several predecessors is in the dominance frontier of
+    // the nodes from each predecessor up to (but excluding) its immediate
+    // dominator. The nodes are processed in increasing ID order, so the
+    // frontiers come out sorted and a node is added twice in a row at most.
+    for (std::size_t id = 0; id < nodeCount; ++id) {
+        const auto &predecessors = cfg.getBlock(id).predecessors;
+        if (!immediateDominators[id] || predecessors.size() < 2) {
+            continue;
+        }
+        for (const auto predecessor : predecessors) {
+            if (!immediateDominators[predecessor]) {
+                continue;
+            }
+            for (auto runner = predecessor; runner != *immediateDominators[id];
+                 runner = *immediateDominators[runner]) {
+                auto &frontier = dominanceFrontiers[runner];
+                if (frontier.empty() || frontier.back() != id) {
+                    frontier.emplace_back(id);
+                }
+            }
+        }
+    }
+
+    // Number the nodes in preorder and postorder of the dominator tree.
+    std::size_t preorderNumber = 0;
+    std::size_t postorderNumber = 0;
+    stack.clear();
+    stack.emplace_back(entryId, 0);
+    preorder.emplace_back(entryId);
+    preorderNumbers[entryId] = preorderNumber++;
+    while (!stack.empty()) {
+        const auto id = stack.back().first;
+        if (stack.back().second < children[id].size()) {
+            const auto child = children[id][stack.back().second++];
+            preorder.emplace_back(child);
+            preorderNumbers[child] = preorderNumber++;
+            stack.emplace_back(child, 0);
+        }
+        else {
+            postorderNumbers[id] = postorderNumber++;
+            stack.pop_back();
+        }
+    }
+}
+
+bool DominatorTree::isReachable(std::size_t id) const {
+    checkNodeId(id, "isReachable");
+    return immediateDominators[id].has_value();
+}
+
+std::optional<std::size_t>
+DominatorTree::getImmediateDominator(std::size_t id) const {
+    checkNodeId(id, "getImmediateDominator");
+    if (id == CFG::getEntryId()) {
+        return std::nullopt;
+    }
+    return immediateDominators[id];
+}
+
+const std::vector<std::size_t> &
+DominatorTree::getChildren(std::size_t id) const {
+    checkNodeId(id, "getChildren");
+    return children[id];
+}
+
+bool DominatorTree::dominates(std::size_t dominator, std::size_t id) const {
+    checkNodeId(dominator, "dominates");
+    checkNodeId(id, "dominates");
+    return immediateDominators[dominator] && immediateDominators[id] &&
+           preorderNumbers[dominator] <= preorderNumbers[id] &&
+           postorderNumbers[id] <= postorderNumbers[dominator];
+}
+
+const std::vector<std::size_t> &
+DominatorTree::getDominanceFrontier(std::size_t id) const {
+    checkNodeId(id, "getDominanceFrontier");
+    return dominanceFrontiers[id];
+}
+
+const std::vector<std::size_t> &DominatorTree::getReversePostorder() const {
+    return reversePostorder;
+}
+
+const std::vector<std::size_t> &DominatorTree::getPreorder() const {
+    return preorder;
+}
+
+void DominatorTree::checkNodeId(std::size_t id,
+                                const char *functionName) const {
+    if (id >= immediateDominators.size()) {
+        throw std::logic_error(std::string("Out-of-range node ID in ") +
+                               functionName + " in DominatorTree");
+    }
+}
+} // namespace IR
@@ -0,0 +1,136 @@
+#ifndef MIDEND_DOMINATORS_H
+#define MIDEND_DOMINATORS_H
+
+#include "cfg.h"
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace IR {
+/**
+ * Class representing the dominator tree of a CFG, together with the dominance
+ * frontiers of its nodes.
+ *
+ * A node `a` dominates a node `b` if every path from the entry node to `b`
+ * goes through `a`; the immediate dominator of `b` is its closest strict
+ * dominator. The dominance frontier of `a` holds the nodes where the
+ * dominance of `a` ends: the nodes that have a predecessor dominated by `a`
+ * but are not strictly dominated by `a` themselves.
+ *
+ * The tree is computed with the iterative algorithm of Cooper, Harvey, and
+ * Kennedy over the reverse postorder of the CFG. Nodes that are unreachable
+ * from the entry node are not part of the tree. The tree is a snapshot: it
+ * must be recomputed after the edges of the CFG change.
+ */
+class DominatorTree {
+  public:
+    /**
+     * Constructor for the dominator tree class.
+     *
+     * @param cfg The CFG to compute the dominator tree of.
+     */
+    explicit DominatorTree(const CFG &cfg);
+
+    /**
+     * Check whether a node is reachable from the entry node (and thus part
+     * of the tree).
+     *
+     * @param id The ID of the node.
+     * @return True if the node is reachable, false otherwise.
+     */
+    [[nodiscard]] bool isReachable(std::size_t id) const;
+
+    /**
+     * Get the immediate dominator of a node.
+     *
+     * @param id The ID of the node.
+     * @return The ID of the immediate dominator, or `std::nullopt` for the
+     * entry node and unreachable nodes.
+     */
+    [[nodiscard]] std::optional<std::size_t>
+    getImmediateDominator(std::size_t id) const;
+
+    /**
+     * Get the children of a node in the dominator tree (the nodes it
+     * immediately dominates), in increasing ID order.
+     *
+     * @param id The ID of the node.
+     * @return The IDs of the children.
+     */
+    [[nodiscard]] const std::vector<std::size_t> &
+    getChildren(std::size_t id) const;
+
+    /**
+     * Check whether a node dominates another one (every node dominates
+     * itself).
+     *
+     * @param dominator The ID of the candidate dominator.
+     * @param id The ID of the node.
+     * @return True if `dominator` dominates `id`, false otherwise (in
+     * particular if either node is unreachable).
+     */
+    [[nodiscard]] bool dominates(std::size_t dominator, std::size_t id) const;
+
+    /**
+     * Get the dominance frontier of a node, in increasing ID order.
+     *
+     * @param id The ID of the node.
+     * @return The IDs of the nodes in the dominance frontier.
+     */
+    [[nodiscard]] const std::vector<std::size_t> &
+    getDominanceFrontier(std::size_t id) const;
+
+    /**
+     * Get the reachable nodes in reverse postorder (so that each node comes
+     * after its dominators, and after its predecessors except along back
+     * edges).
+     *
+     * @return The IDs of the reachable nodes in reverse postorder.
+     */
+    [[nodiscard]] const std::vector<std::size_t> &getReversePostorder() const;
+
+    /**
+     * Get the reachable nodes in a preorder of the dominator tree (so that
+     * each node comes after its dominators), visiting children in increasing
+     * ID order.
+     *
+     * @return The IDs of the reachable nodes in dominator-tree preorder.
+     */
+    [[nodiscard]] const std::vector<std::size_t> &getPreorder() const;
+
+  private:
+    /**
+     * Check that a node ID is in range.
+     */
+    void checkNodeId(std::size_t id, const char *functionName) const;
+
+    /**
+     * The immediate dominator of each node (indexed by ID; the entry node is
+     * its own immediate dominator, and unreachable nodes have none).
+     */
+    std::vector<std::optional<std::size_t>> immediateDominators;
+    /**
+     * The children of each node in the dominator tree (indexed by ID).
+     */
+    std::vector<std::vector<std::size_t>> children;
+    /**
+     * The dominance frontier of each node (indexed by ID).
+     */
+    std::vector<std::vector<std::size_t>> dominanceFrontiers;
+    /**
+     * The reachable nodes in reverse postorder.
+     */
+    std::vector<std::size_t> reversePostorder;
+    /**
+     * The reachable nodes in dominator-tree preorder.
+     */
+    std::vector<std::size_t> preorder;
+    /**
+     * The preorder and postorder numbers of each reachable node in the
+     * dominator tree (indexed by ID), for constant-time dominance queries.
+     */
+    std::vector<std::size_t> preorderNumbers, postorderNumbers;
+};
+} // namespace IR
+
+#endif // MIDEND_DOMINATORS_H
@@ -0,0 +1,434 @@
+#include "flatIR.h"
+#include "../frontend/constant.h"
+#include "../utils/symbol.h"
+#include "ir.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace IR {
+UnaryOpcode flattenUnaryOperator(const UnaryOperator *unaryOperator) {
+    if (dynamic_cast<const NegateOperator *>(unaryOperator) != nullptr) {
+        return UnaryOpcode::Negate;
+    }
+    if (dynamic_cast<const ComplementOperator *>(unaryOperator) != nullptr) {
+        return UnaryOpcode::Complement;
+    }
+    if (dynamic_cast<const NotOperator *>(unaryOperator) != nullptr) {
+        return UnaryOpcode::Not;
+    }
+    throw std::logic_error(
+        "Unsupported unary operator in flattenUnaryOperator in FlatIR");
+}
+
+BinaryOpcode flattenBinaryOperator(const BinaryOperator *binaryOperator) {
+    if (dynamic_cast<const AddOperator *>(binaryOperator) != nullptr) {
+        return BinaryOpcode::Add;
+    }
+    if (dynamic_cast<const SubtractOperator *>(binaryOperator) != nullptr) {
+        return BinaryOpcode::Subtract;
+    }
+    if (dynamic_cast<const MultiplyOperator *>(binaryOperator) != nullptr) {
+        return BinaryOpcode::Multiply;
+    }
+    if (dynamic_cast<const DivideOperator *>(binaryOperator) != nullptr) {
+        return BinaryOpcode::Divide;
+    }
+    if (dynamic_cast<const RemainderOperator *>(binaryOperator) != nullptr) {
+        return BinaryOpcode::Remainder;
+    }
+    if (dynamic_cast<const EqualOperator *>(binaryOperator) != nullptr) {
+        return BinaryOpcode::Equal;
+    }
+    if (dynamic_cast<const NotEqualOperator *>(binaryOperator) != nullptr) {
+        return BinaryOpcode::NotEqual;
+    }
+    if (dynamic_cast<const LessThanOperator *>(binaryOperator) != nullptr) {
+        return BinaryOpcode::LessThan;
+    }
+    if (dynamic_cast<const LessThanOrEqualOperator *>(binaryOperator) !=
+        nullptr) {
+        return BinaryOpcode::LessThanOrEqual;
+    }
+    if (dynamic_cast<const GreaterThanOperator *>(binaryOperator) != nullptr) {
+        return BinaryOpcode::GreaterThan;
+    }
+    if (dynamic_cast<const GreaterThanOrEqualOperator *>(binaryOperator) !=
+        nullptr) {
+        return BinaryOpcode::GreaterThanOrEqual;
+    }
+    throw std::logic_error(
+        "Unsupported binary operator in flattenBinaryOperator in FlatIR");
+}
+
+std::unique_ptr<UnaryOperator> unflattenUnaryOperator(UnaryOpcode opcode) {
+    switch (opcode) {
+    case UnaryOpcode::Negate:
+        return std::make_unique<NegateOperator>();
+    case UnaryOpcode::Complement:
+        return std::make_unique<ComplementOperator>();
+    case UnaryOpcode::Not:
+        return std::make_unique<NotOperator>();
+    }
+    throw std::logic_error(
+        "Unsupported unary opcode in unflattenUnaryOperator in FlatIR");
+}
+
+std::unique_ptr<BinaryOperator> unflattenBinaryOperator(BinaryOpcode opcode) {
+    switch (opcode) {
+    case BinaryOpcode::Add:
+        return std::make_unique<AddOperator>();
+    case BinaryOpcode::Subtract:
+        return std::make_unique<SubtractOperator>();
+    case BinaryOpcode::Multiply:
+        return std::make_unique<MultiplyOperator>();
+    case BinaryOpcode::Divide:
+        return std::make_unique<DivideOperator>();
+    case BinaryOpcode::Remainder:
+        return std::make_unique<RemainderOperator>();
+    case BinaryOpcode::Equal:
+        return std::make_unique<EqualOperator>();
+    case BinaryOpcode::NotEqual:
+        return std::make_unique<NotEqualOperator>();
+    case BinaryOpcode::LessThan:
+        return std::make_unique<LessThanOperator>();
+    case BinaryOpcode::LessThanOrEqual:
+        return std::make_unique<LessThanOrEqualOperator>();
+    case BinaryOpcode::GreaterThan:
+        return std::make_unique<GreaterThanOperator>();
+    case BinaryOpcode::GreaterThanOrEqual:
+        return std::make_unique<GreaterThanOrEqualOperator>();
+    }
+    throw std::logic_error(
+        "Unsupported binary opcode in unflattenBinaryOperator in FlatIR");
+}
+
+FlatConstant flattenConstant(const AST::Constant *astConstant) {
+    if (const auto *constantInt =
+            dynamic_cast<const AST::ConstantInt *>(astConstant)) {
+        return {.kind = ConstantKind::Int,
+                .bits = static_cast<std::uint64_t>(constantInt->getValue())};
+    }
+    if (const auto *constantLong =
+            dynamic_cast<const AST::ConstantLong *>(astConstant)) {
+        return {.kind = ConstantKind::Long,
+                .bits = static_cast<std::uint64_t>(constantLong->getValue())};
+    }
+    if (const auto *constantUInt =
+            dynamic_cast<const AST::ConstantUInt *>(astConstant)) {
+        return {.kind = ConstantKind::UInt,
+                .bits = static_cast<std::uint64_t>(constantUInt->getValue())};
+    }
+    if (const auto *constantULong =
+            dynamic_cast<const AST::ConstantULong *>(astConstant)) {
+        return {.kind = ConstantKind::ULong,
+                .bits = static_cast<std::uint64_t>(constantULong->getValue())};
+    }
+    throw std::logic_error("Unsupported constant in flattenConstant in FlatIR");
+}
+
+std::unique_ptr<AST::Constant> unflattenConstant(FlatConstant constant) {
+    switch (constant.kind) {
+    case ConstantKind::Int:
+        return std::make_unique<AST::ConstantInt>(
+            static_cast<int>(constant.bits));
+    case ConstantKind::Long:
+        return std::make_unique<AST::ConstantLong>(
+            static_cast<long>(constant.bits));
+    case ConstantKind::UInt:
+        return std::make_unique<AST::ConstantUInt>(
+            static_cast<unsigned int>(constant.bits));
+    case ConstantKind::ULong:
+        return std::make_unique<AST::ConstantULong>(
+            static_cast<unsigned long>(constant.bits));
+    }
+    throw std::logic_error(
+        "Unsupported constant kind in unflattenConstant in FlatIR");
+}
+
+FlatFunctionBody::FlatFunctionBody()
+    : instructions(&arena), callArguments(&arena), constants(&arena),
+      variables(&arena), constantIndices(&arena), variableIndices(&arena) {}
+
+FlatFunctionBody::FlatFunctionBody(
+    const std::vector<std::unique_ptr<Instruction>> &functionBody)
+    : FlatFunctionBody() {
+    instructions.reserve(functionBody.size());
+    std::vector<FlatValue> arguments;
+    for (const auto &instruction : functionBody) {
+        FlatInstruction flat;
+        switch (instruction->getKind()) {
+        case Instruction::Kind::Return: {
+            const auto &returnInstruction =
+                static_cast<const ReturnInstruction &>(*instruction);
+            flat.opcode = Opcode::Return;
+            flat.operands[0] = flattenValue(returnInstruction.getReturnValue());
+            break;
+        }
+        case Instruction::Kind::SignExtend: {
+            const auto &signExtendInstruction =
+                static_cast<const SignExtendInstruction &>(*instruction);
+            flat.opcode = Opcode::SignExtend;
+            flat.operands[0] = flattenValue(signExtendInstruction.getSrc());
+            flat.operands[2] = flattenValue(signExtendInstruction.getDst());
+            break;
+        }
+        case Instruction::Kind::Truncate: {
+            const auto &truncateInstruction =
+                static_cast<const TruncateInstruction &>(*instruction);
+            flat.opcode = Opcode::Truncate;
+            flat.operands[0] = flattenValue(truncateInstruction.getSrc());
+            flat.operands[2] = flattenValue(truncateInstruction.getDst());
+            break;
+        }
+        case Instruction::Kind::ZeroExtend: {
+            const auto &zeroExtendInstruction =
+                static_cast<const ZeroExtendInstruction &>(*instruction);
+            flat.opcode = Opcode::ZeroExtend;
+            flat.operands[0] = flattenValue(zeroExtendInstruction.getSrc());
+            flat.operands[2] = flattenValue(zeroExtendInstruction.getDst());
+            break;
+        }
+        case Instruction::Kind::Unary: {
+            const auto &unaryInstruction =
+                static_cast<const UnaryInstruction &>(*instruction);
+            flat.opcode = Opcode::Unary;
+            flat.op = static_cast<std::uint8_t>(
+                flattenUnaryOperator(unaryInstruction.getUnaryOperator()));
+            flat.operands[0] = flattenValue(unaryInstruction.getSrc());
+            flat.operands[2] = flattenValue(unaryInstruction.getDst());
+            break;
+        }
+        case Instruction::Kind::Binary: {
+            const auto &binaryInstruction =
+                static_cast<const BinaryInstruction &>(*instruction);
+            flat.opcode = Opcode::Binary;
+            flat.op = static_cast<std::uint8_t>(
+                flattenBinaryOperator(binaryInstruction.getBinaryOperator()));
+            flat.operands[0] = flattenValue(binaryInstruction.getSrc1());
+            flat.operands[1] = flattenValue(binaryInstruction.getSrc2());
+            flat.operands[2] = flattenValue(binaryInstruction.getDst());
+            break;
+        }
+        case Instruction::Kind::Copy: {
+            const auto &copyInstruction =
+                static_cast<const CopyInstruction &>(*instruction);
+            flat.opcode = Opcode::Copy;
+            flat.operands[0] = flattenValue(copyInstruction.getSrc());
+            flat.operands[2] = flattenValue(copyInstruction.getDst());
+            break;
+        }
+        case Instruction::Kind::Jump:
+            flat.opcode = Opcode::Jump;
+            flat.symbol = static_cast<const JumpInstruction &>(*instruction)
+                              .getTargetSymbol();
+            break;
+        case Instruction::Kind::JumpIfZero: {
+            const auto &jumpIfZeroInstruction =
+                static_cast<const JumpIfZeroInstruction &>(*instruction);
+            flat.opcode = Opcode::JumpIfZero;
+            flat.operands[0] =
+                flattenValue(jumpIfZeroInstruction.getCondition());
+            flat.symbol = jumpIfZeroInstruction.getTargetSymbol();
+            break;
+        }
+        case Instruction::Kind::JumpIfNotZero: {
+            const auto &jumpIfNotZeroInstruction =
+                static_cast<const JumpIfNotZeroInstruction &>(*instruction);
+            flat.opcode = Opcode::JumpIfNotZero;
+            flat.operands[0] =
+                flattenValue(jumpIfNotZeroInstruction.getCondition());
+            flat.symbol = jumpIfNotZeroInstruction.getTargetSymbol();
+            break;
+        }
+        case Instruction::Kind::Label:
+            flat.opcode = Opcode::Label;
+            flat.symbol = static_cast<const LabelInstruction &>(*instruction)
+                              .getLabelSymbol();
+            break;
+        case Instruction::Kind::FunctionCall: {
+            const auto &functionCallInstruction =
+                static_cast<const FunctionCallInstruction &>(*instruction);
+            flat.opcode = Opcode::FunctionCall;
+            flat.symbol =
+                Symbol(functionCallInstruction.getFunctionIdentifier());
+            flat.operands[2] = flattenValue(functionCallInstruction.getDst());
+            arguments.clear();
+            for (const auto &arg : functionCallInstruction.getArgs()) {
+                arguments.emplace_back(flattenValue(arg.get()));
+            }
+            setCallArguments(flat, arguments);
+            break;
+        }
+        }
+        append(flat);
+    }
+}
+
+std::unique_ptr<std::vector<std::unique_ptr<Instruction>>>
+FlatFunctionBody::toInstructions() const {
+    auto functionBody =
+        std::make_unique<std::vector<std::unique_ptr<Instruction>>>();
+    functionBody->reserve(instructions.size());
+    for (const auto &flat : instructions) {
+        const auto &operands = flat.operands;
+        switch (flat.opcode) {
+        case Opcode::Return:
+            functionBody->emplace_back(std::make_unique<ReturnInstruction>(
+                unflattenValue(operands[0])));
+            break;
+        case Opcode::SignExtend:
+            functionBody->emplace_back(std::make_unique<SignExtendInstruction>(
+                unflattenValue(operands[0]), unflattenValue(operands[2])));
+            break;
+        case Opcode::Truncate:
+            functionBody->emplace_back(std::make_unique<TruncateInstruction>(
+                unflattenValue(operands[0]), unflattenValue(operands[2])));
+            break;
+        case Opcode::ZeroExtend:
+            functionBody->emplace_back(std::make_unique<ZeroExtendInstruction>(
+                unflattenValue(operands[0]), unflattenValue(operands[2])));
+            break;
+        case Opcode::Unary:
+            functionBody->emplace_back(std::make_unique<UnaryInstruction>(
+                unflattenUnaryOperator(static_cast<UnaryOpcode>(flat.op)),
+                unflattenValue(operands[0]), unflattenValue(operands[2])));
+            break;
+        case Opcode::Binary:
+            functionBody->emplace_back(std::make_unique<BinaryInstruction>(
+                unflattenBinaryOperator(static_cast<BinaryOpcode>(flat.op)),
+                unflattenValue(operands[0]), unflattenValue(operands[1]),
+                unflattenValue(operands[2])));
+            break;
+        case Opcode::Copy:
+            functionBody->emplace_back(std::make_unique<CopyInstruction>(
+                unflattenValue(operands[0]), unflattenValue(operands[2])));
+            break;
+        case Opcode::Jump:
+            functionBody->emplace_back(
+                std::make_unique<JumpInstruction>(flat.symbol));
+            break;
+        case Opcode::JumpIfZero:
+            functionBody->emplace_back(std::make_unique<JumpIfZeroInstruction>(
+                unflattenValue(operands[0]), flat.symbol));
+            break;
+        case Opcode::JumpIfNotZero:
+            functionBody->emplace_back(
+                std::make_unique<JumpIfNotZeroInstruction>(
+                    unflattenValue(operands[0]), flat.symbol));
+            break;
+        case Opcode::Label:
+            functionBody->emplace_back(
+                std::make_unique<LabelInstruction>(flat.symbol));
+            break;
+        case Opcode::FunctionCall: {
+            auto args = std::make_unique<std::vector<std::unique_ptr<Value>>>();
+            for (const auto argument : getCallArguments(flat)) {
+                args->emplace_back(unflattenValue(argument));
+            }
+            functionBody->emplace_back(
+                std::make_unique<FunctionCallInstruction>(
+                    flat.symbol.str(), std::move(args),
+                    unflattenValue(operands[2])));
+            break;
+        }
+        }
+    }
+    return functionBody;
+}
+
+void FlatFunctionBody::append(const FlatInstruction &instruction) {
+    instructions.emplace_back(instruction);
+}
+
+void FlatFunctionBody::setCallArguments(FlatInstruction &instruction,
+                                        std::span<const FlatValue> arguments) {
+    if (arguments.size() > std::numeric_limits<std::uint16_t>::max()) {
+        throw std::logic_error(
+            "Too many call arguments in setCallArguments in FlatFunctionBody");
+    }
+    instruction.firstArgument =
+        static_cast<std::uint32_t>(callArguments.size());
+    instruction.argumentCount = static_cast<std::uint16_t>(arguments.size());
+    callArguments.insert(callArguments.end(), arguments.begin(),
+                         arguments.end());
+}
+
+FlatValue FlatFunctionBody::internVariable(Symbol variable) {
+    const auto [it, inserted] = variableIndices.try_emplace(
+        variable, static_cast<std::uint32_t>(variables.size()));
+    if (inserted) {
+        variables.emplace_back(variable);
+    }
+    return {FlatValue::Tag::Variable, it->second};
+}
+
+FlatValue FlatFunctionBody::internConstant(FlatConstant constant) {
+    const auto [it, inserted] = constantIndices.try_emplace(
+        constant, static_cast<std::uint32_t>(constants.size()));
+    if (inserted) {
+        constants.emplace_back(constant);
+    }
+    return {FlatValue::Tag::Constant, it->second};
+}
+
+std::span<const FlatInstruction> FlatFunctionBody::getInstructions() const {
+    return instructions;
+}
+
+std::span<const FlatValue>
+FlatFunctionBody::getCallArguments(const FlatInstruction &instruction) const {
+    return std::span<const FlatValue>(callArguments)
+        .subspan(instruction.firstArgument, instruction.argumentCount);
+}
+
+Symbol FlatFunctionBody::getVariable(FlatValue value) const {
+    if (!value.isVariable()) {
+        throw std::logic_error(
+            "Getting variable of non-variable value in getVariable in "
+            "FlatFunctionBody");
+    }
+    return variables[value.getIndex()];
+}
+
+FlatConstant FlatFunctionBody::getConstant(FlatValue value) const {
+    if (!value.isConstant()) {
+        throw std::logic_error(
+            "Getting constant of non-constant value in getConstant in "
+            "FlatFunctionBody");
+    }
+    return constants[value.getIndex()];
+}
+
+FlatValue FlatFunctionBody::flattenValue(const Value *value) {
+    if (const auto *constantValue =
+            dynamic_cast<const ConstantValue *>(value)) {
+        return internConstant(flattenConstant(constantValue->getASTConstant()));
+    }
+    if (const auto *variableValue =
+            dynamic_cast<const VariableValue *>(value)) {
+        return internVariable(variableValue->getSymbol());
+    }
+    throw std::logic_error(
+        "Unsupported value in flattenValue in FlatFunctionBody");
+}
+
+std::unique_ptr<Value> FlatFunctionBody::unflattenValue(FlatValue value) const {
+    switch (value.getTag()) {
+    case FlatValue::Tag::Constant:
+        return std::make_unique<ConstantValue>(
+            unflattenConstant(getConstant(value)));
+    case FlatValue::Tag::Variable:
+        return std::make_unique<VariableValue>(getVariable(value));
+    case FlatValue::Tag::None:
+        break;
+    }
+    throw std::logic_error(
+        "Converting missing value in unflattenValue in FlatFunctionBody");
+}
+} // namespace IR
@@ -0,0 +1,387 @@
+#ifndef MIDEND_FLAT_IR_H
+#define MIDEND_FLAT_IR_H
+
+#include "../utils/symbol.h"
+#include "ir.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace IR {
+/**
+ * Enumeration representing the opcodes of the flat IR instructions (one per
+ * `IR::Instruction` subclass).
+ */
+enum class Opcode : std::uint8_t {
+    Return,
+    SignExtend,
+    Truncate,
+    ZeroExtend,
+    Unary,
+    Binary,
+    Copy,
+    Jump,
+    JumpIfZero,
+    JumpIfNotZero,
+    Label,
+    FunctionCall
+};
+
+/**
+ * Enumeration representing the unary operators of the flat IR (one per
+ * `IR::UnaryOperator` subclass).
+ */
+enum class UnaryOpcode : std::uint8_t { Negate, Complement, Not };
+
+/**
+ * Enumeration representing the binary operators of the flat IR (one per
+ * `IR::BinaryOperator` subclass).
+ */
+enum class BinaryOpcode : std::uint8_t {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Remainder,
+    Equal,
+    NotEqual,
+    LessThan,
+    LessThanOrEqual,
+    GreaterThan,
+    GreaterThanOrEqual
+};
+
+/**
+ * Enumeration representing the types of the flat IR constants (one per
+ * `AST::Constant` subclass).
+ */
+enum class ConstantKind : std::uint8_t { Int, Long, UInt, ULong };
+
+/**
+ * Structure representing a constant in the flat IR: its type and its bits
+ * (the value converted to `std::uint64_t`).
+ */
+struct FlatConstant {
+    ConstantKind kind;
+    std::uint64_t bits;
+
+    friend constexpr bool operator==(const FlatConstant &,
+                                     const FlatConstant &) = default;
+};
+
+/**
+ * Hash function for flat constants (so that the constant table can be
+ * deduplicated).
+ */
+struct FlatConstantHash {
+    std::size_t operator()(const FlatConstant &constant) const noexcept {
+        return std::hash<std::uint64_t>{}(constant.bits) ^
+               static_cast<std::size_t>(constant.kind);
+    }
+};
+
+/**
+ * Convert an IR unary operator to its flat opcode.
+ *
+ * @param unaryOperator The IR unary operator.
+ * @return The flat opcode.
+ * @throws std::logic_error if the operator is not supported.
+ */
+[[nodiscard]] UnaryOpcode
+flattenUnaryOperator(const UnaryOperator *unaryOperator);
+
+/**
+ * Convert an IR binary operator to its flat opcode.
+ *
+ * @param binaryOperator The IR binary operator.
+ * @return The flat opcode.
+ * @throws std::logic_error if the operator is not supported.
+ */
+[[nodiscard]] BinaryOpcode
+flattenBinaryOperator(const BinaryOperator *binaryOperator);
+
+/**
+ * Create the IR unary operator for a flat opcode.
+ *
+ * @param opcode The flat opcode.
+ * @return The IR unary operator.
+ * @throws std::logic_error if the opcode is not supported.
+ */
+[[nodiscard]] std::unique_ptr<UnaryOperator>
+unflattenUnaryOperator(UnaryOpcode opcode);
+
+/**
+ * Create the IR binary operator for a flat opcode.
+ *
+ * @param opcode The flat opcode.
+ * @return The IR binary operator.
+ * @throws std::logic_error if the opcode is not supported.
+ */
+[[nodiscard]] std::unique_ptr<BinaryOperator>
+unflattenBinaryOperator(BinaryOpcode opcode);
+
+/**
+ * Convert an AST constant to a flat constant.
+ *
+ * @param astConstant The AST constant.
+ * @return The flat constant.
+ * @throws std::logic_error if the constant is not supported.
+ */
+[[nodiscard]] FlatConstant flattenConstant(const AST::Constant *astConstant);
+
+/**
+ * Create the AST constant for a flat constant.
+ *
+ * @param constant The flat constant.
+ * @return The AST constant.
+ * @throws std::logic_error if the constant kind is not supported.
+ */
+[[nodiscard]] std::unique_ptr<AST::Constant>
+unflattenConstant(FlatConstant constant);
+
+/**
+ * Class representing a value operand in the flat IR: a tagged index into the
+ * constant table or the variable table of the function body (or no value).
+ */
+class FlatValue {
+  public:
+    /**
+     * Enumeration representing the tag of a flat value.
+     */
+    enum class Tag : std::uint8_t { None, Constant, Variable };
+
+    /**
+     * Default constructor for the flat value class (no value).
+     */
+    constexpr FlatValue() = default;
+
+    /**
+     * Constructor for the flat value class.
+     *
+     * @param tag The tag of the value.
+     * @param index The index of the value in the table selected by the tag.
+     */
+    constexpr FlatValue(Tag tag, std::uint32_t index)
+        : encoded((static_cast<std::uint32_t>(tag) << indexBits) |
+                  (index & indexMask)) {}
+
+    [[nodiscard]] constexpr Tag getTag() const {
+        return static_cast<Tag>(encoded >> indexBits);
+    }
+
+    [[nodiscard]] constexpr std::uint32_t getIndex() const {
+        return encoded & indexMask;
+    }
+
+    [[nodiscard]] constexpr bool isConstant() const {
+        return getTag() == Tag::Constant;
+    }
+
+    [[nodiscard]] constexpr bool isVariable() const {
+        return getTag() == Tag::Variable;
+    }
+
+    friend constexpr bool operator==(FlatValue, FlatValue) = default;
+
+    /**
+     * The number of bits of the encoding used for the index (the remaining
+     * high bits hold the tag).
+     */
+    static constexpr std::uint32_t indexBits = 30;
+
+  private:
+    /**
+     * The mask selecting the index bits of the encoding.
+     */
+    static constexpr std::uint32_t indexMask = (1U << indexBits) - 1;
+
+    /**
+     * The encoding of the value (the tag in the high bits and the index in the
+     * low bits).
+     */
+    std::uint32_t encoded = 0;
+};
+
+/**
+ * Structure representing an instruction in the flat IR.
+ *
+ * The operand slots are used as follows:
+ * - `Return`: `operands[0]` is the return value.
+ * - `SignExtend`, `Truncate`, `ZeroExtend`, `Copy`, `Unary`: `operands[0]` is
+ *   the source and `operands[2]` is the destination.
+ * - `Binary`: `operands[0]` and `operands[1]` are the sources and `operands[2]`
+ *   is the destination.
+ * - `JumpIfZero`, `JumpIfNotZero`: `operands[0]` is the condition and `symbol`
+ *   is the target.
+ * - `Jump`, `Label`: `symbol` is the target (or the label).
+ * - `FunctionCall`: `symbol` is the callee, `operands[2]` is the destination,
+ *   and the arguments are `argumentCount` values starting at
+ *   `firstArgument` in the argument pool of the function body.
+ */
+struct FlatInstruction {
+    Opcode opcode = Opcode::Return;
+    /**
+     * The `UnaryOpcode` or `BinaryOpcode` (for `Unary` and `Binary`).
+     */
+    std::uint8_t op = 0;
+    std::uint16_t argumentCount = 0;
+    std::array<FlatValue, 3> operands{};
+    Symbol symbol;
+    std::uint32_t firstArgument = 0;
+};
+
+/**
+ * Class representing a function body in the flat IR.
+ *
+ * The instructions are stored contiguously and refer to values by index into
+ * the per-function constant and variable tables (which are deduplicated), so
+ * that a function body costs a handful of allocations instead of several per
+ * instruction. All the tables are backed by a monotonic arena owned by the
+ * function body, so destroying it is a few frees.
+ */
+class FlatFunctionBody {
+  public:
+    /**
+     * Default constructor for the flat function body class (empty body).
+     */
+    FlatFunctionBody();
+
+    /**
+     * Constructor for the flat function body class.
+     *
+     * Convert the instructions of an IR function body to the flat encoding.
+     *
+     * @param functionBody The IR function body to convert.
+     * @throws std::logic_error if a value or operator is not supported.
+     */
+    explicit FlatFunctionBody(
+        const std::vector<std::unique_ptr<Instruction>> &functionBody);
+
+    /**
+     * Default destructor for the flat function body class.
+     */
+    ~FlatFunctionBody() = default;
+
+    /**
+     * Delete the copy constructor for the flat function body class.
+     */
+    FlatFunctionBody(const FlatFunctionBody &) = delete;
+
+    /**
+     * Delete the copy assignment operator for the flat function body class.
+     */
+    FlatFunctionBody &operator=(const FlatFunctionBody &) = delete;
+
+    /**
+     * Delete the move constructor for the flat function body class (the
+     * tables refer to the arena member).
+     */
+    FlatFunctionBody(FlatFunctionBody &&) = delete;
+
+    /**
+     * Delete the move assignment operator for the flat function body class.
+     */
+    FlatFunctionBody &operator=(FlatFunctionBody &&) = delete;
+
+    /**
+     * Convert the flat function body back to IR instructions.
+     *
+     * @return The IR function body.
+     */
+    [[nodiscard]] std::unique_ptr<std::vector<std::unique_ptr<Instruction>>>
+    toInstructions() const;
+
+    /**
+     * Append an instruction to the function body.
+     *
+     * @param instruction The instruction to append.
+     */
+    void append(const FlatInstruction &instruction);
+
+    /**
+     * Append the arguments of a function call to the argument pool.
+     *
+     * @param instruction The `FunctionCall` instruction to set the argument
+     * range of.
+     * @param arguments The arguments of the function call.
+     */
+    void setCallArguments(FlatInstruction &instruction,
+                          std::span<const FlatValue> arguments);
+
+    /**
+     * Get the flat value for a variable, adding it to the variable table if
+     * needed.
+     *
+     * @param variable The (interned) identifier of the variable.
+     * @return The flat value for the variable.
+     */
+    [[nodiscard]] FlatValue internVariable(Symbol variable);
+
+    /**
+     * Get the flat value for a constant, adding it to the constant table if
+     * needed.
+     *
+     * @param constant The constant.
+     * @return The flat value for the constant.
+     */
+    [[nodiscard]] FlatValue internConstant(FlatConstant constant);
+
+    [[nodiscard]] std::span<const FlatInstruction> getInstructions() const;
+
+    [[nodiscard]] std::span<const FlatValue>
+    getCallArguments(const FlatInstruction &instruction) const;
+
+    [[nodiscard]] Symbol getVariable(FlatValue value) const;
+
+    [[nodiscard]] FlatConstant getConstant(FlatValue value) const;
+
+  private:
+    /**
+     * Convert an IR value to a flat value.
+     */
+    FlatValue flattenValue(const Value *value);
+
+    /**
+     * Convert a flat value to an IR value.
+     */
+    [[nodiscard]] std::unique_ptr<Value> unflattenValue(FlatValue value) const;
+
+    /**
+     * The arena backing the tables of the function body.
+     */
+    std::pmr::monotonic_buffer_resource arena;
+    /**
+     * The instructions of the function body.
+     */
+    std::pmr::vector<FlatInstruction> instructions;
+    /**
+     * The pool of the arguments of the function calls.
+     */
+    std::pmr::vector<FlatValue> callArguments;
+    /**
+     * The constant table.
+     */
+    std::pmr::vector<FlatConstant> constants;
+    /**
+     * The variable table.
+     */
+    std::pmr::vector<Symbol> variables;
+    /**
+     * The map from constants to their indices in the constant table.
+     */
+    std::pmr::unordered_map<FlatConstant, std::uint32_t, FlatConstantHash>
+        constantIndices;
+    /**
+     * The map from variables to their indices in the variable table.
+     */
+    std::pmr::unordered_map<Symbol, std::uint32_t> variableIndices;
+};
+} // namespace IR
+
+#endif // MIDEND_FLAT_IR_H
@@ -0,0 +1,101 @@
+#include "functionBodyRewriter.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace IR {
+FunctionBodyRewriter::FunctionBodyRewriter(
+    std::vector<std::unique_ptr<Instruction>> &functionBody)
+    : functionBody(functionBody) {}
+
+std::size_t FunctionBodyRewriter::size() const { return functionBody.size(); }
+
+Instruction *FunctionBodyRewriter::get(std::size_t index) const {
+    if (index >= functionBody.size()) {
+        throw std::logic_error(
+            "Getting out-of-range instruction in get in FunctionBodyRewriter");
+    }
+    return functionBody[index].get();
+}
+
+void FunctionBodyRewriter::replace(std::size_t index,
+                                   std::unique_ptr<Instruction> instruction) {
+    if (index >= functionBody.size() || !functionBody[index]) {
+        throw std::logic_error("Replacing out-of-range or erased instruction "
+                               "in replace in FunctionBodyRewriter");
+    }
+    if (!instruction) {
+        throw std::logic_error(
+            "Replacing instruction with null in replace in "
+            "FunctionBodyRewriter");
+    }
+    functionBody[index] = std::move(instruction);
+    changed = true;
+}
+
+void FunctionBodyRewriter::erase(std::size_t index) {
+    if (index >= functionBody.size() || !functionBody[index]) {
+        throw std::logic_error("Erasing out-of-range or erased instruction in "
+                               "erase in FunctionBodyRewriter");
+    }
+    // Leave a null tombstone behind until the next commit.
+    functionBody[index].reset();
+    ++erasedCount;
+    changed = true;
+}
+
+void FunctionBodyRewriter::insertBefore(
+    std::size_t index, std::unique_ptr<Instruction> instruction) {
+    if (index > functionBody.size()) {
+        throw std::logic_error("Inserting at out-of-range position in "
+                               "insertBefore in FunctionBodyRewriter");
+    }
+    if (!instruction) {
+        throw std::logic_error(
+            "Inserting null instruction in insertBefore in "
+            "FunctionBodyRewriter");
+    }
+    insertions.emplace_back(index, std::move(instruction));
+    changed = true;
+}
+
+bool FunctionBodyRewriter::commit() {
+    if (erasedCount == 0 && insertions.empty()) {
+        return changed;
+    }
+
+    // Passes usually insert in increasing position order, in which case
+    // checking that the insertions are already sorted is the only (linear)
+    // work.
+    auto getPosition = [](const auto &insertion) { return insertion.first; };
+    if (!std::ranges::is_sorted(insertions, {}, getPosition)) {
+        std::ranges::stable_sort(insertions, {}, getPosition);
+    }
+
+    std::vector<std::unique_ptr<Instruction>> rewritten;
+    rewritten.reserve(functionBody.size() - erasedCount + insertions.size());
+    auto insertionIt = insertions.begin();
+    for (std::size_t index = 0; index < functionBody.size(); ++index) {
+        for (; insertionIt != insertions.end() && insertionIt->first == index;
+             ++insertionIt) {
+            rewritten.emplace_back(std::move(insertionIt->second));
+        }
+        if (functionBody[index]) {
+            rewritten.emplace_back(std::move(functionBody[index]));
+        }
+    }
+    for (; insertionIt != insertions.end(); ++insertionIt) {
+        rewritten.emplace_back(std::move(insertionIt->second));
+    }
+
+    functionBody = std::move(rewritten);
+    insertions.clear();
+    erasedCount = 0;
+    return changed;
+}
+
+bool FunctionBodyRewriter::hasChanged() const { return changed; }
+} // namespace IR
@@ -0,0 +1,148 @@
+#ifndef MIDEND_FUNCTION_BODY_REWRITER_H
+#define MIDEND_FUNCTION_BODY_REWRITER_H
+
+#include "ir.h"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace IR {
+/**
+ * Class for rewriting an IR function body in place.
+ *
+ * Instructions are addressed by their position in the function body as it was
+ * when the rewriter was constructed (or last committed), so a pass can walk
+ * the function body by index and replace, erase, or insert instructions
+ * without invalidating the positions it has yet to visit. Replacements take
+ * effect immediately; erasures and insertions are recorded and applied by
+ * `commit` in a single linear compaction (moving the instruction pointers, not
+ * copying the instructions).
+ */
+class FunctionBodyRewriter {
+  public:
+    /**
+     * Constructor for the function body rewriter class.
+     *
+     * @param functionBody The function body to rewrite.
+     */
+    explicit FunctionBodyRewriter(
+        std::vector<std::unique_ptr<Instruction>> &functionBody);
+
+    /**
+     * Default destructor for the function body rewriter class.
+     */
+    ~FunctionBodyRewriter() = default;
+
+    /**
+     * Delete the copy constructor for the function body rewriter class.
+     */
+    FunctionBodyRewriter(const FunctionBodyRewriter &) = delete;
+
+    /**
+     * Delete the copy assignment operator for the function body rewriter
+     * class.
+     */
+    FunctionBodyRewriter &operator=(const FunctionBodyRewriter &) = delete;
+
+    /**
+     * Delete the move constructor for the function body rewriter class.
+     */
+    FunctionBodyRewriter(FunctionBodyRewriter &&) = delete;
+
+    /**
+     * Delete the move assignment operator for the function body rewriter
+     * class.
+     */
+    FunctionBodyRewriter &operator=(FunctionBodyRewriter &&) = delete;
+
+    /**
+     * Get the number of positions in the function body (including the erased
+     * ones, until the next commit).
+     *
+     * @return The number of positions.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * Get the instruction at a position.
+     *
+     * @param index The position of the instruction.
+     * @return The instruction, or `nullptr` if it has been erased.
+     */
+    [[nodiscard]] Instruction *get(std::size_t index) const;
+
+    /**
+     * Replace the instruction at a position.
+     *
+     * @param index The position of the instruction to replace.
+     * @param instruction The new instruction.
+     * @throws std::logic_error if the position is out of range or has been
+     * erased, or if `instruction` is null.
+     */
+    void replace(std::size_t index, std::unique_ptr<Instruction> instruction);
+
+    /**
+     * Erase the instruction at a position.
+     *
+     * @param index The position of the instruction to erase.
+     * @throws std::logic_error if the position is out of range or has already
+     * been erased.
+     */
+    void erase(std::size_t index);
+
+    /**
+     * Insert an instruction before the instruction at a position (or at the
+     * end of the function body if the position is `size()`). Instructions
+     * inserted at the same position keep their insertion order.
+     *
+     * @param index The position to insert the instruction before.
+     * @param instruction The instruction to insert.
+     * @throws std::logic_error if the position is out of range or if
+     * `instruction` is null.
+     */
+    void insertBefore(std::size_t index,
+                      std::unique_ptr<Instruction> instruction);
+
+    /**
+     * Apply the pending erasures and insertions to the function body.
+     *
+     * @return True if the function body has been changed (by a replacement,
+     * erasure, or insertion) since the rewriter was constructed, false
+     * otherwise.
+     */
+    bool commit();
+
+    /**
+     * Check whether the function body has been changed since the rewriter was
+     * constructed.
+     *
+     * @return True if the function body has been changed, false otherwise.
+     */
+    [[nodiscard]] bool hasChanged() const;
+
+  private:
+    /**
+     * The function body being rewritten.
+     */
+    std::vector<std::unique_ptr<Instruction>> &functionBody;
+
+    /**
+     * The pending insertions (positions and instructions).
+     */
+    std::vector<std::pair<std::size_t, std::unique_ptr<Instruction>>>
+        insertions;
+
+    /**
+     * The number of pending erasures.
+     */
+    std::size_t erasedCount = 0;
+
+    /**
+     * Boolean indicating whether the function body has been changed.
+     */
+    bool changed = false;
+};
+} // namespace IR
+
+#endif // MIDEND_FUNCTION_BODY_REWRITER_H
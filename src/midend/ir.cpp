@@ -34,10 +34,16 @@ void ConstantValue::setASTConstant(
 VariableValue::VariableValue(std::string_view identifier)
     : identifier(identifier) {}
 
-const std::string &VariableValue::getIdentifier() const { return identifier; }
+VariableValue::VariableValue(Symbol identifier) : identifier(identifier) {}
+
+const std::string &VariableValue::getIdentifier() const {
+    return identifier.str();
+}
+
+Symbol VariableValue::getSymbol() const { return identifier; }
 
 void VariableValue::setIdentifier(std::string_view newIdentifier) {
-    identifier = newIdentifier;
+    identifier = Symbol(newIdentifier);
 }
 
 ReturnInstruction::ReturnInstruction(std::unique_ptr<Value> returnValue)
@@ -317,14 +323,24 @@ void CopyInstruction::setDst(std::unique_ptr<Value> newDst) {
 
 JumpInstruction::JumpInstruction(std::string_view target) : target(target) {}
 
-const std::string &JumpInstruction::getTarget() const { return target; }
+JumpInstruction::JumpInstruction(Symbol target) : target(target) {}
+
+const std::string &JumpInstruction::getTarget() const { return target.str(); }
+
+Symbol JumpInstruction::getTargetSymbol() const { return target; }
 
 void JumpInstruction::setTarget(std::string_view newTarget) {
-    target = newTarget;
+    target = Symbol(newTarget);
 }
 
+void JumpInstruction::setTarget(Symbol newTarget) { target = newTarget; }
+
 JumpIfZeroInstruction::JumpIfZeroInstruction(std::unique_ptr<Value> condition,
                                              std::string_view target)
+    : JumpIfZeroInstruction(std::move(condition), Symbol(target)) {}
+
+JumpIfZeroInstruction::JumpIfZeroInstruction(std::unique_ptr<Value> condition,
+                                             Symbol target)
     : condition(std::move(condition)), target(target) {
     if (!this->condition) {
         throw std::invalid_argument("Creating JumpIfZeroInstruction with null "
@@ -334,7 +350,11 @@ JumpIfZeroInstruction::JumpIfZeroInstruction(std::unique_ptr<Value> condition,
 
 Value *JumpIfZeroInstruction::getCondition() const { return condition.get(); }
 
-const std::string &JumpIfZeroInstruction::getTarget() const { return target; }
+const std::string &JumpIfZeroInstruction::getTarget() const {
+    return target.str();
+}
+
+Symbol JumpIfZeroInstruction::getTargetSymbol() const { return target; }
 
 void JumpIfZeroInstruction::setCondition(std::unique_ptr<Value> newCondition) {
     if (!newCondition) {
@@ -346,11 +366,17 @@ void JumpIfZeroInstruction::setCondition(std::unique_ptr<Value> newCondition) {
 }
 
 void JumpIfZeroInstruction::setTarget(std::string_view newTarget) {
-    target = newTarget;
+    target = Symbol(newTarget);
 }
 
+void JumpIfZeroInstruction::setTarget(Symbol newTarget) { target = newTarget; }
+
 JumpIfNotZeroInstruction::JumpIfNotZeroInstruction(
     std::unique_ptr<Value> condition, std::string_view target)
+    : JumpIfNotZeroInstruction(std::move(condition), Symbol(target)) {}
+
+JumpIfNotZeroInstruction::JumpIfNotZeroInstruction(
+    std::unique_ptr<Value> condition, Symbol target)
     : condition(std::move(condition)), target(target) {
     if (!this->condition) {
         throw std::invalid_argument(
@@ -364,9 +390,11 @@ Value *JumpIfNotZeroInstruction::getCondition() const {
 }
 
 const std::string &JumpIfNotZeroInstruction::getTarget() const {
-    return target;
+    return target.str();
 }
 
+Symbol JumpIfNotZeroInstruction::getTargetSymbol() const { return target; }
+
 void JumpIfNotZeroInstruction::setCondition(
     std::unique_ptr<Value> newCondition) {
     if (!newCondition) {
@@ -378,14 +406,26 @@ void JumpIfNotZeroInstruction::setCondition(
 }
 
 void JumpIfNotZeroInstruction::setTarget(std::string_view newTarget) {
+    target = Symbol(newTarget);
+}
+
+void JumpIfNotZeroInstruction::setTarget(Symbol newTarget) {
     target = newTarget;
 }
 
 LabelInstruction::LabelInstruction(std::string_view label) : label(label) {}
 
-const std::string &LabelInstruction::getLabel() const { return label; }
+LabelInstruction::LabelInstruction(Symbol label) : label(label) {}
+
+const std::string &LabelInstruction::getLabel() const { return label.str(); }
+
+Symbol LabelInstruction::getLabelSymbol() const { return label; }
+
+void LabelInstruction::setLabel(std::string_view newLabel) {
+    label = Symbol(newLabel);
+}
 
-void LabelInstruction::setLabel(std::string_view newLabel) { label = newLabel; }
+void LabelInstruction::setLabel(Symbol newLabel) { label = newLabel; }
 
 FunctionCallInstruction::FunctionCallInstruction(
     std::string_view functionIdentifier,
@@ -414,6 +454,10 @@ FunctionCallInstruction::getArgs() const {
     return *args;
 }
 
+std::vector<std::unique_ptr<Value>> &FunctionCallInstruction::getArgs() {
+    return *args;
+}
+
 Value *FunctionCallInstruction::getDst() const { return dst.get(); }
 
 void FunctionCallInstruction::setFunctionIdentifier(
@@ -470,6 +514,11 @@ FunctionDefinition::getFunctionBody() const {
     return *functionBody;
 }
 
+std::vector<std::unique_ptr<Instruction>> &
+FunctionDefinition::getFunctionBody() {
+    return *functionBody;
+}
+
 void FunctionDefinition::setFunctionBody(
     std::unique_ptr<std::vector<std::unique_ptr<Instruction>>>
         newFunctionBody) {
@@ -4,6 +4,8 @@
 #include "../frontend/constant.h"
 #include "../frontend/semanticAnalysisPasses.h"
 #include "../frontend/type.h"
+#include "../utils/symbol.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -197,9 +199,9 @@ class ConstantValue : public Value {
 class VariableValue : public Value {
   private:
     /**
-     * The identifier of the variable.
+     * The (interned) identifier of the variable.
      */
-    std::string identifier;
+    Symbol identifier;
 
   public:
     /**
@@ -210,8 +212,18 @@ class VariableValue : public Value {
      */
     explicit VariableValue(std::string_view identifier);
 
+    /**
+     * Constructor for creating an IR variable value from an interned variable
+     * identifier.
+     *
+     * @param identifier The interned identifier of the variable.
+     */
+    explicit VariableValue(Symbol identifier);
+
     [[nodiscard]] const std::string &getIdentifier() const;
 
+    [[nodiscard]] Symbol getSymbol() const;
+
     void setIdentifier(std::string_view newIdentifier);
 };
 
@@ -220,6 +232,26 @@ class VariableValue : public Value {
  */
 class Instruction {
   public:
+    /**
+     * Enumeration representing the kinds of IR instructions (one per
+     * subclass), so that passes can dispatch on an instruction with a single
+     * `switch` rather than a chain of `dynamic_cast`s.
+     */
+    enum class Kind : std::uint8_t {
+        Return,
+        SignExtend,
+        Truncate,
+        ZeroExtend,
+        Unary,
+        Binary,
+        Copy,
+        Jump,
+        JumpIfZero,
+        JumpIfNotZero,
+        Label,
+        FunctionCall
+    };
+
     /**
      * Default constructor for the IR instruction class.
      */
@@ -249,6 +281,13 @@ class Instruction {
      * Default move assignment operator for the IR instruction class.
      */
     constexpr Instruction &operator=(Instruction &&) = default;
+
+    /**
+     * Get the kind of the instruction.
+     *
+     * @return The kind of the instruction.
+     */
+    [[nodiscard]] virtual Kind getKind() const = 0;
 };
 
 /**
@@ -273,6 +312,8 @@ class ReturnInstruction : public Instruction {
     [[nodiscard]] Value *getReturnValue() const;
 
     void setReturnValue(std::unique_ptr<Value> newReturnValue);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Return; }
 };
 
 /**
@@ -304,6 +345,8 @@ class SignExtendInstruction : public Instruction {
     void setSrc(std::unique_ptr<Value> newSrc);
 
     void setDst(std::unique_ptr<Value> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::SignExtend; }
 };
 
 /**
@@ -335,6 +378,8 @@ class TruncateInstruction : public Instruction {
     void setSrc(std::unique_ptr<Value> newSrc);
 
     void setDst(std::unique_ptr<Value> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Truncate; }
 };
 
 class ZeroExtendInstruction : public Instruction {
@@ -363,6 +408,8 @@ class ZeroExtendInstruction : public Instruction {
     void setSrc(std::unique_ptr<Value> newSrc);
 
     void setDst(std::unique_ptr<Value> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::ZeroExtend; }
 };
 
 /**
@@ -405,6 +452,8 @@ class UnaryInstruction : public Instruction {
     void setSrc(std::unique_ptr<Value> newSrc);
 
     void setDst(std::unique_ptr<Value> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Unary; }
 };
 
 /**
@@ -453,6 +502,8 @@ class BinaryInstruction : public Instruction {
     void setSrc2(std::unique_ptr<Value> newSrc2);
 
     void setDst(std::unique_ptr<Value> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Binary; }
 };
 
 /**
@@ -484,6 +535,8 @@ class CopyInstruction : public Instruction {
     void setSrc(std::unique_ptr<Value> newSrc);
 
     void setDst(std::unique_ptr<Value> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Copy; }
 };
 
 /**
@@ -492,9 +545,9 @@ class CopyInstruction : public Instruction {
 class JumpInstruction : public Instruction {
   private:
     /**
-     * The target label of the jump instruction.
+     * The (interned) target label of the jump instruction.
      */
-    std::string target;
+    Symbol target;
 
   public:
     /**
@@ -504,9 +557,23 @@ class JumpInstruction : public Instruction {
      */
     explicit JumpInstruction(std::string_view target);
 
+    /**
+     * Constructor for creating a jump instruction with an interned target
+     * label.
+     *
+     * @param target The interned target label of the jump instruction.
+     */
+    explicit JumpInstruction(Symbol target);
+
     [[nodiscard]] const std::string &getTarget() const;
 
+    [[nodiscard]] Symbol getTargetSymbol() const;
+
     void setTarget(std::string_view newTarget);
+
+    void setTarget(Symbol newTarget);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Jump; }
 };
 
 /**
@@ -519,9 +586,9 @@ class JumpIfZeroInstruction : public Instruction {
      */
     std::unique_ptr<Value> condition;
     /**
-     * The target label of the jump instruction.
+     * The (interned) target label of the jump instruction.
      */
-    std::string target;
+    Symbol target;
 
   public:
     /**
@@ -535,13 +602,30 @@ class JumpIfZeroInstruction : public Instruction {
     explicit JumpIfZeroInstruction(std::unique_ptr<Value> condition,
                                    std::string_view target);
 
+    /**
+     * Constructor for creating a conditional jump instruction with a condition
+     * value and an interned target label.
+     *
+     * @param condition The condition value of the jump instruction.
+     * @param target The interned target label of the jump instruction.
+     * @throws std::invalid_argument if `condition` is null.
+     */
+    explicit JumpIfZeroInstruction(std::unique_ptr<Value> condition,
+                                   Symbol target);
+
     [[nodiscard]] Value *getCondition() const;
 
     [[nodiscard]] const std::string &getTarget() const;
 
+    [[nodiscard]] Symbol getTargetSymbol() const;
+
     void setCondition(std::unique_ptr<Value> newCondition);
 
     void setTarget(std::string_view newTarget);
+
+    void setTarget(Symbol newTarget);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::JumpIfZero; }
 };
 
 /**
@@ -554,9 +638,9 @@ class JumpIfNotZeroInstruction : public Instruction {
      */
     std::unique_ptr<Value> condition;
     /**
-     * The target label of the jump instruction.
+     * The (interned) target label of the jump instruction.
      */
-    std::string target;
+    Symbol target;
 
   public:
     /**
@@ -570,13 +654,30 @@ class JumpIfNotZeroInstruction : public Instruction {
     explicit JumpIfNotZeroInstruction(std::unique_ptr<Value> condition,
                                       std::string_view target);
 
+    /**
+     * Constructor for creating a conditional jump instruction with a condition
+     * value and an interned target label.
+     *
+     * @param condition The condition value of the jump instruction.
+     * @param target The interned target label of the jump instruction.
+     * @throws std::invalid_argument if `condition` is null.
+     */
+    explicit JumpIfNotZeroInstruction(std::unique_ptr<Value> condition,
+                                      Symbol target);
+
     [[nodiscard]] Value *getCondition() const;
 
     [[nodiscard]] const std::string &getTarget() const;
 
+    [[nodiscard]] Symbol getTargetSymbol() const;
+
     void setCondition(std::unique_ptr<Value> newCondition);
 
     void setTarget(std::string_view newTarget);
+
+    void setTarget(Symbol newTarget);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::JumpIfNotZero; }
 };
 
 /**
@@ -585,9 +686,9 @@ class JumpIfNotZeroInstruction : public Instruction {
 class LabelInstruction : public Instruction {
   private:
     /**
-     * The label of the instruction.
+     * The (interned) label of the instruction.
      */
-    std::string label;
+    Symbol label;
 
   public:
     /**
@@ -597,9 +698,22 @@ class LabelInstruction : public Instruction {
      */
     explicit LabelInstruction(std::string_view label);
 
+    /**
+     * Constructor for creating a label instruction with an interned label.
+     *
+     * @param label The interned label of the instruction.
+     */
+    explicit LabelInstruction(Symbol label);
+
     [[nodiscard]] const std::string &getLabel() const;
 
+    [[nodiscard]] Symbol getLabelSymbol() const;
+
     void setLabel(std::string_view newLabel);
+
+    void setLabel(Symbol newLabel);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::Label; }
 };
 
 /**
@@ -639,6 +753,8 @@ class FunctionCallInstruction : public Instruction {
 
     [[nodiscard]] const std::vector<std::unique_ptr<Value>> &getArgs() const;
 
+    [[nodiscard]] std::vector<std::unique_ptr<Value>> &getArgs();
+
     [[nodiscard]] Value *getDst() const;
 
     void setFunctionIdentifier(std::string_view newFunctionIdentifier);
@@ -646,6 +762,8 @@ class FunctionCallInstruction : public Instruction {
     void setArgs(std::unique_ptr<std::vector<std::unique_ptr<Value>>> newArgs);
 
     void setDst(std::unique_ptr<Value> newDst);
+
+    [[nodiscard]] Kind getKind() const override { return Kind::FunctionCall; }
 };
 
 /**
@@ -734,6 +852,8 @@ class FunctionDefinition : public TopLevel {
     [[nodiscard]] const std::vector<std::unique_ptr<Instruction>> &
     getFunctionBody() const;
 
+    [[nodiscard]] std::vector<std::unique_ptr<Instruction>> &getFunctionBody();
+
     void
     setFunctionBody(std::unique_ptr<std::vector<std::unique_ptr<Instruction>>>
                         newFunctionBody);
@@ -170,8 +170,8 @@ IRGenerator::generateIR(const AST::Program &astProgram) {
             // Find the global attribute of the function declaration in the
             // frontend symbol table and set the global flag.
             bool global = false;
-            if (frontendSymbolTable->contains(identifier)) {
-                auto &symbolEntry = (*frontendSymbolTable)[identifier];
+            if (frontendSymbolTable->contains(Symbol(identifier))) {
+                auto &symbolEntry = (*frontendSymbolTable)[Symbol(identifier)];
                 if (auto *functionAttribute =
                         dynamic_cast<AST::FunctionAttribute *>(
                             symbolEntry.second.get())) {
@@ -229,7 +229,7 @@ IRGenerator::generateIR(const AST::Program &astProgram) {
             if (needsImplicitReturn) {
                 // Get the function's return type from the symbol table.
                 auto *functionType =
-                    (*frontendSymbolTable)[identifier].first.get();
+                    (*frontendSymbolTable)[Symbol(identifier)].first.get();
                 auto *functionTypePtr =
                     dynamic_cast<AST::FunctionType *>(functionType);
                 if (functionTypePtr != nullptr) {
@@ -732,7 +732,7 @@ std::unique_ptr<IR::Value> IRGenerator::generateIRInstruction(
         }
         // Add the result variable to the frontend symbol table with the type of
         // the conditional expression's result.
-        (*frontendSymbolTable)[resultLabel] = std::make_pair(
+        (*frontendSymbolTable)[Symbol(resultLabel)] = std::make_pair(
             cloneType(resultType), std::make_unique<AST::LocalAttribute>());
 
         auto resultValue = std::make_unique<IR::VariableValue>(resultLabel);
@@ -782,7 +782,7 @@ std::unique_ptr<IR::VariableValue> IRGenerator::generateIRUnaryInstruction(
 
     // Add the temporary variable to the frontend symbol table with the type
     // of the expression and local attribute.
-    (*frontendSymbolTable)[tmpName] =
+    (*frontendSymbolTable)[Symbol(tmpName)] =
         std::make_pair(cloneType(unaryExpr->getExpType()),
                        std::make_unique<AST::LocalAttribute>());
 
@@ -824,7 +824,7 @@ std::unique_ptr<IR::VariableValue> IRGenerator::generateIRBinaryInstruction(
     // destination value.
     instructions.emplace_back(std::make_unique<IR::BinaryInstruction>(
         std::move(IROp), std::move(lhs), std::move(rhs),
-        std::make_unique<IR::VariableValue>(dst->getIdentifier())));
+        std::make_unique<IR::VariableValue>(dst->getSymbol())));
 
     // Return the destination value.
     return dst;
@@ -854,7 +854,7 @@ IRGenerator::generateIRInstructionWithLogicalAnd(
     auto resultLabel = generateIRResultLabel();
 
     // Add the result variable to the frontend symbol table with type int.
-    (*frontendSymbolTable)[resultLabel] =
+    (*frontendSymbolTable)[Symbol(resultLabel)] =
         std::make_pair(std::make_unique<AST::IntType>(),
                        std::make_unique<AST::LocalAttribute>());
 
@@ -908,7 +908,7 @@ IRGenerator::generateIRInstructionWithLogicalOr(
     auto resultLabel = generateIRResultLabel();
 
     // Add the result variable to the frontend symbol table with type int.
-    (*frontendSymbolTable)[resultLabel] =
+    (*frontendSymbolTable)[Symbol(resultLabel)] =
         std::make_pair(std::make_unique<AST::IntType>(),
                        std::make_unique<AST::LocalAttribute>());
 
@@ -991,7 +991,7 @@ IRGenerator::generateIRFunctionCallInstruction(
 
     // Look up the function's return type in the frontend symbol table.
     auto *functionType =
-        (*frontendSymbolTable)[std::string(functionIdentifier)].first.get();
+        (*frontendSymbolTable)[Symbol(functionIdentifier)].first.get();
     auto *functionTypePtr = dynamic_cast<AST::FunctionType *>(functionType);
     if (functionTypePtr == nullptr) {
         throw std::logic_error(
@@ -1003,7 +1003,7 @@ IRGenerator::generateIRFunctionCallInstruction(
 
     // Add the temporary variable to the frontend symbol table with the type
     // of the function's return type and local attribute.
-    (*frontendSymbolTable)[tmpName] = std::make_pair(
+    (*frontendSymbolTable)[Symbol(tmpName)] = std::make_pair(
         cloneType(&returnType), std::make_unique<AST::LocalAttribute>());
 
     // Create a variable value for the temporary variable.
@@ -1034,7 +1034,7 @@ std::unique_ptr<IR::VariableValue> IRGenerator::generateIRCastInstruction(
         auto *varValue = dynamic_cast<IR::VariableValue *>(result.get());
         if (varValue != nullptr) {
             return std::make_unique<IR::VariableValue>(
-                varValue->getIdentifier());
+                varValue->getSymbol());
         }
     }
 
@@ -1042,7 +1042,7 @@ std::unique_ptr<IR::VariableValue> IRGenerator::generateIRCastInstruction(
     auto dstName = generateIRTemporary();
     // Add the temporary variable to the frontend symbol table with the type
     // of the target type and local attribute.
-    (*frontendSymbolTable)[dstName] = std::make_pair(
+    (*frontendSymbolTable)[Symbol(dstName)] = std::make_pair(
         cloneType(targetType), std::make_unique<AST::LocalAttribute>());
     // Create a variable value for the temporary variable.
     auto dst = std::make_unique<IR::VariableValue>(dstName);
@@ -1136,7 +1136,7 @@ IRGenerator::convertFrontendSymbolTableToIRStaticVariables() {
     auto irDefs =
         std::make_unique<std::vector<std::unique_ptr<IR::StaticVariable>>>();
     for (const auto &symbol : *frontendSymbolTable) {
-        auto name = symbol.first;
+        const auto &name = symbol.first.str();
         auto *type = symbol.second.first.get();
         auto *attribute = symbol.second.second.get();
         if (auto *staticAttribute =
@@ -1270,7 +1270,7 @@ IRGenerator::generateIRVariable(const AST::BinaryExpression *binaryExpr) {
 
     // Add the temporary variable to the frontend symbol table with the
     // appropriate type and local attribute.
-    (*frontendSymbolTable)[tmpName] =
+    (*frontendSymbolTable)[Symbol(tmpName)] =
         std::make_pair(cloneType(binaryExpr->getExpType()),
                        std::make_unique<AST::LocalAttribute>());
 
@@ -1,9 +1,30 @@
 #include "irOptimizationPasses.h"
 #include "../frontend/constant.h"
+#include "../frontend/frontendSymbolTable.h"
+#include "../frontend/type.h"
+#include "../utils/symbol.h"
+#include "algebraicSimplification.h"
+#include "cfg.h"
+#include "constantEvaluator.h"
+#include "dataflow.h"
+#include "dominators.h"
+#include "flatIR.h"
+#include "functionBodyRewriter.h"
 #include "ir.h"
+#include "loops.h"
+#include "ssa.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -12,135 +33,55 @@
  */
 namespace {
 /**
- * Struct representing a constant value, which can be either an int or a long.
- */
-struct ConstValue {
-    bool isLong;
-    long value;
-};
-
-/**
- * Retrieve the constant value from an IR value if it is a constant.
+ * Get the constant an IR value is (if it is one).
  *
- * @param value The IR value to check.
- * @return An optional `ConstValue` if the IR value is a constant, otherwise
- * `std::nullopt`.
+ * @param value The IR value.
+ * @return The flat constant, or `std::nullopt` if the IR value is not a
+ * constant.
  */
-std::optional<ConstValue> getConstValue(const IR::Value *value) {
+std::optional<IR::FlatConstant> getConstant(const IR::Value *value) {
     const auto *constantValue = dynamic_cast<const IR::ConstantValue *>(value);
     if (constantValue == nullptr) {
         return std::nullopt;
     }
-    const auto *astConst = constantValue->getASTConstant();
-    if (const auto *intConst =
-            dynamic_cast<const AST::ConstantInt *>(astConst)) {
-        return ConstValue{.isLong = false,
-                          .value = static_cast<long>(intConst->getValue())};
-    }
-    else if (const auto *longConst =
-                 dynamic_cast<const AST::ConstantLong *>(astConst)) {
-        return ConstValue{.isLong = true, .value = longConst->getValue()};
-    }
-    return std::nullopt;
+    return IR::flattenConstant(constantValue->getASTConstant());
 }
 
 /**
- * Create an IR constant value from a `ConstValue`.
+ * Create an IR constant value from a flat constant.
  *
- * @param value The `ConstValue` to convert.
+ * @param constant The flat constant.
  * @return A `std::unique_ptr` to the created IR constant value.
  */
-std::unique_ptr<IR::Value> makeConstValue(const ConstValue &value) {
-    if (value.isLong) {
-        return std::make_unique<IR::ConstantValue>(
-            std::make_unique<AST::ConstantLong>(value.value));
-    }
+std::unique_ptr<IR::Value> makeConstantValue(IR::FlatConstant constant) {
     return std::make_unique<IR::ConstantValue>(
-        std::make_unique<AST::ConstantInt>(static_cast<int>(value.value)));
-}
-
-/**
- * Attempt to fold a unary operation on a constant value.
- *
- * @param op The unary operator.
- * @param src The source constant value.
- * @return An optional `ConstValue` if the operation can be folded, otherwise
- * `std::nullopt`.
- */
-std::optional<ConstValue> foldUnary(const IR::UnaryOperator *op,
-                                    const ConstValue &src) {
-    if (dynamic_cast<const IR::NegateOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = src.isLong, .value = -src.value};
-    }
-    else if (dynamic_cast<const IR::ComplementOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = src.isLong, .value = ~src.value};
-    }
-    else if (dynamic_cast<const IR::NotOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = false, .value = src.value == 0 ? 1 : 0};
-    }
-    return std::nullopt;
+        IR::unflattenConstant(constant));
 }
 
 /**
- * Attempt to fold a binary operation on two constant values.
+ * Get the constant kind of the type of the variable an IR value is.
  *
- * @param op The binary operator.
- * @param lhs The left-hand side constant value.
- * @param rhs The right-hand side constant value.
- * @return An optional `ConstValue` if the operation can be folded, otherwise
- * `std::nullopt`.
+ * @param value The IR value.
+ * @param frontendSymbolTable The frontend symbol table.
+ * @param introducedOriginals The original variables of the variables
+ * introduced while optimizing the function body.
+ * @return The constant kind, or `std::nullopt` if the IR value is not a
+ * variable of a known integer type.
  */
-std::optional<ConstValue> foldBinary(const IR::BinaryOperator *op,
-                                     const ConstValue &lhs,
-                                     const ConstValue &rhs) {
-    const bool isLong = lhs.isLong || rhs.isLong;
-    if (dynamic_cast<const IR::AddOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = isLong, .value = lhs.value + rhs.value};
-    }
-    else if (dynamic_cast<const IR::SubtractOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = isLong, .value = lhs.value - rhs.value};
-    }
-    else if (dynamic_cast<const IR::MultiplyOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = isLong, .value = lhs.value * rhs.value};
-    }
-    else if (dynamic_cast<const IR::DivideOperator *>(op) != nullptr) {
-        if (rhs.value == 0) {
-            return std::nullopt;
-        }
-        return ConstValue{.isLong = isLong, .value = lhs.value / rhs.value};
-    }
-    else if (dynamic_cast<const IR::RemainderOperator *>(op) != nullptr) {
-        if (rhs.value == 0) {
-            return std::nullopt;
-        }
-        return ConstValue{.isLong = isLong, .value = lhs.value % rhs.value};
-    }
-    else if (dynamic_cast<const IR::EqualOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = false,
-                          .value = lhs.value == rhs.value ? 1 : 0};
-    }
-    else if (dynamic_cast<const IR::NotEqualOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = false,
-                          .value = lhs.value != rhs.value ? 1 : 0};
-    }
-    else if (dynamic_cast<const IR::LessThanOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = false,
-                          .value = lhs.value < rhs.value ? 1 : 0};
-    }
-    else if (dynamic_cast<const IR::LessThanOrEqualOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = false,
-                          .value = lhs.value <= rhs.value ? 1 : 0};
-    }
-    else if (dynamic_cast<const IR::GreaterThanOperator *>(op) != nullptr) {
-        return ConstValue{.isLong = false,
-                          .value = lhs.value > rhs.value ? 1 : 0};
+std::optional<IR::ConstantKind>
+getVariableKind(const IR::Value *value,
+                const AST::FrontendSymbolTable &frontendSymbolTable,
+                const IR::IntroducedOriginals &introducedOriginals) {
+    const auto *variableValue = dynamic_cast<const IR::VariableValue *>(value);
+    if (variableValue == nullptr) {
+        return std::nullopt;
     }
-    else if (dynamic_cast<const IR::GreaterThanOrEqualOperator *>(op) !=
-             nullptr) {
-        return ConstValue{.isLong = false,
-                          .value = lhs.value >= rhs.value ? 1 : 0};
+    const auto *type = IR::findVariableType(
+        variableValue->getSymbol(), frontendSymbolTable, introducedOriginals);
+    if (type == nullptr) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    return IR::getConstantKind(type);
 }
 
 /**
@@ -158,6 +99,14 @@ std::unique_ptr<AST::Constant> cloneASTConstant(const AST::Constant *constant) {
                  dynamic_cast<const AST::ConstantLong *>(constant)) {
         return std::make_unique<AST::ConstantLong>(longConst->getValue());
     }
+    else if (const auto *uintConst =
+                 dynamic_cast<const AST::ConstantUInt *>(constant)) {
+        return std::make_unique<AST::ConstantUInt>(uintConst->getValue());
+    }
+    else if (const auto *ulongConst =
+                 dynamic_cast<const AST::ConstantULong *>(constant)) {
+        return std::make_unique<AST::ConstantULong>(ulongConst->getValue());
+    }
     throw std::logic_error("Unsupported AST constant in cloneASTConstant");
 }
 
@@ -176,297 +125,2435 @@ std::unique_ptr<IR::Value> cloneValue(const IR::Value *value) {
     else if (const auto *variableValue =
                  dynamic_cast<const IR::VariableValue *>(value)) {
         return std::make_unique<IR::VariableValue>(
-            variableValue->getIdentifier());
+            variableValue->getSymbol());
     }
     throw std::logic_error("Unsupported IR value in cloneValue");
 }
+/**
+ * Struct representing a copy fact of the reaching copies analysis: the copy
+ * of `src` (a constant or a variable) to the variable `dst`.
+ */
+struct CopyFact {
+    bool srcIsConstant = false;
+    Symbol srcVariable;
+    IR::FlatConstant srcConstant{.kind = IR::ConstantKind::Int, .bits = 0};
+    Symbol dst;
+
+    friend bool operator==(const CopyFact &, const CopyFact &) = default;
+};
+
+/**
+ * Hash function for copy facts.
+ */
+struct CopyFactHash {
+    std::size_t operator()(const CopyFact &fact) const noexcept {
+        const auto src =
+            fact.srcIsConstant
+                ? IR::FlatConstantHash{}(fact.srcConstant)
+                : std::hash<Symbol>{}(fact.srcVariable);
+        return (src * 31) ^ std::hash<Symbol>{}(fact.dst);
+    }
+};
 
 /**
- * Clone an IR unary operator.
+ * Check whether a copy preserves the type of its source (so that the
+ * destination can be replaced by the source without changing the type an
+ * instruction operates on).
  *
- * @param op The unary operator to clone.
- * @return A `std::unique_ptr` to the cloned unary operator.
+ * @param src The source of the copy.
+ * @param dst The destination of the copy.
+ * @param frontendSymbolTable The frontend symbol table.
+ * @param introducedOriginals The original variables of the variables
+ * introduced while optimizing the function body.
+ * @return True if the source and the destination have the same type, false
+ * otherwise.
  */
-std::unique_ptr<IR::UnaryOperator>
-cloneUnaryOperator(const IR::UnaryOperator *op) {
-    if (dynamic_cast<const IR::NegateOperator *>(op) != nullptr) {
-        return std::make_unique<IR::NegateOperator>();
+bool isSameTypeCopy(const IR::Value &src, Symbol dst,
+                    const AST::FrontendSymbolTable &frontendSymbolTable,
+                    const IR::IntroducedOriginals &introducedOriginals) {
+    const auto *dstType =
+        IR::findVariableType(dst, frontendSymbolTable, introducedOriginals);
+    if (dstType == nullptr) {
+        return false;
+    }
+    if (const auto *variableValue =
+            dynamic_cast<const IR::VariableValue *>(&src)) {
+        const auto *srcType = IR::findVariableType(
+            variableValue->getSymbol(), frontendSymbolTable,
+            introducedOriginals);
+        return srcType != nullptr && srcType->isEqual(*dstType);
+    }
+    const auto *constantValue = static_cast<const IR::ConstantValue *>(&src);
+    switch (IR::flattenConstant(constantValue->getASTConstant()).kind) {
+    case IR::ConstantKind::Int:
+        return dynamic_cast<const AST::IntType *>(dstType) != nullptr;
+    case IR::ConstantKind::Long:
+        return dynamic_cast<const AST::LongType *>(dstType) != nullptr;
+    case IR::ConstantKind::UInt:
+        return dynamic_cast<const AST::UIntType *>(dstType) != nullptr;
+    case IR::ConstantKind::ULong:
+        return dynamic_cast<const AST::ULongType *>(dstType) != nullptr;
+    }
+    return false;
+}
+
+/**
+ * Class for the reaching copies analysis of a CFG: which copies `dst = src`
+ * are guaranteed to have happened (with neither side reassigned since) at
+ * each point of the function body.
+ */
+class ReachingCopies {
+  public:
+    /**
+     * Constructor for the reaching copies class.
+     *
+     * Collect the copies of the CFG and solve the analysis.
+     *
+     * @param cfg The CFG to analyze.
+     * @param frontendSymbolTable The frontend symbol table.
+     * @param introducedOriginals The original variables of the variables
+     * introduced while optimizing the function body.
+     */
+    ReachingCopies(const IR::CFG &cfg,
+                   const AST::FrontendSymbolTable &frontendSymbolTable,
+                   const IR::IntroducedOriginals &introducedOriginals)
+        : frontendSymbolTable(frontendSymbolTable),
+          introducedOriginals(introducedOriginals) {
+        for (const auto &block : cfg.getBlocks()) {
+            for (const auto &instruction : block.instructions) {
+                if (instruction->getKind() == IR::Instruction::Kind::Copy) {
+                    addFact(static_cast<const IR::CopyInstruction &>(
+                        *instruction));
+                }
+            }
+        }
+        reachingIn = IR::solveDataflow(
+            cfg, IR::DataflowDirection::Forward,
+            IR::DataflowMeet::Intersection, IR::BitSet(facts.size()),
+            [this, &cfg](std::size_t id, const IR::BitSet &in) {
+                auto out = in;
+                for (const auto &instruction : cfg.getBlock(id).instructions) {
+                    transfer(*instruction, out);
+                }
+                return out;
+            });
+    }
+
+    /**
+     * Get the copies reaching the start of a basic block.
+     */
+    [[nodiscard]] const IR::BitSet &getReachingIn(std::size_t id) const {
+        return reachingIn[id];
     }
-    else if (dynamic_cast<const IR::ComplementOperator *>(op) != nullptr) {
-        return std::make_unique<IR::ComplementOperator>();
+
+    /**
+     * Apply the effect of an instruction to a set of reaching copies.
+     */
+    void transfer(const IR::Instruction &instruction,
+                  IR::BitSet &reaching) const {
+        switch (instruction.getKind()) {
+        case IR::Instruction::Kind::Copy: {
+            const auto &copy =
+                static_cast<const IR::CopyInstruction &>(instruction);
+            if (isRedundant(copy, reaching)) {
+                return;
+            }
+            const auto index = findFact(copy);
+            kill(getVariable(*copy.getDst()), reaching);
+            if (index.has_value()) {
+                reaching.set(*index);
+            }
+            return;
+        }
+        case IR::Instruction::Kind::FunctionCall:
+            // The callee may update any static variable.
+            for (auto index : staticFacts) {
+                reaching.reset(index);
+            }
+            break;
+        default:
+            break;
+        }
+        if (const auto *dst = IR::getDst(instruction)) {
+            kill(getVariable(*dst), reaching);
+        }
+    }
+
+    /**
+     * Check whether a copy is redundant: the same copy, or the copy in the
+     * opposite direction, already reaches it.
+     */
+    [[nodiscard]] bool isRedundant(const IR::CopyInstruction &copy,
+                                   const IR::BitSet &reaching) const {
+        if (auto index = findFact(copy); index && reaching.test(*index)) {
+            return true;
+        }
+        const auto *srcVariable =
+            dynamic_cast<const IR::VariableValue *>(copy.getSrc());
+        if (srcVariable == nullptr) {
+            return false;
+        }
+        const CopyFact reverseFact{
+            .srcIsConstant = false,
+            .srcVariable = getVariable(*copy.getDst()),
+            .srcConstant = {.kind = IR::ConstantKind::Int, .bits = 0},
+            .dst = srcVariable->getSymbol()};
+        auto reverse = factIndices.find(reverseFact);
+        return reverse != factIndices.end() && reaching.test(reverse->second);
+    }
+
+    /**
+     * Get the replacement of a source operand: the source of the copy to it
+     * that reaches it (if any).
+     */
+    [[nodiscard]] std::unique_ptr<IR::Value>
+    replacementFor(const IR::Value &src, const IR::BitSet &reaching) const {
+        const auto *variableValue =
+            dynamic_cast<const IR::VariableValue *>(&src);
+        if (variableValue == nullptr) {
+            return nullptr;
+        }
+        auto it = factsByDst.find(variableValue->getSymbol());
+        if (it == factsByDst.end()) {
+            return nullptr;
+        }
+        for (auto index : it->second) {
+            if (!reaching.test(index)) {
+                continue;
+            }
+            const auto &fact = facts[index];
+            if (fact.srcIsConstant) {
+                return std::make_unique<IR::ConstantValue>(
+                    IR::unflattenConstant(fact.srcConstant));
+            }
+            return std::make_unique<IR::VariableValue>(fact.srcVariable);
+        }
+        return nullptr;
+    }
+
+  private:
+    /**
+     * Get the variable of a (variable) value.
+     */
+    [[nodiscard]] static Symbol getVariable(const IR::Value &value) {
+        return static_cast<const IR::VariableValue &>(value).getSymbol();
+    }
+
+    /**
+     * Build the copy fact of a copy instruction.
+     */
+    [[nodiscard]] static CopyFact makeFact(const IR::CopyInstruction &copy) {
+        CopyFact fact;
+        fact.dst = getVariable(*copy.getDst());
+        if (const auto *constantValue =
+                dynamic_cast<const IR::ConstantValue *>(copy.getSrc())) {
+            fact.srcIsConstant = true;
+            fact.srcConstant =
+                IR::flattenConstant(constantValue->getASTConstant());
+        }
+        else {
+            fact.srcVariable = getVariable(*copy.getSrc());
+        }
+        return fact;
+    }
+
+    /**
+     * Get the index of the copy fact of a copy instruction (if it is
+     * tracked).
+     */
+    [[nodiscard]] std::optional<std::size_t>
+    findFact(const IR::CopyInstruction &copy) const {
+        auto it = factIndices.find(makeFact(copy));
+        if (it == factIndices.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * Track the copy fact of a copy instruction (unless it changes the type of
+     * its source).
+     */
+    void addFact(const IR::CopyInstruction &copy) {
+        auto fact = makeFact(copy);
+        if (factIndices.contains(fact) ||
+            !isSameTypeCopy(*copy.getSrc(), fact.dst, frontendSymbolTable,
+                            introducedOriginals)) {
+            return;
+        }
+        const auto index = facts.size();
+        facts.emplace_back(fact);
+        factIndices.emplace(fact, index);
+        factsByDst[fact.dst].emplace_back(index);
+        factsByVariable[fact.dst].emplace_back(index);
+        bool isStatic = IR::isStaticVariable(fact.dst, frontendSymbolTable);
+        if (!fact.srcIsConstant) {
+            factsByVariable[fact.srcVariable].emplace_back(index);
+            isStatic = isStatic || IR::isStaticVariable(fact.srcVariable,
+                                                        frontendSymbolTable);
+        }
+        if (isStatic) {
+            staticFacts.emplace_back(index);
+        }
+    }
+
+    /**
+     * Remove the copies to or from a variable (which has been updated) from a
+     * set of reaching copies.
+     */
+    void kill(Symbol variable, IR::BitSet &reaching) const {
+        auto it = factsByVariable.find(variable);
+        if (it == factsByVariable.end()) {
+            return;
+        }
+        for (auto index : it->second) {
+            reaching.reset(index);
+        }
+    }
+
+    /**
+     * The frontend symbol table.
+     */
+    const AST::FrontendSymbolTable &frontendSymbolTable;
+    /**
+     * The original variables of the variables introduced while optimizing the
+     * function body.
+     */
+    const IR::IntroducedOriginals &introducedOriginals;
+    /**
+     * The tracked copy facts (indexed by fact).
+     */
+    std::vector<CopyFact> facts;
+    /**
+     * The map from copy facts to their indices.
+     */
+    std::unordered_map<CopyFact, std::size_t, CopyFactHash> factIndices;
+    /**
+     * The map from variables to the indices of the copies to them.
+     */
+    std::unordered_map<Symbol, std::vector<std::size_t>> factsByDst;
+    /**
+     * The map from variables to the indices of the copies to or from them.
+     */
+    std::unordered_map<Symbol, std::vector<std::size_t>> factsByVariable;
+    /**
+     * The indices of the copies to or from static variables.
+     */
+    std::vector<std::size_t> staticFacts;
+    /**
+     * The copies reaching the start of each basic block (indexed by ID).
+     */
+    std::vector<IR::BitSet> reachingIn;
+};
+
+/**
+ * Enumeration representing the states of the constant propagation lattice:
+ * a value not (yet) known to be computed at all (top), a value known to be a
+ * constant, and a value that may vary at runtime (bottom).
+ */
+enum class LatticeState : std::uint8_t { Top, Constant, Bottom };
+
+/**
+ * Struct representing a value of the constant propagation lattice.
+ */
+struct LatticeValue {
+    LatticeState state = LatticeState::Top;
+    IR::FlatConstant constant{.kind = IR::ConstantKind::Int, .bits = 0};
+
+    friend bool operator==(const LatticeValue &,
+                           const LatticeValue &) = default;
+};
+
+/**
+ * Combine two lattice values flowing into the same point.
+ *
+ * @param lhs The first lattice value.
+ * @param rhs The second lattice value.
+ * @return The combined lattice value.
+ */
+LatticeValue meetLatticeValues(const LatticeValue &lhs,
+                               const LatticeValue &rhs) {
+    if (lhs.state == LatticeState::Top) {
+        return rhs;
     }
-    else if (dynamic_cast<const IR::NotOperator *>(op) != nullptr) {
-        return std::make_unique<IR::NotOperator>();
+    if (rhs.state == LatticeState::Top || lhs == rhs) {
+        return lhs;
     }
-    throw std::logic_error("Unsupported unary operator in cloneUnaryOperator");
+    return LatticeValue{.state = LatticeState::Bottom, .constant = {}};
 }
 
 /**
- * Clone an IR binary operator.
+ * Class for the sparse conditional constant propagation (SCCP) analysis of an
+ * SSA form (Wegman and Zadeck): which versions hold the same constant on every
+ * execution, and which CFG edges can be taken at all.
  *
- * @param op The binary operator to clone.
- * @return A `std::unique_ptr` to the cloned binary operator.
+ * Values are only propagated along edges found executable, and a conditional
+ * jump on a constant only makes one of its edges executable, so constants
+ * merged from branches that are never taken are still found. The constants
+ * are computed with the semantics of the types of the versions (those of the
+ * variables they belong to); the versions of variables of unknown type, and
+ * all other variables, vary at runtime.
  */
-std::unique_ptr<IR::BinaryOperator>
-cloneBinaryOperator(const IR::BinaryOperator *op) {
-    if (dynamic_cast<const IR::AddOperator *>(op) != nullptr) {
-        return std::make_unique<IR::AddOperator>();
+class SparseConditionalConstants {
+  public:
+    /**
+     * Constructor for the sparse conditional constants class.
+     *
+     * Number the versions of the SSA form, collect their uses, and solve the
+     * analysis.
+     *
+     * @param ssaForm The SSA form to analyze.
+     * @param frontendSymbolTable The frontend symbol table.
+     * @param introducedOriginals The original variables of the variables
+     * introduced while optimizing the function body.
+     */
+    SparseConditionalConstants(
+        const IR::SSAForm &ssaForm,
+        const AST::FrontendSymbolTable &frontendSymbolTable,
+        const IR::IntroducedOriginals &introducedOriginals)
+        : cfg(ssaForm.getCFG()), ssaForm(ssaForm) {
+        const auto blockCount = cfg.getBlocks().size();
+        auto addVersion = [&](Symbol version) {
+            const auto variable = ssaForm.getOriginalVariable(version);
+            if (variable == version || versionIndices.contains(version)) {
+                return;
+            }
+            versionIndices.emplace(version, values.size());
+            const auto *type = IR::findVariableType(
+                variable, frontendSymbolTable, introducedOriginals);
+            kinds.emplace_back(type == nullptr ? std::nullopt
+                                               : IR::getConstantKind(type));
+            values.emplace_back(LatticeValue{
+                .state = kinds.back() ? LatticeState::Top
+                                      : LatticeState::Bottom,
+                .constant = {}});
+            uses.emplace_back();
+        };
+        for (const auto &block : cfg.getBlocks()) {
+            for (const auto &phi : ssaForm.getPhis(block.id)) {
+                addVersion(phi.dst);
+            }
+            for (const auto &instruction : block.instructions) {
+                if (const auto *dst = IR::getDst(*instruction)) {
+                    addVersion(static_cast<const IR::VariableValue *>(dst)
+                                   ->getSymbol());
+                }
+            }
+        }
+        for (const auto &block : cfg.getBlocks()) {
+            const auto &phis = ssaForm.getPhis(block.id);
+            for (std::size_t index = 0; index < phis.size(); ++index) {
+                for (const auto &arg : phis[index].args) {
+                    if (arg) {
+                        addUse(*arg, Use{.blockId = block.id,
+                                         .isPhi = true,
+                                         .index = index});
+                    }
+                }
+            }
+            for (std::size_t index = 0; index < block.instructions.size();
+                 ++index) {
+                IR::forEachSrc(*block.instructions[index],
+                               [&](const IR::Value &src) {
+                                   addUse(src, Use{.blockId = block.id,
+                                                   .isPhi = false,
+                                                   .index = index});
+                               });
+            }
+        }
+        executableBlocks.assign(blockCount, false);
+        executableSuccessors.assign(blockCount, {});
+        solve();
+    }
+
+    /**
+     * Check whether a basic block can be executed.
+     */
+    [[nodiscard]] bool isExecutable(std::size_t id) const {
+        return executableBlocks[id];
     }
-    else if (dynamic_cast<const IR::SubtractOperator *>(op) != nullptr) {
-        return std::make_unique<IR::SubtractOperator>();
+
+    /**
+     * Check whether an edge can be taken.
+     */
+    [[nodiscard]] bool isEdgeExecutable(std::size_t from,
+                                        std::size_t to) const {
+        return std::ranges::find(executableSuccessors[from], to) !=
+               executableSuccessors[from].end();
+    }
+
+    /**
+     * Get the constant a value always holds (a constant, or a version found
+     * constant), if any.
+     */
+    [[nodiscard]] std::optional<IR::FlatConstant>
+    getConstant(const IR::Value &value) const {
+        const auto latticeValue = getLatticeValue(value);
+        if (latticeValue.state != LatticeState::Constant) {
+            return std::nullopt;
+        }
+        return latticeValue.constant;
+    }
+
+    /**
+     * Check whether a version is an argument of a phi node.
+     */
+    [[nodiscard]] bool isPhiArgument(Symbol version) const {
+        auto it = versionIndices.find(version);
+        return it != versionIndices.end() &&
+               std::ranges::any_of(uses[it->second],
+                                   [](const Use &use) { return use.isPhi; });
+    }
+
+  private:
+    /**
+     * Struct representing a use of a version: an instruction or a phi node
+     * (by index) of a basic block.
+     */
+    struct Use {
+        std::size_t blockId;
+        bool isPhi;
+        std::size_t index;
+    };
+
+    /**
+     * Record a use of a value (if it is a version).
+     */
+    void addUse(const IR::Value &value, Use use) {
+        if (auto index = findVersion(value)) {
+            uses[*index].emplace_back(use);
+        }
     }
-    else if (dynamic_cast<const IR::MultiplyOperator *>(op) != nullptr) {
-        return std::make_unique<IR::MultiplyOperator>();
+
+    /**
+     * Get the index of the version a value is (if any).
+     */
+    [[nodiscard]] std::optional<std::size_t>
+    findVersion(const IR::Value &value) const {
+        if (const auto *variableValue =
+                dynamic_cast<const IR::VariableValue *>(&value)) {
+            auto it = versionIndices.find(variableValue->getSymbol());
+            if (it != versionIndices.end()) {
+                return it->second;
+            }
+        }
+        return std::nullopt;
     }
-    else if (dynamic_cast<const IR::DivideOperator *>(op) != nullptr) {
-        return std::make_unique<IR::DivideOperator>();
+
+    /**
+     * Get the lattice value of a value.
+     */
+    [[nodiscard]] LatticeValue getLatticeValue(const IR::Value &value) const {
+        if (const auto *constantValue =
+                dynamic_cast<const IR::ConstantValue *>(&value)) {
+            return LatticeValue{
+                .state = LatticeState::Constant,
+                .constant =
+                    IR::flattenConstant(constantValue->getASTConstant())};
+        }
+        if (auto index = findVersion(value)) {
+            return values[*index];
+        }
+        return LatticeValue{.state = LatticeState::Bottom, .constant = {}};
     }
-    else if (dynamic_cast<const IR::RemainderOperator *>(op) != nullptr) {
-        return std::make_unique<IR::RemainderOperator>();
+
+    /**
+     * Run the worklist algorithm until no more edges become executable and
+     * no more versions change.
+     */
+    void solve() {
+        constexpr auto entryId = IR::CFG::getEntryId();
+        executableBlocks[entryId] = true;
+        for (const auto successorId : cfg.getBlock(entryId).successors) {
+            markEdgeExecutable(entryId, successorId);
+        }
+        while (!blockWorklist.empty() || !versionWorklist.empty()) {
+            if (!blockWorklist.empty()) {
+                const auto id = blockWorklist.back();
+                blockWorklist.pop_back();
+                visitBlock(id);
+                continue;
+            }
+            const auto index = versionWorklist.back();
+            versionWorklist.pop_back();
+            for (const auto &use : uses[index]) {
+                if (!executableBlocks[use.blockId]) {
+                    continue;
+                }
+                if (use.isPhi) {
+                    visitPhi(use.blockId, use.index);
+                }
+                else {
+                    visitInstruction(use.blockId, use.index);
+                }
+            }
+        }
     }
-    else if (dynamic_cast<const IR::EqualOperator *>(op) != nullptr) {
-        return std::make_unique<IR::EqualOperator>();
+
+    /**
+     * Mark an edge as executable (and queue its destination).
+     */
+    void markEdgeExecutable(std::size_t from, std::size_t to) {
+        if (isEdgeExecutable(from, to)) {
+            return;
+        }
+        executableSuccessors[from].emplace_back(to);
+        blockWorklist.emplace_back(to);
     }
-    else if (dynamic_cast<const IR::NotEqualOperator *>(op) != nullptr) {
-        return std::make_unique<IR::NotEqualOperator>();
+
+    /**
+     * Visit a basic block reached by a newly executable edge: reevaluate its
+     * phi nodes and, the first time, all of its instructions.
+     */
+    void visitBlock(std::size_t id) {
+        const bool isFirstVisit = !executableBlocks[id];
+        executableBlocks[id] = true;
+        for (std::size_t index = 0; index < ssaForm.getPhis(id).size();
+             ++index) {
+            visitPhi(id, index);
+        }
+        if (!isFirstVisit) {
+            return;
+        }
+        const auto &instructions = cfg.getBlock(id).instructions;
+        for (std::size_t index = 0; index < instructions.size(); ++index) {
+            visitInstruction(id, index);
+        }
+        const auto kind = instructions.empty()
+                              ? IR::Instruction::Kind::Label
+                              : instructions.back()->getKind();
+        if (kind != IR::Instruction::Kind::JumpIfZero &&
+            kind != IR::Instruction::Kind::JumpIfNotZero) {
+            for (const auto successorId : cfg.getBlock(id).successors) {
+                markEdgeExecutable(id, successorId);
+            }
+        }
     }
-    else if (dynamic_cast<const IR::LessThanOperator *>(op) != nullptr) {
-        return std::make_unique<IR::LessThanOperator>();
+
+    /**
+     * Reevaluate a phi node: combine its arguments along the executable
+     * edges.
+     */
+    void visitPhi(std::size_t id, std::size_t index) {
+        const auto &phi = ssaForm.getPhis(id)[index];
+        const auto &predecessors = cfg.getBlock(id).predecessors;
+        LatticeValue value;
+        for (std::size_t k = 0; k < phi.args.size(); ++k) {
+            if (phi.args[k] && isEdgeExecutable(predecessors[k], id)) {
+                value = meetLatticeValues(value, getLatticeValue(*phi.args[k]));
+            }
+        }
+        lower(versionIndices.at(phi.dst), value);
     }
-    else if (dynamic_cast<const IR::LessThanOrEqualOperator *>(op) != nullptr) {
-        return std::make_unique<IR::LessThanOrEqualOperator>();
+
+    /**
+     * Reevaluate an instruction: lower the lattice value of its destination,
+     * or, for a conditional jump, mark the edges it can take.
+     */
+    void visitInstruction(std::size_t id, std::size_t index) {
+        const auto &instruction = *cfg.getBlock(id).instructions[index];
+        const auto kind = instruction.getKind();
+        if (kind == IR::Instruction::Kind::JumpIfZero ||
+            kind == IR::Instruction::Kind::JumpIfNotZero) {
+            visitConditionalJump(id, instruction);
+            return;
+        }
+        const auto *dst = IR::getDst(instruction);
+        if (dst == nullptr) {
+            return;
+        }
+        // The versions of variables of unknown type start (and stay) at
+        // bottom.
+        auto dstIndex = findVersion(*dst);
+        if (dstIndex && kinds[*dstIndex]) {
+            lower(*dstIndex, evaluate(instruction, *kinds[*dstIndex]));
+        }
     }
-    else if (dynamic_cast<const IR::GreaterThanOperator *>(op) != nullptr) {
-        return std::make_unique<IR::GreaterThanOperator>();
+
+    /**
+     * Mark the edges a conditional jump can take: one if its condition is
+     * constant, both otherwise.
+     */
+    void visitConditionalJump(std::size_t id,
+                              const IR::Instruction &instruction) {
+        const bool isJumpIfZero =
+            instruction.getKind() == IR::Instruction::Kind::JumpIfZero;
+        const auto &condition =
+            isJumpIfZero
+                ? *static_cast<const IR::JumpIfZeroInstruction &>(instruction)
+                       .getCondition()
+                : *static_cast<const IR::JumpIfNotZeroInstruction &>(
+                       instruction)
+                       .getCondition();
+        const auto target =
+            isJumpIfZero
+                ? static_cast<const IR::JumpIfZeroInstruction &>(instruction)
+                      .getTargetSymbol()
+                : static_cast<const IR::JumpIfNotZeroInstruction &>(
+                      instruction)
+                      .getTargetSymbol();
+        const auto targetId = *cfg.getBlockIdForLabel(target);
+        const auto &successors = cfg.getBlock(id).successors;
+        const auto conditionValue = getLatticeValue(condition);
+        const bool isTaken =
+            isJumpIfZero == (conditionValue.constant.bits == 0);
+        for (const auto successorId : successors) {
+            if (conditionValue.state != LatticeState::Constant ||
+                successors.size() == 1 ||
+                (successorId == targetId) == isTaken) {
+                markEdgeExecutable(id, successorId);
+            }
+        }
     }
-    else if (dynamic_cast<const IR::GreaterThanOrEqualOperator *>(op) !=
-             nullptr) {
-        return std::make_unique<IR::GreaterThanOrEqualOperator>();
+
+    /**
+     * Evaluate an instruction on the lattice values of its operands.
+     */
+    [[nodiscard]] LatticeValue evaluate(const IR::Instruction &instruction,
+                                        IR::ConstantKind dstKind) const {
+        constexpr LatticeValue bottom{.state = LatticeState::Bottom,
+                                      .constant = {}};
+        auto makeValue = [&](IR::FlatConstant constant) {
+            return LatticeValue{
+                .state = LatticeState::Constant,
+                .constant = IR::convertConstant(constant, dstKind)};
+        };
+        switch (instruction.getKind()) {
+        case IR::Instruction::Kind::Copy:
+        case IR::Instruction::Kind::SignExtend:
+        case IR::Instruction::Kind::Truncate:
+        case IR::Instruction::Kind::ZeroExtend: {
+            // The conversions are those of C from the type of the source.
+            LatticeValue src;
+            IR::forEachSrc(instruction, [&](const IR::Value &value) {
+                src = getLatticeValue(value);
+            });
+            return src.state == LatticeState::Constant ? makeValue(src.constant)
+                                                       : src;
+        }
+        case IR::Instruction::Kind::Unary: {
+            const auto &unary =
+                static_cast<const IR::UnaryInstruction &>(instruction);
+            const auto src = getLatticeValue(*unary.getSrc());
+            if (src.state != LatticeState::Constant) {
+                return src;
+            }
+            return makeValue(IR::evaluateUnary(
+                IR::flattenUnaryOperator(unary.getUnaryOperator()),
+                src.constant));
+        }
+        case IR::Instruction::Kind::Binary: {
+            const auto &binary =
+                static_cast<const IR::BinaryInstruction &>(instruction);
+            const auto lhs = getLatticeValue(*binary.getSrc1());
+            const auto rhs = getLatticeValue(*binary.getSrc2());
+            if (lhs.state == LatticeState::Bottom ||
+                rhs.state == LatticeState::Bottom) {
+                return bottom;
+            }
+            if (lhs.state == LatticeState::Top ||
+                rhs.state == LatticeState::Top) {
+                return LatticeValue{};
+            }
+            const auto result = IR::evaluateBinary(
+                IR::flattenBinaryOperator(binary.getBinaryOperator()),
+                lhs.constant, rhs.constant);
+            return result ? makeValue(*result) : bottom;
+        }
+        default:
+            return bottom;
+        }
     }
-    throw std::logic_error(
-        "Unsupported binary operator in cloneBinaryOperator");
+
+    /**
+     * Lower the lattice value of a version (to its meet with a new value),
+     * and queue its uses if it changed.
+     */
+    void lower(std::size_t index, const LatticeValue &value) {
+        const auto lowered = meetLatticeValues(values[index], value);
+        if (lowered != values[index]) {
+            values[index] = lowered;
+            versionWorklist.emplace_back(index);
+        }
+    }
+
+    /**
+     * The CFG of the SSA form.
+     */
+    const IR::CFG &cfg;
+    /**
+     * The SSA form (for its phi nodes and versions).
+     */
+    const IR::SSAForm &ssaForm;
+    /**
+     * The map from versions to their indices.
+     */
+    std::unordered_map<Symbol, std::size_t> versionIndices;
+    /**
+     * The constant kind of each version (indexed by version; `std::nullopt`
+     * if the type of its variable is unknown).
+     */
+    std::vector<std::optional<IR::ConstantKind>> kinds;
+    /**
+     * The lattice value of each version (indexed by version).
+     */
+    std::vector<LatticeValue> values;
+    /**
+     * The uses of each version (indexed by version).
+     */
+    std::vector<std::vector<Use>> uses;
+    /**
+     * Booleans indicating whether each basic block is executable (indexed by
+     * ID).
+     */
+    std::vector<bool> executableBlocks;
+    /**
+     * The successors along executable edges of each basic block (indexed by
+     * ID).
+     */
+    std::vector<std::vector<std::size_t>> executableSuccessors;
+    /**
+     * The basic blocks reached by newly executable edges.
+     */
+    std::vector<std::size_t> blockWorklist;
+    /**
+     * The versions whose lattice values changed.
+     */
+    std::vector<std::size_t> versionWorklist;
+};
+
+/**
+ * Struct representing an operand of an expression of global value numbering:
+ * a constant, or a variable standing for its value.
+ */
+struct ValueOperand {
+    bool isConstant = false;
+    Symbol variable;
+    IR::FlatConstant constant{.kind = IR::ConstantKind::Int, .bits = 0};
+
+    friend bool operator==(const ValueOperand &,
+                           const ValueOperand &) = default;
+};
+
+/**
+ * Check whether an operand comes before another one in the canonical order of
+ * the operands of commutative operators (variables by ID, then constants).
+ *
+ * @param lhs The first operand.
+ * @param rhs The second operand.
+ * @return True if `lhs` comes before `rhs`, false otherwise.
+ */
+bool isOperandBefore(const ValueOperand &lhs, const ValueOperand &rhs) {
+    if (lhs.isConstant != rhs.isConstant) {
+        return !lhs.isConstant;
+    }
+    if (!lhs.isConstant) {
+        return lhs.variable.getId() < rhs.variable.getId();
+    }
+    return std::pair(lhs.constant.kind, lhs.constant.bits) <
+           std::pair(rhs.constant.kind, rhs.constant.bits);
+}
+
+/**
+ * Struct representing an expression of global value numbering: a unary or
+ * binary operator applied to operands (the second operand of a unary
+ * operator is the default operand).
+ */
+struct ValueExpression {
+    bool isBinary = false;
+    std::uint8_t opcode = 0;
+    ValueOperand lhs;
+    ValueOperand rhs;
+
+    friend bool operator==(const ValueExpression &,
+                           const ValueExpression &) = default;
+};
+
+/**
+ * Hash function for expressions of global value numbering.
+ */
+struct ValueExpressionHash {
+    std::size_t operator()(const ValueExpression &expression) const noexcept {
+        auto hashOperand = [](const ValueOperand &operand) {
+            return operand.isConstant
+                       ? IR::FlatConstantHash{}(operand.constant)
+                       : std::hash<Symbol>{}(operand.variable);
+        };
+        return (((hashOperand(expression.lhs) * 31) ^
+                 hashOperand(expression.rhs)) *
+                31) ^
+               ((static_cast<std::size_t>(expression.opcode) << 1) |
+                static_cast<std::size_t>(expression.isBinary));
+    }
+};
+
+/**
+ * Put the operands of a binary expression in canonical order: swap those of
+ * commutative operators into order, and mirror `>` and `>=` into `<` and
+ * `<=`.
+ *
+ * @param expression The binary expression.
+ */
+void canonicalizeBinaryExpression(ValueExpression &expression) {
+    switch (static_cast<IR::BinaryOpcode>(expression.opcode)) {
+    case IR::BinaryOpcode::Add:
+    case IR::BinaryOpcode::Multiply:
+    case IR::BinaryOpcode::Equal:
+    case IR::BinaryOpcode::NotEqual:
+        if (isOperandBefore(expression.rhs, expression.lhs)) {
+            std::swap(expression.lhs, expression.rhs);
+        }
+        break;
+    case IR::BinaryOpcode::GreaterThan:
+        expression.opcode =
+            static_cast<std::uint8_t>(IR::BinaryOpcode::LessThan);
+        std::swap(expression.lhs, expression.rhs);
+        break;
+    case IR::BinaryOpcode::GreaterThanOrEqual:
+        expression.opcode =
+            static_cast<std::uint8_t>(IR::BinaryOpcode::LessThanOrEqual);
+        std::swap(expression.lhs, expression.rhs);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Check whether an instruction can be executed where it would not have been
+ * (e.g., hoisted out of a loop that runs zero times): it has no side effects
+ * and cannot trap.
+ *
+ * @param instruction The instruction.
+ * @return True if the instruction can be executed speculatively, false
+ * otherwise.
+ */
+bool isSpeculatable(const IR::Instruction &instruction) {
+    switch (instruction.getKind()) {
+    case IR::Instruction::Kind::Copy:
+    case IR::Instruction::Kind::Unary:
+    case IR::Instruction::Kind::SignExtend:
+    case IR::Instruction::Kind::Truncate:
+    case IR::Instruction::Kind::ZeroExtend:
+        return true;
+    case IR::Instruction::Kind::Binary: {
+        const auto &binaryInstr =
+            static_cast<const IR::BinaryInstruction &>(instruction);
+        const auto opcode =
+            IR::flattenBinaryOperator(binaryInstr.getBinaryOperator());
+        if (opcode != IR::BinaryOpcode::Divide &&
+            opcode != IR::BinaryOpcode::Remainder) {
+            return true;
+        }
+        // Division and remainder trap when dividing by zero, or the minimum
+        // of a signed type by `-1`.
+        const auto divisor = getConstant(binaryInstr.getSrc2());
+        return divisor.has_value() && divisor->bits != 0 &&
+               !(IR::isSignedKind(divisor->kind) &&
+                 divisor->bits == ~std::uint64_t{0});
+    }
+    default:
+        return false;
+    }
+}
+
+/**
+ * Check whether an IR value is a given variable.
+ *
+ * @param value The IR value.
+ * @param variable The variable.
+ * @return True if the IR value is the variable, false otherwise.
+ */
+bool isVariable(const IR::Value *value, Symbol variable) {
+    const auto *variableValue = dynamic_cast<const IR::VariableValue *>(value);
+    return variableValue != nullptr && variableValue->getSymbol() == variable;
 }
 
 /**
- * Clone an IR instruction.
+ * Struct representing the constant step of an induction variable: the
+ * constant added to it (or subtracted from it) by its update.
+ */
+struct InductionStep {
+    bool isSubtract = false;
+    IR::FlatConstant constant{.kind = IR::ConstantKind::Int, .bits = 0};
+};
+
+/**
+ * Match an instruction that adds a constant to a variable (or subtracts one
+ * from it): `i + c`, `c + i`, or `i - c`.
  *
- * @param instruction The IR instruction to clone.
- * @return A `std::unique_ptr` to the cloned IR instruction.
+ * @param instruction The instruction.
+ * @param variable The variable.
+ * @return The step, or `std::nullopt` if the instruction does not match.
  */
-std::unique_ptr<IR::Instruction>
-cloneInstruction(const IR::Instruction *instruction) {
-    if (const auto *returnInstr =
-            dynamic_cast<const IR::ReturnInstruction *>(instruction)) {
-        return std::make_unique<IR::ReturnInstruction>(
-            cloneValue(returnInstr->getReturnValue()));
-    }
-    else if (const auto *signExtend =
-                 dynamic_cast<const IR::SignExtendInstruction *>(instruction)) {
-        return std::make_unique<IR::SignExtendInstruction>(
-            cloneValue(signExtend->getSrc()), cloneValue(signExtend->getDst()));
-    }
-    else if (const auto *truncate =
-                 dynamic_cast<const IR::TruncateInstruction *>(instruction)) {
-        return std::make_unique<IR::TruncateInstruction>(
-            cloneValue(truncate->getSrc()), cloneValue(truncate->getDst()));
-    }
-    else if (const auto *unaryInstr =
-                 dynamic_cast<const IR::UnaryInstruction *>(instruction)) {
-        return std::make_unique<IR::UnaryInstruction>(
-            cloneUnaryOperator(unaryInstr->getUnaryOperator()),
-            cloneValue(unaryInstr->getSrc()), cloneValue(unaryInstr->getDst()));
-    }
-    else if (const auto *binaryInstr =
-                 dynamic_cast<const IR::BinaryInstruction *>(instruction)) {
-        return std::make_unique<IR::BinaryInstruction>(
-            cloneBinaryOperator(binaryInstr->getBinaryOperator()),
-            cloneValue(binaryInstr->getSrc1()),
-            cloneValue(binaryInstr->getSrc2()),
-            cloneValue(binaryInstr->getDst()));
-    }
-    else if (const auto *copyInstr =
-                 dynamic_cast<const IR::CopyInstruction *>(instruction)) {
-        return std::make_unique<IR::CopyInstruction>(
-            cloneValue(copyInstr->getSrc()), cloneValue(copyInstr->getDst()));
-    }
-    else if (const auto *jumpInstr =
-                 dynamic_cast<const IR::JumpInstruction *>(instruction)) {
-        return std::make_unique<IR::JumpInstruction>(jumpInstr->getTarget());
-    }
-    else if (const auto *jumpIfZero =
-                 dynamic_cast<const IR::JumpIfZeroInstruction *>(instruction)) {
-        return std::make_unique<IR::JumpIfZeroInstruction>(
-            cloneValue(jumpIfZero->getCondition()), jumpIfZero->getTarget());
-    }
-    else if (const auto *jumpIfNotZero =
-                 dynamic_cast<const IR::JumpIfNotZeroInstruction *>(
-                     instruction)) {
-        return std::make_unique<IR::JumpIfNotZeroInstruction>(
-            cloneValue(jumpIfNotZero->getCondition()),
-            jumpIfNotZero->getTarget());
-    }
-    else if (const auto *labelInstr =
-                 dynamic_cast<const IR::LabelInstruction *>(instruction)) {
-        return std::make_unique<IR::LabelInstruction>(labelInstr->getLabel());
-    }
-    else if (const auto *callInstr =
-                 dynamic_cast<const IR::FunctionCallInstruction *>(
-                     instruction)) {
-        auto args = std::make_unique<std::vector<std::unique_ptr<IR::Value>>>();
-        for (const auto &arg : callInstr->getArgs()) {
-            args->emplace_back(cloneValue(arg.get()));
-        }
-        return std::make_unique<IR::FunctionCallInstruction>(
-            callInstr->getFunctionIdentifier(), std::move(args),
-            cloneValue(callInstr->getDst()));
-    }
-    throw std::logic_error("Unsupported instruction in cloneInstruction");
+std::optional<InductionStep>
+matchInductionStep(const IR::Instruction &instruction, Symbol variable) {
+    if (instruction.getKind() != IR::Instruction::Kind::Binary) {
+        return std::nullopt;
+    }
+    const auto &binaryInstr =
+        static_cast<const IR::BinaryInstruction &>(instruction);
+    const auto opcode =
+        IR::flattenBinaryOperator(binaryInstr.getBinaryOperator());
+    if (opcode == IR::BinaryOpcode::Add ||
+        opcode == IR::BinaryOpcode::Subtract) {
+        const bool isSubtract = opcode == IR::BinaryOpcode::Subtract;
+        if (isVariable(binaryInstr.getSrc1(), variable)) {
+            if (auto constant = getConstant(binaryInstr.getSrc2())) {
+                return InductionStep{.isSubtract = isSubtract,
+                                     .constant = *constant};
+            }
+        }
+        else if (!isSubtract && isVariable(binaryInstr.getSrc2(), variable)) {
+            if (auto constant = getConstant(binaryInstr.getSrc1())) {
+                return InductionStep{.isSubtract = false,
+                                     .constant = *constant};
+            }
+        }
+    }
+    return std::nullopt;
 }
 
 /**
- * Clone a function body represented as a vector of IR instructions.
+ * Get the binary operator that gives the same result with its operands
+ * swapped.
  *
- * @param functionBody The function body to clone.
- * @return A `std::unique_ptr` to the cloned function body.
+ * @param opcode The binary operator.
+ * @return The operator itself if it is commutative, the mirrored comparison
+ * for an ordering comparison, or `std::nullopt` otherwise.
  */
-std::unique_ptr<std::vector<std::unique_ptr<IR::Instruction>>>
-cloneFunctionBody(
-    const std::vector<std::unique_ptr<IR::Instruction>> &functionBody) {
-    auto cloned =
-        std::make_unique<std::vector<std::unique_ptr<IR::Instruction>>>();
-    cloned->reserve(functionBody.size());
-    for (const auto &instruction : functionBody) {
-        cloned->emplace_back(cloneInstruction(instruction.get()));
-    }
-    return cloned;
+std::optional<IR::BinaryOpcode> getSwappedOpcode(IR::BinaryOpcode opcode) {
+    switch (opcode) {
+    case IR::BinaryOpcode::Add:
+    case IR::BinaryOpcode::Multiply:
+    case IR::BinaryOpcode::Equal:
+    case IR::BinaryOpcode::NotEqual:
+        return opcode;
+    case IR::BinaryOpcode::LessThan:
+        return IR::BinaryOpcode::GreaterThan;
+    case IR::BinaryOpcode::LessThanOrEqual:
+        return IR::BinaryOpcode::GreaterThanOrEqual;
+    case IR::BinaryOpcode::GreaterThan:
+        return IR::BinaryOpcode::LessThan;
+    case IR::BinaryOpcode::GreaterThanOrEqual:
+        return IR::BinaryOpcode::LessThanOrEqual;
+    default:
+        return std::nullopt;
+    }
 }
 } // namespace
 
 namespace IR {
-std::unique_ptr<std::vector<std::unique_ptr<IR::Instruction>>>
-IROptimizer::irOptimize(
-    const std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
-    bool foldConstantsPass, bool propagateCopiesPass,
-    bool eliminateUnreachableCodePass, bool eliminateDeadStoresPass) {
-    auto currentFunctionBody = cloneFunctionBody(functionBody);
-    if (foldConstantsPass) {
-        currentFunctionBody =
-            IR::ConstantFoldingPass::foldConstants(*currentFunctionBody);
-    }
-    if (eliminateUnreachableCodePass) {
-        currentFunctionBody =
-            IR::UnreachableCodeEliminationPass::eliminateUnreachableCode(
-                *currentFunctionBody);
-    }
-    if (propagateCopiesPass) {
-        currentFunctionBody =
-            IR::CopyPropagationPass::propagateCopies(*currentFunctionBody);
-    }
-    if (eliminateDeadStoresPass) {
-        currentFunctionBody = IR::DeadStoreEliminationPass::eliminateDeadStores(
-            *currentFunctionBody);
-    }
-    return currentFunctionBody;
+std::string_view getOptimizationPassName(OptimizationPassKind pass) {
+    switch (pass) {
+    case OptimizationPassKind::FoldConstants:
+        return "fold-constants";
+    case OptimizationPassKind::SimplifyAlgebra:
+        return "simplify-algebra";
+    case OptimizationPassKind::EliminateUnreachableCode:
+        return "eliminate-unreachable-code";
+    case OptimizationPassKind::PropagateCopies:
+        return "propagate-copies";
+    case OptimizationPassKind::EliminateDeadStores:
+        return "eliminate-dead-stores";
+    case OptimizationPassKind::PropagateConstants:
+        return "propagate-constants";
+    case OptimizationPassKind::EliminateCommonSubexpressions:
+        return "eliminate-common-subexpressions";
+    case OptimizationPassKind::ConvertToSSA:
+        return "ssa";
+    case OptimizationPassKind::MoveLoopInvariants:
+        return "licm";
+    case OptimizationPassKind::ReduceInductionVariables:
+        return "reduce-induction-variables";
+    }
+    throw std::logic_error(
+        "Unsupported optimization pass in getOptimizationPassName");
+}
+
+bool OptimizationOptions::isEnabled(OptimizationPassKind pass) const {
+    switch (pass) {
+    case OptimizationPassKind::FoldConstants:
+        return foldConstants;
+    case OptimizationPassKind::SimplifyAlgebra:
+        return simplifyAlgebra;
+    case OptimizationPassKind::EliminateUnreachableCode:
+        return eliminateUnreachableCode;
+    case OptimizationPassKind::PropagateCopies:
+        return propagateCopies;
+    case OptimizationPassKind::EliminateDeadStores:
+        return eliminateDeadStores;
+    case OptimizationPassKind::PropagateConstants:
+        return propagateConstants;
+    case OptimizationPassKind::EliminateCommonSubexpressions:
+        return eliminateCommonSubexpressions;
+    case OptimizationPassKind::ConvertToSSA:
+        return convertToSSA || propagateConstants ||
+               eliminateCommonSubexpressions;
+    case OptimizationPassKind::MoveLoopInvariants:
+        return moveLoopInvariants;
+    case OptimizationPassKind::ReduceInductionVariables:
+        return reduceInductionVariables;
+    }
+    throw std::logic_error(
+        "Unsupported optimization pass in isEnabled in OptimizationOptions");
+}
+
+bool OptimizationOptions::isAnyEnabled() const {
+    return foldConstants || simplifyAlgebra || eliminateUnreachableCode ||
+           propagateCopies || eliminateDeadStores || propagateConstants ||
+           eliminateCommonSubexpressions || convertToSSA ||
+           moveLoopInvariants || reduceInductionVariables;
+}
+
+void OptimizationStatistics::accumulate(const OptimizationStatistics &other) {
+    iterations = std::max(iterations, other.iterations);
+    for (std::size_t pass = 0; pass < optimizationPassCount; ++pass) {
+        runs[pass] += other.runs[pass];
+        changes[pass] += other.changes[pass];
+    }
+    for (std::size_t rule = 0; rule < simplificationRuleCount; ++rule) {
+        ruleHits[rule] += other.ruleHits[rule];
+    }
+}
+
+OptimizationStatistics IROptimizer::irOptimize(
+    std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+    const AST::FrontendSymbolTable &frontendSymbolTable,
+    const OptimizationOptions &options,
+    std::vector<IntroducedVariable> &introducedVariables) {
+    OptimizationStatistics statistics;
+
+    // Count the changes to the function body, and remember, for each pass,
+    // the count at which it last ran without changing anything: the pass
+    // cannot find anything new until another pass changes the function body.
+    std::size_t changeCount = 0;
+    std::array<std::optional<std::size_t>, optimizationPassCount> unchangedAt;
+    auto shouldRun = [&](OptimizationPassKind pass) {
+        return options.isEnabled(pass) &&
+               unchangedAt[static_cast<std::size_t>(pass)] != changeCount;
+    };
+    auto recordRun = [&](OptimizationPassKind pass, bool changed) {
+        const auto index = static_cast<std::size_t>(pass);
+        ++statistics.runs[index];
+        if (changed) {
+            ++statistics.changes[index];
+            ++changeCount;
+            unchangedAt[index].reset();
+        }
+        else {
+            unchangedAt[index] = changeCount;
+        }
+    };
+    auto runPass = [&](OptimizationPassKind pass, auto &&run) {
+        if (shouldRun(pass)) {
+            recordRun(pass, run());
+        }
+    };
+
+    // The introduced variables are only added to the frontend symbol table
+    // once all the function bodies are optimized, so the passes look their
+    // types up through their original variables in the meantime.
+    IR::IntroducedOriginals introducedOriginals;
+    std::size_t recordedCount = 0;
+    auto recordIntroducedVariables = [&] {
+        for (; recordedCount < introducedVariables.size(); ++recordedCount) {
+            const auto &[variable, original] =
+                introducedVariables[recordedCount];
+            introducedOriginals.emplace(variable, original);
+        }
+    };
+
+    while (statistics.iterations < options.maxIterations) {
+        ++statistics.iterations;
+        const auto changeCountBefore = changeCount;
+        recordIntroducedVariables();
+
+        runPass(OptimizationPassKind::FoldConstants, [&] {
+            return IR::ConstantFoldingPass::foldConstants(
+                functionBody, frontendSymbolTable, introducedOriginals);
+        });
+        runPass(OptimizationPassKind::SimplifyAlgebra, [&] {
+            return IR::AlgebraicSimplificationPass::simplifyAlgebra(
+                functionBody, frontendSymbolTable, introducedOriginals,
+                statistics.ruleHits);
+        });
+
+        // The remaining passes work on the control flow graph (CFG), which
+        // takes ownership of the instructions and hands them back afterwards.
+        const bool useSSA =
+            shouldRun(OptimizationPassKind::PropagateConstants) ||
+            shouldRun(OptimizationPassKind::EliminateCommonSubexpressions) ||
+            shouldRun(OptimizationPassKind::ConvertToSSA);
+        if (shouldRun(OptimizationPassKind::EliminateUnreachableCode) ||
+            shouldRun(OptimizationPassKind::PropagateCopies) ||
+            shouldRun(OptimizationPassKind::EliminateDeadStores) || useSSA) {
+            auto cfg = IR::CFG::makeControlFlowGraph(std::move(functionBody));
+            runPass(OptimizationPassKind::EliminateUnreachableCode, [&] {
+                return IR::UnreachableCodeEliminationPass::
+                    eliminateUnreachableCode(cfg);
+            });
+            runPass(OptimizationPassKind::PropagateCopies, [&] {
+                return IR::CopyPropagationPass::propagateCopies(
+                    cfg, frontendSymbolTable, introducedOriginals);
+            });
+            runPass(OptimizationPassKind::EliminateDeadStores, [&] {
+                return IR::DeadStoreEliminationPass::eliminateDeadStores(
+                    cfg, frontendSymbolTable);
+            });
+            if (useSSA) {
+                // The SSA passes run between the construction and the
+                // destruction of the SSA form. Destruction counts as a change
+                // only if it could not translate the SSA form back verbatim.
+                auto ssaForm = IR::SSAForm::constructSSA(std::move(cfg),
+                                                         frontendSymbolTable);
+                runPass(OptimizationPassKind::PropagateConstants, [&] {
+                    return IR::SparseConditionalConstantPropagationPass::
+                        propagateConstants(ssaForm, frontendSymbolTable,
+                                           introducedOriginals);
+                });
+                runPass(
+                    OptimizationPassKind::EliminateCommonSubexpressions, [&] {
+                        return IR::CommonSubexpressionEliminationPass::
+                            eliminateCommonSubexpressions(ssaForm,
+                                                          frontendSymbolTable,
+                                                          introducedOriginals);
+                    });
+                recordRun(OptimizationPassKind::ConvertToSSA,
+                          IR::SSAForm::destructSSA(std::move(ssaForm),
+                                                   functionBody,
+                                                   introducedVariables));
+                recordIntroducedVariables();
+            }
+            else {
+                functionBody = IR::CFG::cfgToInstructions(std::move(cfg));
+            }
+        }
+
+        runPass(OptimizationPassKind::MoveLoopInvariants, [&] {
+            return IR::LoopInvariantCodeMotionPass::moveLoopInvariants(
+                functionBody, frontendSymbolTable);
+        });
+        runPass(OptimizationPassKind::ReduceInductionVariables, [&] {
+            return IR::InductionVariableStrengthReductionPass::
+                reduceInductionVariables(functionBody, frontendSymbolTable,
+                                         introducedOriginals,
+                                         introducedVariables);
+        });
+
+        if (changeCount == changeCountBefore) {
+            break;
+        }
+    }
+    return statistics;
 }
 
-std::unique_ptr<std::vector<std::unique_ptr<IR::Instruction>>>
-ConstantFoldingPass::foldConstants(
-    const std::vector<std::unique_ptr<IR::Instruction>> &functionBody) {
-    auto folded =
-        std::make_unique<std::vector<std::unique_ptr<IR::Instruction>>>();
-    folded->reserve(functionBody.size());
-    for (const auto &instruction : functionBody) {
+bool ConstantFoldingPass::foldConstants(
+    std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+    const AST::FrontendSymbolTable &frontendSymbolTable,
+    const IntroducedOriginals &introducedOriginals) {
+    FunctionBodyRewriter rewriter(functionBody);
+    // Replace an instruction by a copy of its folded result, converted to
+    // the type of its destination (if known).
+    auto replaceWithCopy = [&](std::size_t index, IR::FlatConstant result,
+                               const IR::Value *dst) {
+        if (auto dstKind = getVariableKind(dst, frontendSymbolTable,
+                                           introducedOriginals)) {
+            result = IR::convertConstant(result, *dstKind);
+        }
+        rewriter.replace(index,
+                         std::make_unique<IR::CopyInstruction>(
+                             makeConstantValue(result), cloneValue(dst)));
+    };
+    for (std::size_t index = 0; index < rewriter.size(); ++index) {
+        auto *instruction = rewriter.get(index);
+        switch (instruction->getKind()) {
+        // Handle constant folding for conversions (with the semantics of C
+        // conversions from the type of the source to that of the
+        // destination).
+        case IR::Instruction::Kind::SignExtend:
+        case IR::Instruction::Kind::Truncate:
+        case IR::Instruction::Kind::ZeroExtend: {
+            const IR::Value *src = nullptr;
+            IR::forEachSrc(*instruction,
+                           [&](const IR::Value &value) { src = &value; });
+            const auto *dst = IR::getDst(*instruction);
+            auto srcConst = getConstant(src);
+            if (srcConst.has_value() &&
+                getVariableKind(dst, frontendSymbolTable, introducedOriginals)
+                    .has_value()) {
+                replaceWithCopy(index, *srcConst, dst);
+            }
+            break;
+        }
         // Handle constant folding for unary instructions.
-        if (const auto *unaryInstr =
-                dynamic_cast<const IR::UnaryInstruction *>(instruction.get())) {
-            auto srcConst = getConstValue(unaryInstr->getSrc());
+        case IR::Instruction::Kind::Unary: {
+            const auto *unaryInstr =
+                static_cast<const IR::UnaryInstruction *>(instruction);
+            auto srcConst = getConstant(unaryInstr->getSrc());
             if (srcConst.has_value()) {
-                auto foldedConst =
-                    foldUnary(unaryInstr->getUnaryOperator(), *srcConst);
-                if (foldedConst.has_value()) {
-                    folded->emplace_back(std::make_unique<IR::CopyInstruction>(
-                        makeConstValue(*foldedConst),
-                        cloneValue(unaryInstr->getDst())));
-                    continue;
-                }
+                replaceWithCopy(
+                    index,
+                    IR::evaluateUnary(IR::flattenUnaryOperator(
+                                          unaryInstr->getUnaryOperator()),
+                                      *srcConst),
+                    unaryInstr->getDst());
             }
+            break;
         }
         // Handle constant folding for binary instructions.
-        if (const auto *binaryInstr =
-                dynamic_cast<const IR::BinaryInstruction *>(
-                    instruction.get())) {
-            auto lhsConst = getConstValue(binaryInstr->getSrc1());
-            auto rhsConst = getConstValue(binaryInstr->getSrc2());
+        case IR::Instruction::Kind::Binary: {
+            const auto *binaryInstr =
+                static_cast<const IR::BinaryInstruction *>(instruction);
+            auto lhsConst = getConstant(binaryInstr->getSrc1());
+            auto rhsConst = getConstant(binaryInstr->getSrc2());
             if (lhsConst.has_value() && rhsConst.has_value()) {
-                auto foldedConst = foldBinary(binaryInstr->getBinaryOperator(),
-                                              *lhsConst, *rhsConst);
+                auto foldedConst = IR::evaluateBinary(
+                    IR::flattenBinaryOperator(binaryInstr->getBinaryOperator()),
+                    *lhsConst, *rhsConst);
                 if (foldedConst.has_value()) {
-                    folded->emplace_back(std::make_unique<IR::CopyInstruction>(
-                        makeConstValue(*foldedConst),
-                        cloneValue(binaryInstr->getDst())));
-                    continue;
+                    replaceWithCopy(index, *foldedConst, binaryInstr->getDst());
                 }
             }
+            break;
+        }
+        // Handle constant folding for copies of constants to variables of
+        // another type of the same width (e.g., casts between `int` and
+        // `unsigned int`): give the constant the type of the destination.
+        case IR::Instruction::Kind::Copy: {
+            const auto *copy =
+                static_cast<const IR::CopyInstruction *>(instruction);
+            auto srcConst = getConstant(copy->getSrc());
+            auto dstKind = getVariableKind(copy->getDst(), frontendSymbolTable,
+                                           introducedOriginals);
+            if (srcConst.has_value() && dstKind.has_value() &&
+                srcConst->kind != *dstKind) {
+                replaceWithCopy(index, *srcConst, copy->getDst());
+            }
+            break;
         }
         // Handle constant folding for jump instructions.
-        if (const auto *jumpIfZero =
-                dynamic_cast<const IR::JumpIfZeroInstruction *>(
-                    instruction.get())) {
-            auto condConst = getConstValue(jumpIfZero->getCondition());
+        case IR::Instruction::Kind::JumpIfZero: {
+            const auto *jumpIfZero =
+                static_cast<const IR::JumpIfZeroInstruction *>(instruction);
+            auto condConst = getConstant(jumpIfZero->getCondition());
             if (condConst.has_value()) {
-                if (condConst->value == 0) {
-                    folded->emplace_back(std::make_unique<IR::JumpInstruction>(
-                        jumpIfZero->getTarget()));
+                if (condConst->bits == 0) {
+                    rewriter.replace(index,
+                                     std::make_unique<IR::JumpInstruction>(
+                                         jumpIfZero->getTargetSymbol()));
+                }
+                else {
+                    rewriter.erase(index);
                 }
-                continue;
             }
+            break;
         }
         // Handle constant folding for jump-if-not-zero instructions.
-        if (const auto *jumpIfNotZero =
-                dynamic_cast<const IR::JumpIfNotZeroInstruction *>(
-                    instruction.get())) {
-            auto condConst = getConstValue(jumpIfNotZero->getCondition());
+        case IR::Instruction::Kind::JumpIfNotZero: {
+            const auto *jumpIfNotZero =
+                static_cast<const IR::JumpIfNotZeroInstruction *>(instruction);
+            auto condConst = getConstant(jumpIfNotZero->getCondition());
             if (condConst.has_value()) {
-                if (condConst->value != 0) {
-                    folded->emplace_back(std::make_unique<IR::JumpInstruction>(
-                        jumpIfNotZero->getTarget()));
+                if (condConst->bits != 0) {
+                    rewriter.replace(index,
+                                     std::make_unique<IR::JumpInstruction>(
+                                         jumpIfNotZero->getTargetSymbol()));
+                }
+                else {
+                    rewriter.erase(index);
                 }
-                continue;
             }
+            break;
+        }
+        default:
+            break;
         }
-        // If no folding was possible, clone the original instruction.
-        folded->emplace_back(cloneInstruction(instruction.get()));
     }
-    return folded;
+    return rewriter.commit();
 }
 
-std::unique_ptr<std::vector<std::unique_ptr<IR::Instruction>>>
-CFG::makeControlFlowGraph(
-    const std::vector<std::unique_ptr<IR::Instruction>> &functionBody) {
-    return cloneFunctionBody(functionBody);
+bool AlgebraicSimplificationPass::simplifyAlgebra(
+    std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+    const AST::FrontendSymbolTable &frontendSymbolTable,
+    const IntroducedOriginals &introducedOriginals,
+    std::array<std::size_t, simplificationRuleCount> &ruleHits) {
+    FunctionBodyRewriter rewriter(functionBody);
+    auto applyRule = [&](std::optional<std::size_t> rule) {
+        if (!rule) {
+            throw std::logic_error(
+                "Missing simplification rule in simplifyAlgebra in "
+                "AlgebraicSimplificationPass");
+        }
+        ++ruleHits[*rule];
+    };
+
+    // The unary instructions since the start of the current basic block whose
+    // operands and destinations have not been reassigned since (indexed by
+    // destination).
+    struct UnaryDefinition {
+        UnaryOpcode opcode;
+        std::unique_ptr<Value> src;
+    };
+    std::unordered_map<Symbol, UnaryDefinition> unaryDefinitions;
+    auto findUnaryOperand = [&](const Value *value,
+                                UnaryOpcode opcode) -> const Value * {
+        const auto *variableValue = dynamic_cast<const VariableValue *>(value);
+        if (variableValue == nullptr) {
+            return nullptr;
+        }
+        auto it = unaryDefinitions.find(variableValue->getSymbol());
+        return it != unaryDefinitions.end() && it->second.opcode == opcode
+                   ? it->second.src.get()
+                   : nullptr;
+    };
+    auto forgetVariable = [&](Symbol variable) {
+        unaryDefinitions.erase(variable);
+        std::erase_if(unaryDefinitions, [&](const auto &entry) {
+            return isVariable(entry.second.src.get(), variable);
+        });
+    };
+
+    for (std::size_t index = 0; index < rewriter.size(); ++index) {
+        auto *instruction = rewriter.get(index);
+        switch (instruction->getKind()) {
+        case Instruction::Kind::Binary: {
+            auto *binaryInstr = static_cast<BinaryInstruction *>(instruction);
+            auto opcode =
+                flattenBinaryOperator(binaryInstr->getBinaryOperator());
+            if (getConstant(binaryInstr->getSrc1()) &&
+                !getConstant(binaryInstr->getSrc2())) {
+                if (auto swappedOpcode = getSwappedOpcode(opcode)) {
+                    rewriter.replace(
+                        index, std::make_unique<BinaryInstruction>(
+                                   unflattenBinaryOperator(*swappedOpcode),
+                                   cloneValue(binaryInstr->getSrc2()),
+                                   cloneValue(binaryInstr->getSrc1()),
+                                   cloneValue(binaryInstr->getDst())));
+                    applyRule(findStructuralRule(
+                        SimplificationRuleKind::ConstantToRight));
+                    binaryInstr =
+                        static_cast<BinaryInstruction *>(rewriter.get(index));
+                    opcode = *swappedOpcode;
+                }
+            }
+            const auto *lhs = binaryInstr->getSrc1();
+            const auto *dst = binaryInstr->getDst();
+            const auto *lhsVariable = dynamic_cast<const VariableValue *>(lhs);
+            const bool isSameOperand =
+                lhsVariable != nullptr &&
+                isVariable(binaryInstr->getSrc2(), lhsVariable->getSymbol());
+            const auto rule = findBinaryIdentity(
+                opcode, getConstant(binaryInstr->getSrc2()), isSameOperand);
+            if (!rule) {
+                break;
+            }
+            std::unique_ptr<Instruction> replacement;
+            switch (simplificationRules[*rule].result) {
+            case SimplificationResult::Left:
+                replacement = std::make_unique<CopyInstruction>(
+                    cloneValue(lhs), cloneValue(dst));
+                break;
+            case SimplificationResult::Zero:
+            case SimplificationResult::One:
+                if (auto kind = getVariableKind(dst, frontendSymbolTable,
+                                                introducedOriginals)) {
+                    const bool isOne = simplificationRules[*rule].result ==
+                                       SimplificationResult::One;
+                    replacement = std::make_unique<CopyInstruction>(
+                        makeConstantValue(makeConstant(*kind, isOne ? 1 : 0)),
+                        cloneValue(dst));
+                }
+                break;
+            case SimplificationResult::NegatedLeft:
+                replacement = std::make_unique<UnaryInstruction>(
+                    unflattenUnaryOperator(UnaryOpcode::Negate),
+                    cloneValue(lhs), cloneValue(dst));
+                break;
+            }
+            if (replacement) {
+                rewriter.replace(index, std::move(replacement));
+                applyRule(rule);
+            }
+            break;
+        }
+        case Instruction::Kind::Unary: {
+            const auto *unaryInstr =
+                static_cast<const UnaryInstruction *>(instruction);
+            const auto opcode =
+                flattenUnaryOperator(unaryInstr->getUnaryOperator());
+            if (opcode == UnaryOpcode::Negate ||
+                opcode == UnaryOpcode::Complement) {
+                if (const auto *operand =
+                        findUnaryOperand(unaryInstr->getSrc(), opcode)) {
+                    rewriter.replace(index,
+                                     std::make_unique<CopyInstruction>(
+                                         cloneValue(operand),
+                                         cloneValue(unaryInstr->getDst())));
+                    applyRule(findStructuralRule(
+                        SimplificationRuleKind::DoubleUnary, opcode));
+                }
+            }
+            break;
+        }
+        case Instruction::Kind::JumpIfZero:
+        case Instruction::Kind::JumpIfNotZero: {
+            // Flip the jump for as many logical negations as its condition
+            // goes through.
+            bool isJumpIfZero =
+                instruction->getKind() == Instruction::Kind::JumpIfZero;
+            const Value *condition = nullptr;
+            Symbol target;
+            if (isJumpIfZero) {
+                const auto *jumpInstr =
+                    static_cast<const JumpIfZeroInstruction *>(instruction);
+                condition = jumpInstr->getCondition();
+                target = jumpInstr->getTargetSymbol();
+            }
+            else {
+                const auto *jumpInstr =
+                    static_cast<const JumpIfNotZeroInstruction *>(instruction);
+                condition = jumpInstr->getCondition();
+                target = jumpInstr->getTargetSymbol();
+            }
+            const auto *originalCondition = condition;
+            while (const auto *operand =
+                       findUnaryOperand(condition, UnaryOpcode::Not)) {
+                condition = operand;
+                isJumpIfZero = !isJumpIfZero;
+                applyRule(
+                    findStructuralRule(SimplificationRuleKind::BranchOnNot));
+            }
+            if (condition != originalCondition) {
+                if (isJumpIfZero) {
+                    rewriter.replace(index,
+                                     std::make_unique<JumpIfZeroInstruction>(
+                                         cloneValue(condition), target));
+                }
+                else {
+                    rewriter.replace(
+                        index, std::make_unique<JumpIfNotZeroInstruction>(
+                                   cloneValue(condition), target));
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        // Track the unary instructions through the basic block.
+        instruction = rewriter.get(index);
+        if (instruction->getKind() == Instruction::Kind::Label) {
+            unaryDefinitions.clear();
+            continue;
+        }
+        const auto *dst = getDst(*instruction);
+        if (const auto *dstVariable =
+                dynamic_cast<const VariableValue *>(dst)) {
+            forgetVariable(dstVariable->getSymbol());
+        }
+        if (instruction->getKind() == Instruction::Kind::FunctionCall) {
+            // A function call can change any static variable.
+            std::erase_if(unaryDefinitions, [&](const auto &entry) {
+                const auto *srcVariable = dynamic_cast<const VariableValue *>(
+                    entry.second.src.get());
+                return isStaticVariable(entry.first, frontendSymbolTable) ||
+                       (srcVariable != nullptr &&
+                        isStaticVariable(srcVariable->getSymbol(),
+                                         frontendSymbolTable));
+            });
+        }
+        if (instruction->getKind() == Instruction::Kind::Unary) {
+            const auto *unaryInstr =
+                static_cast<const UnaryInstruction *>(instruction);
+            const auto dstVariable =
+                static_cast<const VariableValue *>(unaryInstr->getDst())
+                    ->getSymbol();
+            if (!isVariable(unaryInstr->getSrc(), dstVariable)) {
+                unaryDefinitions.insert_or_assign(
+                    dstVariable,
+                    UnaryDefinition{
+                        .opcode = flattenUnaryOperator(
+                            unaryInstr->getUnaryOperator()),
+                        .src = cloneValue(unaryInstr->getSrc())});
+            }
+        }
+    }
+    return rewriter.commit();
 }
 
-std::unique_ptr<std::vector<std::unique_ptr<IR::Instruction>>>
-CFG::cfgToInstructions(
-    const std::vector<std::unique_ptr<IR::Instruction>> &cfg) {
-    return cloneFunctionBody(cfg);
+bool UnreachableCodeEliminationPass::eliminateUnreachableCode(CFG &cfg) {
+    auto &blocks = cfg.getBlocks();
+    const auto exitId = cfg.getExitId();
+    bool changed = false;
+
+    // Remove the basic blocks that are not reachable from the entry node.
+    std::vector<bool> reachable(blocks.size(), false);
+    std::vector<std::size_t> worklist{CFG::getEntryId()};
+    reachable[CFG::getEntryId()] = true;
+    while (!worklist.empty()) {
+        const auto id = worklist.back();
+        worklist.pop_back();
+        for (auto successor : blocks[id].successors) {
+            if (!reachable[successor]) {
+                reachable[successor] = true;
+                worklist.emplace_back(successor);
+            }
+        }
+    }
+    for (std::size_t id = CFG::getEntryId() + 1; id < exitId; ++id) {
+        if (!reachable[id] && !blocks[id].removed) {
+            cfg.removeBlock(id);
+            changed = true;
+        }
+    }
+
+    // Remove the jumps (and conditional jumps) whose only successor is the
+    // basic block that follows anyway.
+    std::size_t nextId = exitId;
+    for (std::size_t id = exitId - 1; id > CFG::getEntryId(); --id) {
+        auto &block = blocks[id];
+        if (block.removed) {
+            continue;
+        }
+        if (!block.instructions.empty()) {
+            const auto kind = block.instructions.back()->getKind();
+            const bool isJump = kind == IR::Instruction::Kind::Jump ||
+                                kind == IR::Instruction::Kind::JumpIfZero ||
+                                kind == IR::Instruction::Kind::JumpIfNotZero;
+            if (isJump && block.successors.size() == 1 &&
+                block.successors.front() == nextId) {
+                block.instructions.pop_back();
+                changed = true;
+            }
+        }
+        nextId = id;
+    }
+
+    // Remove the labels that no remaining jump targets.
+    std::unordered_set<Symbol> targets;
+    for (const auto &block : blocks) {
+        if (block.instructions.empty()) {
+            continue;
+        }
+        const auto *last = block.instructions.back().get();
+        switch (last->getKind()) {
+        case IR::Instruction::Kind::Jump:
+            targets.emplace(static_cast<const IR::JumpInstruction *>(last)
+                                ->getTargetSymbol());
+            break;
+        case IR::Instruction::Kind::JumpIfZero:
+            targets.emplace(
+                static_cast<const IR::JumpIfZeroInstruction *>(last)
+                    ->getTargetSymbol());
+            break;
+        case IR::Instruction::Kind::JumpIfNotZero:
+            targets.emplace(
+                static_cast<const IR::JumpIfNotZeroInstruction *>(last)
+                    ->getTargetSymbol());
+            break;
+        default:
+            break;
+        }
+    }
+    for (auto &block : blocks) {
+        if (block.instructions.empty() ||
+            block.instructions.front()->getKind() !=
+                IR::Instruction::Kind::Label) {
+            continue;
+        }
+        const auto *label = static_cast<const IR::LabelInstruction *>(
+            block.instructions.front().get());
+        if (!targets.contains(label->getLabelSymbol())) {
+            block.instructions.erase(block.instructions.begin());
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        cfg.recomputeEdges();
+    }
+    return changed;
 }
 
-std::unique_ptr<std::vector<std::unique_ptr<IR::Instruction>>>
-UnreachableCodeEliminationPass::eliminateUnreachableCode(
-    const std::vector<std::unique_ptr<IR::Instruction>> &cfg) {
-    return cloneFunctionBody(cfg);
+bool CopyPropagationPass::propagateCopies(
+    CFG &cfg, const AST::FrontendSymbolTable &frontendSymbolTable,
+    const IntroducedOriginals &introducedOriginals) {
+    const ReachingCopies reachingCopies(cfg, frontendSymbolTable,
+                                        introducedOriginals);
+    bool changed = false;
+    for (auto &block : cfg.getBlocks()) {
+        if (block.removed || block.instructions.empty()) {
+            continue;
+        }
+        auto reaching = reachingCopies.getReachingIn(block.id);
+        FunctionBodyRewriter rewriter(block.instructions);
+        for (std::size_t index = 0; index < rewriter.size(); ++index) {
+            auto *instruction = rewriter.get(index);
+            // Compute the copies reaching the next instruction before
+            // rewriting this one (the analysis saw the original operands).
+            auto reachingNext = reaching;
+            reachingCopies.transfer(*instruction, reachingNext);
+            if (instruction->getKind() == IR::Instruction::Kind::Copy &&
+                reachingCopies.isRedundant(
+                    *static_cast<const IR::CopyInstruction *>(instruction),
+                    reaching)) {
+                rewriter.erase(index);
+            }
+            else if (IR::replaceSrcs(*instruction,
+                                     [&](const IR::Value &src) {
+                                         return reachingCopies.replacementFor(
+                                             src, reaching);
+                                     })) {
+                changed = true;
+            }
+            reaching = std::move(reachingNext);
+        }
+        changed = rewriter.commit() || changed;
+    }
+    return changed;
 }
 
-std::unique_ptr<std::vector<std::unique_ptr<IR::Instruction>>>
-CopyPropagationPass::propagateCopies(
-    const std::vector<std::unique_ptr<IR::Instruction>> &cfg) {
-    return cloneFunctionBody(cfg);
+bool DeadStoreEliminationPass::eliminateDeadStores(
+    CFG &cfg, const AST::FrontendSymbolTable &frontendSymbolTable) {
+    const LivenessAnalysis liveness(cfg, frontendSymbolTable);
+    bool changed = false;
+    for (auto &block : cfg.getBlocks()) {
+        if (block.removed || block.instructions.empty()) {
+            continue;
+        }
+        auto live = liveness.getLiveOut(block.id);
+        FunctionBodyRewriter rewriter(block.instructions);
+        for (auto index = rewriter.size(); index-- > 0;) {
+            const auto *instruction = rewriter.get(index);
+            const auto *dst = IR::getDst(*instruction);
+            // Function calls are kept for their side effects, and stores to
+            // static variables are visible to other functions.
+            if (dst != nullptr &&
+                instruction->getKind() != IR::Instruction::Kind::FunctionCall) {
+                const auto variableIndex = liveness.getVariableIndex(
+                    static_cast<const IR::VariableValue *>(dst)->getSymbol());
+                if (variableIndex.has_value() && !live.test(*variableIndex) &&
+                    !liveness.isStatic(*variableIndex)) {
+                    rewriter.erase(index);
+                    continue;
+                }
+            }
+            liveness.transfer(*instruction, live);
+        }
+        changed = rewriter.commit() || changed;
+    }
+    return changed;
 }
 
-std::unique_ptr<std::vector<std::unique_ptr<IR::Instruction>>>
-DeadStoreEliminationPass::eliminateDeadStores(
-    const std::vector<std::unique_ptr<IR::Instruction>> &cfg) {
-    return cloneFunctionBody(cfg);
+bool SparseConditionalConstantPropagationPass::propagateConstants(
+    SSAForm &ssaForm, const AST::FrontendSymbolTable &frontendSymbolTable,
+    const IntroducedOriginals &introducedOriginals) {
+    const SparseConditionalConstants constants(ssaForm, frontendSymbolTable,
+                                               introducedOriginals);
+    auto &cfg = ssaForm.getCFG();
+    bool changed = false;
+
+    // Fold the conditional jumps on constants, dropping the edges they never
+    // take.
+    for (auto &block : cfg.getBlocks()) {
+        if (!constants.isExecutable(block.id) || block.instructions.empty()) {
+            continue;
+        }
+        auto &last = block.instructions.back();
+        const auto kind = last->getKind();
+        if (kind != Instruction::Kind::JumpIfZero &&
+            kind != Instruction::Kind::JumpIfNotZero) {
+            continue;
+        }
+        const bool isJumpIfZero = kind == Instruction::Kind::JumpIfZero;
+        const auto condition = constants.getConstant(
+            isJumpIfZero
+                ? *static_cast<const JumpIfZeroInstruction &>(*last)
+                       .getCondition()
+                : *static_cast<const JumpIfNotZeroInstruction &>(*last)
+                       .getCondition());
+        if (!condition) {
+            continue;
+        }
+        const auto successors = block.successors;
+        for (const auto successorId : successors) {
+            if (!constants.isEdgeExecutable(block.id, successorId)) {
+                ssaForm.removeEdge(block.id, successorId);
+            }
+        }
+        if (isJumpIfZero == (condition->bits == 0)) {
+            const auto target =
+                isJumpIfZero
+                    ? static_cast<const JumpIfZeroInstruction &>(*last)
+                          .getTargetSymbol()
+                    : static_cast<const JumpIfNotZeroInstruction &>(*last)
+                          .getTargetSymbol();
+            last = std::make_unique<JumpInstruction>(target);
+        }
+        else {
+            block.instructions.pop_back();
+        }
+        changed = true;
+    }
+
+    // Remove the basic blocks that are never executed (including those that
+    // are unreachable in the CFG).
+    for (auto &block : cfg.getBlocks()) {
+        if (!block.removed && !constants.isExecutable(block.id) &&
+            block.id != CFG::getEntryId() && block.id != cfg.getExitId()) {
+            ssaForm.removeBlock(block.id);
+            changed = true;
+        }
+    }
+
+    // Replace the uses of the constant versions by their constants, and
+    // remove their definitions. The arguments of phi nodes are left alone
+    // (SSA destruction would turn constant arguments back into the copies
+    // they come from), so the definitions of constant versions that are
+    // arguments become copies of their constants instead.
+    auto replacement = [&](const Value &src) -> std::unique_ptr<Value> {
+        if (dynamic_cast<const VariableValue *>(&src) != nullptr) {
+            if (auto constant = constants.getConstant(src)) {
+                return std::make_unique<ConstantValue>(
+                    unflattenConstant(*constant));
+            }
+        }
+        return nullptr;
+    };
+    for (auto &block : cfg.getBlocks()) {
+        if (block.removed) {
+            continue;
+        }
+        changed = std::erase_if(ssaForm.getPhis(block.id),
+                                [&](const PhiNode &phi) {
+                                    return constants
+                                               .getConstant(
+                                                   VariableValue(phi.dst))
+                                               .has_value() &&
+                                           !constants.isPhiArgument(phi.dst);
+                                }) > 0 ||
+                  changed;
+        FunctionBodyRewriter rewriter(block.instructions);
+        for (std::size_t index = 0; index < rewriter.size(); ++index) {
+            auto *instruction = rewriter.get(index);
+            const auto *dst = getDst(*instruction);
+            const auto constant =
+                dst != nullptr &&
+                        instruction->getKind() !=
+                            Instruction::Kind::FunctionCall
+                    ? constants.getConstant(*dst)
+                    : std::nullopt;
+            if (!constant) {
+                if (replaceSrcs(*instruction, replacement)) {
+                    changed = true;
+                }
+                continue;
+            }
+            const auto variable =
+                static_cast<const VariableValue *>(dst)->getSymbol();
+            if (!constants.isPhiArgument(variable)) {
+                rewriter.erase(index);
+                continue;
+            }
+            const auto *src =
+                instruction->getKind() == Instruction::Kind::Copy
+                    ? dynamic_cast<const ConstantValue *>(
+                          static_cast<const CopyInstruction *>(instruction)
+                              ->getSrc())
+                    : nullptr;
+            if (src == nullptr ||
+                flattenConstant(src->getASTConstant()) != *constant) {
+                rewriter.replace(
+                    index, std::make_unique<CopyInstruction>(
+                               std::make_unique<ConstantValue>(
+                                   unflattenConstant(*constant)),
+                               std::make_unique<VariableValue>(variable)));
+            }
+        }
+        changed = rewriter.commit() || changed;
+    }
+    return changed;
+}
+
+bool CommonSubexpressionEliminationPass::eliminateCommonSubexpressions(
+    SSAForm &ssaForm, const AST::FrontendSymbolTable &frontendSymbolTable,
+    const IntroducedOriginals &introducedOriginals) {
+    auto &cfg = ssaForm.getCFG();
+    const auto &dominatorTree = ssaForm.getDominatorTree();
+    bool changed = false;
+
+    // The type of a version is that of the variable it belongs to.
+    auto getType = [&](Symbol variable) {
+        return findVariableType(ssaForm.getOriginalVariable(variable),
+                                frontendSymbolTable, introducedOriginals);
+    };
+    // Each variable other than a static one is defined at most once (or is
+    // never defined and keeps its value on entry), so the value it stands for
+    // holds wherever it is used. A variable copied from another value stands
+    // for that value.
+    std::unordered_map<Symbol, ValueOperand> copiedValues;
+    auto getOperand = [&](const Value &value) -> std::optional<ValueOperand> {
+        if (const auto *variableValue =
+                dynamic_cast<const VariableValue *>(&value)) {
+            const auto variable = variableValue->getSymbol();
+            if (isStaticVariable(variable, frontendSymbolTable)) {
+                return std::nullopt;
+            }
+            auto it = copiedValues.find(variable);
+            return it != copiedValues.end()
+                       ? it->second
+                       : ValueOperand{.isConstant = false,
+                                      .variable = variable,
+                                      .constant = {}};
+        }
+        return ValueOperand{
+            .isConstant = true,
+            .variable = {},
+            .constant = flattenConstant(
+                static_cast<const ConstantValue &>(value).getASTConstant())};
+    };
+    // Check whether an operand has the given type (so that a copy of it to a
+    // variable of the type keeps its value).
+    auto hasType = [&](const ValueOperand &operand, const AST::Type &type) {
+        if (operand.isConstant) {
+            return getConstantKind(&type) == operand.constant.kind;
+        }
+        const auto *operandType = getType(operand.variable);
+        return operandType != nullptr && operandType->isEqual(type);
+    };
+
+    // Number the expressions along a preorder walk of the dominator tree,
+    // with a table of the expressions computed by the dominators of the
+    // current basic block (and the variables holding them).
+    std::unordered_map<ValueExpression, Symbol, ValueExpressionHash>
+        availableExpressions;
+
+    /**
+     * Structure representing a basic block being numbered: its ID, the index
+     * of its next child in the dominator tree, and the expressions it made
+     * available.
+     */
+    struct NumberingFrame {
+        std::size_t id;
+        std::size_t nextChild;
+        std::vector<ValueExpression> addedExpressions;
+    };
+    std::vector<NumberingFrame> frames;
+    auto enterBlock = [&](std::size_t id) {
+        NumberingFrame frame{.id = id, .nextChild = 0, .addedExpressions = {}};
+        for (auto &instruction : cfg.getBlock(id).instructions) {
+            const auto *dstValue = getDst(*instruction);
+            if (dstValue == nullptr) {
+                continue;
+            }
+            const auto dst =
+                static_cast<const VariableValue *>(dstValue)->getSymbol();
+            const auto *dstType = getType(dst);
+            if (dstType == nullptr) {
+                continue;
+            }
+            const bool isDstStatic = isStaticVariable(dst, frontendSymbolTable);
+
+            ValueExpression expression;
+            if (instruction->getKind() == Instruction::Kind::Copy) {
+                auto src = getOperand(
+                    *static_cast<const CopyInstruction &>(*instruction)
+                         .getSrc());
+                if (src && !isDstStatic && hasType(*src, *dstType)) {
+                    copiedValues.emplace(dst, *src);
+                }
+                continue;
+            }
+            if (instruction->getKind() == Instruction::Kind::Unary) {
+                const auto &unaryInstr =
+                    static_cast<const UnaryInstruction &>(*instruction);
+                auto src = getOperand(*unaryInstr.getSrc());
+                if (!src) {
+                    continue;
+                }
+                expression.opcode = static_cast<std::uint8_t>(
+                    flattenUnaryOperator(unaryInstr.getUnaryOperator()));
+                expression.lhs = *src;
+            }
+            else if (instruction->getKind() == Instruction::Kind::Binary) {
+                const auto &binaryInstr =
+                    static_cast<const BinaryInstruction &>(*instruction);
+                auto lhs = getOperand(*binaryInstr.getSrc1());
+                auto rhs = getOperand(*binaryInstr.getSrc2());
+                if (!lhs || !rhs) {
+                    continue;
+                }
+                expression.isBinary = true;
+                expression.opcode = static_cast<std::uint8_t>(
+                    flattenBinaryOperator(binaryInstr.getBinaryOperator()));
+                expression.lhs = *lhs;
+                expression.rhs = *rhs;
+                canonicalizeBinaryExpression(expression);
+            }
+            else {
+                continue;
+            }
+
+            auto it = availableExpressions.find(expression);
+            if (it == availableExpressions.end()) {
+                // The value of a static variable can change before the
+                // expression is computed again.
+                if (!isDstStatic) {
+                    availableExpressions.emplace(expression, dst);
+                    frame.addedExpressions.emplace_back(expression);
+                }
+                continue;
+            }
+            const auto first = it->second;
+            const ValueOperand firstOperand{
+                .isConstant = false, .variable = first, .constant = {}};
+            if (!hasType(firstOperand, *dstType)) {
+                continue;
+            }
+            instruction = std::make_unique<CopyInstruction>(
+                std::make_unique<VariableValue>(first),
+                std::make_unique<VariableValue>(dst));
+            if (!isDstStatic) {
+                copiedValues.emplace(dst, firstOperand);
+            }
+            changed = true;
+        }
+        frames.emplace_back(std::move(frame));
+    };
+
+    enterBlock(CFG::getEntryId());
+    while (!frames.empty()) {
+        auto &frame = frames.back();
+        const auto &children = dominatorTree.getChildren(frame.id);
+        if (frame.nextChild < children.size()) {
+            enterBlock(children[frame.nextChild++]);
+            continue;
+        }
+        for (const auto &expression : frame.addedExpressions) {
+            availableExpressions.erase(expression);
+        }
+        frames.pop_back();
+    }
+    return changed;
+}
+
+bool LoopInvariantCodeMotionPass::moveLoopInvariants(
+    std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+    const AST::FrontendSymbolTable &frontendSymbolTable) {
+    auto cfg = CFG::makeControlFlowGraph(std::move(functionBody));
+    const DominatorTree dominatorTree(cfg);
+    const auto loops = findNaturalLoops(cfg, dominatorTree);
+    if (loops.empty()) {
+        functionBody = CFG::cfgToInstructions(std::move(cfg));
+        return false;
+    }
+    const LivenessAnalysis liveness(cfg, frontendSymbolTable);
+    std::vector<std::optional<BitSet>> liveIn(cfg.getBlocks().size());
+    auto isLiveIn = [&](Symbol variable, std::size_t id) {
+        const auto index = liveness.getVariableIndex(variable);
+        if (!index) {
+            return false;
+        }
+        if (!liveIn[id]) {
+            auto live = liveness.getLiveOut(id);
+            const auto &instructions = cfg.getBlock(id).instructions;
+            for (auto it = instructions.rbegin(); it != instructions.rend();
+                 ++it) {
+                liveness.transfer(**it, live);
+            }
+            liveIn[id] = std::move(live);
+        }
+        return liveIn[id]->test(*index);
+    };
+
+    // Mark the instructions to hoist, and the loop each goes out of (the
+    // outermost loop it is invariant in, since the enclosing loops come
+    // first), in an order in which each comes after those it depends on.
+    std::unordered_set<const Instruction *> hoisted;
+    std::vector<std::vector<const Instruction *>> hoistedFromLoops(
+        loops.size());
+    for (std::size_t loopIndex = 0; loopIndex < loops.size(); ++loopIndex) {
+        const auto &loop = loops[loopIndex];
+        const auto &header = cfg.getBlock(loop.header);
+        if (header.instructions.empty() ||
+            header.instructions.front()->getKind() !=
+                Instruction::Kind::Label) {
+            continue;
+        }
+        std::unordered_map<Symbol, std::size_t> definitionCounts;
+        std::vector<std::pair<std::size_t, std::size_t>> exitEdges;
+        for (const auto id : loop.blocks) {
+            const auto &block = cfg.getBlock(id);
+            for (const auto &instruction : block.instructions) {
+                const auto *dst = getDst(*instruction);
+                if (dst != nullptr && !hoisted.contains(instruction.get())) {
+                    ++definitionCounts[static_cast<const VariableValue *>(dst)
+                                           ->getSymbol()];
+                }
+            }
+            for (const auto successorId : block.successors) {
+                if (!loop.contains(successorId)) {
+                    exitEdges.emplace_back(id, successorId);
+                }
+            }
+        }
+        auto getDefinitionCount = [&](Symbol variable) {
+            auto it = definitionCounts.find(variable);
+            return it == definitionCounts.end() ? 0 : it->second;
+        };
+
+        std::unordered_set<Symbol> invariantVariables;
+        auto isInvariant = [&](const Value &value) {
+            const auto *variableValue =
+                dynamic_cast<const VariableValue *>(&value);
+            if (variableValue == nullptr) {
+                return true;
+            }
+            const auto variable = variableValue->getSymbol();
+            return !isStaticVariable(variable, frontendSymbolTable) &&
+                   (getDefinitionCount(variable) == 0 ||
+                    invariantVariables.contains(variable));
+        };
+        auto isHoistable = [&](std::size_t id,
+                               const Instruction &instruction) {
+            if (hoisted.contains(&instruction) ||
+                !isSpeculatable(instruction)) {
+                return false;
+            }
+            const auto dst =
+                static_cast<const VariableValue *>(getDst(instruction))
+                    ->getSymbol();
+            if (isStaticVariable(dst, frontendSymbolTable) ||
+                getDefinitionCount(dst) != 1 || isLiveIn(dst, loop.header)) {
+                return false;
+            }
+            bool operandsInvariant = true;
+            forEachSrc(instruction, [&](const Value &src) {
+                operandsInvariant = operandsInvariant && isInvariant(src);
+            });
+            return operandsInvariant &&
+                   std::ranges::all_of(exitEdges, [&](const auto &edge) {
+                       return !isLiveIn(dst, edge.second) ||
+                              dominatorTree.dominates(id, edge.first);
+                   });
+        };
+        // Hoisting an instruction can make those that depend on it
+        // invariant, so repeat until nothing more is found.
+        bool found = true;
+        while (found) {
+            found = false;
+            for (const auto id : loop.blocks) {
+                for (const auto &instruction : cfg.getBlock(id).instructions) {
+                    if (isHoistable(id, *instruction)) {
+                        hoisted.insert(instruction.get());
+                        hoistedFromLoops[loopIndex].emplace_back(
+                            instruction.get());
+                        invariantVariables.insert(
+                            static_cast<const VariableValue *>(
+                                getDst(*instruction))
+                                ->getSymbol());
+                        found = true;
+                    }
+                }
+            }
+        }
+    }
+    if (hoisted.empty()) {
+        functionBody = CFG::cfgToInstructions(std::move(cfg));
+        return false;
+    }
+
+    // Take the hoisted instructions out of their basic blocks, and hand them
+    // to the preheaders.
+    std::unordered_map<const Instruction *, std::unique_ptr<Instruction>>
+        hoistedInstructions;
+    for (auto &block : cfg.getBlocks()) {
+        std::vector<std::unique_ptr<Instruction>> keptInstructions;
+        for (auto &instruction : block.instructions) {
+            const auto *key = instruction.get();
+            if (hoisted.contains(key)) {
+                hoistedInstructions.emplace(key, std::move(instruction));
+            }
+            else {
+                keptInstructions.emplace_back(std::move(instruction));
+            }
+        }
+        block.instructions = std::move(keptInstructions);
+    }
+    std::vector<std::vector<std::unique_ptr<Instruction>>>
+        preheaderInstructions(loops.size());
+    for (std::size_t loopIndex = 0; loopIndex < loops.size(); ++loopIndex) {
+        for (const auto *instruction : hoistedFromLoops[loopIndex]) {
+            preheaderInstructions[loopIndex].emplace_back(
+                std::move(hoistedInstructions.at(instruction)));
+        }
+    }
+    functionBody = cfgToInstructionsWithPreheaders(
+        std::move(cfg), loops, std::move(preheaderInstructions));
+    return true;
+}
+
+bool InductionVariableStrengthReductionPass::reduceInductionVariables(
+    std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+    const AST::FrontendSymbolTable &frontendSymbolTable,
+    const IntroducedOriginals &introducedOriginals,
+    std::vector<IntroducedVariable> &introducedVariables) {
+    auto cfg = CFG::makeControlFlowGraph(std::move(functionBody));
+    const DominatorTree dominatorTree(cfg);
+    const auto loops = findNaturalLoops(cfg, dominatorTree);
+    if (loops.empty()) {
+        functionBody = CFG::cfgToInstructions(std::move(cfg));
+        return false;
+    }
+
+    auto getKind = [&](Symbol variable) -> std::optional<ConstantKind> {
+        const auto *type = findVariableType(variable, frontendSymbolTable,
+                                            introducedOriginals);
+        if (type == nullptr) {
+            return std::nullopt;
+        }
+        return getConstantKind(type);
+    };
+    // The new variables are named `<i>.iv.<k>` after their basic induction
+    // variables, with the first `k` not in use.
+    std::unordered_set<Symbol> usedNames;
+    for (const auto &block : cfg.getBlocks()) {
+        for (const auto &instruction : block.instructions) {
+            auto addName = [&](const Value &value) {
+                if (const auto *variableValue =
+                        dynamic_cast<const VariableValue *>(&value)) {
+                    usedNames.insert(variableValue->getSymbol());
+                }
+            };
+            forEachSrc(*instruction, addName);
+            if (const auto *dst = getDst(*instruction)) {
+                addName(*dst);
+            }
+        }
+    }
+    for (const auto &introducedVariable : introducedVariables) {
+        usedNames.insert(introducedVariable.variable);
+    }
+    auto makeReducedVariable = [&](Symbol variable) {
+        for (std::size_t suffix = 1;; ++suffix) {
+            const Symbol name(variable.str() + ".iv." + std::to_string(suffix));
+            if (!usedNames.contains(name) &&
+                !frontendSymbolTable.contains(name)) {
+                usedNames.insert(name);
+                introducedVariables.emplace_back(
+                    IntroducedVariable{.variable = name, .original = variable});
+                return name;
+            }
+        }
+    };
+
+    /**
+     * Structure representing the definitions of a variable in a loop: how
+     * many there are, and the last one (with its basic block).
+     */
+    struct LoopDefinitions {
+        std::size_t count = 0;
+        std::size_t blockId = 0;
+        const Instruction *instruction = nullptr;
+    };
+    /**
+     * Structure representing a derived induction variable: the basic
+     * induction variable, the constant it is multiplied by, and the variable
+     * that holds the product.
+     */
+    struct DerivedVariable {
+        Symbol basicVariable;
+        FlatConstant factor;
+        Symbol reducedVariable;
+    };
+
+    bool changed = false;
+    std::vector<std::vector<std::unique_ptr<Instruction>>>
+        preheaderInstructions(loops.size());
+    for (std::size_t loopIndex = 0; loopIndex < loops.size(); ++loopIndex) {
+        const auto &loop = loops[loopIndex];
+        const auto &header = cfg.getBlock(loop.header);
+        if (header.instructions.empty() ||
+            header.instructions.front()->getKind() !=
+                Instruction::Kind::Label) {
+            continue;
+        }
+        std::unordered_map<Symbol, LoopDefinitions> definitions;
+        for (const auto id : loop.blocks) {
+            for (const auto &instruction : cfg.getBlock(id).instructions) {
+                if (const auto *dst = getDst(*instruction)) {
+                    auto &definition =
+                        definitions[static_cast<const VariableValue *>(dst)
+                                        ->getSymbol()];
+                    ++definition.count;
+                    definition.blockId = id;
+                    definition.instruction = instruction.get();
+                }
+            }
+        }
+        auto getSingleDefinition =
+            [&](Symbol variable) -> const LoopDefinitions * {
+            auto it = definitions.find(variable);
+            return it != definitions.end() && it->second.count == 1 &&
+                           !isStaticVariable(variable, frontendSymbolTable)
+                       ? &it->second
+                       : nullptr;
+        };
+        auto isBefore = [&](std::size_t id, const Instruction *lhs,
+                            const Instruction *rhs) {
+            for (const auto &instruction : cfg.getBlock(id).instructions) {
+                if (instruction.get() == rhs) {
+                    return false;
+                }
+                if (instruction.get() == lhs) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        // Find the step of a basic induction variable of the loop (if the
+        // variable is one), through the temporary its update goes through.
+        auto getInductionStep =
+            [&](Symbol variable) -> std::optional<InductionStep> {
+            const auto *definition = getSingleDefinition(variable);
+            if (definition == nullptr) {
+                return std::nullopt;
+            }
+            const auto &update = *definition->instruction;
+            auto step = matchInductionStep(update, variable);
+            if (!step && update.getKind() == Instruction::Kind::Copy) {
+                const auto *src = dynamic_cast<const VariableValue *>(
+                    static_cast<const CopyInstruction &>(update).getSrc());
+                const auto *srcDefinition =
+                    src != nullptr ? getSingleDefinition(src->getSymbol())
+                                   : nullptr;
+                if (srcDefinition != nullptr &&
+                    srcDefinition->blockId == definition->blockId &&
+                    isBefore(definition->blockId, srcDefinition->instruction,
+                             &update)) {
+                    step = matchInductionStep(*srcDefinition->instruction,
+                                              variable);
+                }
+            }
+            if (!step || step->constant.kind != getKind(variable)) {
+                return std::nullopt;
+            }
+            return step;
+        };
+
+        // The loop is analyzed in full before any of it is rewritten, since
+        // `definitions` points into its instructions: the multiplications
+        // to replace are collected in `replacements`, and the updates of the
+        // new variables in `reducedUpdates`.
+        std::vector<DerivedVariable> derivedVariables;
+        std::vector<
+            std::pair<std::unique_ptr<Instruction> *,
+                      std::unique_ptr<Instruction>>>
+            replacements;
+        std::vector<
+            std::pair<const Instruction *, std::unique_ptr<Instruction>>>
+            reducedUpdates;
+        for (const auto id : loop.blocks) {
+            for (auto &instruction : cfg.getBlock(id).instructions) {
+                if (instruction->getKind() != Instruction::Kind::Binary) {
+                    continue;
+                }
+                const auto &binaryInstr =
+                    static_cast<const BinaryInstruction &>(*instruction);
+                if (flattenBinaryOperator(binaryInstr.getBinaryOperator()) !=
+                    BinaryOpcode::Multiply) {
+                    continue;
+                }
+                const Value *variableOperand = binaryInstr.getSrc1();
+                auto factor = getConstant(binaryInstr.getSrc2());
+                if (!factor) {
+                    variableOperand = binaryInstr.getSrc2();
+                    factor = getConstant(binaryInstr.getSrc1());
+                }
+                const auto *basicVariable =
+                    dynamic_cast<const VariableValue *>(variableOperand);
+                if (!factor || basicVariable == nullptr) {
+                    continue;
+                }
+                const auto variable = basicVariable->getSymbol();
+                const auto dst =
+                    static_cast<const VariableValue *>(binaryInstr.getDst())
+                        ->getSymbol();
+                const auto kind = getKind(variable);
+                const auto step = getInductionStep(variable);
+                if (!step || factor->kind != kind || getKind(dst) != kind) {
+                    continue;
+                }
+
+                auto it = std::ranges::find_if(
+                    derivedVariables, [&](const DerivedVariable &derived) {
+                        return derived.basicVariable == variable &&
+                               derived.factor == *factor;
+                    });
+                if (it == derivedVariables.end()) {
+                    const auto reducedVariable = makeReducedVariable(variable);
+                    preheaderInstructions[loopIndex].emplace_back(
+                        std::make_unique<BinaryInstruction>(
+                            unflattenBinaryOperator(BinaryOpcode::Multiply),
+                            std::make_unique<VariableValue>(variable),
+                            makeConstantValue(*factor),
+                            std::make_unique<VariableValue>(reducedVariable)));
+                    const auto increment = evaluateBinary(
+                        BinaryOpcode::Multiply, step->constant, *factor);
+                    reducedUpdates.emplace_back(
+                        getSingleDefinition(variable)->instruction,
+                        std::make_unique<BinaryInstruction>(
+                            unflattenBinaryOperator(step->isSubtract
+                                                        ? BinaryOpcode::Subtract
+                                                        : BinaryOpcode::Add),
+                            std::make_unique<VariableValue>(reducedVariable),
+                            makeConstantValue(*increment),
+                            std::make_unique<VariableValue>(reducedVariable)));
+                    it = derivedVariables.insert(
+                        derivedVariables.end(),
+                        DerivedVariable{.basicVariable = variable,
+                                        .factor = *factor,
+                                        .reducedVariable = reducedVariable});
+                }
+                replacements.emplace_back(
+                    &instruction,
+                    std::make_unique<CopyInstruction>(
+                        std::make_unique<VariableValue>(it->reducedVariable),
+                        std::make_unique<VariableValue>(dst)));
+            }
+        }
+
+        // Replace the multiplications by copies of the new variables (before
+        // any insertion, which would move the instructions they point to).
+        for (auto &[instruction, replacement] : replacements) {
+            *instruction = std::move(replacement);
+            changed = true;
+        }
+        // Update the new variables right after their basic induction
+        // variables.
+        for (auto &[update, reducedUpdate] : reducedUpdates) {
+            for (const auto id : loop.blocks) {
+                auto &instructions = cfg.getBlock(id).instructions;
+                auto position = std::ranges::find_if(
+                    instructions,
+                    [&](const auto &instruction) {
+                        return instruction.get() == update;
+                    });
+                if (position != instructions.end()) {
+                    instructions.insert(position + 1, std::move(reducedUpdate));
+                    break;
+                }
+            }
+        }
+    }
+    if (!changed) {
+        functionBody = CFG::cfgToInstructions(std::move(cfg));
+        return false;
+    }
+    functionBody = cfgToInstructionsWithPreheaders(
+        std::move(cfg), loops, std::move(preheaderInstructions));
+    return true;
 }
 } // namespace IR
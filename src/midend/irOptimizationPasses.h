@@ -1,11 +1,111 @@
 #ifndef MIDEND_IR_OPTIMIZATION_PASSES_H
 #define MIDEND_IR_OPTIMIZATION_PASSES_H
 
+#include "../frontend/frontendSymbolTable.h"
+#include "algebraicSimplification.h"
+#include "cfg.h"
 #include "ir.h"
+#include "ssa.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 namespace IR {
+/**
+ * Enumeration representing the optimization passes run by the pass manager
+ * (`IROptimizer::irOptimize`), in the order they run in each iteration.
+ */
+enum class OptimizationPassKind : std::uint8_t {
+    FoldConstants,
+    SimplifyAlgebra,
+    EliminateUnreachableCode,
+    PropagateCopies,
+    EliminateDeadStores,
+    PropagateConstants,
+    EliminateCommonSubexpressions,
+    ConvertToSSA,
+    MoveLoopInvariants,
+    ReduceInductionVariables
+};
+
+/**
+ * The number of optimization passes.
+ */
+constexpr std::size_t optimizationPassCount = 10;
+
+/**
+ * Get the name (the command-line flag without the dashes) of an optimization
+ * pass.
+ *
+ * @param pass The optimization pass.
+ * @return The name of the optimization pass.
+ */
+[[nodiscard]] std::string_view
+getOptimizationPassName(OptimizationPassKind pass);
+
+/**
+ * Structure representing the optimization passes to run and how many times at
+ * most to iterate them.
+ */
+struct OptimizationOptions {
+    /**
+     * The default cap on the number of iterations of the pass manager.
+     */
+    static constexpr std::size_t defaultMaxIterations = 10;
+
+    bool foldConstants = false;
+    bool simplifyAlgebra = false;
+    bool eliminateUnreachableCode = false;
+    bool propagateCopies = false;
+    bool eliminateDeadStores = false;
+    bool propagateConstants = false;
+    bool eliminateCommonSubexpressions = false;
+    bool convertToSSA = false;
+    bool moveLoopInvariants = false;
+    bool reduceInductionVariables = false;
+    std::size_t maxIterations = defaultMaxIterations;
+
+    /**
+     * Check whether an optimization pass is enabled (the conversion to SSA
+     * form is implied by the passes that run on it).
+     *
+     * @param pass The optimization pass.
+     * @return True if the optimization pass is enabled, false otherwise.
+     */
+    [[nodiscard]] bool isEnabled(OptimizationPassKind pass) const;
+
+    /**
+     * Check whether any optimization pass is enabled.
+     *
+     * @return True if any optimization pass is enabled, false otherwise.
+     */
+    [[nodiscard]] bool isAnyEnabled() const;
+};
+
+/**
+ * Structure representing what the pass manager did: how many iterations it
+ * ran, for each optimization pass, how many times it ran and how many of
+ * those runs changed the function body, and, for each rule of the algebraic
+ * simplifier, how many times it applied.
+ */
+struct OptimizationStatistics {
+    std::size_t iterations = 0;
+    std::array<std::size_t, optimizationPassCount> runs{};
+    std::array<std::size_t, optimizationPassCount> changes{};
+    std::array<std::size_t, simplificationRuleCount> ruleHits{};
+
+    /**
+     * Accumulate the statistics of another function body (the iterations are
+     * combined by maximum, the other counts by sum).
+     *
+     * @param other The statistics to accumulate.
+     */
+    void accumulate(const OptimizationStatistics &other);
+};
+
 /**
  * Class for optimizing IR function bodies using various
  * optimization passes.
@@ -13,26 +113,35 @@ namespace IR {
 class IROptimizer {
   public:
     /**
-     * Optimize the given IR function body using the specified optimization
-     * passes.
+     * Optimize the given IR function body in place using the specified
+     * optimization passes.
+     *
+     * The enabled passes are iterated until an iteration leaves the function
+     * body unchanged (or the iteration cap is reached), since each pass can
+     * expose opportunities for the others. A pass is skipped when the function
+     * body has not changed since its last run changed nothing.
+     *
+     * With `convertToSSA` (or any pass that runs on SSA form), each iteration
+     * converts the CFG into SSA form, runs the SSA passes, and converts it
+     * back. Since the frontend symbol table is shared by the function bodies
+     * optimized in parallel, the variables introduced by SSA destruction (and
+     * by induction variable strength reduction) are handed back to the caller
+     * rather than registered here; until then, the passes take their types
+     * from those of their original variables.
      *
      * @param functionBody The IR function body to optimize.
-     * @param foldConstantsPass Boolean indicating whether to apply constant
-     * folding.
-     * @param propagateCopiesPass Boolean indicating whether to apply copy
-     * propagation.
-     * @param eliminateUnreachableCodePass Boolean indicating whether to apply
-     * unreachable code elimination.
-     * @param eliminateDeadStoresPass Boolean indicating whether to apply dead
-     * store elimination.
-     * @return The optimized IR function body.
-     */
-    [[nodiscard]] static std::unique_ptr<
-        std::vector<std::unique_ptr<IR::Instruction>>>
-    irOptimize(
-        const std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
-        bool foldConstantsPass, bool propagateCopiesPass,
-        bool eliminateUnreachableCodePass, bool eliminateDeadStoresPass);
+     * @param frontendSymbolTable The frontend symbol table (for the types and
+     * storage durations of the variables).
+     * @param options The optimization passes to run and the iteration cap.
+     * @param introducedVariables The vector to append the variables
+     * introduced by SSA destruction and strength reduction to.
+     * @return The statistics of the optimization.
+     */
+    static OptimizationStatistics
+    irOptimize(std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+               const AST::FrontendSymbolTable &frontendSymbolTable,
+               const OptimizationOptions &options,
+               std::vector<IntroducedVariable> &introducedVariables);
 };
 
 /**
@@ -77,46 +186,59 @@ class OptimizationPass {
 class ConstantFoldingPass : public OptimizationPass {
   public:
     /**
-     * Perform constant folding on the given IR function body.
+     * Perform constant folding on the given IR function body in place.
+     *
+     * Instructions whose operands are all constants are evaluated with the
+     * exact semantics of their types (`int`, `long`, `unsigned int`, and
+     * `unsigned long`: wraparound, signed or unsigned division and
+     * comparisons, and the C conversions of `SignExtend`, `Truncate`, and
+     * `ZeroExtend`) and replaced by copies of their results, converted to the
+     * types of their destinations. Operations that trap at runtime (division
+     * by zero, or of the minimum of a signed type by `-1`) are left alone.
      *
      * @param functionBody The IR function body to optimize.
-     * @return The optimized IR function body with constants folded.
+     * @param frontendSymbolTable The frontend symbol table (for the types of
+     * the destinations).
+     * @param introducedOriginals The original variables of the variables
+     * introduced while optimizing the function body (for their types).
+     * @return True if the function body has been changed, false otherwise.
      */
-    [[nodiscard]] static std::unique_ptr<
-        std::vector<std::unique_ptr<IR::Instruction>>>
-    foldConstants(
-        const std::vector<std::unique_ptr<IR::Instruction>> &functionBody);
+    static bool
+    foldConstants(std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+                  const AST::FrontendSymbolTable &frontendSymbolTable,
+                  const IntroducedOriginals &introducedOriginals);
 };
 
 /**
- * Class for constructing control flow graphs (CFGs) from IR instructions.
- *
- * TODO(zzmic): CFGs are temporarily of type
- * `std::unique_ptr<std::vector<std::unique_ptr<IR::Instruction>>>`.
+ * Class for performing algebraic simplification on IR instructions.
  */
-class CFG {
+class AlgebraicSimplificationPass : public OptimizationPass {
   public:
     /**
-     * Convert the given IR function body into a control flow graph (CFG).
+     * Simplify the given IR function body in place with the rules of
+     * `simplificationRules`.
      *
-     * @param functionBody The IR function body to convert.
-     * @return The control flow graph (CFG) representation of the function body.
-     */
-    [[nodiscard]] static std::unique_ptr<
-        std::vector<std::unique_ptr<IR::Instruction>>>
-    makeControlFlowGraph(
-        const std::vector<std::unique_ptr<IR::Instruction>> &functionBody);
-
-    /**
-     * Convert the given control flow graph (CFG) back into a linear sequence
-     * of IR instructions.
+     * Constant left operands of commutative operators and comparisons are
+     * moved to the right, then binary identities (e.g., `x + 0`, `x * 0`,
+     * `x - x`, or `x < x`) are replaced by copies of their results. Within a
+     * basic block, `-(-x)` and `~(~x)` become `x`, and a conditional jump on
+     * `!x` becomes the opposite conditional jump on `x`, as long as neither
+     * variable has been reassigned in between.
      *
-     * @param cfg The control flow graph (CFG) to convert.
-     * @return The linear sequence of IR instructions.
+     * @param functionBody The IR function body to optimize.
+     * @param frontendSymbolTable The frontend symbol table (for the types of
+     * the constant results).
+     * @param introducedOriginals The original variables of the variables
+     * introduced while optimizing the function body (for their types).
+     * @param ruleHits The counts to add the number of times each rule
+     * applied to (indexed like `simplificationRules`).
+     * @return True if the function body has been changed, false otherwise.
      */
-    [[nodiscard]] static std::unique_ptr<
-        std::vector<std::unique_ptr<IR::Instruction>>>
-    cfgToInstructions(const std::vector<std::unique_ptr<IR::Instruction>> &cfg);
+    static bool
+    simplifyAlgebra(std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+                    const AST::FrontendSymbolTable &frontendSymbolTable,
+                    const IntroducedOriginals &introducedOriginals,
+                    std::array<std::size_t, simplificationRuleCount> &ruleHits);
 };
 
 /**
@@ -126,16 +248,12 @@ class CFG {
 class UnreachableCodeEliminationPass : public OptimizationPass {
   public:
     /**
-     * Eliminate unreachable code from the given IR function body.
+     * Eliminate unreachable code from the given CFG in place.
      *
-     * @param cfg The control flow graph (CFG) representation of the function
-     * body.
-     * @return The optimized IR function body with unreachable code removed.
+     * @param cfg The control flow graph (CFG) of the function body.
+     * @return True if the function body has been changed, false otherwise.
      */
-    [[nodiscard]] static std::unique_ptr<
-        std::vector<std::unique_ptr<IR::Instruction>>>
-    eliminateUnreachableCode(
-        const std::vector<std::unique_ptr<IR::Instruction>> &cfg);
+    static bool eliminateUnreachableCode(CFG &cfg);
 };
 
 /**
@@ -144,15 +262,24 @@ class UnreachableCodeEliminationPass : public OptimizationPass {
 class CopyPropagationPass : public OptimizationPass {
   public:
     /**
-     * Perform copy propagation on the given IR function body.
+     * Perform copy propagation on the given CFG in place.
+     *
+     * Solve the reaching copies analysis, then replace each use of a variable
+     * by the source of the copy to it that reaches the use (if any), and
+     * remove the copies that are already known to hold. Only copies that keep
+     * the type of their source are propagated, and function calls kill the
+     * copies to or from static variables.
      *
-     * @param cfg The control flow graph (CFG) representation of the function
-     * body.
-     * @return The optimized IR function body with copies propagated.
+     * @param cfg The control flow graph (CFG) of the function body.
+     * @param frontendSymbolTable The frontend symbol table.
+     * @param introducedOriginals The original variables of the variables
+     * introduced while optimizing the function body (for their types).
+     * @return True if the function body has been changed, false otherwise.
      */
-    [[nodiscard]] static std::unique_ptr<
-        std::vector<std::unique_ptr<IR::Instruction>>>
-    propagateCopies(const std::vector<std::unique_ptr<IR::Instruction>> &cfg);
+    static bool
+    propagateCopies(CFG &cfg,
+                    const AST::FrontendSymbolTable &frontendSymbolTable,
+                    const IntroducedOriginals &introducedOriginals);
 };
 
 /**
@@ -162,16 +289,147 @@ class CopyPropagationPass : public OptimizationPass {
 class DeadStoreEliminationPass : public OptimizationPass {
   public:
     /**
-     * Eliminate dead stores from the given IR function body.
+     * Eliminate dead stores from the given CFG in place.
+     *
+     * Solve the liveness analysis, then remove each instruction (other than a
+     * function call) whose destination is not live after it and is not a
+     * static variable.
+     *
+     * @param cfg The control flow graph (CFG) of the function body.
+     * @param frontendSymbolTable The frontend symbol table.
+     * @return True if the function body has been changed, false otherwise.
+     */
+    static bool
+    eliminateDeadStores(CFG &cfg,
+                        const AST::FrontendSymbolTable &frontendSymbolTable);
+};
+
+/**
+ * Class for performing sparse conditional constant propagation (SCCP) on the
+ * SSA form of IR function bodies.
+ */
+class SparseConditionalConstantPropagationPass : public OptimizationPass {
+  public:
+    /**
+     * Perform sparse conditional constant propagation on the given SSA form
+     * in place.
+     *
+     * Find the versions that hold the same constant on every execution
+     * (computed with the width and signedness of their types, through copies,
+     * conversions, and phi nodes) together with the edges that can be taken,
+     * assuming that conditional jumps on constants only take one edge. Then
+     * replace the uses of the constant versions by their constants, remove
+     * their definitions, turn the conditional jumps on constants into jumps
+     * (or nothing), and remove the basic blocks that are never executed.
+     *
+     * @param ssaForm The SSA form of the function body.
+     * @param frontendSymbolTable The frontend symbol table.
+     * @param introducedOriginals The original variables of the variables
+     * introduced while optimizing the function body (for their types).
+     * @return True if the function body has been changed, false otherwise.
+     */
+    static bool
+    propagateConstants(SSAForm &ssaForm,
+                       const AST::FrontendSymbolTable &frontendSymbolTable,
+                       const IntroducedOriginals &introducedOriginals);
+};
+
+/**
+ * Class for performing common subexpression elimination (CSE) on the SSA form
+ * of IR function bodies, by global value numbering (GVN).
+ */
+class CommonSubexpressionEliminationPass : public OptimizationPass {
+  public:
+    /**
+     * Eliminate the common subexpressions of the given SSA form in place.
+     *
+     * Walk the dominator tree in preorder, numbering each unary or binary
+     * instruction by its operator and the values of its operands (the
+     * operands of commutative operators, and of comparisons once mirrored
+     * into `<` or `<=`, are put in a canonical order, and the destinations of
+     * copies take the values of their sources). An instruction that computes
+     * the same value as one that dominates it, into a destination of the same
+     * type, is replaced by a copy of the result of the dominating one. Static
+     * variables can change at any function call, so the instructions that
+     * read them are left alone.
+     *
+     * @param ssaForm The SSA form of the function body.
+     * @param frontendSymbolTable The frontend symbol table.
+     * @param introducedOriginals The original variables of the variables
+     * introduced while optimizing the function body (for their types).
+     * @return True if the function body has been changed, false otherwise.
+     */
+    static bool eliminateCommonSubexpressions(
+        SSAForm &ssaForm, const AST::FrontendSymbolTable &frontendSymbolTable,
+        const IntroducedOriginals &introducedOriginals);
+};
+
+/**
+ * Class for performing loop-invariant code motion (LICM) on IR instructions.
+ */
+class LoopInvariantCodeMotionPass : public OptimizationPass {
+  public:
+    /**
+     * Move the loop-invariant instructions of the given IR function body in
+     * place into the preheaders of their loops.
+     *
+     * Find the natural loops of the function body (from the back edges of
+     * its CFG, whose destinations dominate their sources), and visit them
+     * from the outermost in. An instruction of a loop is hoisted into the
+     * preheader of the loop when:
+     * - it has no side effects and cannot trap (a copy, a conversion, a unary
+     *   instruction, or a binary instruction other than a division or
+     *   remainder by a variable, by zero, or by `-1`);
+     * - each of its operands is a constant or a non-static variable that is
+     *   either not defined in the loop or only by a hoisted instruction;
+     * - its destination is a non-static variable defined only by it in the
+     *   loop and not live on entry to the header (so every use of it in the
+     *   loop sees its value);
+     * - its basic block dominates each exit of the loop after which its
+     *   destination is live.
      *
-     * @param cfg The control flow graph (CFG) representation of the function
-     * body.
-     * @return The optimized IR function body with dead stores removed.
+     * @param functionBody The IR function body to optimize.
+     * @param frontendSymbolTable The frontend symbol table.
+     * @return True if the function body has been changed, false otherwise.
+     */
+    static bool moveLoopInvariants(
+        std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+        const AST::FrontendSymbolTable &frontendSymbolTable);
+};
+
+/**
+ * Class for performing induction variable strength reduction on IR
+ * instructions.
+ */
+class InductionVariableStrengthReductionPass : public OptimizationPass {
+  public:
+    /**
+     * Replace the multiplications of induction variables by constants in the
+     * given IR function body in place with additive updates.
+     *
+     * For each natural loop, a basic induction variable is a non-static
+     * variable whose only definition in the loop adds a constant to it or
+     * subtracts one (`i = i + c`, or `t = i + c` followed by `i = t`). A
+     * derived induction variable is the result of multiplying a basic one by
+     * a constant (`j = i * k`). Each distinct derived induction variable gets
+     * a new variable `s`, set to `i * k` in the preheader of the loop and
+     * updated by `s = s + c * k` right after each update of `i`, so that the
+     * multiplication becomes the copy `j = s`. The arithmetic wraps around in
+     * the generated code, so `s == i * k` holds throughout the loop.
+     *
+     * @param functionBody The IR function body to optimize.
+     * @param frontendSymbolTable The frontend symbol table.
+     * @param introducedOriginals The original variables of the variables
+     * introduced while optimizing the function body (for their types).
+     * @param introducedVariables The vector to append the new variables to
+     * (each with the basic induction variable it takes its type from).
+     * @return True if the function body has been changed, false otherwise.
      */
-    [[nodiscard]] static std::unique_ptr<
-        std::vector<std::unique_ptr<IR::Instruction>>>
-    eliminateDeadStores(
-        const std::vector<std::unique_ptr<IR::Instruction>> &cfg);
+    static bool reduceInductionVariables(
+        std::vector<std::unique_ptr<IR::Instruction>> &functionBody,
+        const AST::FrontendSymbolTable &frontendSymbolTable,
+        const IntroducedOriginals &introducedOriginals,
+        std::vector<IntroducedVariable> &introducedVariables);
 };
 } // namespace IR
 
@@ -0,0 +1,237 @@
+#include "loops.h"
+#include "../utils/symbol.h"
+#include "cfg.h"
+#include "dominators.h"
+#include "ir.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Unnamed namespace for helper functions for the natural loops.
+ */
+namespace {
+/**
+ * Get the target of a jump instruction (of any kind).
+ *
+ * @param instruction The instruction.
+ * @return The target label, or `std::nullopt` if the instruction is not a
+ * jump.
+ */
+std::optional<Symbol> getJumpTarget(const IR::Instruction &instruction) {
+    switch (instruction.getKind()) {
+    case IR::Instruction::Kind::Jump:
+        return static_cast<const IR::JumpInstruction &>(instruction)
+            .getTargetSymbol();
+    case IR::Instruction::Kind::JumpIfZero:
+        return static_cast<const IR::JumpIfZeroInstruction &>(instruction)
+            .getTargetSymbol();
+    case IR::Instruction::Kind::JumpIfNotZero:
+        return static_cast<const IR::JumpIfNotZeroInstruction &>(instruction)
+            .getTargetSymbol();
+    default:
+        return std::nullopt;
+    }
+}
+
+/**
+ * Redirect a jump instruction (of any kind) to another target.
+ *
+ * @param instruction The jump instruction.
+ * @param target The new target label.
+ */
+void setJumpTarget(IR::Instruction &instruction, Symbol target) {
+    switch (instruction.getKind()) {
+    case IR::Instruction::Kind::Jump:
+        static_cast<IR::JumpInstruction &>(instruction).setTarget(target);
+        break;
+    case IR::Instruction::Kind::JumpIfZero:
+        static_cast<IR::JumpIfZeroInstruction &>(instruction)
+            .setTarget(target);
+        break;
+    case IR::Instruction::Kind::JumpIfNotZero:
+        static_cast<IR::JumpIfNotZeroInstruction &>(instruction)
+            .setTarget(target);
+        break;
+    default:
+        throw std::logic_error("Unsupported instruction in setJumpTarget");
+    }
+}
+
+/**
+ * Check whether a basic block falls through into the basic block laid out
+ * after it (i.e., does not end with a jump or a return).
+ *
+ * @param block The basic block.
+ * @return True if the basic block falls through, false otherwise.
+ */
+bool fallsThrough(const IR::BasicBlock &block) {
+    if (block.instructions.empty()) {
+        return true;
+    }
+    const auto kind = block.instructions.back()->getKind();
+    return kind != IR::Instruction::Kind::Jump &&
+           kind != IR::Instruction::Kind::Return;
+}
+} // namespace
+
+namespace IR {
+bool NaturalLoop::contains(std::size_t id) const {
+    return id < isInLoop.size() && isInLoop[id];
+}
+
+std::vector<NaturalLoop> findNaturalLoops(const CFG &cfg,
+                                          const DominatorTree &dominatorTree) {
+    const auto blockCount = cfg.getBlocks().size();
+    std::vector<NaturalLoop> loops;
+    for (const auto header : dominatorTree.getPreorder()) {
+        NaturalLoop loop{.header = header,
+                         .latches = {},
+                         .blocks = {},
+                         .isInLoop = std::vector<bool>(blockCount, false)};
+        for (const auto predecessor : cfg.getBlock(header).predecessors) {
+            if (dominatorTree.isReachable(predecessor) &&
+                dominatorTree.dominates(header, predecessor)) {
+                loop.latches.emplace_back(predecessor);
+            }
+        }
+        if (loop.latches.empty()) {
+            continue;
+        }
+        std::ranges::sort(loop.latches);
+
+        // Walk backwards from the latches up to the header.
+        loop.isInLoop[header] = true;
+        std::vector<std::size_t> worklist;
+        for (const auto latch : loop.latches) {
+            if (!loop.isInLoop[latch]) {
+                loop.isInLoop[latch] = true;
+                worklist.emplace_back(latch);
+            }
+        }
+        while (!worklist.empty()) {
+            const auto id = worklist.back();
+            worklist.pop_back();
+            for (const auto predecessor : cfg.getBlock(id).predecessors) {
+                if (dominatorTree.isReachable(predecessor) &&
+                    !loop.isInLoop[predecessor]) {
+                    loop.isInLoop[predecessor] = true;
+                    worklist.emplace_back(predecessor);
+                }
+            }
+        }
+        for (std::size_t id = 0; id < blockCount; ++id) {
+            if (loop.isInLoop[id]) {
+                loop.blocks.emplace_back(id);
+            }
+        }
+        loops.emplace_back(std::move(loop));
+    }
+    // The headers are in preorder of the dominator tree, so the header of an
+    // enclosing loop comes before the headers of the loops nested in it.
+    return loops;
+}
+
+std::vector<std::unique_ptr<Instruction>> cfgToInstructionsWithPreheaders(
+    CFG &&cfg, const std::vector<NaturalLoop> &loops,
+    std::vector<std::vector<std::unique_ptr<Instruction>>>
+        &&preheaderInstructions) {
+    if (preheaderInstructions.size() != loops.size()) {
+        throw std::logic_error("Mismatched preheader instructions in "
+                               "cfgToInstructionsWithPreheaders");
+    }
+    auto &blocks = cfg.getBlocks();
+
+    // The instructions to lay out before each basic block (the new
+    // preheaders).
+    std::vector<std::vector<std::unique_ptr<Instruction>>> blockPrefixes(
+        blocks.size());
+    for (std::size_t index = 0; index < loops.size(); ++index) {
+        auto &instructions = preheaderInstructions[index];
+        if (instructions.empty()) {
+            continue;
+        }
+        const auto &loop = loops[index];
+        auto &header = cfg.getBlock(loop.header);
+        if (header.instructions.empty() ||
+            header.instructions.front()->getKind() !=
+                Instruction::Kind::Label) {
+            throw std::logic_error("Loop header without label in "
+                                   "cfgToInstructionsWithPreheaders");
+        }
+        const auto headerLabel =
+            static_cast<const LabelInstruction &>(*header.instructions.front())
+                .getLabelSymbol();
+        std::vector<std::size_t> entries;
+        for (const auto predecessor : header.predecessors) {
+            if (!loop.contains(predecessor)) {
+                entries.emplace_back(predecessor);
+            }
+        }
+
+        // Reuse a basic block that only enters the loop (e.g., the preheader
+        // made by a previous run), keeping its final jump last.
+        if (entries.size() == 1) {
+            auto &entry = cfg.getBlock(entries.front());
+            const bool endsWithJump =
+                !entry.instructions.empty() &&
+                entry.instructions.back()->getKind() == Instruction::Kind::Jump;
+            const bool endsWithConditionalJump =
+                !endsWithJump && !entry.instructions.empty() &&
+                getJumpTarget(*entry.instructions.back()).has_value();
+            if (entry.successors.size() == 1 && !endsWithConditionalJump) {
+                const auto position =
+                    entry.instructions.end() - (endsWithJump ? 1 : 0);
+                entry.instructions.insert(
+                    position, std::make_move_iterator(instructions.begin()),
+                    std::make_move_iterator(instructions.end()));
+                continue;
+            }
+        }
+
+        // Otherwise, lay out a new preheader right before the header.
+        Symbol preheaderLabel(headerLabel.str() + ".preheader");
+        for (std::size_t suffix = 2;
+             cfg.getBlockIdForLabel(preheaderLabel).has_value(); ++suffix) {
+            preheaderLabel = Symbol(headerLabel.str() + ".preheader." +
+                                    std::to_string(suffix));
+        }
+        for (const auto entryId : entries) {
+            auto &entry = cfg.getBlock(entryId);
+            if (!entry.instructions.empty()) {
+                const auto target = getJumpTarget(*entry.instructions.back());
+                if (target == headerLabel) {
+                    setJumpTarget(*entry.instructions.back(), preheaderLabel);
+                }
+            }
+        }
+        auto &prefix = blockPrefixes[loop.header];
+        const auto previousId = loop.header - 1;
+        if (loop.contains(previousId) && fallsThrough(blocks[previousId])) {
+            prefix.emplace_back(std::make_unique<JumpInstruction>(headerLabel));
+        }
+        prefix.emplace_back(std::make_unique<LabelInstruction>(preheaderLabel));
+        prefix.insert(prefix.end(),
+                      std::make_move_iterator(instructions.begin()),
+                      std::make_move_iterator(instructions.end()));
+    }
+
+    std::vector<std::unique_ptr<Instruction>> functionBody;
+    for (auto &block : blocks) {
+        auto &prefix = blockPrefixes[block.id];
+        functionBody.insert(functionBody.end(),
+                            std::make_move_iterator(prefix.begin()),
+                            std::make_move_iterator(prefix.end()));
+        functionBody.insert(functionBody.end(),
+                            std::make_move_iterator(block.instructions.begin()),
+                            std::make_move_iterator(block.instructions.end()));
+        block.instructions.clear();
+    }
+    return functionBody;
+}
+} // namespace IR
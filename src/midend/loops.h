@@ -0,0 +1,89 @@
+#ifndef MIDEND_LOOPS_H
+#define MIDEND_LOOPS_H
+
+#include "cfg.h"
+#include "dominators.h"
+#include "ir.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace IR {
+/**
+ * Structure representing a natural loop of a CFG: the header, which dominates
+ * every basic block of the loop, and the basic blocks that can reach one of
+ * the back edges to the header without going through the header (the back
+ * edges sharing a header form a single loop).
+ */
+struct NaturalLoop {
+    /**
+     * The ID of the header of the loop.
+     */
+    std::size_t header = 0;
+    /**
+     * The IDs of the sources of the back edges to the header (the latches),
+     * in increasing order.
+     */
+    std::vector<std::size_t> latches;
+    /**
+     * The IDs of the basic blocks of the loop (including the header), in
+     * increasing order.
+     */
+    std::vector<std::size_t> blocks;
+    /**
+     * Whether each basic block (indexed by ID) belongs to the loop.
+     */
+    std::vector<bool> isInLoop;
+
+    /**
+     * Check whether a basic block belongs to the loop.
+     *
+     * @param id The ID of the basic block.
+     * @return True if the basic block belongs to the loop, false otherwise.
+     */
+    [[nodiscard]] bool contains(std::size_t id) const;
+};
+
+/**
+ * Find the natural loops of a CFG: an edge is a back edge when its
+ * destination dominates its source. Unreachable basic blocks belong to no
+ * loop.
+ *
+ * @param cfg The CFG.
+ * @param dominatorTree The dominator tree of the CFG.
+ * @return The natural loops, each enclosing loop before the loops nested in
+ * it.
+ */
+[[nodiscard]] std::vector<NaturalLoop>
+findNaturalLoops(const CFG &cfg, const DominatorTree &dominatorTree);
+
+/**
+ * Convert a CFG back into a linear sequence of IR instructions (see
+ * `CFG::cfgToInstructions`), placing instructions in the preheaders of its
+ * natural loops: basic blocks that only enter the loop, right before its
+ * header.
+ *
+ * If the header has a single predecessor outside the loop, and that
+ * predecessor only goes to the header, the instructions are appended to it
+ * (before its final jump). Otherwise a new labelled basic block is laid out
+ * right before the header, and the jumps to the header from outside the loop
+ * are redirected to it (a basic block of the loop that falls through into the
+ * header gets a jump to the header instead).
+ *
+ * @param cfg The CFG to convert.
+ * @param loops The natural loops of the CFG.
+ * @param preheaderInstructions The instructions to place in the preheader of
+ * each loop (indexed like `loops`; nothing is done for a loop with none).
+ * @return The IR instructions.
+ * @throws std::logic_error if `preheaderInstructions` is not indexed like
+ * `loops`, or if instructions are to be placed in the preheader of a loop
+ * whose header does not start with a label.
+ */
+[[nodiscard]] std::vector<std::unique_ptr<Instruction>>
+cfgToInstructionsWithPreheaders(
+    CFG &&cfg, const std::vector<NaturalLoop> &loops,
+    std::vector<std::vector<std::unique_ptr<Instruction>>>
+        &&preheaderInstructions);
+} // namespace IR
+
+#endif // MIDEND_LOOPS_H
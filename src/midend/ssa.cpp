@@ -0,0 +1,762 @@
+#include "ssa.h"
+#include "../frontend/frontendSymbolTable.h"
+#include "../frontend/semanticAnalysisPasses.h"
+#include "../frontend/type.h"
+#include "../utils/symbol.h"
+#include "cfg.h"
+#include "dataflow.h"
+#include "dominators.h"
+#include "flatIR.h"
+#include "ir.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * Unnamed namespace for helper functions for the SSA form.
+ */
+namespace {
+/**
+ * Make the name of a version of a variable (also used for the variables
+ * introduced by SSA destruction).
+ *
+ * @param variable The variable.
+ * @param version The (positive) number of the version.
+ * @return The name of the version.
+ */
+Symbol makeVersionName(Symbol variable, std::size_t version) {
+    return Symbol(variable.str() + ".ssa." + std::to_string(version));
+}
+
+/**
+ * Clone an IR value.
+ *
+ * @param value The IR value to clone.
+ * @return The cloned IR value.
+ */
+std::unique_ptr<IR::Value> cloneValue(const IR::Value &value) {
+    if (const auto *variableValue =
+            dynamic_cast<const IR::VariableValue *>(&value)) {
+        return std::make_unique<IR::VariableValue>(
+            variableValue->getSymbol());
+    }
+    return std::make_unique<IR::ConstantValue>(IR::unflattenConstant(
+        IR::flattenConstant(static_cast<const IR::ConstantValue &>(value)
+                                .getASTConstant())));
+}
+
+/**
+ * Clone the type of a (scalar) variable.
+ *
+ * @param type The type to clone.
+ * @return The cloned type.
+ */
+std::unique_ptr<AST::Type> cloneVariableType(const AST::Type *type) {
+    if (dynamic_cast<const AST::IntType *>(type) != nullptr) {
+        return std::make_unique<AST::IntType>();
+    }
+    else if (dynamic_cast<const AST::LongType *>(type) != nullptr) {
+        return std::make_unique<AST::LongType>();
+    }
+    else if (dynamic_cast<const AST::UIntType *>(type) != nullptr) {
+        return std::make_unique<AST::UIntType>();
+    }
+    else if (dynamic_cast<const AST::ULongType *>(type) != nullptr) {
+        return std::make_unique<AST::ULongType>();
+    }
+    throw std::logic_error("Unsupported variable type in cloneVariableType");
+}
+
+/**
+ * Structure representing one copy of a parallel copy (all of whose sources
+ * are read before any of its destinations is written).
+ */
+struct ParallelCopy {
+    Symbol dst;
+    std::unique_ptr<IR::Value> src;
+};
+} // namespace
+
+namespace IR {
+SSAForm::SSAForm(CFG &&controlFlowGraph)
+    : cfg(std::move(controlFlowGraph)), dominatorTree(cfg),
+      phis(cfg.getBlocks().size()) {}
+
+SSAForm
+SSAForm::constructSSA(CFG &&cfg,
+                      const AST::FrontendSymbolTable &frontendSymbolTable) {
+    SSAForm ssaForm(std::move(cfg));
+    auto &graph = ssaForm.cfg;
+    const auto &dominatorTree = ssaForm.dominatorTree;
+    const auto blockCount = graph.getBlocks().size();
+
+    // Number the non-static variables defined in the reachable basic blocks
+    // (in the order they are first defined), and collect the basic blocks
+    // defining each of them.
+    std::unordered_map<Symbol, std::size_t> variableIndices;
+    std::vector<std::vector<std::size_t>> definingBlocks;
+    for (const auto &block : graph.getBlocks()) {
+        if (!dominatorTree.isReachable(block.id)) {
+            continue;
+        }
+        for (const auto &instruction : block.instructions) {
+            const auto *dst = getDst(*instruction);
+            if (dst == nullptr) {
+                continue;
+            }
+            const auto variable =
+                static_cast<const VariableValue *>(dst)->getSymbol();
+            if (isStaticVariable(variable, frontendSymbolTable)) {
+                continue;
+            }
+            auto [it, inserted] = variableIndices.emplace(
+                variable, ssaForm.renamedVariables.size());
+            if (inserted) {
+                ssaForm.renamedVariables.emplace_back(variable);
+                definingBlocks.emplace_back();
+            }
+            auto &blocks = definingBlocks[it->second];
+            if (blocks.empty() || blocks.back() != block.id) {
+                blocks.emplace_back(block.id);
+            }
+        }
+    }
+    const auto variableCount = ssaForm.renamedVariables.size();
+
+    // Compute the variables live on entry to each reachable basic block, to
+    // prune the phi nodes of variables that are dead there.
+    const LivenessAnalysis liveness(graph, frontendSymbolTable);
+    std::vector<BitSet> liveIn(blockCount);
+    for (const auto id : dominatorTree.getReversePostorder()) {
+        auto live = liveness.getLiveOut(id);
+        const auto &instructions = graph.getBlock(id).instructions;
+        for (auto it = instructions.rbegin(); it != instructions.rend(); ++it) {
+            liveness.transfer(**it, live);
+        }
+        liveIn[id] = std::move(live);
+    }
+
+    // Insert the phi nodes of each variable at the iterated dominance
+    // frontier of its definitions. The markers hold the index of the last
+    // variable that has been placed (or queued) at each basic block, so that
+    // they need not be cleared between variables.
+    constexpr auto unmarked = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> phiMarkers(blockCount, unmarked);
+    std::vector<std::size_t> worklistMarkers(blockCount, unmarked);
+    for (std::size_t index = 0; index < variableCount; ++index) {
+        const auto variable = ssaForm.renamedVariables[index];
+        const auto liveIndex = liveness.getVariableIndex(variable);
+        auto worklist = definingBlocks[index];
+        for (const auto id : worklist) {
+            worklistMarkers[id] = index;
+        }
+        while (!worklist.empty()) {
+            const auto id = worklist.back();
+            worklist.pop_back();
+            for (const auto frontierId :
+                 dominatorTree.getDominanceFrontier(id)) {
+                if (phiMarkers[frontierId] == index || !liveIndex ||
+                    !liveIn[frontierId].test(*liveIndex)) {
+                    continue;
+                }
+                phiMarkers[frontierId] = index;
+                ssaForm.phis[frontierId].emplace_back(PhiNode{
+                    .variable = variable,
+                    .dst = Symbol(),
+                    .args = std::vector<std::unique_ptr<Value>>(
+                        graph.getBlock(frontierId).predecessors.size())});
+                if (worklistMarkers[frontierId] != index) {
+                    worklistMarkers[frontierId] = index;
+                    worklist.emplace_back(frontierId);
+                }
+            }
+        }
+    }
+
+    // Rename the variables along a preorder walk of the dominator tree, with
+    // a stack of the versions in scope for each variable (an empty stack
+    // stands for the value on entry to the function, i.e., the variable
+    // itself).
+    ssaForm.versions.resize(variableCount);
+    std::vector<std::vector<Symbol>> versionStacks(variableCount);
+    auto getIndex = [&](Symbol variable) -> std::optional<std::size_t> {
+        auto it = variableIndices.find(variable);
+        if (it == variableIndices.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    };
+    auto currentVersion = [&](std::size_t index) {
+        return versionStacks[index].empty() ? ssaForm.renamedVariables[index]
+                                            : versionStacks[index].back();
+    };
+    auto pushNewVersion = [&](std::size_t index) {
+        const auto variable = ssaForm.renamedVariables[index];
+        const auto version =
+            makeVersionName(variable, ssaForm.versions[index].size() + 1);
+        ssaForm.versions[index].emplace_back(version);
+        ssaForm.originalVariables.emplace(version, variable);
+        versionStacks[index].emplace_back(version);
+        return version;
+    };
+    auto renameSrc = [&](const Value &src) -> std::unique_ptr<Value> {
+        if (const auto *variableValue =
+                dynamic_cast<const VariableValue *>(&src)) {
+            if (auto index = getIndex(variableValue->getSymbol())) {
+                const auto version = currentVersion(*index);
+                if (version != variableValue->getSymbol()) {
+                    return std::make_unique<VariableValue>(version);
+                }
+            }
+        }
+        return nullptr;
+    };
+
+    /**
+     * Structure representing a basic block being renamed: its ID, the index
+     * of its next child in the dominator tree, and the variables it pushed
+     * versions of.
+     */
+    struct RenameFrame {
+        std::size_t id;
+        std::size_t nextChild;
+        std::vector<std::size_t> pushedVariables;
+    };
+    std::vector<RenameFrame> frames;
+    auto enterBlock = [&](std::size_t id) {
+        RenameFrame frame{.id = id, .nextChild = 0, .pushedVariables = {}};
+        for (auto &phi : ssaForm.phis[id]) {
+            const auto index = *getIndex(phi.variable);
+            phi.dst = pushNewVersion(index);
+            frame.pushedVariables.emplace_back(index);
+        }
+        auto &block = graph.getBlock(id);
+        for (auto &instruction : block.instructions) {
+            replaceSrcs(*instruction, renameSrc);
+            const auto *dst = getDst(*instruction);
+            if (dst == nullptr) {
+                continue;
+            }
+            if (auto index = getIndex(
+                    static_cast<const VariableValue *>(dst)->getSymbol())) {
+                replaceDst(*instruction, std::make_unique<VariableValue>(
+                                             pushNewVersion(*index)));
+                frame.pushedVariables.emplace_back(*index);
+            }
+        }
+        // Fill in the arguments of the phi nodes of the successors for the
+        // edges from this basic block.
+        for (const auto successorId : block.successors) {
+            const auto &predecessors = graph.getBlock(successorId).predecessors;
+            const auto predecessorIndex = static_cast<std::size_t>(
+                std::ranges::find(predecessors, id) - predecessors.begin());
+            for (auto &phi : ssaForm.phis[successorId]) {
+                phi.args[predecessorIndex] = std::make_unique<VariableValue>(
+                    currentVersion(*getIndex(phi.variable)));
+            }
+        }
+        frames.emplace_back(std::move(frame));
+    };
+
+    enterBlock(CFG::getEntryId());
+    while (!frames.empty()) {
+        auto &frame = frames.back();
+        const auto &children = dominatorTree.getChildren(frame.id);
+        if (frame.nextChild < children.size()) {
+            enterBlock(children[frame.nextChild++]);
+            continue;
+        }
+        for (const auto index : frame.pushedVariables) {
+            versionStacks[index].pop_back();
+        }
+        frames.pop_back();
+    }
+    return ssaForm;
+}
+
+bool SSAForm::destructSSA(
+    SSAForm &&ssaForm, std::vector<std::unique_ptr<Instruction>> &functionBody,
+    std::vector<IntroducedVariable> &introducedVariables) {
+    auto &graph = ssaForm.cfg;
+    const auto &dominatorTree = ssaForm.dominatorTree;
+    const auto blockCount = graph.getBlocks().size();
+    bool changed = false;
+
+    // Number the names: each renamed variable, followed by its versions.
+    std::unordered_map<Symbol, std::size_t> nameIndices;
+    std::vector<Symbol> names;
+    std::vector<std::size_t> nameVariables;
+    std::vector<std::vector<std::size_t>> variableNames(
+        ssaForm.renamedVariables.size());
+    for (std::size_t index = 0; index < ssaForm.renamedVariables.size();
+         ++index) {
+        auto addName = [&](Symbol name) {
+            nameIndices.emplace(name, names.size());
+            variableNames[index].emplace_back(names.size());
+            names.emplace_back(name);
+            nameVariables.emplace_back(index);
+        };
+        addName(ssaForm.renamedVariables[index]);
+        for (const auto version : ssaForm.versions[index]) {
+            addName(version);
+        }
+    }
+    const auto nameCount = names.size();
+    auto getNameIndex = [&](const Value &value) -> std::optional<std::size_t> {
+        if (const auto *variableValue =
+                dynamic_cast<const VariableValue *>(&value)) {
+            auto it = nameIndices.find(variableValue->getSymbol());
+            if (it != nameIndices.end()) {
+                return it->second;
+            }
+        }
+        return std::nullopt;
+    };
+
+    // Solve the liveness of the names. The arguments of a phi node are read
+    // at the end of their predecessors (not on entry to the basic block of
+    // the phi node), and its destination is written on entry to its basic
+    // block.
+    std::vector<BitSet> edgeUses(blockCount, BitSet(nameCount));
+    for (const auto &block : graph.getBlocks()) {
+        for (const auto &phi : ssaForm.phis[block.id]) {
+            for (std::size_t k = 0; k < phi.args.size(); ++k) {
+                if (phi.args[k]) {
+                    if (auto index = getNameIndex(*phi.args[k])) {
+                        edgeUses[block.predecessors[k]].set(*index);
+                    }
+                }
+            }
+        }
+    }
+    auto transferInstruction = [&](const Instruction &instruction,
+                                   BitSet &live) {
+        if (const auto *dst = getDst(instruction)) {
+            if (auto index = getNameIndex(*dst)) {
+                live.reset(*index);
+            }
+        }
+        forEachSrc(instruction, [&](const Value &src) {
+            if (auto index = getNameIndex(src)) {
+                live.set(*index);
+            }
+        });
+    };
+    const auto liveOut = solveDataflow(
+        graph, DataflowDirection::Backward, DataflowMeet::Union,
+        BitSet(nameCount), [&](std::size_t id, const BitSet &out) {
+            auto live = out;
+            live.uniteWith(edgeUses[id]);
+            const auto &instructions = graph.getBlock(id).instructions;
+            for (auto it = instructions.rbegin(); it != instructions.rend();
+                 ++it) {
+                transferInstruction(**it, live);
+            }
+            for (const auto &phi : ssaForm.phis[id]) {
+                live.reset(nameIndices.at(phi.dst));
+            }
+            return live;
+        });
+
+    // Build the interference between the names of each variable: a name
+    // interferes with the other names of its variable live where it is
+    // defined, except for the source of the copy defining it (which holds
+    // the same value). Unreachable basic blocks never run, so they cannot
+    // cause interference.
+    std::vector<std::vector<std::size_t>> interferences(nameCount);
+    auto addInterferences = [&](std::size_t index, const BitSet &live,
+                                std::optional<std::size_t> copySrc) {
+        for (const auto other : variableNames[nameVariables[index]]) {
+            if (other != index && other != copySrc && live.test(other)) {
+                interferences[index].emplace_back(other);
+                interferences[other].emplace_back(index);
+            }
+        }
+    };
+    for (const auto &block : graph.getBlocks()) {
+        if (!dominatorTree.isReachable(block.id)) {
+            continue;
+        }
+        auto live = liveOut[block.id];
+        live.uniteWith(edgeUses[block.id]);
+        for (auto it = block.instructions.rbegin();
+             it != block.instructions.rend(); ++it) {
+            const auto &instruction = **it;
+            if (const auto *dst = getDst(instruction)) {
+                if (auto index = getNameIndex(*dst)) {
+                    std::optional<std::size_t> copySrc;
+                    if (instruction.getKind() == Instruction::Kind::Copy) {
+                        copySrc = getNameIndex(
+                            *static_cast<const CopyInstruction &>(instruction)
+                                 .getSrc());
+                    }
+                    addInterferences(*index, live, copySrc);
+                }
+            }
+            transferInstruction(instruction, live);
+        }
+        for (const auto &phi : ssaForm.phis[block.id]) {
+            addInterferences(nameIndices.at(phi.dst), live, std::nullopt);
+        }
+    }
+
+    // Coalesce the names of each variable by greedy coloring of their
+    // interference (in definition order, so that the variable itself gets
+    // the first color): color `0` is the variable itself, and color `k > 0`
+    // is a new variable.
+    std::vector<Symbol> coalescedNames(nameCount);
+    std::vector<std::optional<std::size_t>> colors(nameCount);
+    std::vector<std::size_t> colorCounts(ssaForm.renamedVariables.size(), 1);
+    std::unordered_map<Symbol, std::size_t> coalescedVariables;
+    std::vector<bool> used;
+    for (std::size_t index = 0; index < ssaForm.renamedVariables.size();
+         ++index) {
+        const auto variable = ssaForm.renamedVariables[index];
+        const auto &variableNameIndices = variableNames[index];
+        for (const auto nameIndex : variableNameIndices) {
+            used.assign(variableNameIndices.size() + 1, false);
+            for (const auto other : interferences[nameIndex]) {
+                if (colors[other]) {
+                    used[*colors[other]] = true;
+                }
+            }
+            std::size_t color = 0;
+            while (used[color]) {
+                ++color;
+            }
+            colors[nameIndex] = color;
+            if (color == 0) {
+                coalescedNames[nameIndex] = variable;
+            }
+            else {
+                coalescedNames[nameIndex] = makeVersionName(variable, color);
+                if (color >= colorCounts[index]) {
+                    for (auto k = colorCounts[index]; k <= color; ++k) {
+                        introducedVariables.emplace_back(IntroducedVariable{
+                            .variable = makeVersionName(variable, k),
+                            .original = variable});
+                    }
+                    colorCounts[index] = color + 1;
+                }
+                changed = true;
+            }
+            coalescedVariables.emplace(coalescedNames[nameIndex], index);
+        }
+    }
+    auto rename = [&](const Value &value) -> std::unique_ptr<Value> {
+        if (auto index = getNameIndex(value)) {
+            if (coalescedNames[*index] !=
+                static_cast<const VariableValue &>(value).getSymbol()) {
+                return std::make_unique<VariableValue>(coalescedNames[*index]);
+            }
+        }
+        return nullptr;
+    };
+
+    // Collect the parallel copy for the phi nodes of a basic block along the
+    // edge from one of its predecessors (the arguments already coalesced
+    // with their destinations need no copy).
+    auto collectCopies = [&](std::size_t predecessorId,
+                             std::size_t successorId) {
+        std::vector<ParallelCopy> copies;
+        const auto &successorPhis = ssaForm.phis[successorId];
+        if (successorPhis.empty()) {
+            return copies;
+        }
+        const auto &predecessors = graph.getBlock(successorId).predecessors;
+        const auto predecessorIndex = static_cast<std::size_t>(
+            std::ranges::find(predecessors, predecessorId) -
+            predecessors.begin());
+        for (const auto &phi : successorPhis) {
+            const auto &arg = phi.args[predecessorIndex];
+            if (!arg) {
+                continue;
+            }
+            const auto dst = coalescedNames[nameIndices.at(phi.dst)];
+            auto src = cloneValue(*arg);
+            if (auto renamed = rename(*src)) {
+                src = std::move(renamed);
+            }
+            if (const auto *srcVariable =
+                    dynamic_cast<const VariableValue *>(src.get());
+                srcVariable != nullptr && srcVariable->getSymbol() == dst) {
+                continue;
+            }
+            copies.emplace_back(
+                ParallelCopy{.dst = dst, .src = std::move(src)});
+        }
+        return copies;
+    };
+
+    // Sequentialize a parallel copy: emit the copies whose destinations are
+    // not read by the others first, and break the remaining cycles with a
+    // new variable holding the value of one destination.
+    auto emitCopies = [&](std::vector<ParallelCopy> copies,
+                          std::vector<std::unique_ptr<Instruction>> &output) {
+        auto isReadByOthers = [&copies](std::size_t index) {
+            for (std::size_t other = 0; other < copies.size(); ++other) {
+                const auto *srcVariable = dynamic_cast<const VariableValue *>(
+                    copies[other].src.get());
+                if (other != index && srcVariable != nullptr &&
+                    srcVariable->getSymbol() == copies[index].dst) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        while (!copies.empty()) {
+            bool emitted = false;
+            for (std::size_t index = 0; index < copies.size(); ++index) {
+                if (!isReadByOthers(index)) {
+                    output.emplace_back(std::make_unique<CopyInstruction>(
+                        std::move(copies[index].src),
+                        std::make_unique<VariableValue>(copies[index].dst)));
+                    copies.erase(copies.begin() +
+                                 static_cast<std::ptrdiff_t>(index));
+                    emitted = true;
+                    break;
+                }
+            }
+            if (emitted) {
+                continue;
+            }
+            const auto cycleDst = copies.front().dst;
+            const auto variableIndex = coalescedVariables.at(cycleDst);
+            const auto variable = ssaForm.renamedVariables[variableIndex];
+            const auto temporary =
+                makeVersionName(variable, colorCounts[variableIndex]++);
+            introducedVariables.emplace_back(IntroducedVariable{
+                .variable = temporary, .original = variable});
+            output.emplace_back(std::make_unique<CopyInstruction>(
+                std::make_unique<VariableValue>(cycleDst),
+                std::make_unique<VariableValue>(temporary)));
+            for (auto &copy : copies) {
+                const auto *srcVariable =
+                    dynamic_cast<const VariableValue *>(copy.src.get());
+                if (srcVariable != nullptr &&
+                    srcVariable->getSymbol() == cycleDst) {
+                    copy.src = std::make_unique<VariableValue>(temporary);
+                }
+            }
+        }
+        changed = true;
+    };
+
+    auto getLabel = [&](std::size_t id) {
+        const auto &instructions = graph.getBlock(id).instructions;
+        if (instructions.empty() ||
+            instructions.front()->getKind() != Instruction::Kind::Label) {
+            throw std::logic_error("Basic block with phi nodes reached by "
+                                   "fall-through has no label in destructSSA "
+                                   "in SSAForm");
+        }
+        return static_cast<const LabelInstruction &>(*instructions.front())
+            .getLabelSymbol();
+    };
+    std::unordered_set<Symbol> newLabels;
+    auto makeSplitLabel = [&](Symbol target) {
+        for (std::size_t k = 1;; ++k) {
+            const Symbol label(target.str() + ".ssa." + std::to_string(k));
+            if (!graph.getBlockIdForLabel(label) &&
+                !newLabels.contains(label)) {
+                newLabels.emplace(label);
+                return label;
+            }
+        }
+    };
+
+    // Emit the basic blocks in ID order with the coalesced names, placing the
+    // copies for the phi nodes on the edges; the basic blocks splitting
+    // critical edges go at the end of the function body.
+    functionBody.clear();
+    std::vector<std::unique_ptr<Instruction>> splitBlocks;
+    for (auto &block : graph.getBlocks()) {
+        auto &instructions = block.instructions;
+        for (auto &instruction : instructions) {
+            replaceSrcs(*instruction, rename);
+            if (const auto *dst = getDst(*instruction)) {
+                if (auto renamed = rename(*dst)) {
+                    replaceDst(*instruction, std::move(renamed));
+                }
+            }
+        }
+        // Drop the copies that coalescing has turned into self-copies.
+        std::erase_if(instructions, [&](const auto &instruction) {
+            if (instruction->getKind() != Instruction::Kind::Copy) {
+                return false;
+            }
+            const auto &copy =
+                static_cast<const CopyInstruction &>(*instruction);
+            const auto *src =
+                dynamic_cast<const VariableValue *>(copy.getSrc());
+            const bool isSelfCopy =
+                src != nullptr &&
+                src->getSymbol() ==
+                    static_cast<const VariableValue *>(copy.getDst())
+                        ->getSymbol();
+            changed = changed || isSelfCopy;
+            return isSelfCopy;
+        });
+
+        const auto kind = instructions.empty()
+                              ? std::optional<Instruction::Kind>()
+                              : instructions.back()->getKind();
+        if (kind == Instruction::Kind::JumpIfZero ||
+            kind == Instruction::Kind::JumpIfNotZero) {
+            auto &conditionalJump = *instructions.back();
+            const auto target =
+                kind == Instruction::Kind::JumpIfZero
+                    ? static_cast<JumpIfZeroInstruction &>(conditionalJump)
+                          .getTargetSymbol()
+                    : static_cast<JumpIfNotZeroInstruction &>(conditionalJump)
+                          .getTargetSymbol();
+            const auto targetId = *graph.getBlockIdForLabel(target);
+            auto fallThroughId = targetId;
+            for (const auto successorId : block.successors) {
+                if (successorId != targetId) {
+                    fallThroughId = successorId;
+                }
+            }
+            auto targetCopies = collectCopies(block.id, targetId);
+            auto fallThroughCopies = collectCopies(block.id, fallThroughId);
+            if (!targetCopies.empty()) {
+                // Split the edge to the target: jump to a new basic block
+                // that copies and then jumps to the target.
+                const auto splitLabel = makeSplitLabel(target);
+                if (kind == Instruction::Kind::JumpIfZero) {
+                    static_cast<JumpIfZeroInstruction &>(conditionalJump)
+                        .setTarget(splitLabel);
+                }
+                else {
+                    static_cast<JumpIfNotZeroInstruction &>(conditionalJump)
+                        .setTarget(splitLabel);
+                }
+                splitBlocks.emplace_back(
+                    std::make_unique<LabelInstruction>(splitLabel));
+                emitCopies(std::move(targetCopies), splitBlocks);
+                splitBlocks.emplace_back(
+                    std::make_unique<JumpInstruction>(target));
+            }
+            std::ranges::move(instructions, std::back_inserter(functionBody));
+            if (!fallThroughCopies.empty()) {
+                // Split the fall-through edge in place: copy, then jump to
+                // the basic block that used to be fallen through to.
+                emitCopies(std::move(fallThroughCopies), functionBody);
+                functionBody.emplace_back(
+                    std::make_unique<JumpInstruction>(getLabel(fallThroughId)));
+            }
+            continue;
+        }
+
+        std::unique_ptr<Instruction> jump;
+        if (kind == Instruction::Kind::Jump) {
+            jump = std::move(instructions.back());
+            instructions.pop_back();
+        }
+        std::ranges::move(instructions, std::back_inserter(functionBody));
+        if (block.successors.size() == 1) {
+            auto copies = collectCopies(block.id, block.successors.front());
+            if (!copies.empty()) {
+                emitCopies(std::move(copies), functionBody);
+            }
+        }
+        if (jump) {
+            functionBody.emplace_back(std::move(jump));
+        }
+    }
+    std::ranges::move(splitBlocks, std::back_inserter(functionBody));
+    return changed;
+}
+
+const CFG &SSAForm::getCFG() const { return cfg; }
+
+CFG &SSAForm::getCFG() { return cfg; }
+
+const DominatorTree &SSAForm::getDominatorTree() const {
+    return dominatorTree;
+}
+
+const std::vector<PhiNode> &SSAForm::getPhis(std::size_t id) const {
+    if (id >= phis.size()) {
+        throw std::logic_error("Out-of-range block ID in getPhis in SSAForm");
+    }
+    return phis[id];
+}
+
+std::vector<PhiNode> &SSAForm::getPhis(std::size_t id) {
+    if (id >= phis.size()) {
+        throw std::logic_error("Out-of-range block ID in getPhis in SSAForm");
+    }
+    return phis[id];
+}
+
+void SSAForm::removeEdge(std::size_t from, std::size_t to) {
+    const auto &predecessors = getCFG().getBlock(to).predecessors;
+    auto it = std::ranges::find(predecessors, from);
+    if (it == predecessors.end()) {
+        return;
+    }
+    const auto predecessorIndex = it - predecessors.begin();
+    for (auto &phi : phis[to]) {
+        phi.args.erase(phi.args.begin() + predecessorIndex);
+    }
+    cfg.removeEdge(from, to);
+}
+
+void SSAForm::removeBlock(std::size_t id) {
+    const auto successors = cfg.getBlock(id).successors;
+    for (const auto successorId : successors) {
+        removeEdge(id, successorId);
+    }
+    phis[id].clear();
+    cfg.removeBlock(id);
+}
+
+Symbol SSAForm::getOriginalVariable(Symbol variable) const {
+    auto it = originalVariables.find(variable);
+    return it == originalVariables.end() ? variable : it->second;
+}
+
+void registerIntroducedVariables(
+    const std::vector<IntroducedVariable> &introducedVariables,
+    AST::FrontendSymbolTable &frontendSymbolTable) {
+    for (const auto &[variable, original] : introducedVariables) {
+        auto it = frontendSymbolTable.find(original);
+        if (it == frontendSymbolTable.end()) {
+            throw std::logic_error(
+                "Registering variable introduced for unknown variable in "
+                "registerIntroducedVariables");
+        }
+        auto type = cloneVariableType(it->second.first.get());
+        frontendSymbolTable[variable] =
+            std::make_pair(std::move(type),
+                           std::make_unique<AST::LocalAttribute>());
+    }
+}
+
+const AST::Type *
+findVariableType(Symbol variable,
+                 const AST::FrontendSymbolTable &frontendSymbolTable,
+                 const IntroducedOriginals &introducedOriginals) {
+    // A variable can be introduced for another introduced variable.
+    while (true) {
+        auto it = frontendSymbolTable.find(variable);
+        if (it != frontendSymbolTable.end()) {
+            return it->second.first.get();
+        }
+        auto originalIt = introducedOriginals.find(variable);
+        if (originalIt == introducedOriginals.end()) {
+            return nullptr;
+        }
+        variable = originalIt->second;
+    }
+}
+} // namespace IR
@@ -0,0 +1,262 @@
+#ifndef MIDEND_SSA_H
+#define MIDEND_SSA_H
+
+#include "../frontend/frontendSymbolTable.h"
+#include "../utils/symbol.h"
+#include "cfg.h"
+#include "dominators.h"
+#include "ir.h"
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace IR {
+/**
+ * Structure representing a phi node of the SSA form: at the start of its
+ * basic block, `dst` takes the value of the argument for the predecessor the
+ * control came from.
+ */
+struct PhiNode {
+    /**
+     * The variable the phi node merges the versions of.
+     */
+    Symbol variable;
+    /**
+     * The version of the variable defined by the phi node.
+     */
+    Symbol dst;
+    /**
+     * The arguments of the phi node, one per predecessor of its basic block
+     * (in the order of `BasicBlock::predecessors`); an argument is `nullptr`
+     * if the value is undefined along its edge (e.g., from an unreachable
+     * predecessor).
+     */
+    std::vector<std::unique_ptr<Value>> args;
+};
+
+/**
+ * Structure representing a variable introduced by SSA destruction (when the
+ * versions of a variable cannot all be coalesced back into it), together with
+ * the variable whose type and storage duration it takes.
+ */
+struct IntroducedVariable {
+    Symbol variable;
+    Symbol original;
+};
+
+/**
+ * Map from the variables introduced while optimizing a function body (and
+ * not yet added to the frontend symbol table) to their original variables.
+ */
+using IntroducedOriginals = std::unordered_map<Symbol, Symbol>;
+
+/**
+ * Class representing an IR function body in static single assignment (SSA)
+ * form: a CFG in which every variable is defined at most once, plus the phi
+ * nodes of each basic block.
+ *
+ * Each non-static variable defined in the function body is renamed so that
+ * each of its definitions defines a new version `<variable>.ssa.<k>`; the
+ * value of the variable on entry to the function (e.g., a parameter) keeps the
+ * name of the variable itself. Static variables are not renamed, since any
+ * function call may read or write them. The phi nodes are kept next to the
+ * CFG rather than in the instructions, so that they never reach the
+ * backend.
+ *
+ * Passes written against the SSA form rewrite the CFG and the phi nodes in
+ * place between `constructSSA` and `destructSSA`.
+ */
+class SSAForm {
+  public:
+    /**
+     * Convert the given CFG into SSA form, taking ownership of it.
+     *
+     * Compute the dominator tree and dominance frontiers, insert phi nodes at
+     * the iterated dominance frontiers of the definitions of each variable
+     * (pruned to where the variable is live), and rename the variables along
+     * a preorder walk of the dominator tree. Unreachable basic blocks are
+     * left untouched.
+     *
+     * @param cfg The CFG to convert.
+     * @param frontendSymbolTable The frontend symbol table.
+     * @return The SSA form of the CFG.
+     */
+    [[nodiscard]] static SSAForm
+    constructSSA(CFG &&cfg,
+                 const AST::FrontendSymbolTable &frontendSymbolTable);
+
+    /**
+     * Convert the given SSA form back into a linear sequence of IR
+     * instructions, taking ownership of it.
+     *
+     * The versions of each variable are coalesced back into as few variables
+     * as their interference allows (the first one being the variable itself,
+     * so that an SSA form that has not been transformed translates back to
+     * the function body it was constructed from). Each phi node becomes a
+     * parallel copy on each incoming edge whose argument was not coalesced
+     * with its destination; the copies go at the end of the predecessor, or
+     * on a new basic block when the edge is critical.
+     *
+     * @param ssaForm The SSA form to convert.
+     * @param functionBody The function body to write the instructions to.
+     * @param introducedVariables The vector to append the variables
+     * introduced for versions that could not be coalesced to.
+     * @return True if the instructions differ from those the SSA form was
+     * constructed from (copies have been inserted or variables introduced),
+     * false otherwise.
+     * @throws std::logic_error if a basic block with phi nodes is reached by
+     * fall-through but does not start with a label.
+     */
+    static bool
+    destructSSA(SSAForm &&ssaForm,
+                std::vector<std::unique_ptr<Instruction>> &functionBody,
+                std::vector<IntroducedVariable> &introducedVariables);
+
+    /**
+     * Default destructor for the SSA form class.
+     */
+    ~SSAForm() = default;
+
+    /**
+     * Delete the copy constructor for the SSA form class.
+     */
+    SSAForm(const SSAForm &) = delete;
+
+    /**
+     * Delete the copy assignment operator for the SSA form class.
+     */
+    SSAForm &operator=(const SSAForm &) = delete;
+
+    /**
+     * Default move constructor for the SSA form class.
+     */
+    SSAForm(SSAForm &&) = default;
+
+    /**
+     * Default move assignment operator for the SSA form class.
+     */
+    SSAForm &operator=(SSAForm &&) = default;
+
+    [[nodiscard]] const CFG &getCFG() const;
+
+    [[nodiscard]] CFG &getCFG();
+
+    /**
+     * Get the dominator tree of the CFG (as it was when the SSA form was
+     * constructed).
+     *
+     * @return The dominator tree.
+     */
+    [[nodiscard]] const DominatorTree &getDominatorTree() const;
+
+    /**
+     * Get the phi nodes at the start of a basic block.
+     *
+     * @param id The ID of the basic block.
+     * @return The phi nodes.
+     * @throws std::logic_error if the ID is out of range.
+     */
+    [[nodiscard]] const std::vector<PhiNode> &getPhis(std::size_t id) const;
+
+    [[nodiscard]] std::vector<PhiNode> &getPhis(std::size_t id);
+
+    /**
+     * Remove an edge of the CFG, together with the arguments of the phi nodes
+     * of its destination for it.
+     *
+     * @param from The ID of the source node.
+     * @param to The ID of the destination node.
+     * @throws std::logic_error if either ID is out of range.
+     */
+    void removeEdge(std::size_t from, std::size_t to);
+
+    /**
+     * Remove a basic block of the CFG (see `CFG::removeBlock`), together with
+     * its phi nodes and the arguments of the phi nodes of its successors for
+     * it.
+     *
+     * @param id The ID of the basic block.
+     * @throws std::logic_error if the ID is out of range or is the entry or
+     * exit node.
+     */
+    void removeBlock(std::size_t id);
+
+    /**
+     * Get the variable a version belongs to (for its type and storage
+     * duration).
+     *
+     * @param variable The version (or any other variable).
+     * @return The variable the version belongs to, or `variable` itself if it
+     * is not a version.
+     */
+    [[nodiscard]] Symbol getOriginalVariable(Symbol variable) const;
+
+  private:
+    /**
+     * Constructor for the SSA form class (used by `constructSSA`).
+     */
+    explicit SSAForm(CFG &&cfg);
+
+    /**
+     * The CFG of the function body.
+     */
+    CFG cfg;
+    /**
+     * The dominator tree of the CFG.
+     */
+    DominatorTree dominatorTree;
+    /**
+     * The phi nodes of each basic block (indexed by ID).
+     */
+    std::vector<std::vector<PhiNode>> phis;
+    /**
+     * The variables that have been renamed, in the order they were first
+     * defined.
+     */
+    std::vector<Symbol> renamedVariables;
+    /**
+     * The versions of each renamed variable, in the order they were defined
+     * (indexed like `renamedVariables`).
+     */
+    std::vector<std::vector<Symbol>> versions;
+    /**
+     * The map from versions to the variables they belong to.
+     */
+    std::unordered_map<Symbol, Symbol> originalVariables;
+};
+
+/**
+ * Add the variables introduced by SSA destruction to the frontend symbol
+ * table, each with the type and storage duration of its original variable.
+ *
+ * The variables must be added in the order they were introduced, since a
+ * variable can be introduced for another introduced variable.
+ *
+ * @param introducedVariables The variables introduced by SSA destruction.
+ * @param frontendSymbolTable The frontend symbol table.
+ * @throws std::logic_error if an original variable is not in the frontend
+ * symbol table.
+ */
+void registerIntroducedVariables(
+    const std::vector<IntroducedVariable> &introducedVariables,
+    AST::FrontendSymbolTable &frontendSymbolTable);
+
+/**
+ * Find the type of a variable in the frontend symbol table, or, for a
+ * variable introduced while optimizing the function body, that of its
+ * original variable.
+ *
+ * @param variable The variable.
+ * @param frontendSymbolTable The frontend symbol table.
+ * @param introducedOriginals The original variables of the variables
+ * introduced while optimizing the function body.
+ * @return The type of the variable, or `nullptr` if it is unknown.
+ */
+const AST::Type *
+findVariableType(Symbol variable,
+                 const AST::FrontendSymbolTable &frontendSymbolTable,
+                 const IntroducedOriginals &introducedOriginals);
+} // namespace IR
+
+#endif // MIDEND_SSA_H
@@ -4,16 +4,21 @@
 #include "../backend/backendSymbolTable.h"
 #include "../backend/fixupPass.h"
 #include "../backend/pseudoToStackPass.h"
+#include "../frontend/astArena.h"
 #include "../frontend/frontendSymbolTable.h"
 #include "../frontend/lexer.h"
 #include "../frontend/parser.h"
 #include "../frontend/printVisitor.h"
 #include "../frontend/program.h"
 #include "../frontend/semanticAnalysisPasses.h"
+#include "../frontend/sourceBuffer.h"
+#include "../midend/flatIR.h"
 #include "../midend/ir.h"
 #include "../midend/irGenerator.h"
 #include "../midend/irOptimizationPasses.h"
 #include "../utils/constants.h"
+#include "threadPool.h"
+#include <cstddef>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -26,28 +31,15 @@
 #include <vector>
 
 std::vector<Token>
-PipelineStagesExecutors::lexerExecutor(std::string_view sourceFileName) {
-    std::ifstream sourceFileInputStream(std::string{sourceFileName});
-    if (sourceFileInputStream.fail()) {
-        std::stringstream msg;
-        msg << "Unable to open source file: " << sourceFileName;
-        throw std::ios_base::failure(msg.str());
-    }
-
-    // Read the entire source file into a string.
-    // The first iterator is an iterator that reads characters from the input
-    // stream.
-    // The second iterator is the (default-constructed) end-of-stream iterator.
-    // The string range-constructor reads characters from the input stream until
-    // the end-of-stream iterator is reached.
-    auto input =
-        std::string((std::istreambuf_iterator<char>(sourceFileInputStream)),
-                    std::istreambuf_iterator<char>());
-    sourceFileInputStream.close();
+PipelineStagesExecutors::lexerExecutor(const SourceBuffer &sourceBuffer,
+                                       bool useDFALexer) {
+    // The tokens view into the source buffer rather than owning copies of
+    // their lexemes.
+    const auto input = sourceBuffer.getContents();
 
     std::vector<Token> tokens;
     try {
-        tokens = lexer(input);
+        tokens = useDFALexer ? dfaLexer(input) : lexer(input);
         printTokens(tokens);
     } catch (const std::runtime_error &e) {
         std::stringstream msg;
@@ -60,12 +52,17 @@ PipelineStagesExecutors::lexerExecutor(std::string_view sourceFileName) {
 }
 
 std::unique_ptr<AST::Program>
-PipelineStagesExecutors::parserExecutor(const std::vector<Token> &tokens) {
+PipelineStagesExecutors::parserExecutor(const std::vector<Token> &tokens,
+                                        AST::ASTArena &astArena) {
     std::unique_ptr<AST::Program> program;
     try {
         AST::Parser parser(tokens);
-        // Parse the tokens to generate the AST program.
-        program = parser.parse();
+        // Parse the tokens to generate the AST program, allocating the AST
+        // nodes from the arena.
+        {
+            const AST::ASTArena::Scope astArenaScope(astArena);
+            program = parser.parse();
+        }
         AST::PrintVisitor printVisitor;
         std::cout << "\n";
         // Visit and print the AST program after parsing.
@@ -158,29 +155,66 @@ PipelineStagesExecutors::irGeneratorExecutor(
     return irProgramAndIRStaticVariables;
 }
 
-void PipelineStagesExecutors::irOptimizationExecutor(
-    IR::Program &irProgram, bool foldConstantsPass, bool propagateCopiesPass,
-    bool eliminateUnreachableCodePass, bool eliminateDeadStoresPass) {
+IR::OptimizationStatistics PipelineStagesExecutors::irOptimizationExecutor(
+    IR::Program &irProgram, AST::FrontendSymbolTable &frontendSymbolTable,
+    const IR::OptimizationOptions &optimizationOptions,
+    ThreadPool &threadPool) {
+    std::vector<IR::FunctionDefinition *> functionDefinitions;
     for (auto &topLevel : irProgram.getTopLevels()) {
         if (auto *functionDefinition =
                 dynamic_cast<IR::FunctionDefinition *>(topLevel.get())) {
-            // Extract the function body from the function definition, optimize
-            // the function body, and set the optimized function body back to
-            // the function definition.
-            const auto &functionBody = functionDefinition->getFunctionBody();
-            auto optimizedFunctionBody = IR::IROptimizer::irOptimize(
-                functionBody, foldConstantsPass, propagateCopiesPass,
-                eliminateUnreachableCodePass, eliminateDeadStoresPass);
-            functionDefinition->setFunctionBody(
-                std::move(optimizedFunctionBody));
+            functionDefinitions.emplace_back(functionDefinition);
         }
     }
+
+    // Optimize the function body of each function definition in place, each
+    // on its own task, and keep the statistics and the variables introduced
+    // by each task in its own slot (the symbol table is only read meanwhile).
+    std::vector<IR::OptimizationStatistics> functionStatistics(
+        functionDefinitions.size());
+    std::vector<std::vector<IR::IntroducedVariable>> introducedVariables(
+        functionDefinitions.size());
+    threadPool.parallelFor(
+        functionDefinitions.size(), [&](std::size_t index) {
+            functionStatistics[index] = IR::IROptimizer::irOptimize(
+                functionDefinitions[index]->getFunctionBody(),
+                frontendSymbolTable, optimizationOptions,
+                introducedVariables[index]);
+        });
+
+    // Accumulate the statistics and register the introduced variables in
+    // program order.
+    IR::OptimizationStatistics statistics;
+    for (std::size_t index = 0; index < functionDefinitions.size(); ++index) {
+        statistics.accumulate(functionStatistics[index]);
+        IR::registerIntroducedVariables(introducedVariables[index],
+                                        frontendSymbolTable);
+    }
+    return statistics;
+}
+
+void PipelineStagesExecutors::flatIRRoundTripExecutor(IR::Program &irProgram,
+                                                      ThreadPool &threadPool) {
+    std::vector<IR::FunctionDefinition *> functionDefinitions;
+    for (auto &topLevel : irProgram.getTopLevels()) {
+        if (auto *functionDefinition =
+                dynamic_cast<IR::FunctionDefinition *>(topLevel.get())) {
+            functionDefinitions.emplace_back(functionDefinition);
+        }
+    }
+    threadPool.parallelFor(
+        functionDefinitions.size(), [&](std::size_t index) {
+            auto &functionBody = functionDefinitions[index]->getFunctionBody();
+            const IR::FlatFunctionBody flatFunctionBody(functionBody);
+            functionBody = std::move(*flatFunctionBody.toInstructions());
+        });
 }
 
 std::unique_ptr<Assembly::Program> PipelineStagesExecutors::codegenExecutor(
     const IR::Program &irProgram,
     const std::vector<std::unique_ptr<IR::StaticVariable>> &irStaticVariables,
-    const AST::FrontendSymbolTable &frontendSymbolTable) {
+    const AST::FrontendSymbolTable &frontendSymbolTable,
+    ThreadPool &threadPool) {
     std::unique_ptr<Assembly::Program> assemblyProgram;
     try {
         // Convert the frontend symbol table to backend symbol table before
@@ -193,16 +227,18 @@ std::unique_ptr<Assembly::Program> PipelineStagesExecutors::codegenExecutor(
         Assembly::AssemblyGenerator assemblyGenerator(irStaticVariables,
                                                       frontendSymbolTable);
         // Generate the assembly program from the IR program.
-        assemblyProgram = assemblyGenerator.generateAssembly(irProgram);
+        assemblyProgram =
+            assemblyGenerator.generateAssembly(irProgram, threadPool);
 
-        Assembly::PseudoToStackPass pseudoToStackPass;
-        // Associate the stack size with each top-level element.
+        // Associate the stack size with each top-level element. The backend
+        // symbol table is shared read-only by the function definitions.
         auto &topLevels = assemblyProgram->getTopLevels();
-        pseudoToStackPass.replacePseudoWithStackAndAssociateStackSize(
-            topLevels, backendSymbolTable);
+        Assembly::PseudoToStackPass::
+            replacePseudoWithStackAndAssociateStackSize(
+                topLevels, backendSymbolTable, threadPool);
 
         // Fix up the assembly program.
-        Assembly::FixupPass::fixup(topLevels);
+        Assembly::FixupPass::fixup(topLevels, threadPool);
     } catch (const std::runtime_error &e) {
         std::stringstream msg;
         msg << "Code generation error in codegenExecutor in "
@@ -365,81 +401,94 @@ void PipelineStagesExecutors::emitAssyStaticVariable(
 void PipelineStagesExecutors::emitAssyInstruction(
     const Assembly::Instruction &instruction,
     std::ofstream &assemblyFileStream) {
-    if (const auto *movInstruction =
-            dynamic_cast<const Assembly::MovInstruction *>(&instruction)) {
-        emitAssyMovInstruction(*movInstruction, assemblyFileStream);
-    }
-    else if (dynamic_cast<const Assembly::RetInstruction *>(&instruction) !=
-             nullptr) {
+    switch (instruction.getKind()) {
+    case Assembly::Instruction::Kind::Mov:
+        emitAssyMovInstruction(
+            static_cast<const Assembly::MovInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Movsx:
+        emitAssyMovsxInstruction(
+            static_cast<const Assembly::MovsxInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Unary:
+        emitAssyUnaryInstruction(
+            static_cast<const Assembly::UnaryInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Binary:
+        emitAssyBinaryInstruction(
+            static_cast<const Assembly::BinaryInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Cmp:
+        emitAssyCmpInstruction(
+            static_cast<const Assembly::CmpInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Idiv:
+        emitAssyIdivInstruction(
+            static_cast<const Assembly::IdivInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Div:
+        emitAssyDivInstruction(
+            static_cast<const Assembly::DivInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Imul:
+        emitAssyImulInstruction(
+            static_cast<const Assembly::ImulInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Mul:
+        emitAssyMulInstruction(
+            static_cast<const Assembly::MulInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Cdq:
+        emitAssyCdqInstruction(
+            static_cast<const Assembly::CdqInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Jmp:
+        emitAssyJmpInstruction(
+            static_cast<const Assembly::JmpInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::JmpCC:
+        emitAssyJmpCCInstruction(
+            static_cast<const Assembly::JmpCCInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::SetCC:
+        emitAssySetCCInstruction(
+            static_cast<const Assembly::SetCCInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Label:
+        emitAssyLabelInstruction(
+            static_cast<const Assembly::LabelInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Push:
+        emitAssyPushInstruction(
+            static_cast<const Assembly::PushInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Call:
+        emitAssyCallInstruction(
+            static_cast<const Assembly::CallInstruction &>(instruction),
+            assemblyFileStream);
+        break;
+    case Assembly::Instruction::Kind::Ret:
         emitAssyRetInstruction(assemblyFileStream);
-    }
-    else if (const auto *pushInstruction =
-                 dynamic_cast<const Assembly::PushInstruction *>(
-                     &instruction)) {
-        emitAssyPushInstruction(*pushInstruction, assemblyFileStream);
-    }
-    else if (const auto *callInstruction =
-                 dynamic_cast<const Assembly::CallInstruction *>(
-                     &instruction)) {
-        emitAssyCallInstruction(*callInstruction, assemblyFileStream);
-    }
-    else if (const auto *unaryInstruction =
-                 dynamic_cast<const Assembly::UnaryInstruction *>(
-                     &instruction)) {
-        emitAssyUnaryInstruction(*unaryInstruction, assemblyFileStream);
-    }
-    else if (const auto *binaryInstruction =
-                 dynamic_cast<const Assembly::BinaryInstruction *>(
-                     &instruction)) {
-        emitAssyBinaryInstruction(*binaryInstruction, assemblyFileStream);
-    }
-    else if (const auto *cmpInstruction =
-                 dynamic_cast<const Assembly::CmpInstruction *>(&instruction)) {
-        emitAssyCmpInstruction(*cmpInstruction, assemblyFileStream);
-    }
-    else if (const auto *idivInstruction =
-                 dynamic_cast<const Assembly::IdivInstruction *>(
-                     &instruction)) {
-        emitAssyIdivInstruction(*idivInstruction, assemblyFileStream);
-    }
-    else if (const auto *divInstruction =
-                 dynamic_cast<const Assembly::DivInstruction *>(&instruction)) {
-        emitAssyDivInstruction(*divInstruction, assemblyFileStream);
-    }
-    else if (const auto *movsxInstruction =
-                 dynamic_cast<const Assembly::MovsxInstruction *>(
-                     &instruction)) {
-        emitAssyMovsxInstruction(*movsxInstruction, assemblyFileStream);
-    }
-    else if (const auto *cdqInstruction =
-                 dynamic_cast<const Assembly::CdqInstruction *>(&instruction)) {
-        emitAssyCdqInstruction(*cdqInstruction, assemblyFileStream);
-    }
-    else if (const auto *jmpInstruction =
-                 dynamic_cast<const Assembly::JmpInstruction *>(&instruction)) {
-        emitAssyJmpInstruction(*jmpInstruction, assemblyFileStream);
-    }
-    else if (const auto *jmpCCInstruction =
-                 dynamic_cast<const Assembly::JmpCCInstruction *>(
-                     &instruction)) {
-        emitAssyJmpCCInstruction(*jmpCCInstruction, assemblyFileStream);
-    }
-    else if (const auto *setCCInstruction =
-                 dynamic_cast<const Assembly::SetCCInstruction *>(
-                     &instruction)) {
-        emitAssySetCCInstruction(*setCCInstruction, assemblyFileStream);
-    }
-    else if (const auto *labelInstruction =
-                 dynamic_cast<const Assembly::LabelInstruction *>(
-                     &instruction)) {
-        emitAssyLabelInstruction(*labelInstruction, assemblyFileStream);
-    }
-    else {
-        const auto &r = *&instruction;
+        break;
+    default:
         throw std::logic_error(
             "Unsupported instruction type while printing assembly instruction "
-            "in emitAssyInstruction in PipelineStagesExecutors: " +
-            std::string(typeid(r).name()));
+            "in emitAssyInstruction in PipelineStagesExecutors");
     }
 }
 
@@ -465,60 +514,10 @@ void PipelineStagesExecutors::emitAssyMovInstruction(
     }
 
     const auto *src = movInstruction.getSrc();
-    std::string srcStr;
-    if (const auto *srcReg =
-            dynamic_cast<const Assembly::RegisterOperand *>(src)) {
-        srcStr = srcReg->getRegisterInBytesInStr(registerSize);
-    }
-    else if (const auto *srcImm =
-                 dynamic_cast<const Assembly::ImmediateOperand *>(src)) {
-        srcStr =
-            "$" + std::to_string(static_cast<long>(srcImm->getImmediate()));
-    }
-    else if (const auto *srcStack =
-                 dynamic_cast<const Assembly::StackOperand *>(src)) {
-        srcStr = std::to_string(srcStack->getOffset()) + "(" +
-                 srcStack->getReservedRegisterInStr() + ")";
-    }
-    else if (const auto *srcData =
-                 dynamic_cast<const Assembly::DataOperand *>(src)) {
-        auto identifier = srcData->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        srcStr = identifier + "(%rip)";
-    }
-    else {
-        const auto &r = *src;
-        throw std::logic_error(
-            "Unsupported source type while printing assembly mov instruction "
-            "in emitAssyMovInstruction in PipelineStagesExecutors: " +
-            std::string(typeid(r).name()));
-    }
+    const auto srcStr = formatAssyOperand(*src, registerSize);
 
     const auto *dst = movInstruction.getDst();
-    std::string dstStr;
-    if (const auto *dstReg =
-            dynamic_cast<const Assembly::RegisterOperand *>(dst)) {
-        dstStr = dstReg->getRegisterInBytesInStr(registerSize);
-    }
-    else if (const auto *dstStack =
-                 dynamic_cast<const Assembly::StackOperand *>(dst)) {
-        dstStr = std::to_string(dstStack->getOffset()) + "(" +
-                 dstStack->getReservedRegisterInStr() + ")";
-    }
-    else if (const auto *dstData =
-                 dynamic_cast<const Assembly::DataOperand *>(dst)) {
-        auto identifier = dstData->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        dstStr = identifier + "(%rip)";
-    }
-    else {
-        const auto &r = *dst;
-        throw std::logic_error(
-            "Unsupported destination type while printing assembly mov "
-            "instruction in emitAssyMovInstruction in "
-            "PipelineStagesExecutors: " +
-            std::string(typeid(r).name()));
-    }
+    const auto dstStr = formatAssyOperand(*dst, registerSize);
 
     assemblyFileStream << "    " << instructionName << " " << srcStr << ", "
                        << dstStr << "\n";
@@ -528,56 +527,10 @@ void PipelineStagesExecutors::emitAssyMovsxInstruction(
     const Assembly::MovsxInstruction &movsxInstruction,
     std::ofstream &assemblyFileStream) {
     const auto *src = movsxInstruction.getSrc();
-    std::string srcStr;
-    if (const auto *srcReg =
-            dynamic_cast<const Assembly::RegisterOperand *>(src)) {
-        srcStr = srcReg->getRegisterInBytesInStr(4);
-    }
-    else if (const auto *srcImm =
-                 dynamic_cast<const Assembly::ImmediateOperand *>(src)) {
-        srcStr =
-            "$" + std::to_string(static_cast<long>(srcImm->getImmediate()));
-    }
-    else if (const auto *srcStack =
-                 dynamic_cast<const Assembly::StackOperand *>(src)) {
-        srcStr = std::to_string(srcStack->getOffset()) + "(" +
-                 srcStack->getReservedRegisterInStr() + ")";
-    }
-    else if (const auto *srcData =
-                 dynamic_cast<const Assembly::DataOperand *>(src)) {
-        auto identifier = srcData->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        srcStr = identifier + "(%rip)";
-    }
-    else {
-        throw std::logic_error(
-            "Unsupported source type while printing assembly movsx instruction "
-            "in emitAssyMovsxInstruction in PipelineStagesExecutors");
-    }
+    const auto srcStr = formatAssyOperand(*src, LONGWORD_SIZE);
 
     const auto *dst = movsxInstruction.getDst();
-    std::string dstStr;
-    if (const auto *dstReg =
-            dynamic_cast<const Assembly::RegisterOperand *>(dst)) {
-        dstStr = dstReg->getRegisterInBytesInStr(QUADWORD_SIZE);
-    }
-    else if (const auto *dstStack =
-                 dynamic_cast<const Assembly::StackOperand *>(dst)) {
-        dstStr = std::to_string(dstStack->getOffset()) + "(" +
-                 dstStack->getReservedRegisterInStr() + ")";
-    }
-    else if (const auto *dstData =
-                 dynamic_cast<const Assembly::DataOperand *>(dst)) {
-        auto identifier = dstData->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        dstStr = identifier + "(%rip)";
-    }
-    else {
-        throw std::logic_error(
-            "Unsupported destination type while printing assembly movsx "
-            "instruction in emitAssyMovsxInstruction in "
-            "PipelineStagesExecutors");
-    }
+    const auto dstStr = formatAssyOperand(*dst, QUADWORD_SIZE);
 
     assemblyFileStream << "    movslq " << srcStr << ", " << dstStr << "\n";
 }
@@ -596,34 +549,8 @@ void PipelineStagesExecutors::emitAssyPushInstruction(
     std::ofstream &assemblyFileStream) {
     const auto *operand = pushInstruction.getOperand();
 
-    if (const auto *stackOperand =
-            dynamic_cast<const Assembly::StackOperand *>(operand)) {
-        assemblyFileStream << "    pushq " << stackOperand->getOffset() << "("
-                           << stackOperand->getReservedRegisterInStr() << ")\n";
-    }
-    else if (const auto *regOperand =
-                 dynamic_cast<const Assembly::RegisterOperand *>(operand)) {
-        assemblyFileStream << "    pushq "
-                           << regOperand->getRegisterInBytesInStr(QUADWORD_SIZE)
-                           << "\n";
-    }
-    else if (const auto *immOperand =
-                 dynamic_cast<const Assembly::ImmediateOperand *>(operand)) {
-        assemblyFileStream << "    pushq $"
-                           << static_cast<long>(immOperand->getImmediate())
-                           << "\n";
-    }
-    else if (const auto *dataOperand =
-                 dynamic_cast<const Assembly::DataOperand *>(operand)) {
-        auto identifier = dataOperand->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        assemblyFileStream << "    pushq " << identifier << "(%rip)\n";
-    }
-    else {
-        throw std::logic_error(
-            "Unsupported operand type while printing assembly push instruction "
-            "in emitAssyPushInstruction in PipelineStagesExecutors");
-    }
+    assemblyFileStream << "    pushq "
+                       << formatAssyOperand(*operand, QUADWORD_SIZE) << "\n";
 }
 
 void PipelineStagesExecutors::emitAssyCallInstruction(
@@ -683,31 +610,8 @@ void PipelineStagesExecutors::emitAssyUnaryInstruction(
     assemblyFileStream << "    " << instructionName << typeSuffix;
 
     const auto *operand = unaryInstruction.getOperand();
-    if (const auto *regOperand =
-            dynamic_cast<const Assembly::RegisterOperand *>(operand)) {
-        assemblyFileStream << " "
-                           << regOperand->getRegisterInBytesInStr(registerSize)
-                           << "\n";
-    }
-    else if (const auto *stackOperand =
-                 dynamic_cast<const Assembly::StackOperand *>(operand)) {
-        assemblyFileStream << " " << stackOperand->getOffset() << "("
-                           << stackOperand->getReservedRegisterInStr() << ")\n";
-    }
-    else if (const auto *dataOperand =
-                 dynamic_cast<const Assembly::DataOperand *>(operand)) {
-        auto identifier = dataOperand->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        assemblyFileStream << " " << identifier << "(%rip)\n";
-    }
-    else {
-        const auto &r = *operand;
-        throw std::logic_error(
-            "Unsupported operand type while printing assembly unary "
-            "instruction in emitAssyUnaryInstruction in "
-            "PipelineStagesExecutors: " +
-            std::string(typeid(r).name()));
-    }
+    assemblyFileStream << " " << formatAssyOperand(*operand, registerSize)
+                       << "\n";
 }
 
 void PipelineStagesExecutors::emitAssyBinaryInstruction(
@@ -729,6 +633,22 @@ void PipelineStagesExecutors::emitAssyBinaryInstruction(
              nullptr) {
         instructionName = "imul";
     }
+    else if (dynamic_cast<const Assembly::SalOperator *>(binaryOperator) !=
+             nullptr) {
+        instructionName = "sal";
+    }
+    else if (dynamic_cast<const Assembly::SarOperator *>(binaryOperator) !=
+             nullptr) {
+        instructionName = "sar";
+    }
+    else if (dynamic_cast<const Assembly::ShrOperator *>(binaryOperator) !=
+             nullptr) {
+        instructionName = "shr";
+    }
+    else if (dynamic_cast<const Assembly::LeaOperator *>(binaryOperator) !=
+             nullptr) {
+        instructionName = "lea";
+    }
     else {
         throw std::logic_error("Unsupported binary operator while printing "
                                "assembly binary instruction");
@@ -750,60 +670,34 @@ void PipelineStagesExecutors::emitAssyBinaryInstruction(
             "emitAssyBinaryInstruction in PipelineStagesExecutors");
     }
 
-    assemblyFileStream << "    " << instructionName << typeSuffix;
-
     const auto *operand1 = binaryInstruction.getOperand1();
-    if (const auto *operand1Imm =
-            dynamic_cast<const Assembly::ImmediateOperand *>(operand1)) {
-        assemblyFileStream << " $"
-                           << static_cast<long>(operand1Imm->getImmediate())
-                           << ",";
-    }
-    else if (const auto *operand1Reg =
-                 dynamic_cast<const Assembly::RegisterOperand *>(operand1)) {
-        assemblyFileStream << " "
-                           << operand1Reg->getRegisterInBytesInStr(registerSize)
-                           << ",";
-    }
-    else if (const auto *operand1Stack =
-                 dynamic_cast<const Assembly::StackOperand *>(operand1)) {
-        assemblyFileStream << " " << operand1Stack->getOffset() << "("
-                           << operand1Stack->getReservedRegisterInStr() << "),";
-    }
-    else if (const auto *operand1Data =
-                 dynamic_cast<const Assembly::DataOperand *>(operand1)) {
-        auto identifier = operand1Data->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        assemblyFileStream << " " << identifier << "(%rip),";
-    }
-
     const auto *operand2 = binaryInstruction.getOperand2();
-    if (const auto *operand2Reg =
-            dynamic_cast<const Assembly::RegisterOperand *>(operand2)) {
-        assemblyFileStream << " "
-                           << operand2Reg->getRegisterInBytesInStr(registerSize)
+    if (const auto *leaOperator =
+            dynamic_cast<const Assembly::LeaOperator *>(binaryOperator)) {
+        if (operand1->getKind() != Assembly::Operand::Kind::Register ||
+            operand2->getKind() != Assembly::Operand::Kind::Register) {
+            throw std::logic_error(
+                "Non-register operand while printing assembly lea "
+                "instruction in emitAssyBinaryInstruction in "
+                "PipelineStagesExecutors");
+        }
+        // The address is computed with the 8-byte registers.
+        assemblyFileStream << "    " << instructionName << typeSuffix << " ("
+                           << formatAssyOperand(*operand2, QUADWORD_SIZE)
+                           << ","
+                           << formatAssyOperand(*operand1, QUADWORD_SIZE)
+                           << "," << leaOperator->getScale() << "), "
+                           << formatAssyOperand(*operand2, registerSize)
                            << "\n";
+        return;
     }
-    else if (const auto *operand2Stack =
-                 dynamic_cast<const Assembly::StackOperand *>(operand2)) {
-        assemblyFileStream << " " << operand2Stack->getOffset() << "("
-                           << operand2Stack->getReservedRegisterInStr()
-                           << ")\n";
-    }
-    else if (const auto *operand2Data =
-                 dynamic_cast<const Assembly::DataOperand *>(operand2)) {
-        auto identifier = operand2Data->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        assemblyFileStream << " " << identifier << "(%rip)\n";
-    }
-    else {
-        const auto &r = *operand2;
-        throw std::logic_error(
-            "Unsupported operand type while printing assembly binary "
-            "instruction in emitAssyBinaryInstruction in "
-            "PipelineStagesExecutors: " +
-            std::string(typeid(r).name()));
-    }
+
+    assemblyFileStream << "    " << instructionName << typeSuffix;
+    assemblyFileStream << " " << formatAssyOperand(*operand1, registerSize)
+                       << ",";
+
+    assemblyFileStream << " " << formatAssyOperand(*operand2, registerSize)
+                       << "\n";
 }
 
 void PipelineStagesExecutors::emitAssyCmpInstruction(
@@ -830,57 +724,13 @@ void PipelineStagesExecutors::emitAssyCmpInstruction(
     assemblyFileStream << "    cmp" << typeSuffix;
 
     const auto *operand1 = cmpInstruction.getOperand1();
-    if (const auto *operand1Imm =
-            dynamic_cast<const Assembly::ImmediateOperand *>(operand1)) {
-        assemblyFileStream << " $"
-                           << static_cast<long>(operand1Imm->getImmediate());
-    }
-    else if (const auto *operand1Reg =
-                 dynamic_cast<const Assembly::RegisterOperand *>(operand1)) {
-        assemblyFileStream << " "
-                           << operand1Reg->getRegisterInBytesInStr(
-                                  registerSize);
-    }
-    else if (const auto *operand1Stack =
-                 dynamic_cast<const Assembly::StackOperand *>(operand1)) {
-        assemblyFileStream << " " << operand1Stack->getOffset() << "("
-                           << operand1Stack->getReservedRegisterInStr() << ")";
-    }
-    else if (const auto *operand1Data =
-                 dynamic_cast<const Assembly::DataOperand *>(operand1)) {
-        auto identifier = operand1Data->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        assemblyFileStream << " " << identifier << "(%rip)";
-    }
+    assemblyFileStream << " " << formatAssyOperand(*operand1, registerSize);
 
     assemblyFileStream << ",";
 
     const auto *operand2 = cmpInstruction.getOperand2();
-    if (const auto *operand2Reg =
-            dynamic_cast<const Assembly::RegisterOperand *>(operand2)) {
-        assemblyFileStream << " "
-                           << operand2Reg->getRegisterInBytesInStr(registerSize)
-                           << "\n";
-    }
-    else if (const auto *operand2Stack =
-                 dynamic_cast<const Assembly::StackOperand *>(operand2)) {
-        assemblyFileStream << " " << operand2Stack->getOffset() << "("
-                           << operand2Stack->getReservedRegisterInStr()
-                           << ")\n";
-    }
-    else if (const auto *operand2Data =
-                 dynamic_cast<const Assembly::DataOperand *>(operand2)) {
-        auto identifier = operand2Data->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        assemblyFileStream << " " << identifier << "(%rip)\n";
-    }
-    else {
-        const auto &r = *operand2;
-        throw std::logic_error(
-            "Unsupported operand type while printing assembly cmp instruction "
-            "in emitAssyCmpInstruction in PipelineStagesExecutors: " +
-            std::string(typeid(r).name()));
-    }
+    assemblyFileStream << " " << formatAssyOperand(*operand2, registerSize)
+                       << "\n";
 }
 
 void PipelineStagesExecutors::emitAssyIdivInstruction(
@@ -907,30 +757,8 @@ void PipelineStagesExecutors::emitAssyIdivInstruction(
     assemblyFileStream << "    idiv" << typeSuffix;
 
     const auto *operand = idivInstruction.getOperand();
-    if (const auto *regOperand =
-            dynamic_cast<const Assembly::RegisterOperand *>(operand)) {
-        assemblyFileStream << " "
-                           << regOperand->getRegisterInBytesInStr(registerSize)
-                           << "\n";
-    }
-    else if (const auto *stackOperand =
-                 dynamic_cast<const Assembly::StackOperand *>(operand)) {
-        assemblyFileStream << " " << stackOperand->getOffset() << "("
-                           << stackOperand->getReservedRegisterInStr() << ")\n";
-    }
-    else if (const auto *dataOperand =
-                 dynamic_cast<const Assembly::DataOperand *>(operand)) {
-        auto identifier = dataOperand->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        assemblyFileStream << " " << identifier << "(%rip)\n";
-    }
-    else {
-        const auto &r = *operand;
-        throw std::logic_error(
-            "Unsupported operand type while printing assembly idiv instruction "
-            "in emitAssyIdivInstruction in PipelineStagesExecutors: " +
-            std::string(typeid(r).name()));
-    }
+    assemblyFileStream << " " << formatAssyOperand(*operand, registerSize)
+                       << "\n";
 }
 
 void PipelineStagesExecutors::emitAssyDivInstruction(
@@ -957,30 +785,64 @@ void PipelineStagesExecutors::emitAssyDivInstruction(
     assemblyFileStream << "    div" << typeSuffix;
 
     const auto *operand = divInstruction.getOperand();
-    if (const auto *regOperand =
-            dynamic_cast<const Assembly::RegisterOperand *>(operand)) {
-        assemblyFileStream << " "
-                           << regOperand->getRegisterInBytesInStr(registerSize)
-                           << "\n";
+    assemblyFileStream << " " << formatAssyOperand(*operand, registerSize)
+                       << "\n";
+}
+
+void PipelineStagesExecutors::emitAssyImulInstruction(
+    const Assembly::ImulInstruction &imulInstruction,
+    std::ofstream &assemblyFileStream) {
+    const auto *type = imulInstruction.getType();
+
+    std::string typeSuffix;
+    int registerSize = 0;
+    if (dynamic_cast<const Assembly::Longword *>(type) != nullptr) {
+        typeSuffix = "l";
+        registerSize = LONGWORD_SIZE;
+    }
+    else if (dynamic_cast<const Assembly::Quadword *>(type) != nullptr) {
+        typeSuffix = "q";
+        registerSize = QUADWORD_SIZE;
     }
-    else if (const auto *stackOperand =
-                 dynamic_cast<const Assembly::StackOperand *>(operand)) {
-        assemblyFileStream << " " << stackOperand->getOffset() << "("
-                           << stackOperand->getReservedRegisterInStr() << ")\n";
+    else {
+        throw std::logic_error(
+            "Unsupported type while printing assembly imul instruction in "
+            "emitAssyImulInstruction in PipelineStagesExecutors");
     }
-    else if (const auto *dataOperand =
-                 dynamic_cast<const Assembly::DataOperand *>(operand)) {
-        auto identifier = dataOperand->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        assemblyFileStream << " " << identifier << "(%rip)\n";
+
+    assemblyFileStream << "    imul" << typeSuffix;
+
+    const auto *operand = imulInstruction.getOperand();
+    assemblyFileStream << " " << formatAssyOperand(*operand, registerSize)
+                       << "\n";
+}
+
+void PipelineStagesExecutors::emitAssyMulInstruction(
+    const Assembly::MulInstruction &mulInstruction,
+    std::ofstream &assemblyFileStream) {
+    const auto *type = mulInstruction.getType();
+
+    std::string typeSuffix;
+    int registerSize = 0;
+    if (dynamic_cast<const Assembly::Longword *>(type) != nullptr) {
+        typeSuffix = "l";
+        registerSize = LONGWORD_SIZE;
+    }
+    else if (dynamic_cast<const Assembly::Quadword *>(type) != nullptr) {
+        typeSuffix = "q";
+        registerSize = QUADWORD_SIZE;
     }
     else {
-        const auto &r = *operand;
         throw std::logic_error(
-            "Unsupported operand type while printing assembly div instruction "
-            "in emitAssyDivInstruction in PipelineStagesExecutors: " +
-            std::string(typeid(r).name()));
+            "Unsupported type while printing assembly mul instruction in "
+            "emitAssyMulInstruction in PipelineStagesExecutors");
     }
+
+    assemblyFileStream << "    mul" << typeSuffix;
+
+    const auto *operand = mulInstruction.getOperand();
+    assemblyFileStream << " " << formatAssyOperand(*operand, registerSize)
+                       << "\n";
 }
 
 void PipelineStagesExecutors::emitAssyCdqInstruction(
@@ -1095,30 +957,7 @@ void PipelineStagesExecutors::emitAssySetCCInstruction(
     }
 
     const auto *operand = setCCInstruction.getOperand();
-    if (const auto *regOperand =
-            dynamic_cast<const Assembly::RegisterOperand *>(operand)) {
-        assemblyFileStream << " " << regOperand->getRegisterInBytesInStr(1)
-                           << "\n";
-    }
-    else if (const auto *stackOperand =
-                 dynamic_cast<const Assembly::StackOperand *>(operand)) {
-        assemblyFileStream << " " << stackOperand->getOffset() << "("
-                           << stackOperand->getReservedRegisterInStr() << ")\n";
-    }
-    else if (const auto *dataOperand =
-                 dynamic_cast<const Assembly::DataOperand *>(operand)) {
-        auto identifier = dataOperand->getIdentifier();
-        prependUnderscoreToIdentifierIfMacOS(identifier);
-        assemblyFileStream << " " << identifier << "(%rip)\n";
-    }
-    else {
-        const auto &r = *operand;
-        throw std::logic_error(
-            "Unsupported operand type while printing assembly setcc "
-            "instruction in emitAssySetCCInstruction in "
-            "PipelineStagesExecutors: " +
-            std::string(typeid(r).name()));
-    }
+    assemblyFileStream << " " << formatAssyOperand(*operand, 1) << "\n";
 }
 
 void PipelineStagesExecutors::emitAssyLabelInstruction(
@@ -1128,6 +967,36 @@ void PipelineStagesExecutors::emitAssyLabelInstruction(
     assemblyFileStream << ".L" << label << ":\n";
 }
 
+std::string PipelineStagesExecutors::formatAssyOperand(
+    const Assembly::Operand &operand, int registerSize) {
+    switch (operand.getKind()) {
+    case Assembly::Operand::Kind::Immediate:
+        return "$" +
+               std::to_string(static_cast<long>(
+                   static_cast<const Assembly::ImmediateOperand &>(operand)
+                       .getImmediate()));
+    case Assembly::Operand::Kind::Register:
+        return static_cast<const Assembly::RegisterOperand &>(operand)
+            .getRegisterInBytesInStr(registerSize);
+    case Assembly::Operand::Kind::Stack: {
+        const auto &stackOperand =
+            static_cast<const Assembly::StackOperand &>(operand);
+        return std::to_string(stackOperand.getOffset()) + "(" +
+               stackOperand.getReservedRegisterInStr() + ")";
+    }
+    case Assembly::Operand::Kind::Data: {
+        auto identifier =
+            static_cast<const Assembly::DataOperand &>(operand).getIdentifier();
+        prependUnderscoreToIdentifierIfMacOS(identifier);
+        return identifier + "(%rip)";
+    }
+    default:
+        throw std::logic_error(
+            "Unsupported operand type while printing assembly operand in "
+            "formatAssyOperand in PipelineStagesExecutors");
+    }
+}
+
 void PipelineStagesExecutors::prependUnderscoreToIdentifierIfMacOS(
     [[maybe_unused]] std::string &identifier) {
 // If the underlying OS is macOS, prepend an underscore to the function name.
@@ -2,10 +2,14 @@
 #define UTILS_PIPELINE_STAGES_EXECUTORS_H
 
 #include "../backend/assembly.h"
+#include "../frontend/astArena.h"
 #include "../frontend/frontendSymbolTable.h"
 #include "../frontend/lexer.h"
 #include "../frontend/program.h"
+#include "../frontend/sourceBuffer.h"
 #include "../midend/ir.h"
+#include "../midend/irOptimizationPasses.h"
+#include "threadPool.h"
 #include <fstream>
 #include <memory>
 #include <string>
@@ -19,24 +23,33 @@
 class PipelineStagesExecutors {
   public:
     /**
-     * Perform lexical analysis on the source file and generate the list of
+     * Perform lexical analysis on the source buffer and generate the list of
      * tokens.
      *
-     * @param sourceFile The input source file.
+     * The values of the tokens are views into the source buffer, so the source
+     * buffer must outlive the tokens.
+     *
+     * @param sourceBuffer The source buffer holding the input source file.
+     * @param useDFALexer Whether to lex with the single-pass DFA scanner
+     * instead of the regular expressions.
      * @return The list of tokens generated from lexing.
      */
     [[nodiscard]] static std::vector<Token>
-    lexerExecutor(std::string_view sourceFile);
+    lexerExecutor(const SourceBuffer &sourceBuffer, bool useDFALexer);
 
     /**
      * Perform syntactic analysis on the list of tokens and generate the AST
      * program.
      *
+     * The AST nodes created by the parser are allocated from the AST arena,
+     * so the arena must outlive the AST program.
+     *
      * @param tokens The list of tokens to parse.
+     * @param astArena The arena to allocate the AST nodes from.
      * @return The AST program generated from parsing.
      */
     [[nodiscard]] static std::unique_ptr<AST::Program>
-    parserExecutor(const std::vector<Token> &tokens);
+    parserExecutor(const std::vector<Token> &tokens, AST::ASTArena &astArena);
 
     /**
      * Perform semantic-analysis passes on the AST program.
@@ -69,33 +82,62 @@ class PipelineStagesExecutors {
     /**
      * Perform optimization passes on the IR program.
      *
+     * The passes are intra-procedural, so the function definitions are
+     * optimized independently on the threads of the thread pool; the result
+     * does not depend on the number of threads.
+     *
      * @param irProgram The IR program to optimize.
-     * @param foldConstantsPass Whether to perform the constant-folding pass.
-     * @param propagateCopiesPass Whether to perform the copy-propagation pass.
-     * @param eliminateUnreachableCodePass Whether to perform the
-     * unreachable-code elimination pass.
-     * @param eliminateDeadStoresPass Whether to perform the dead-store
-     * elimination pass.
+     * @param frontendSymbolTable The frontend symbol table (only read while
+     * optimizing; the variables introduced by SSA destruction are added to it
+     * afterwards).
+     * @param optimizationOptions The optimization passes to perform and the
+     * cap on the iterations of the pass manager.
+     * @param threadPool The thread pool to optimize the function definitions
+     * on.
+     * @return The statistics of the optimization (accumulated over the
+     * function definitions).
+     */
+    static IR::OptimizationStatistics
+    irOptimizationExecutor(IR::Program &irProgram,
+                           AST::FrontendSymbolTable &frontendSymbolTable,
+                           const IR::OptimizationOptions &optimizationOptions,
+                           ThreadPool &threadPool);
+
+    /**
+     * Convert the function body of each function definition of the IR
+     * program to the flat IR and back, in place.
+     *
+     * The round trip leaves the IR program unchanged, so that compiling with
+     * it checks the flat encoding against the whole pipeline.
+     *
+     * @param irProgram The IR program to convert.
+     * @param threadPool The thread pool to convert the function definitions
+     * on.
      */
-    static void irOptimizationExecutor(IR::Program &irProgram,
-                                       bool foldConstantsPass,
-                                       bool propagateCopiesPass,
-                                       bool eliminateUnreachableCodePass,
-                                       bool eliminateDeadStoresPass);
+    static void flatIRRoundTripExecutor(IR::Program &irProgram,
+                                        ThreadPool &threadPool);
 
     /**
      * Generate (but not yet emit) the assembly program from the IR program.
      *
+     * Assembly generation, pseudo-register replacement, and fixup are each
+     * run per function definition on the threads of the thread pool; the
+     * top-levels (and thus the emitted assembly) keep the order of the IR
+     * program regardless of the number of threads.
+     *
      * @param irProgram The IR program to convert to assembly.
      * @param irStaticVariables A vector of static variables in IR.
      * @param frontendSymbolTable The frontend symbol table.
+     * @param threadPool The thread pool to process the function definitions
+     * on.
      * @return The assembly program generated from the IR.
      */
     [[nodiscard]] static std::unique_ptr<Assembly::Program>
     codegenExecutor(const IR::Program &irProgram,
                     const std::vector<std::unique_ptr<IR::StaticVariable>>
                         &irStaticVariables,
-                    const AST::FrontendSymbolTable &frontendSymbolTable);
+                    const AST::FrontendSymbolTable &frontendSymbolTable,
+                    ThreadPool &threadPool);
 
     /**
      * Emit the generated assembly code to the assembly file.
@@ -233,6 +275,30 @@ class PipelineStagesExecutors {
     emitAssyDivInstruction(const Assembly::DivInstruction &divInstruction,
                            std::ofstream &assemblyFileStream);
 
+    /**
+     * Emit the assembly code for a one-operand signed-multiplication
+     * instruction.
+     *
+     * @param imulInstruction The one-operand signed-multiplication instruction
+     * to emit.
+     * @param assemblyFileStream The output assembly file stream.
+     */
+    static void
+    emitAssyImulInstruction(const Assembly::ImulInstruction &imulInstruction,
+                            std::ofstream &assemblyFileStream);
+
+    /**
+     * Emit the assembly code for a one-operand unsigned-multiplication
+     * instruction.
+     *
+     * @param mulInstruction The one-operand unsigned-multiplication
+     * instruction to emit.
+     * @param assemblyFileStream The output assembly file stream.
+     */
+    static void
+    emitAssyMulInstruction(const Assembly::MulInstruction &mulInstruction,
+                           std::ofstream &assemblyFileStream);
+
     /**
      * Emit the assembly code for a covert-doubleword-to-quadword instruction.
      *
@@ -284,6 +350,19 @@ class PipelineStagesExecutors {
     emitAssyLabelInstruction(const Assembly::LabelInstruction &labelInstruction,
                              std::ofstream &assemblyFileStream);
 
+    /**
+     * Format an assembly operand in AT&T syntax.
+     *
+     * @param operand The operand to format.
+     * @param registerSize The size (in bytes) of the register to use if the
+     * operand is a register.
+     * @return The formatted operand.
+     * @throws std::logic_error if the operand type is not supported (e.g., a
+     * pseudo register).
+     */
+    [[nodiscard]] static std::string
+    formatAssyOperand(const Assembly::Operand &operand, int registerSize);
+
     /**
      * Prepend an underscore to the identifier if the underlying OS is macOS.
      *
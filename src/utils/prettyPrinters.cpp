@@ -3,7 +3,9 @@
 #include "../frontend/constant.h"
 #include "../frontend/semanticAnalysisPasses.h"
 #include "../midend/ir.h"
+#include "../midend/irOptimizationPasses.h"
 #include "../utils/constants.h"
+#include <cstddef>
 #include <iostream>
 #include <iterator>
 #include <memory>
@@ -35,6 +37,33 @@ void PrettyPrinters::printIRProgram(
     }
 }
 
+void PrettyPrinters::printOptimizationStatistics(
+    const IR::OptimizationStatistics &statistics) {
+    std::cout << "Optimization iterations (at most, per function): "
+              << statistics.iterations << "\n";
+    for (std::size_t pass = 0; pass < IR::optimizationPassCount; ++pass) {
+        if (statistics.runs[pass] == 0) {
+            continue;
+        }
+        std::cout << "  "
+                  << IR::getOptimizationPassName(
+                         static_cast<IR::OptimizationPassKind>(pass))
+                  << ": " << statistics.changes[pass] << " of "
+                  << statistics.runs[pass] << " runs changed the IR\n";
+        if (static_cast<IR::OptimizationPassKind>(pass) !=
+            IR::OptimizationPassKind::SimplifyAlgebra) {
+            continue;
+        }
+        for (std::size_t rule = 0; rule < IR::simplificationRuleCount;
+             ++rule) {
+            if (statistics.ruleHits[rule] != 0) {
+                std::cout << "    " << IR::simplificationRules[rule].name
+                          << ": " << statistics.ruleHits[rule] << " hits\n";
+            }
+        }
+    }
+}
+
 void PrettyPrinters::printIRFunctionDefinition(
     const IR::FunctionDefinition &functionDefinition) {
     std::cout << functionDefinition.getFunctionIdentifier();
@@ -1036,6 +1065,15 @@ void PrettyPrinters::printAssyInstruction(
                  dynamic_cast<const Assembly::DivInstruction *>(&instruction)) {
         printAssyDivInstruction(*divInstruction);
     }
+    else if (const auto *imulInstruction =
+                 dynamic_cast<const Assembly::ImulInstruction *>(
+                     &instruction)) {
+        printAssyImulInstruction(*imulInstruction);
+    }
+    else if (const auto *mulInstruction =
+                 dynamic_cast<const Assembly::MulInstruction *>(&instruction)) {
+        printAssyMulInstruction(*mulInstruction);
+    }
     else if (const auto *cdqInstruction =
                  dynamic_cast<const Assembly::CdqInstruction *>(&instruction)) {
         printAssyCdqInstruction(*cdqInstruction);
@@ -1340,6 +1378,22 @@ void PrettyPrinters::printAssyBinaryInstruction(
              nullptr) {
         instructionName = "imul";
     }
+    else if (dynamic_cast<const Assembly::SalOperator *>(binaryOperator) !=
+             nullptr) {
+        instructionName = "sal";
+    }
+    else if (dynamic_cast<const Assembly::SarOperator *>(binaryOperator) !=
+             nullptr) {
+        instructionName = "sar";
+    }
+    else if (dynamic_cast<const Assembly::ShrOperator *>(binaryOperator) !=
+             nullptr) {
+        instructionName = "shr";
+    }
+    else if (dynamic_cast<const Assembly::LeaOperator *>(binaryOperator) !=
+             nullptr) {
+        instructionName = "lea";
+    }
     else {
         throw std::logic_error(
             "Unsupported binary operator while printing assembly binary "
@@ -1362,9 +1416,30 @@ void PrettyPrinters::printAssyBinaryInstruction(
             "printAssyBinaryInstruction");
     }
 
-    std::cout << "    " << instructionName << typeSuffix;
-
     const auto *operand1 = binaryInstruction.getOperand1();
+    const auto *operand2 = binaryInstruction.getOperand2();
+    if (const auto *leaOperator =
+            dynamic_cast<const Assembly::LeaOperator *>(binaryOperator)) {
+        const auto *operand1Reg =
+            dynamic_cast<const Assembly::RegisterOperand *>(operand1);
+        const auto *operand2Reg =
+            dynamic_cast<const Assembly::RegisterOperand *>(operand2);
+        if (operand1Reg == nullptr || operand2Reg == nullptr) {
+            throw std::logic_error(
+                "Non-register operand while printing assembly lea "
+                "instruction in printAssyBinaryInstruction");
+        }
+        std::cout << "    " << instructionName << typeSuffix << " ("
+                  << operand2Reg->getRegisterInBytesInStr(QUADWORD_SIZE)
+                  << ","
+                  << operand1Reg->getRegisterInBytesInStr(QUADWORD_SIZE)
+                  << "," << leaOperator->getScale() << "), "
+                  << operand2Reg->getRegisterInBytesInStr(registerSize)
+                  << "\n";
+        return;
+    }
+
+    std::cout << "    " << instructionName << typeSuffix;
     if (const auto *operand1Imm =
             dynamic_cast<const Assembly::ImmediateOperand *>(operand1)) {
         std::cout << " $" << static_cast<long>(operand1Imm->getImmediate())
@@ -1387,7 +1462,6 @@ void PrettyPrinters::printAssyBinaryInstruction(
         std::cout << " " << identifier << "(%rip),";
     }
 
-    const auto *operand2 = binaryInstruction.getOperand2();
     if (const auto *operand2Reg =
             dynamic_cast<const Assembly::RegisterOperand *>(operand2)) {
         std::cout << " " << operand2Reg->getRegisterInBytesInStr(registerSize)
@@ -1570,6 +1644,100 @@ void PrettyPrinters::printAssyDivInstruction(
     }
 }
 
+void PrettyPrinters::printAssyImulInstruction(
+    const Assembly::ImulInstruction &imulInstruction) {
+    const auto *type = imulInstruction.getType();
+
+    std::string typeSuffix;
+    int registerSize = 0;
+    if (dynamic_cast<const Assembly::Longword *>(type) != nullptr) {
+        typeSuffix = "l";
+        registerSize = LONGWORD_SIZE;
+    }
+    else if (dynamic_cast<const Assembly::Quadword *>(type) != nullptr) {
+        typeSuffix = "q";
+        registerSize = QUADWORD_SIZE;
+    }
+    else {
+        throw std::logic_error("Unsupported type while printing assembly imul "
+                               "instruction in printAssyImulInstruction");
+    }
+
+    std::cout << "    imul" << typeSuffix;
+
+    const auto *operand = imulInstruction.getOperand();
+    if (const auto *regOperand =
+            dynamic_cast<const Assembly::RegisterOperand *>(operand)) {
+        std::cout << " " << regOperand->getRegisterInBytesInStr(registerSize)
+                  << "\n";
+    }
+    else if (const auto *stackOperand =
+                 dynamic_cast<const Assembly::StackOperand *>(operand)) {
+        std::cout << " " << stackOperand->getOffset() << "("
+                  << stackOperand->getReservedRegisterInStr() << ")\n";
+    }
+    else if (const auto *dataOperand =
+                 dynamic_cast<const Assembly::DataOperand *>(operand)) {
+        auto identifier = dataOperand->getIdentifier();
+        prependUnderscoreToIdentifierIfMacOS(identifier);
+        std::cout << " " << identifier << "(%rip)\n";
+    }
+    else {
+        const auto &r = *operand;
+        throw std::logic_error(
+            "Unsupported operand type while printing assembly imul instruction "
+            "in printAssyImulInstruction: " +
+            std::string(typeid(r).name()));
+    }
+}
+
+void PrettyPrinters::printAssyMulInstruction(
+    const Assembly::MulInstruction &mulInstruction) {
+    const auto *type = mulInstruction.getType();
+
+    std::string typeSuffix;
+    int registerSize = 0;
+    if (dynamic_cast<const Assembly::Longword *>(type) != nullptr) {
+        typeSuffix = "l";
+        registerSize = LONGWORD_SIZE;
+    }
+    else if (dynamic_cast<const Assembly::Quadword *>(type) != nullptr) {
+        typeSuffix = "q";
+        registerSize = QUADWORD_SIZE;
+    }
+    else {
+        throw std::logic_error("Unsupported type while printing assembly mul "
+                               "instruction in printAssyMulInstruction");
+    }
+
+    std::cout << "    mul" << typeSuffix;
+
+    const auto *operand = mulInstruction.getOperand();
+    if (const auto *regOperand =
+            dynamic_cast<const Assembly::RegisterOperand *>(operand)) {
+        std::cout << " " << regOperand->getRegisterInBytesInStr(registerSize)
+                  << "\n";
+    }
+    else if (const auto *stackOperand =
+                 dynamic_cast<const Assembly::StackOperand *>(operand)) {
+        std::cout << " " << stackOperand->getOffset() << "("
+                  << stackOperand->getReservedRegisterInStr() << ")\n";
+    }
+    else if (const auto *dataOperand =
+                 dynamic_cast<const Assembly::DataOperand *>(operand)) {
+        auto identifier = dataOperand->getIdentifier();
+        prependUnderscoreToIdentifierIfMacOS(identifier);
+        std::cout << " " << identifier << "(%rip)\n";
+    }
+    else {
+        const auto &r = *operand;
+        throw std::logic_error(
+            "Unsupported operand type while printing assembly mul instruction "
+            "in printAssyMulInstruction: " +
+            std::string(typeid(r).name()));
+    }
+}
+
 void PrettyPrinters::printAssyCdqInstruction(
     const Assembly::CdqInstruction &cdqInstruction) {
     const auto *type = cdqInstruction.getType();
@@ -3,6 +3,7 @@
 
 #include "../backend/assembly.h"
 #include "../midend/ir.h"
+#include "../midend/irOptimizationPasses.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -30,6 +31,14 @@ class PrettyPrinters {
      */
     static void printAssemblyProgram(const Assembly::Program &assemblyProgram);
 
+    /**
+     * Print the statistics of the IR optimization passes to stdout.
+     *
+     * @param statistics The statistics to print.
+     */
+    static void
+    printOptimizationStatistics(const IR::OptimizationStatistics &statistics);
+
   private:
     /**
      * Print an IR function definition to stdout.
@@ -255,6 +264,26 @@ class PrettyPrinters {
     static void
     printAssyDivInstruction(const Assembly::DivInstruction &divInstruction);
 
+    /**
+     * Print an assembly one-operand signed-multiplication instruction to
+     * stdout.
+     *
+     * @param imulInstruction The assembly one-operand signed-multiplication
+     * instruction to print.
+     */
+    static void
+    printAssyImulInstruction(const Assembly::ImulInstruction &imulInstruction);
+
+    /**
+     * Print an assembly one-operand unsigned-multiplication instruction to
+     * stdout.
+     *
+     * @param mulInstruction The assembly one-operand unsigned-multiplication
+     * instruction to print.
+     */
+    static void
+    printAssyMulInstruction(const Assembly::MulInstruction &mulInstruction);
+
     /**
      * Print an assembly covert-doubleword-to-quadword instruction to stdout.
      *
@@ -0,0 +1,135 @@
+#include "symbol.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * Unnamed namespace for the process-wide string interner.
+ */
+namespace {
+/**
+ * Class representing the process-wide string interner.
+ *
+ * The names are stored in fixed-size chunks that are never moved or freed, so
+ * that `str` can index them without taking the lock (the ID of a symbol is
+ * only ever obtained after its name has been stored), and so that the keys of
+ * the lookup map can be views into them.
+ */
+class SymbolInterner {
+  public:
+    /**
+     * Constructor for the symbol interner class.
+     *
+     * Intern the empty name as ID 0 (the default-constructed symbol).
+     */
+    SymbolInterner() { store(""); }
+
+    /**
+     * Get the ID of the name, interning the name if needed.
+     *
+     * @param name The name to intern.
+     * @return The ID of the name.
+     */
+    std::uint32_t intern(std::string_view name) {
+        {
+            const std::shared_lock lock(mutex);
+            if (const auto it = ids.find(name); it != ids.end()) {
+                return it->second;
+            }
+        }
+        const std::unique_lock lock(mutex);
+        // Another thread may have interned the name in the meantime.
+        if (const auto it = ids.find(name); it != ids.end()) {
+            return it->second;
+        }
+        return store(name);
+    }
+
+    /**
+     * Get the name with the given ID.
+     *
+     * @param id The ID of the name.
+     * @return The name.
+     */
+    [[nodiscard]] const std::string &lookup(std::uint32_t id) const {
+        return chunks[id >> chunkBits][id & (chunkSize - 1)];
+    }
+
+  private:
+    /**
+     * The number of bits of an ID that index into a chunk.
+     */
+    static constexpr std::uint32_t chunkBits = 12;
+    /**
+     * The number of names per chunk.
+     */
+    static constexpr std::uint32_t chunkSize = 1U << chunkBits;
+    /**
+     * The maximum number of chunks.
+     */
+    static constexpr std::uint32_t maxChunks = 1U << 16U;
+
+    /**
+     * Store a new name (with the lock held) and assign it the next ID.
+     *
+     * @param name The name to store.
+     * @return The ID of the name.
+     */
+    std::uint32_t store(std::string_view name) {
+        const auto id = count;
+        const auto chunkIndex = id >> chunkBits;
+        if (chunkIndex >= maxChunks) {
+            throw std::runtime_error(
+                "Too many distinct names in store in SymbolInterner");
+        }
+        if (!chunks[chunkIndex]) {
+            chunks[chunkIndex] = std::make_unique<std::string[]>(chunkSize);
+        }
+        auto &slot = chunks[chunkIndex][id & (chunkSize - 1)];
+        slot = name;
+        ids.emplace(slot, id);
+        ++count;
+        return id;
+    }
+
+    /**
+     * The mutex guarding the lookup map and the interning of new names.
+     */
+    std::shared_mutex mutex;
+    /**
+     * The map from names (views into the chunks) to their IDs.
+     */
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+    /**
+     * The chunks storing the names, indexed by the high bits of the IDs.
+     */
+    std::array<std::unique_ptr<std::string[]>, maxChunks> chunks;
+    /**
+     * The number of interned names (i.e., the next ID).
+     */
+    std::uint32_t count = 0;
+};
+
+/**
+ * Get the process-wide string interner.
+ *
+ * @return The string interner.
+ */
+SymbolInterner &getSymbolInterner() {
+    static SymbolInterner interner;
+    return interner;
+}
+} // namespace
+
+Symbol::Symbol(std::string_view name) : id(getSymbolInterner().intern(name)) {}
+
+const std::string &Symbol::str() const {
+    return getSymbolInterner().lookup(id);
+}
@@ -0,0 +1,73 @@
+#ifndef UTILS_SYMBOL_H
+#define UTILS_SYMBOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/**
+ * Class representing an interned name (e.g., an identifier, a temporary, or a
+ * label).
+ *
+ * Every distinct name is stored once in a process-wide (and thread-safe)
+ * interner, and a symbol is just the compact ID of its name, so that symbols
+ * compare and hash in O(1) regardless of the length of the name. IDs are
+ * handed out in interning order; the default-constructed symbol is the empty
+ * name.
+ */
+class Symbol {
+  public:
+    /**
+     * Default constructor for the symbol class (the empty name).
+     */
+    constexpr Symbol() = default;
+
+    /**
+     * Constructor for the symbol class.
+     *
+     * Intern the name if it has not been interned yet.
+     *
+     * @param name The name to intern.
+     */
+    explicit Symbol(std::string_view name);
+
+    /**
+     * Get the name of the symbol.
+     *
+     * The returned reference is valid for the lifetime of the process.
+     *
+     * @return The name of the symbol.
+     */
+    [[nodiscard]] const std::string &str() const;
+
+    /**
+     * Get the ID of the symbol.
+     *
+     * @return The ID of the symbol.
+     */
+    [[nodiscard]] constexpr std::uint32_t getId() const { return id; }
+
+    /**
+     * Compare two symbols for equality (i.e., whether their names are equal).
+     */
+    friend constexpr bool operator==(Symbol lhs, Symbol rhs) = default;
+
+  private:
+    /**
+     * The ID of the symbol (its index in the interner).
+     */
+    std::uint32_t id = 0;
+};
+
+/**
+ * Hash function for symbols (so that they can key unordered containers).
+ */
+template <> struct std::hash<Symbol> {
+    std::size_t operator()(Symbol symbol) const noexcept {
+        return symbol.getId();
+    }
+};
+
+#endif // UTILS_SYMBOL_H
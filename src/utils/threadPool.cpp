@@ -0,0 +1,116 @@
+#include "threadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min(threadCount, getMaxThreadCount());
+    workers.reserve(threadCount - 1);
+    for (std::size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        const std::scoped_lock lock(mutex);
+        stopping = true;
+    }
+    jobPosted.notify_all();
+    // The workers are joined by the destructors of the `std::jthread`s.
+}
+
+std::size_t ThreadPool::getMaxThreadCount() {
+    return maxThreadsPerHardwareThread *
+           std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::size_t ThreadPool::getThreadCount() const { return workers.size() + 1; }
+
+void ThreadPool::parallelFor(std::size_t count,
+                             const std::function<void(std::size_t)> &task) {
+    if (workers.empty() || count <= 1) {
+        for (std::size_t index = 0; index < count; ++index) {
+            task(index);
+        }
+        return;
+    }
+
+    {
+        const std::scoped_lock lock(mutex);
+        currentTask = &task;
+        taskCount = count;
+        nextIndex.store(0, std::memory_order_relaxed);
+        activeWorkers = workers.size();
+        firstError = nullptr;
+        ++generation;
+    }
+    jobPosted.notify_all();
+
+    // The calling thread helps instead of idling until the workers are done.
+    runTasks();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock lock(mutex);
+        jobFinished.wait(lock, [this] { return activeWorkers == 0; });
+        currentTask = nullptr;
+        error = std::exchange(firstError, nullptr);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    std::uint64_t joinedGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            jobPosted.wait(lock, [this, joinedGeneration] {
+                return stopping || generation != joinedGeneration;
+            });
+            if (stopping) {
+                return;
+            }
+            joinedGeneration = generation;
+        }
+
+        runTasks();
+
+        {
+            const std::scoped_lock lock(mutex);
+            if (--activeWorkers == 0) {
+                jobFinished.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::runTasks() {
+    while (true) {
+        const auto index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (index >= taskCount) {
+            return;
+        }
+        try {
+            (*currentTask)(index);
+        } catch (...) {
+            const std::scoped_lock lock(mutex);
+            if (!firstError || index < firstErrorIndex) {
+                firstError = std::current_exception();
+                firstErrorIndex = index;
+            }
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Class representing a fixed-size pool of worker threads that run indexed
+ * tasks (e.g., one per function definition) in fork-join fashion.
+ *
+ * The calling thread takes part in each `parallelFor`, so a pool of `N`
+ * threads starts `N - 1` workers, and a pool of one thread runs everything
+ * serially on the calling thread. The tasks claim indices in increasing
+ * order, but may complete in any order: callers that need deterministic
+ * results write them into per-index slots and combine the slots in index
+ * order afterwards.
+ */
+class ThreadPool {
+  public:
+    /**
+     * The maximum number of threads of a pool per hardware thread.
+     */
+    static constexpr std::size_t maxThreadsPerHardwareThread = 4;
+
+    /**
+     * Constructor for the thread pool class.
+     *
+     * @param threadCount The number of threads (including the calling
+     * thread), or `0` for the number of hardware threads. Counts above
+     * `getMaxThreadCount()` are clamped to it.
+     */
+    explicit ThreadPool(std::size_t threadCount = 1);
+
+    /**
+     * Destructor for the thread pool class: stop and join the workers.
+     */
+    ~ThreadPool();
+
+    /**
+     * Delete the copy constructor for the thread pool class.
+     */
+    ThreadPool(const ThreadPool &) = delete;
+
+    /**
+     * Delete the copy assignment operator for the thread pool class.
+     */
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Delete the move constructor for the thread pool class.
+     */
+    ThreadPool(ThreadPool &&) = delete;
+
+    /**
+     * Delete the move assignment operator for the thread pool class.
+     */
+    ThreadPool &operator=(ThreadPool &&) = delete;
+
+    /**
+     * Get the maximum number of threads of a pool:
+     * `maxThreadsPerHardwareThread` times the number of hardware threads (or
+     * times one if it is unknown).
+     *
+     * @return The maximum number of threads.
+     */
+    [[nodiscard]] static std::size_t getMaxThreadCount();
+
+    /**
+     * Get the number of threads of the pool (including the calling thread).
+     *
+     * @return The number of threads.
+     */
+    [[nodiscard]] std::size_t getThreadCount() const;
+
+    /**
+     * Run a task for every index in `[0, count)` on the threads of the pool
+     * and wait for all of them to complete.
+     *
+     * If any task throws, the remaining tasks still run, and the exception
+     * of the lowest failing index is rethrown (so that the reported error
+     * does not depend on the scheduling).
+     *
+     * @param count The number of tasks.
+     * @param task The task to run (given its index).
+     */
+    void parallelFor(std::size_t count,
+                     const std::function<void(std::size_t)> &task);
+
+  private:
+    /**
+     * Wait for jobs and help run their tasks until the pool is stopped.
+     */
+    void workerLoop();
+
+    /**
+     * Claim and run the tasks of the current job until none are left.
+     */
+    void runTasks();
+
+    /**
+     * The worker threads (the calling thread is not included).
+     */
+    std::vector<std::jthread> workers;
+
+    /**
+     * The mutex guarding the job state below.
+     */
+    std::mutex mutex;
+    /**
+     * The condition variable signaled when a job is posted or the pool is
+     * stopped.
+     */
+    std::condition_variable jobPosted;
+    /**
+     * The condition variable signaled when the last worker leaves a job.
+     */
+    std::condition_variable jobFinished;
+
+    /**
+     * The task of the current job.
+     */
+    const std::function<void(std::size_t)> *currentTask = nullptr;
+    /**
+     * The number of tasks of the current job.
+     */
+    std::size_t taskCount = 0;
+    /**
+     * The next unclaimed index of the current job.
+     */
+    std::atomic<std::size_t> nextIndex = 0;
+    /**
+     * The number of workers that have not yet left the current job.
+     */
+    std::size_t activeWorkers = 0;
+    /**
+     * The generation of the current job (incremented by each posted job, so
+     * that a worker never joins the same job twice).
+     */
+    std::uint64_t generation = 0;
+    /**
+     * Boolean indicating whether the pool is being stopped.
+     */
+    bool stopping = false;
+
+    /**
+     * The exception of the lowest failing index of the current job (if any).
+     */
+    std::exception_ptr firstError;
+    /**
+     * The lowest failing index of the current job.
+     */
+    std::size_t firstErrorIndex = 0;
+};
+
+#endif // UTILS_THREAD_POOL_H